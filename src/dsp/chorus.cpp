@@ -43,7 +43,7 @@ template<class InputSignalProducerClass>
 Chorus<InputSignalProducerClass>::Chorus(
         std::string const name,
         InputSignalProducerClass& input
-) : Effect<InputSignalProducerClass>(name, input, 19 + VOICES * 3, &mixer),
+) : Effect<InputSignalProducerClass>(name, input, 19 + VOICES * 2, &comb_filters),
     type(name+ "TYP"),
     delay_time(
         name + "DEL",
@@ -154,18 +154,9 @@ Chorus<InputSignalProducerClass>::Chorus(
         FloatParamS(name + "DEL6", 0.0, DELAY_TIME_MAX, DELAY_TIME_DEFAULT),
         FloatParamS(name + "DEL7", 0.0, DELAY_TIME_MAX, DELAY_TIME_DEFAULT),
     },
-    comb_filters{
-        {high_pass_filter, PannedDelayStereoMode::NORMAL, width, delay_times[0], &tempo_sync},
-        {high_pass_filter, PannedDelayStereoMode::NORMAL, width, delay_times[1], &tempo_sync},
-        {high_pass_filter, PannedDelayStereoMode::NORMAL, width, delay_times[2], &tempo_sync},
-        {high_pass_filter, PannedDelayStereoMode::NORMAL, width, delay_times[3], &tempo_sync},
-        {high_pass_filter, PannedDelayStereoMode::NORMAL, width, delay_times[4], &tempo_sync},
-        {high_pass_filter, PannedDelayStereoMode::NORMAL, width, delay_times[5], &tempo_sync},
-        {high_pass_filter, PannedDelayStereoMode::NORMAL, width, delay_times[6], &tempo_sync},
-    },
-    mixer(input.get_channels()),
+    comb_filters(high_pass_filter, width, delay_times, &tempo_sync),
     high_shelf_filter(
-        mixer,
+        comb_filters,
         damping_frequency,
         biquad_filter_q,
         damping_gain,
@@ -173,7 +164,7 @@ Chorus<InputSignalProducerClass>::Chorus(
         0.0,
         NULL,
         NULL,
-        &mixer
+        &comb_filters
     ),
     feedback_gain(high_shelf_filter, feedback),
     previous_type(255),
@@ -198,26 +189,20 @@ Chorus<InputSignalProducerClass>::Chorus(
     this->register_child(high_pass_filter_gain);
     this->register_child(high_pass_filter);
 
-    this->register_child(mixer);
+    this->register_child(comb_filters);
 
     this->register_child(high_shelf_filter);
 
     this->register_child(feedback_gain);
 
-    for (size_t i = 0; i != VOICES; ++i) {
+    comb_filters.set_feedback_signal_producer(feedback_gain);
+
+    for (Integer i = 0; i != VOICES; ++i) {
         lfos[i].center.set_value(ToggleParam::ON);
         delay_times[i].set_lfo(&lfos[i]);
-        comb_filters[i].delay.set_feedback_signal_producer(feedback_gain);
-
-        if (i > 0) {
-            comb_filters[i].delay.use_shared_delay_buffer(comb_filters[0].delay);
-        }
-
-        mixer.add(comb_filters[i]);
 
         this->register_child(lfos[i]);
         this->register_child(delay_times[i]);
-        this->register_child(comb_filters[i]);
     }
 }
 
@@ -227,7 +212,7 @@ void Chorus<InputSignalProducerClass>::start_lfos(Seconds const time_offset) noe
 {
     should_start_lfos = true;
 
-    for (size_t i = 0; i != VOICES; ++i) {
+    for (Integer i = 0; i != VOICES; ++i) {
         lfos[i].start(time_offset);
     }
 }
@@ -238,7 +223,7 @@ void Chorus<InputSignalProducerClass>::stop_lfos(Seconds const time_offset) noex
 {
     should_start_lfos = false;
 
-    for (size_t i = 0; i != VOICES; ++i) {
+    for (Integer i = 0; i != VOICES; ++i) {
         lfos[i].stop(time_offset);
     }
 }
@@ -249,12 +234,27 @@ void Chorus<InputSignalProducerClass>::skip_round_for_lfos(
         Integer const round,
         Integer const sample_count
 ) noexcept {
-    for (size_t i = 0; i != VOICES; ++i) {
+    for (Integer i = 0; i != VOICES; ++i) {
         lfos[i].skip_round(round, sample_count);
     }
 }
 
 
+template<class InputSignalProducerClass>
+void Chorus<InputSignalProducerClass>::use_delay_buffer_pool(
+        DelayBufferPool& delay_buffer_pool
+) noexcept {
+    comb_filters.use_delay_buffer_pool(delay_buffer_pool);
+}
+
+
+template<class InputSignalProducerClass>
+bool Chorus<InputSignalProducerClass>::is_tail_silent() const noexcept
+{
+    return comb_filters.is_delay_buffer_silent();
+}
+
+
 template<class InputSignalProducerClass>
 Sample const* const* Chorus<InputSignalProducerClass>::initialize_rendering(
         Integer const round,
@@ -265,6 +265,8 @@ Sample const* const* Chorus<InputSignalProducerClass>::initialize_rendering(
     );
 
     if (buffer != NULL) {
+        comb_filters.release_delay_buffer();
+
         return buffer;
     }
 
@@ -288,25 +290,20 @@ void Chorus<InputSignalProducerClass>::update_tunings(Byte const type) noexcept
 {
     Tuning const* const tunings = TUNINGS[type];
 
-    mixer.reset();
+    comb_filters.reset();
 
-    for (size_t i = 0; i != VOICES; ++i) {
+    for (Integer i = 0; i != VOICES; ++i) {
         Tuning const& tuning = tunings[i];
-
-        CombFilter& comb_filter = comb_filters[i];
         LFO& lfo = lfos[i];
 
-        comb_filter.reset();
-        comb_filter.set_panning_scale(tuning.panning_scale);
+        comb_filters.set_tap(i, tuning.weight, tuning.panning_scale);
 
         lfo.reset();
         lfo.phase.set_value(tuning.lfo_phase);
-
-        mixer.set_weight(i, tuning.weight);
     }
 
     if (should_start_lfos) {
-        for (size_t i = 0; i != VOICES; ++i) {
+        for (Integer i = 0; i != VOICES; ++i) {
             lfos[i].start(0.0);
         }
     }
@@ -28,7 +28,6 @@
 #include "dsp/effect.hpp"
 #include "dsp/gain.hpp"
 #include "dsp/lfo.hpp"
-#include "dsp/mixer.hpp"
 #include "dsp/param.hpp"
 #include "dsp/signal_producer.hpp"
 
@@ -63,10 +62,12 @@ class Chorus : public Effect<InputSignalProducerClass>
             BiquadFilterFixedType::BFFT_HIGH_PASS
         > HighPassedInput;
 
-        typedef PannedDelay<HighPassedInput> CombFilter;
+        static constexpr Integer VOICES = 7;
+
+        typedef MultiTapDelay<HighPassedInput, VOICES> CombFilters;
 
         typedef BiquadFilter<
-            Mixer<CombFilter>,
+            CombFilters,
             BiquadFilterFixedType::BFFT_HIGH_SHELF
         > HighShelfFilter;
 
@@ -78,6 +79,18 @@ class Chorus : public Effect<InputSignalProducerClass>
 
         Chorus(std::string const name, InputSignalProducerClass& input);
 
+        /**
+         * \brief Lease the delay buffers from the given pool only while the
+         *        effect is in use.
+         */
+        void use_delay_buffer_pool(DelayBufferPool& delay_buffer_pool) noexcept;
+
+        /**
+         * \brief Tell whether the effect has nothing left to render from the
+         *        signal that it has received so far.
+         */
+        bool is_tail_silent() const noexcept;
+
         void start_lfos(Seconds const time_offset) noexcept;
         void stop_lfos(Seconds const time_offset) noexcept;
 
@@ -148,8 +161,6 @@ class Chorus : public Effect<InputSignalProducerClass>
         static constexpr Number DELAY_TIME_MAX = Constants::CHORUS_DELAY_TIME_MAX * 2.0;
         static constexpr Number DELAY_TIME_DEFAULT = Constants::CHORUS_DELAY_TIME_DEFAULT * 2.0;
 
-        static constexpr size_t VOICES = 7;
-
         static constexpr Tuning TUNINGS[][VOICES] = {
             /* CHORUS_1 */
             {
@@ -324,8 +335,7 @@ class Chorus : public Effect<InputSignalProducerClass>
         HighPassedInput high_pass_filter;
         LFO lfos[VOICES];
         FloatParamS delay_times[VOICES];
-        CombFilter comb_filters[VOICES];
-        Mixer<CombFilter> mixer;
+        CombFilters comb_filters;
         HighShelfFilter high_shelf_filter;
         Gain<HighShelfFilter> feedback_gain;
         Sample const* const* chorused;
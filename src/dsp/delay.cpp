@@ -139,6 +139,8 @@ template<class InputSignalProducerClass, DelayCapabilities capabilities>
 void Delay<InputSignalProducerClass, capabilities>::initialize_instance() noexcept
 {
     shared_buffer_owner = NULL;
+    delay_buffer_pool = NULL;
+    delay_buffer_slot_id = DelayBufferPool::INVALID_SLOT_ID;
 
     feedback_signal_producer = NULL;
     time_scale_param = NULL;
@@ -240,6 +242,12 @@ void Delay<InputSignalProducerClass, capabilities>::reallocate_delay_buffer_if_n
 template<class InputSignalProducerClass, DelayCapabilities capabilities>
 void Delay<InputSignalProducerClass, capabilities>::free_delay_buffer() noexcept
 {
+    if (delay_buffer_pool != NULL) {
+        delay_buffer = NULL;
+
+        return;
+    }
+
     if (delay_buffer == NULL || shared_buffer_owner != NULL) {
         return;
     }
@@ -264,6 +272,14 @@ void Delay<InputSignalProducerClass, capabilities>::allocate_delay_buffer() noex
         return;
     }
 
+    if (delay_buffer_pool != NULL) {
+        delay_buffer_pool->resize_slot(
+            delay_buffer_slot_id, this->channels, delay_buffer_size
+        );
+        Delay<InputSignalProducerClass, capabilities>::reset();
+        return;
+    }
+
     delay_buffer = new Sample*[this->channels];
 
     for (Integer c = 0; c != this->channels; ++c) {
@@ -280,12 +296,23 @@ void Delay<InputSignalProducerClass, capabilities>::reset() noexcept
 {
     Filter<InputSignalProducerClass>::reset();
 
-    if (shared_buffer_owner == NULL) {
+    if (delay_buffer_pool != NULL) {
+        delay_buffer = delay_buffer_pool->get(delay_buffer_slot_id);
+    }
+
+    if (shared_buffer_owner == NULL && delay_buffer != NULL) {
         for (Integer c = 0; c != this->channels; ++c) {
             std::fill_n(delay_buffer[c], delay_buffer_size, 0.0);
         }
     }
 
+    reset_state();
+}
+
+
+template<class InputSignalProducerClass, DelayCapabilities capabilities>
+void Delay<InputSignalProducerClass, capabilities>::reset_state() noexcept
+{
     write_index_input = 0;
     silent_input_samples = delay_buffer_size;
 
@@ -295,6 +322,7 @@ void Delay<InputSignalProducerClass, capabilities>::reset() noexcept
     need_to_render_silence = false;
 
     clear_index = this->block_size;
+    dirty_samples = 0;
     is_starting = true;
     previous_round = -1;
 
@@ -387,6 +415,54 @@ void Delay<InputSignalProducerClass, capabilities>::use_shared_delay_buffer(
 }
 
 
+template<class InputSignalProducerClass, DelayCapabilities capabilities>
+void Delay<InputSignalProducerClass, capabilities>::use_delay_buffer_pool(
+    DelayBufferPool& delay_buffer_pool
+) noexcept {
+    if (shared_buffer_owner != NULL || this->delay_buffer_pool != NULL) {
+        return;
+    }
+
+    free_delay_buffer();
+
+    this->delay_buffer_pool = &delay_buffer_pool;
+    delay_buffer_slot_id = delay_buffer_pool.add_slot(
+        this->channels, delay_buffer_size
+    );
+
+    Delay<InputSignalProducerClass, capabilities>::reset();
+}
+
+
+template<class InputSignalProducerClass, DelayCapabilities capabilities>
+void Delay<InputSignalProducerClass, capabilities>::release_delay_buffer() noexcept
+{
+    if (delay_buffer_pool == NULL) {
+        return;
+    }
+
+    if (delay_buffer_pool->get(delay_buffer_slot_id) == NULL) {
+        delay_buffer = NULL;
+
+        return;
+    }
+
+    /*
+    A silent delay line has already zeroed its whole buffer while clearing
+    ahead of the writes, so the pool needs to clear only what may have been
+    written since the last lease.
+    */
+    delay_buffer_pool->release(
+        delay_buffer_slot_id, is_delay_buffer_silent() ? 0 : dirty_samples
+    );
+    delay_buffer = NULL;
+    reset_state();
+
+    /* The last rendered block may still be in the output buffer. */
+    need_to_render_silence = true;
+}
+
+
 template<class InputSignalProducerClass, DelayCapabilities capabilities>
 Sample const* const* Delay<InputSignalProducerClass, capabilities>::initialize_rendering(
     Integer const round,
@@ -394,6 +470,18 @@ Sample const* const* Delay<InputSignalProducerClass, capabilities>::initialize_r
 ) noexcept {
     Filter<InputSignalProducerClass>::initialize_rendering(round, sample_count);
 
+    if (delay_buffer_pool != NULL) {
+        delay_buffer = delay_buffer_pool->lease(delay_buffer_slot_id);
+
+        if (JS80P_UNLIKELY(delay_buffer == NULL)) {
+            /* The pool's arena is not allocated. */
+            this->render_silence(round, 0, this->block_size, this->buffer);
+            this->mark_round_as_silent(round);
+
+            return this->buffer;
+        }
+    }
+
     read_index = write_index_input;
 
     if constexpr (capabilities == DelayCapabilities::DC_REVERSIBLE) {
@@ -499,9 +587,21 @@ void Delay<InputSignalProducerClass, capabilities>::clear_delay_buffer(
         Integer const sample_count
 ) noexcept {
     if constexpr (!is_delay_buffer_shared) {
+        Integer const previous_clear_index = clear_index;
+
         clear_index = write_delay_buffer<DelayBufferWritingMode::CLEAR>(
             NULL, clear_index, sample_count
         );
+
+        /*
+        Nothing is written beyond the index up to which the buffer is cleared,
+        until the index wraps around.
+        */
+        if (clear_index < previous_clear_index) {
+            dirty_samples = delay_buffer_size;
+        } else if (dirty_samples < clear_index) {
+            dirty_samples = clear_index;
+        }
     }
 }
 
@@ -516,10 +616,17 @@ void Delay<InputSignalProducerClass, capabilities>::mix_feedback_into_delay_buff
         return;
     }
 
+    /*
+    The feedback signal of a round is mixed into the delay buffer only in the
+    next round, so the feedback is written one full block ahead of the input.
+    This minimum feedback delay guarantees that a round can never read past the
+    feedback that has been written so far, no matter how the number of samples
+    varies between rounds.
+    */
     if (JS80P_UNLIKELY(is_starting)) {
         is_starting = false;
         write_index_feedback = advance_delay_buffer_index(
-            write_index_feedback, sample_count
+            write_index_feedback, this->block_size
         );
 
         if (silent_feedback_samples < delay_buffer_size) {
@@ -1458,6 +1565,315 @@ void PannedDelay<InputSignalProducerClass, FilterInputClass, capabilities>::rend
 }
 
 
+template<class InputSignalProducerClass, Integer taps>
+MultiTapDelay<InputSignalProducerClass, taps>::MultiTapDelay(
+        InputSignalProducerClass& input,
+        FloatParamS& panning,
+        FloatParamS (&tap_times)[taps],
+        ToggleParam const* tempo_sync
+) noexcept
+    : Delay<InputSignalProducerClass>(input, tap_times[0], tempo_sync),
+    panning(panning),
+    tap_times(tap_times),
+    read_positions(NULL),
+    panning_buffer(NULL),
+    active_taps_count(0)
+{
+    static_assert(taps > 0, "MultiTapDelay needs at least one tap");
+
+    /*
+    The size of the delay buffer is determined by the maximum value of the
+    first tap's delay time parameter.
+    */
+    for (Integer t = 1; t != taps; ++t) {
+        JS80P_ASSERT(tap_times[t].get_max_value() <= tap_times[0].get_max_value());
+    }
+
+    std::fill_n(weights, taps, 1.0);
+    std::fill_n(panning_scales, taps, 1.0);
+
+    allocate_read_positions();
+    update_active_taps();
+}
+
+
+template<class InputSignalProducerClass, Integer taps>
+MultiTapDelay<InputSignalProducerClass, taps>::~MultiTapDelay()
+{
+    free_read_positions();
+}
+
+
+template<class InputSignalProducerClass, Integer taps>
+void MultiTapDelay<InputSignalProducerClass, taps>::set_block_size(
+        Integer const new_block_size
+) noexcept {
+    if (new_block_size == this->get_block_size()) {
+        return;
+    }
+
+    Delay<InputSignalProducerClass>::set_block_size(new_block_size);
+
+    free_read_positions();
+    allocate_read_positions();
+}
+
+
+template<class InputSignalProducerClass, Integer taps>
+void MultiTapDelay<InputSignalProducerClass, taps>::allocate_read_positions() noexcept
+{
+    Integer const block_size = this->block_size;
+
+    read_positions = new Sample*[taps];
+
+    for (Integer t = 0; t != taps; ++t) {
+        read_positions[t] = new Sample[block_size];
+    }
+}
+
+
+template<class InputSignalProducerClass, Integer taps>
+void MultiTapDelay<InputSignalProducerClass, taps>::free_read_positions() noexcept
+{
+    if (read_positions == NULL) {
+        return;
+    }
+
+    for (Integer t = 0; t != taps; ++t) {
+        delete[] read_positions[t];
+    }
+
+    delete[] read_positions;
+
+    read_positions = NULL;
+}
+
+
+template<class InputSignalProducerClass, Integer taps>
+void MultiTapDelay<InputSignalProducerClass, taps>::set_tap(
+        Integer const tap,
+        Number const weight,
+        Number const panning_scale
+) noexcept {
+    if (JS80P_UNLIKELY(tap < 0 || tap >= taps)) {
+        return;
+    }
+
+    weights[tap] = weight;
+    panning_scales[tap] = panning_scale;
+
+    update_active_taps();
+}
+
+
+template<class InputSignalProducerClass, Integer taps>
+void MultiTapDelay<InputSignalProducerClass, taps>::update_active_taps() noexcept
+{
+    Integer active_taps_count = 0;
+
+    for (Integer t = 0; t != taps; ++t) {
+        if (weights[t] > SILENCE_WEIGHT) {
+            active_taps[active_taps_count] = t;
+            active_weights[active_taps_count] = weights[t];
+            active_panning_scales[active_taps_count] = panning_scales[t];
+            ++active_taps_count;
+        }
+    }
+
+    this->active_taps_count = active_taps_count;
+}
+
+
+/* https://www.w3.org/TR/webaudio/#stereopanner-algorithm */
+template<class InputSignalProducerClass, Integer taps>
+void MultiTapDelay<InputSignalProducerClass, taps>::update_stereo_gains(
+        Integer const active_tap,
+        Number const panning
+) noexcept {
+    Number const x = (panning <= 0.0 ? panning + 1.0 : panning) * Math::PI_HALF;
+    Number const weight = active_weights[active_tap];
+    Number left_gain;
+    Number right_gain;
+
+    Math::sincos(x, right_gain, left_gain);
+
+    if (panning > 0.0) {
+        left_to_left[active_tap] = weight * left_gain;
+        right_to_left[active_tap] = 0.0;
+        left_to_right[active_tap] = weight * right_gain;
+        right_to_right[active_tap] = weight;
+    } else {
+        left_to_left[active_tap] = weight;
+        right_to_left[active_tap] = weight * left_gain;
+        left_to_right[active_tap] = 0.0;
+        right_to_right[active_tap] = weight * right_gain;
+    }
+}
+
+
+template<class InputSignalProducerClass, Integer taps>
+Sample const* const* MultiTapDelay<InputSignalProducerClass, taps>::initialize_rendering(
+        Integer const round,
+        Integer const sample_count
+) noexcept {
+    Sample const* const* const buffer = (
+        Delay<InputSignalProducerClass>::initialize_rendering(round, sample_count)
+    );
+
+    if (buffer != NULL) {
+        return buffer;
+    }
+
+    Integer const active_taps_count = this->active_taps_count;
+    Number const time_scale = this->time_scale;
+    Number const read_index = (Number)this->read_index;
+    Number const delay_buffer_size_float = this->delay_buffer_size_float;
+
+    for (Integer a = 0; a != active_taps_count; ++a) {
+        FloatParamS& tap_time = tap_times[active_taps[a]];
+        Sample const* const time_buffer = (
+            FloatParamS::produce_if_not_constant(tap_time, round, sample_count)
+        );
+        Sample* const positions = read_positions[a];
+
+        if (time_buffer == NULL) {
+            Number const first_position = read_index - tap_time.get_value() * time_scale;
+
+            for (Integer i = 0; i != sample_count; ++i) {
+                positions[i] = first_position + (Number)i;
+            }
+        } else {
+            for (Integer i = 0; i != sample_count; ++i) {
+                positions[i] = read_index + (Number)i - time_buffer[i] * time_scale;
+            }
+        }
+
+        for (Integer i = 0; i != sample_count; ++i) {
+            Number const position = positions[i];
+
+            positions[i] = (
+                position < 0.0
+                    ? position + delay_buffer_size_float
+                    : (
+                        position >= delay_buffer_size_float
+                            ? position - delay_buffer_size_float
+                            : position
+                    )
+            );
+        }
+    }
+
+    panning_buffer = FloatParamS::produce_if_not_constant(panning, round, sample_count);
+
+    if (panning_buffer == NULL) {
+        Number const panning_value = panning.get_value();
+
+        for (Integer a = 0; a != active_taps_count; ++a) {
+            update_stereo_gains(a, panning_value * active_panning_scales[a]);
+        }
+    }
+
+    return NULL;
+}
+
+
+template<class InputSignalProducerClass, Integer taps>
+void MultiTapDelay<InputSignalProducerClass, taps>::render(
+        Integer const round,
+        Integer const first_sample_index,
+        Integer const last_sample_index,
+        Sample** buffer
+) noexcept {
+    if (JS80P_UNLIKELY(this->channels != 2)) {
+        render_mono(first_sample_index, last_sample_index, buffer);
+    } else if (panning_buffer == NULL) {
+        render_stereo<true>(first_sample_index, last_sample_index, buffer);
+    } else {
+        render_stereo<false>(first_sample_index, last_sample_index, buffer);
+    }
+}
+
+
+template<class InputSignalProducerClass, Integer taps>
+template<bool is_panning_constant>
+void MultiTapDelay<InputSignalProducerClass, taps>::render_stereo(
+        Integer const first_sample_index,
+        Integer const last_sample_index,
+        Sample** buffer
+) noexcept {
+    Integer const active_taps_count = this->active_taps_count;
+    Integer const delay_buffer_size = this->delay_buffer_size;
+    Sample const* const delay_left = this->delay_buffer[0];
+    Sample const* const delay_right = this->delay_buffer[1];
+    Sample* const out_left = buffer[0];
+    Sample* const out_right = buffer[1];
+
+    for (Integer i = first_sample_index; i != last_sample_index; ++i) {
+        Sample left = 0.0;
+        Sample right = 0.0;
+
+        for (Integer a = 0; a != active_taps_count; ++a) {
+            Number const position = read_positions[a][i];
+            Integer before_index = (Integer)position;
+            Number const after_weight = position - (Number)before_index;
+
+            if (JS80P_UNLIKELY(before_index >= delay_buffer_size)) {
+                before_index -= delay_buffer_size;
+            }
+
+            Integer const after_index = (
+                before_index + 1 == delay_buffer_size ? 0 : before_index + 1
+            );
+            Sample const delayed_left = Math::combine(
+                after_weight, delay_left[after_index], delay_left[before_index]
+            );
+            Sample const delayed_right = Math::combine(
+                after_weight, delay_right[after_index], delay_right[before_index]
+            );
+
+            if constexpr (!is_panning_constant) {
+                update_stereo_gains(a, panning_buffer[i] * active_panning_scales[a]);
+            }
+
+            left += left_to_left[a] * delayed_left + right_to_left[a] * delayed_right;
+            right += left_to_right[a] * delayed_left + right_to_right[a] * delayed_right;
+        }
+
+        out_left[i] = left;
+        out_right[i] = right;
+    }
+}
+
+
+template<class InputSignalProducerClass, Integer taps>
+void MultiTapDelay<InputSignalProducerClass, taps>::render_mono(
+        Integer const first_sample_index,
+        Integer const last_sample_index,
+        Sample** buffer
+) noexcept {
+    Integer const channels = this->channels;
+    Integer const active_taps_count = this->active_taps_count;
+    Integer const delay_buffer_size = this->delay_buffer_size;
+
+    for (Integer c = 0; c != channels; ++c) {
+        Sample const* const delay_channel = this->delay_buffer[c];
+        Sample* const out_channel = buffer[c];
+
+        for (Integer i = first_sample_index; i != last_sample_index; ++i) {
+            Sample sample = 0.0;
+
+            for (Integer a = 0; a != active_taps_count; ++a) {
+                sample += active_weights[a] * Math::lookup_periodic<true>(
+                    delay_channel, (int)delay_buffer_size, read_positions[a][i]
+                );
+            }
+
+            out_channel[i] = sample;
+        }
+    }
+}
+
+
 template<class InputSignalProducerClass, DelayCapabilities capabilities>
 DistortedHighShelfPannedDelay<InputSignalProducerClass, capabilities>::DistortedHighShelfPannedDelay(
     InputSignalProducerClass& input,
@@ -27,6 +27,7 @@
 #include "dsp/biquad_filter.hpp"
 #include "dsp/distortion.hpp"
 #include "dsp/math.hpp"
+#include "dsp/delay_buffer_pool.hpp"
 #include "dsp/param.hpp"
 #include "dsp/signal_producer.hpp"
 
@@ -107,6 +108,30 @@ class Delay : public Filter<InputSignalProducerClass>
             Delay<InputSignalProducerClass, capabilities> const& shared_buffer_owner
         ) noexcept;
 
+        /**
+         * \brief Lease the delay buffer from the given pool when rendering
+         *        starts, instead of allocating it up front.
+         *
+         * \warning Not real-time safe. The pool must outlive the \c Delay, and
+         *          the pool's arena needs to be reallocated after changing
+         *          the sample rate or the block size.
+         */
+        void use_delay_buffer_pool(DelayBufferPool& delay_buffer_pool) noexcept;
+
+        /**
+         * \brief Give the delay buffer back to the pool, and clear the state
+         *        of the delay line. The buffer will be leased again when the
+         *        \c Delay is rendered next time.
+         */
+        void release_delay_buffer() noexcept;
+
+        /**
+         * \brief Tell whether both the input and the feedback have been
+         *        silent for long enough for the delay buffer to contain only
+         *        silence.
+         */
+        bool is_delay_buffer_silent() const noexcept;
+
         void set_time_scale_param(FloatParamS& time_scale_param) noexcept;
 
         void set_reverse_toggle_param(ToggleParam& reverse_toggle_param) noexcept;
@@ -134,6 +159,12 @@ class Delay : public Filter<InputSignalProducerClass>
             Sample** buffer
         ) noexcept;
 
+        Sample** delay_buffer;
+        Sample time_scale;
+        Integer read_index;
+        Integer delay_buffer_size;
+        Number delay_buffer_size_float;
+
     private:
         enum DelayBufferWritingMode {
             CLEAR = 0,
@@ -141,6 +172,7 @@ class Delay : public Filter<InputSignalProducerClass>
         };
 
         void initialize_instance() noexcept;
+        void reset_state() noexcept;
 
         void reallocate_delay_buffer_if_needed() noexcept;
         void free_delay_buffer() noexcept;
@@ -170,8 +202,6 @@ class Delay : public Filter<InputSignalProducerClass>
             Integer const increment
         ) const noexcept;
 
-        bool is_delay_buffer_silent() const noexcept;
-
         template<
             bool need_gain,
             bool is_gain_constant,
@@ -224,25 +254,23 @@ class Delay : public Filter<InputSignalProducerClass>
         bool const is_gain_constant_1;
 
         Delay<InputSignalProducerClass, capabilities> const* shared_buffer_owner;
+        DelayBufferPool* delay_buffer_pool;
+        DelayBufferPool::SlotId delay_buffer_slot_id;
 
         SignalProducer* feedback_signal_producer;
         FloatParamS* time_scale_param;
         ToggleParam* reverse_toggle_param;
-        Sample** delay_buffer;
         Sample const* gain_buffer;
         Sample const* time_buffer;
         Sample const* time_scale_buffer;
-        Sample time_scale;
         Number feedback_value;
         Integer write_index_input;
         Integer silent_input_samples;
         Integer write_index_feedback;
         Integer silent_feedback_samples;
-        Integer read_index;
         Integer clear_index;
-        Integer delay_buffer_size;
+        Integer dirty_samples;
         Integer previous_round;
-        Number delay_buffer_size_float;
 
         Number reverse_next_start_index;
         Number reverse_read_index;
@@ -392,6 +420,114 @@ class PannedDelay : public Filter<FilterInputClass>
 };
 
 
+/**
+ * \brief A stereo delay line with multiple modulated read positions (taps).
+ *        Each tap has its own delay time, panning scale, and weight, and the
+ *        taps are mixed into a single stereo output.
+ *
+ * \note The input (and the feedback) is written into the delay buffer only
+ *       once per round, and all the taps are read, panned, and mixed in a
+ *       single pass, so this is much cheaper than mixing the output of
+ *       multiple \c PannedDelay objects which share a delay buffer.
+ */
+template<class InputSignalProducerClass, Integer taps>
+class MultiTapDelay : public Delay<InputSignalProducerClass>
+{
+    friend class SignalProducer;
+
+    public:
+        static constexpr Integer TAPS = taps;
+
+        MultiTapDelay(
+            InputSignalProducerClass& input,
+            FloatParamS& panning,
+            FloatParamS (&tap_times)[taps],
+            ToggleParam const* tempo_sync = NULL
+        ) noexcept;
+
+        virtual ~MultiTapDelay();
+
+        virtual void set_block_size(Integer const new_block_size) noexcept override;
+
+        /**
+         * \brief Set the weight and the panning scale of a tap. Taps with a
+         *        weight of 0.0 are skipped entirely.
+         */
+        void set_tap(
+            Integer const tap,
+            Number const weight,
+            Number const panning_scale
+        ) noexcept;
+
+    protected:
+        Sample const* const* initialize_rendering(
+            Integer const round,
+            Integer const sample_count
+        ) noexcept;
+
+        void render(
+            Integer const round,
+            Integer const first_sample_index,
+            Integer const last_sample_index,
+            Sample** buffer
+        ) noexcept;
+
+    private:
+        static constexpr Number SILENCE_WEIGHT = 0.000001;
+
+        void allocate_read_positions() noexcept;
+        void free_read_positions() noexcept;
+
+        void update_active_taps() noexcept;
+
+        void update_stereo_gains(
+            Integer const active_tap,
+            Number const panning
+        ) noexcept;
+
+        template<bool is_panning_constant>
+        void render_stereo(
+            Integer const first_sample_index,
+            Integer const last_sample_index,
+            Sample** buffer
+        ) noexcept;
+
+        void render_mono(
+            Integer const first_sample_index,
+            Integer const last_sample_index,
+            Sample** buffer
+        ) noexcept;
+
+        FloatParamS& panning;
+        FloatParamS* const tap_times;
+
+        Number weights[taps];
+        Number panning_scales[taps];
+
+        /*
+        The arrays below are indexed by active tap index, i.e. they only hold
+        data for the taps that have a non-zero weight, contiguously, so that
+        the inner loop of the rendering can iterate over them without
+        branching.
+        */
+        Integer active_taps[taps];
+        Number active_weights[taps];
+        Number active_panning_scales[taps];
+
+        /* Panning and weight combined into a 2x2 matrix for each active tap. */
+        Sample left_to_left[taps];
+        Sample right_to_left[taps];
+        Sample left_to_right[taps];
+        Sample right_to_right[taps];
+
+        /* Fractional read index of each active tap for each sample. */
+        Sample** read_positions;
+
+        Sample const* panning_buffer;
+        Integer active_taps_count;
+};
+
+
 template<class InputSignalProducerClass, DelayCapabilities capabilities = DelayCapabilities::DC_BASIC>
 using DistortedDelay = Distortion::Distortion< Delay<InputSignalProducerClass, capabilities> >;
 
@@ -0,0 +1,309 @@
+/*
+ * This file is part of JS80P, a synthesizer plugin.
+ * Copyright (C) 2023, 2024  Attila M. Magyar
+ *
+ * JS80P is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * JS80P is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef JS80P__DSP__DELAY_BUFFER_POOL_CPP
+#define JS80P__DSP__DELAY_BUFFER_POOL_CPP
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+
+#include "dsp/delay_buffer_pool.hpp"
+
+
+namespace JS80P
+{
+
+DelayBufferPool::Slot::Slot(Integer const channels, Integer const size) noexcept
+    : buffer(NULL),
+    size_in_bytes(0),
+    channels(channels),
+    size(size),
+    dirty_samples(0),
+    cleared_samples(0),
+    state(SlotState::CLEAN)
+{
+}
+
+
+DelayBufferPool::DelayBufferPool() noexcept
+    : arena(NULL),
+    next_released_slot_id(0),
+    is_arena_up_to_date(true)
+{
+    arena_size.store(0);
+    leased_size.store(0);
+}
+
+
+DelayBufferPool::~DelayBufferPool()
+{
+    free_arena();
+}
+
+
+DelayBufferPool::SlotId DelayBufferPool::add_slot(
+        Integer const channels,
+        Integer const size
+) noexcept {
+    slots.push_back(Slot(channels, size));
+    is_arena_up_to_date = false;
+
+    return (SlotId)slots.size() - 1;
+}
+
+
+void DelayBufferPool::resize_slot(
+        SlotId const slot_id,
+        Integer const channels,
+        Integer const size
+) noexcept {
+    Slot& slot = slots[slot_id];
+
+    if (slot.channels == channels && slot.size == size) {
+        return;
+    }
+
+    slot.channels = channels;
+    slot.size = size;
+    is_arena_up_to_date = false;
+}
+
+
+size_t DelayBufferPool::calculate_channel_size_in_bytes(Integer const size) noexcept
+{
+    size_t const size_in_bytes = (size_t)size * sizeof(Sample);
+
+    return ((size_in_bytes + PAGE_SIZE - 1) / PAGE_SIZE) * PAGE_SIZE;
+}
+
+
+void DelayBufferPool::allocate() noexcept
+{
+    if (is_arena_up_to_date) {
+        return;
+    }
+
+    free_arena();
+
+    size_t new_arena_size = 0;
+
+    for (std::vector<Slot>::iterator it = slots.begin(); it != slots.end(); ++it) {
+        it->size_in_bytes = (
+            (size_t)it->channels * calculate_channel_size_in_bytes(it->size)
+        );
+        new_arena_size += it->size_in_bytes;
+    }
+
+    /*
+    Large blocks from calloc() are usually mapped directly from the operating
+    system, which already provides them zeroed, so the pages which are never
+    leased are never touched.
+    */
+    arena = std::calloc(new_arena_size + PAGE_SIZE, 1);
+
+    if (JS80P_UNLIKELY(arena == NULL)) {
+        return;
+    }
+
+    arena_size.store(new_arena_size);
+
+    uintptr_t const arena_start = (uintptr_t)arena;
+    char* next_page = (char*)(
+        ((arena_start + PAGE_SIZE - 1) / PAGE_SIZE) * PAGE_SIZE
+    );
+
+    for (std::vector<Slot>::iterator it = slots.begin(); it != slots.end(); ++it) {
+        size_t const channel_size_in_bytes = calculate_channel_size_in_bytes(it->size);
+
+        it->buffer = new Sample*[it->channels];
+
+        for (Integer c = 0; c != it->channels; ++c) {
+            it->buffer[c] = (Sample*)next_page;
+            next_page += channel_size_in_bytes;
+        }
+
+        it->cleared_samples = 0;
+        it->state = SlotState::CLEAN;
+    }
+
+    leased_size.store(0);
+    next_released_slot_id = 0;
+    is_arena_up_to_date = true;
+}
+
+
+void DelayBufferPool::trim() noexcept
+{
+    if (arena == NULL) {
+        return;
+    }
+
+    is_arena_up_to_date = false;
+    allocate();
+}
+
+
+void DelayBufferPool::free_arena() noexcept
+{
+    for (std::vector<Slot>::iterator it = slots.begin(); it != slots.end(); ++it) {
+        if (it->buffer != NULL) {
+            delete[] it->buffer;
+
+            it->buffer = NULL;
+        }
+
+        it->state = SlotState::CLEAN;
+    }
+
+    if (arena != NULL) {
+        std::free(arena);
+
+        arena = NULL;
+    }
+
+    arena_size.store(0);
+    leased_size.store(0);
+}
+
+
+Sample** DelayBufferPool::lease(SlotId const slot_id) noexcept
+{
+    Slot& slot = slots[slot_id];
+
+    if (JS80P_UNLIKELY(slot.buffer == NULL || !is_arena_up_to_date)) {
+        return NULL;
+    }
+
+    switch (slot.state) {
+        case SlotState::LEASED:
+            return slot.buffer;
+
+        case SlotState::RELEASED:
+            /*
+            Usually, the slot is cleared in batches by clear_released_slots()
+            long before it's needed again, but when it's leased too soon,
+            then the rest of it needs to be cleared right away, because the
+            input that arrives in the meantime must not be lost.
+            */
+            clear(slot, slot.dirty_samples);
+            break;
+
+        default:
+            break;
+    }
+
+    slot.state = SlotState::LEASED;
+    leased_size.fetch_add(slot.size_in_bytes);
+
+    return slot.buffer;
+}
+
+
+Sample** DelayBufferPool::get(SlotId const slot_id) const noexcept
+{
+    Slot const& slot = slots[slot_id];
+
+    return (
+        is_arena_up_to_date && slot.state == SlotState::LEASED ? slot.buffer : NULL
+    );
+}
+
+
+void DelayBufferPool::release(SlotId const slot_id) noexcept
+{
+    release(slot_id, slots[slot_id].size);
+}
+
+
+void DelayBufferPool::release(
+        SlotId const slot_id,
+        Integer const dirty_samples
+) noexcept {
+    Slot& slot = slots[slot_id];
+
+    if (slot.state != SlotState::LEASED) {
+        return;
+    }
+
+    slot.dirty_samples = std::min(std::max((Integer)0, dirty_samples), slot.size);
+    slot.cleared_samples = 0;
+    slot.state = (
+        slot.dirty_samples == 0 ? SlotState::CLEAN : SlotState::RELEASED
+    );
+    leased_size.fetch_sub(slot.size_in_bytes);
+}
+
+
+void DelayBufferPool::clear_released_slots() noexcept
+{
+    SlotId const slots_count = (SlotId)slots.size();
+
+    for (SlotId i = 0; i != slots_count; ++i) {
+        Slot& slot = slots[next_released_slot_id];
+
+        if (slot.state == SlotState::RELEASED) {
+            clear(slot, MAX_CLEARED_SAMPLES);
+
+            return;
+        }
+
+        next_released_slot_id = (next_released_slot_id + 1) % slots_count;
+    }
+}
+
+
+void DelayBufferPool::clear(Slot& slot, Integer const max_samples) noexcept
+{
+    Integer const first_sample_index = slot.cleared_samples;
+    Integer const batch_size = std::min(
+        max_samples, slot.dirty_samples - first_sample_index
+    );
+
+    for (Integer c = 0; c != slot.channels; ++c) {
+        std::fill_n(&slot.buffer[c][first_sample_index], batch_size, 0.0);
+    }
+
+    slot.cleared_samples += batch_size;
+
+    if (slot.cleared_samples == slot.dirty_samples) {
+        slot.state = SlotState::CLEAN;
+    }
+}
+
+
+size_t DelayBufferPool::get_size() const noexcept
+{
+    return arena_size.load();
+}
+
+
+size_t DelayBufferPool::get_leased_size() const noexcept
+{
+    return leased_size.load();
+}
+
+
+bool DelayBufferPool::is_lock_free() const noexcept
+{
+    return arena_size.is_lock_free() && leased_size.is_lock_free();
+}
+
+}
+
+#endif
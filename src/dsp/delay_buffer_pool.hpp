@@ -0,0 +1,180 @@
+/*
+ * This file is part of JS80P, a synthesizer plugin.
+ * Copyright (C) 2023, 2024  Attila M. Magyar
+ *
+ * JS80P is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * JS80P is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef JS80P__DSP__DELAY_BUFFER_POOL_HPP
+#define JS80P__DSP__DELAY_BUFFER_POOL_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+#include "js80p.hpp"
+
+
+namespace JS80P
+{
+
+/**
+ * \brief A single, page-aligned memory arena for the delay buffers of the
+ *        effects, from which each \c Delay leases its buffer only when it is
+ *        actually used, and releases it when its effect is bypassed.
+ *
+ * \note Each delay buffer gets a fixed, page-aligned slot in the arena, so
+ *       leasing and releasing never needs to allocate or move memory, and
+ *       the memory pages of the slots which are never leased are never
+ *       touched, so most operating systems don't need to back them with
+ *       physical memory.
+ *
+ * \warning Registering and resizing slots, and (re)allocating the arena are
+ *          not real-time safe, and they invalidate the buffers of all the
+ *          slots. Leasing, releasing, and clearing slots are real-time safe,
+ *          but they must only be called from the audio thread.
+ */
+class DelayBufferPool
+{
+    public:
+        typedef Integer SlotId;
+
+        static constexpr SlotId INVALID_SLOT_ID = -1;
+
+        static constexpr size_t PAGE_SIZE = 4096;
+
+        /**
+         * \brief The maximum number of samples per channel that
+         *        \c clear_released_slots() zeroes in a single call.
+         */
+        static constexpr Integer MAX_CLEARED_SAMPLES = 16384;
+
+        DelayBufferPool() noexcept;
+        ~DelayBufferPool();
+
+        DelayBufferPool(DelayBufferPool const& pool) = delete;
+        DelayBufferPool(DelayBufferPool&& pool) = delete;
+
+        DelayBufferPool& operator=(DelayBufferPool const& pool) = delete;
+        DelayBufferPool& operator=(DelayBufferPool&& pool) = delete;
+
+        SlotId add_slot(Integer const channels, Integer const size) noexcept;
+
+        void resize_slot(
+            SlotId const slot_id,
+            Integer const channels,
+            Integer const size
+        ) noexcept;
+
+        /**
+         * \brief Allocate a new arena for the current sizes of the slots, if
+         *        they have changed since the last allocation.
+         */
+        void allocate() noexcept;
+
+        /**
+         * \brief Release all the slots and replace the arena with a new one,
+         *        so that the memory pages which were touched by the previous
+         *        leases are returned to the operating system, and only those
+         *        will be backed by physical memory again which get leased
+         *        after this. The buffers of all the slots are invalidated.
+         *
+         * \warning Not real-time safe.
+         */
+        void trim() noexcept;
+
+        /**
+         * \brief Lease the buffer of the given slot, or return the buffer if
+         *        it's already leased. A newly leased buffer is always filled
+         *        with zeros: if the slot was released and it hasn't been
+         *        fully cleared yet, then the rest of it is cleared right
+         *        away. Returns \c NULL if there's no arena allocated for the
+         *        slot yet.
+         */
+        Sample** lease(SlotId const slot_id) noexcept;
+
+        /**
+         * \brief Return the buffer of the given slot if it's leased, or
+         *        \c NULL otherwise.
+         */
+        Sample** get(SlotId const slot_id) const noexcept;
+
+        void release(SlotId const slot_id) noexcept;
+
+        /**
+         * \brief Release the slot, knowing that only the first
+         *        \c dirty_samples samples of each channel may have been
+         *        written to since it was leased, so the rest doesn't need to
+         *        be cleared.
+         */
+        void release(SlotId const slot_id, Integer const dirty_samples) noexcept;
+
+        /**
+         * \brief Zero some of the memory of the released slots, so that they
+         *        can be leased again without having to clear them all at
+         *        once. Should be called once in every rendering round.
+         */
+        void clear_released_slots() noexcept;
+
+        /**
+         * \brief Total size of the arena in bytes. Safe to be called from any
+         *        thread.
+         */
+        size_t get_size() const noexcept;
+
+        /**
+         * \brief Total size of the currently leased buffers in bytes. Safe to
+         *        be called from any thread.
+         */
+        size_t get_leased_size() const noexcept;
+
+        bool is_lock_free() const noexcept;
+
+    private:
+        enum SlotState {
+            CLEAN = 0,
+            LEASED = 1,
+            RELEASED = 2,
+        };
+
+        class Slot
+        {
+            public:
+                Slot(Integer const channels, Integer const size) noexcept;
+
+                Sample** buffer;
+                size_t size_in_bytes;
+                Integer channels;
+                Integer size;
+                Integer dirty_samples;
+                Integer cleared_samples;
+                SlotState state;
+        };
+
+        static size_t calculate_channel_size_in_bytes(Integer const size) noexcept;
+
+        void free_arena() noexcept;
+        void clear(Slot& slot, Integer const max_samples) noexcept;
+
+        std::vector<Slot> slots;
+        void* arena;
+        std::atomic<size_t> arena_size;
+        std::atomic<size_t> leased_size;
+        SlotId next_released_slot_id;
+        bool is_arena_up_to_date;
+};
+
+}
+
+#endif
@@ -172,6 +172,26 @@ Echo<InputSignalProducerClass>::Echo(
 }
 
 
+template<class InputSignalProducerClass>
+void Echo<InputSignalProducerClass>::use_delay_buffer_pool(
+        DelayBufferPool& delay_buffer_pool
+) noexcept {
+    comb_filter_1.delay.use_delay_buffer_pool(delay_buffer_pool);
+    comb_filter_2.delay.use_delay_buffer_pool(delay_buffer_pool);
+}
+
+
+template<class InputSignalProducerClass>
+bool Echo<InputSignalProducerClass>::is_tail_silent() const noexcept
+{
+    return (
+        !this->is_compressing()
+        && comb_filter_1.delay.is_delay_buffer_silent()
+        && comb_filter_2.delay.is_delay_buffer_silent()
+    );
+}
+
+
 template<class InputSignalProducerClass>
 Sample const* const* Echo<InputSignalProducerClass>::initialize_rendering(
         Integer const round,
@@ -184,6 +204,9 @@ Sample const* const* Echo<InputSignalProducerClass>::initialize_rendering(
     );
 
     if (buffer != NULL) {
+        comb_filter_1.delay.release_delay_buffer();
+        comb_filter_2.delay.release_delay_buffer();
+
         return buffer;
     }
 
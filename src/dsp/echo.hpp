@@ -57,6 +57,18 @@ class Echo : public SideChainCompressableEffect<InputSignalProducerClass>
             BiquadFilterSharedBuffers& high_shelf_filter_shared_buffers
         );
 
+        /**
+         * \brief Lease the delay buffers from the given pool only while the
+         *        effect is in use.
+         */
+        void use_delay_buffer_pool(DelayBufferPool& delay_buffer_pool) noexcept;
+
+        /**
+         * \brief Tell whether the effect has nothing left to render from the
+         *        signal that it has received so far.
+         */
+        bool is_tail_silent() const noexcept;
+
         FloatParamS delay_time;
         FloatParamS input_volume;
         FloatParamS feedback;
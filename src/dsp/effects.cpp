@@ -31,7 +31,7 @@ Effects<InputSignalProducerClass>::Effects(
         InputSignalProducerClass& input,
         BiquadFilterSharedBuffers& echo_filter_shared_buffers,
         BiquadFilterSharedBuffers& reverb_filter_shared_buffers
-) : Filter< Volume3<InputSignalProducerClass> >(volume_3, 21, input.get_channels()),
+) : Filter< Limiter<InputSignalProducerClass> >(limiter, 23, input.get_channels()),
     volume_1_gain(name + "V1V", 0.0, 2.0, 1.0),
     volume_2_gain(name + "V2V", 0.0, 1.0, 1.0),
     volume_3_gain(name + "V3V", 0.0, 1.0, 1.0),
@@ -72,7 +72,9 @@ Effects<InputSignalProducerClass>::Effects(
     chorus(name + "C", volume_2),
     echo(name + "E", chorus, echo_filter_shared_buffers),
     reverb(name + "R", echo, reverb_filter_shared_buffers),
-    volume_3(reverb, volume_3_gain)
+    volume_3(reverb, volume_3_gain),
+    limiter_enabled(name + "LIM", ToggleParam::OFF),
+    limiter(volume_3, limiter_enabled)
 {
     this->register_child(volume_1_gain);
     this->register_child(volume_2_gain);
@@ -95,6 +97,36 @@ Effects<InputSignalProducerClass>::Effects(
     this->register_child(echo);
     this->register_child(reverb);
     this->register_child(volume_3);
+    this->register_child(limiter_enabled);
+    this->register_child(limiter);
+}
+
+
+template<class InputSignalProducerClass>
+Integer Effects<InputSignalProducerClass>::get_latency_samples() const noexcept
+{
+    return limiter.get_latency_samples();
+}
+
+
+template<class InputSignalProducerClass>
+void Effects<InputSignalProducerClass>::use_delay_buffer_pool(
+        DelayBufferPool& delay_buffer_pool
+) noexcept {
+    chorus.use_delay_buffer_pool(delay_buffer_pool);
+    echo.use_delay_buffer_pool(delay_buffer_pool);
+    reverb.use_delay_buffer_pool(delay_buffer_pool);
+}
+
+
+template<class InputSignalProducerClass>
+bool Effects<InputSignalProducerClass>::is_tail_silent() const noexcept
+{
+    return (
+        chorus.is_tail_silent()
+        && echo.is_tail_silent()
+        && reverb.is_tail_silent()
+    );
 }
 
 } }
@@ -24,10 +24,12 @@
 #include "js80p.hpp"
 
 #include "dsp/biquad_filter.hpp"
+#include "dsp/delay_buffer_pool.hpp"
 #include "dsp/distortion.hpp"
 #include "dsp/echo.hpp"
 #include "dsp/filter.hpp"
 #include "dsp/gain.hpp"
+#include "dsp/limiter.hpp"
 #include "dsp/param.hpp"
 #include "dsp/reverb.hpp"
 
@@ -65,9 +67,12 @@ using Reverb = JS80P::Reverb< Echo<InputSignalProducerClass> >;
 template<class InputSignalProducerClass>
 using Volume3 = Gain< Reverb<InputSignalProducerClass> >;
 
+template<class InputSignalProducerClass>
+using Limiter = JS80P::Limiter< Volume3<InputSignalProducerClass> >;
+
 
 template<class InputSignalProducerClass>
-class Effects : public Filter< Volume3<InputSignalProducerClass> >
+class Effects : public Filter< Limiter<InputSignalProducerClass> >
 {
     public:
         Effects(
@@ -77,6 +82,22 @@ class Effects : public Filter< Volume3<InputSignalProducerClass> >
             BiquadFilterSharedBuffers& reverb_filter_shared_buffers
         );
 
+        Integer get_latency_samples() const noexcept;
+
+        /**
+         * \brief Lease the delay buffers of the chorus, echo, and reverb
+         *        effects from the given pool only while they are in use.
+         */
+        void use_delay_buffer_pool(DelayBufferPool& delay_buffer_pool) noexcept;
+
+        /**
+         * \brief Tell whether the delay lines of the chorus, echo, and reverb
+         *        effects are empty, and their side-chain compressors are
+         *        released, i.e. none of them would render anything on silent
+         *        input.
+         */
+        bool is_tail_silent() const noexcept;
+
         FloatParamS volume_1_gain;
         FloatParamS volume_2_gain;
         FloatParamS volume_3_gain;
@@ -100,6 +121,8 @@ class Effects : public Filter< Volume3<InputSignalProducerClass> >
         Echo<InputSignalProducerClass> echo;
         Reverb<InputSignalProducerClass> reverb;
         Volume3<InputSignalProducerClass> volume_3;
+        ToggleParam limiter_enabled;
+        Limiter<InputSignalProducerClass> limiter;
 };
 
 } }
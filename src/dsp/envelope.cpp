@@ -50,6 +50,27 @@ EnvelopeSnapshot::EnvelopeSnapshot() noexcept
 }
 
 
+bool EnvelopeSnapshot::operator==(EnvelopeSnapshot const& snapshot) const noexcept
+{
+    return (
+        change_index == snapshot.change_index
+        && envelope_index == snapshot.envelope_index
+        && initial_value == snapshot.initial_value
+        && peak_value == snapshot.peak_value
+        && sustain_value == snapshot.sustain_value
+        && final_value == snapshot.final_value
+        && delay_time == snapshot.delay_time
+        && attack_time == snapshot.attack_time
+        && hold_time == snapshot.hold_time
+        && decay_time == snapshot.decay_time
+        && release_time == snapshot.release_time
+        && attack_shape == snapshot.attack_shape
+        && decay_shape == snapshot.decay_shape
+        && release_shape == snapshot.release_shape
+    );
+}
+
+
 Envelope::ShapeParam::ShapeParam(std::string const& name) noexcept
     : ByteParam(name, SHAPE_SMOOTH_SMOOTH, SHAPE_LINEAR, SHAPE_LINEAR)
 {
@@ -356,8 +377,6 @@ void Envelope::render(
         )
     );
 
-    Number rendered_value = last_rendered_value;
-    Number done_samples = 0.0;
     Number initial_ratio;
     Number delta;
 
@@ -391,28 +410,46 @@ void Envelope::render(
         );
     }
 
-    for (; next_sample_index != end_index; ++next_sample_index, done_samples += 1.0) {
+    /*
+    The segment is filled in closed form, without any loop-carried state or
+    stage checks, so that the compiler can vectorize the loop.
+    */
+    Integer const sample_count = end_index - next_sample_index;
+    Sample* const segment = &buffer[next_sample_index];
+
+    for (Integer j = 0; j != sample_count; ++j) {
+        Number const ratio = initial_ratio + (Number)j * scale;
+        Number value;
+
         if constexpr (need_shaping) {
-            Number const ratio = Math::apply_envelope_shape(
-                (Math::EnvelopeShape)shape, initial_ratio + done_samples * scale
+            value = initial_value + (
+                Math::apply_envelope_shape((Math::EnvelopeShape)shape, ratio)
+                * delta
             );
-
-            rendered_value = initial_value + ratio * delta;
         } else {
-            Number const ratio = initial_ratio + done_samples * scale;
-
-            rendered_value = initial_value + ratio * delta;
+            value = initial_value + ratio * delta;
         }
 
         if constexpr (rendering_mode == RenderingMode::OVERWRITE) {
-            buffer[next_sample_index] = rendered_value;
+            segment[j] = value;
         } else {
-            buffer[next_sample_index] *= rendered_value;
+            segment[j] *= value;
         }
     }
 
-    last_rendered_value = rendered_value;
-    time += done_samples * sampling_period;
+    Number const last_ratio = initial_ratio + (Number)(sample_count - 1) * scale;
+
+    if constexpr (need_shaping) {
+        last_rendered_value = initial_value + (
+            Math::apply_envelope_shape((Math::EnvelopeShape)shape, last_ratio)
+            * delta
+        );
+    } else {
+        last_rendered_value = initial_value + last_ratio * delta;
+    }
+
+    next_sample_index = end_index;
+    time += (Number)sample_count * sampling_period;
 }
 
 
@@ -0,0 +1,392 @@
+/*
+ * This file is part of JS80P, a synthesizer plugin.
+ * Copyright (C) 2023, 2024  Attila M. Magyar
+ *
+ * JS80P is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * JS80P is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef JS80P__DSP__LIMITER_CPP
+#define JS80P__DSP__LIMITER_CPP
+
+#include <algorithm>
+#include <cmath>
+
+#include "dsp/limiter.hpp"
+
+#include "dsp/math.hpp"
+
+
+namespace JS80P
+{
+
+template<class InputSignalProducerClass>
+Limiter<InputSignalProducerClass>::Limiter(
+        InputSignalProducerClass& input,
+        ToggleParam& enabled
+) noexcept
+    : Filter<InputSignalProducerClass>(input),
+    enabled(enabled),
+    fir_history(NULL),
+    delay_line(NULL),
+    peaks(NULL),
+    peak_positions(NULL),
+    gains(NULL),
+    window_size(0),
+    latency(0),
+    was_enabled(false)
+{
+    initialize_fir();
+    allocate_buffers();
+    clear_state();
+}
+
+
+/*
+Windowed sinc interpolation: phase p estimates the signal at p / OVERSAMPLING
+samples after the sample that is FIR_DELAY samples behind the newest one. The
+coefficients are stored in chronological order, i.e. the first one belongs to
+the oldest sample in the history.
+*/
+template<class InputSignalProducerClass>
+void Limiter<InputSignalProducerClass>::initialize_fir() noexcept
+{
+    constexpr Number half_width = (Number)FIR_DELAY;
+
+    for (Integer p = 0; p != FIR_PHASES; ++p) {
+        Number const fraction = (Number)(p + 1) / (Number)OVERSAMPLING;
+        Number sum = 0.0;
+
+        for (Integer m = 0; m != FIR_TAPS; ++m) {
+            Number const t = (Number)(FIR_TAPS - 1 - m - FIR_DELAY) + fraction;
+            Number const x = Math::PI * t;
+            Number const sinc = std::fabs(t) < 0.000001 ? 1.0 : std::sin(x) / x;
+            Number const window = (
+                std::fabs(t) < half_width
+                    ? 0.5 + 0.5 * std::cos(Math::PI * t / half_width)
+                    : 0.0
+            );
+
+            fir[p][m] = sinc * window;
+            sum += fir[p][m];
+        }
+
+        for (Integer m = 0; m != FIR_TAPS; ++m) {
+            fir[p][m] /= sum;
+        }
+    }
+}
+
+
+template<class InputSignalProducerClass>
+Limiter<InputSignalProducerClass>::~Limiter()
+{
+    free_buffers();
+}
+
+
+template<class InputSignalProducerClass>
+void Limiter<InputSignalProducerClass>::allocate_buffers() noexcept
+{
+    Integer const channels = this->channels;
+
+    window_size = std::max(
+        (Integer)1, (Integer)std::round(LOOKAHEAD * this->sample_rate)
+    );
+    latency = FIR_DELAY + window_size - 1;
+    release_coefficient = (
+        1.0 - std::exp(-1.0 / (RELEASE_TIME * (Number)this->sample_rate))
+    );
+
+    fir_history = new Sample*[channels];
+    delay_line = new Sample*[channels];
+
+    for (Integer c = 0; c != channels; ++c) {
+        fir_history[c] = new Sample[FIR_TAPS * 2];
+        delay_line[c] = new Sample[latency];
+    }
+
+    peaks = new Sample[window_size];
+    peak_positions = new Integer[window_size];
+    gains = new Sample[window_size];
+}
+
+
+template<class InputSignalProducerClass>
+void Limiter<InputSignalProducerClass>::free_buffers() noexcept
+{
+    if (fir_history == NULL) {
+        return;
+    }
+
+    for (Integer c = 0; c != this->channels; ++c) {
+        delete[] fir_history[c];
+        delete[] delay_line[c];
+    }
+
+    delete[] fir_history;
+    delete[] delay_line;
+    delete[] peaks;
+    delete[] peak_positions;
+    delete[] gains;
+
+    fir_history = NULL;
+    delay_line = NULL;
+    peaks = NULL;
+    peak_positions = NULL;
+    gains = NULL;
+}
+
+
+template<class InputSignalProducerClass>
+void Limiter<InputSignalProducerClass>::clear_state() noexcept
+{
+    for (Integer c = 0; c != this->channels; ++c) {
+        std::fill_n(fir_history[c], FIR_TAPS * 2, 0.0);
+        std::fill_n(delay_line[c], latency, 0.0);
+    }
+
+    std::fill_n(gains, window_size, 1.0);
+
+    fir_history_index = 0;
+    delay_line_index = 0;
+    position = 0;
+    peaks_first = 0;
+    peaks_length = 0;
+    gains_index = 0;
+    silent_samples = 0;
+    gains_sum = (Number)window_size;
+    envelope = 1.0;
+    previous_interval_peak = 0.0;
+}
+
+
+template<class InputSignalProducerClass>
+void Limiter<InputSignalProducerClass>::set_sample_rate(
+        Frequency const new_sample_rate
+) noexcept {
+    Filter<InputSignalProducerClass>::set_sample_rate(new_sample_rate);
+
+    free_buffers();
+    allocate_buffers();
+    clear_state();
+}
+
+
+template<class InputSignalProducerClass>
+void Limiter<InputSignalProducerClass>::reset() noexcept
+{
+    Filter<InputSignalProducerClass>::reset();
+
+    clear_state();
+}
+
+
+template<class InputSignalProducerClass>
+Integer Limiter<InputSignalProducerClass>::get_latency_samples() const noexcept
+{
+    return enabled.get_value() == ToggleParam::ON ? latency : 0;
+}
+
+
+template<class InputSignalProducerClass>
+Integer Limiter<InputSignalProducerClass>::get_lookahead_latency_samples() const noexcept
+{
+    return latency;
+}
+
+
+template<class InputSignalProducerClass>
+Sample const* const* Limiter<InputSignalProducerClass>::initialize_rendering(
+        Integer const round,
+        Integer const sample_count
+) noexcept {
+    Sample const* const* const input_buffer = (
+        Filter<InputSignalProducerClass>::initialize_rendering(round, sample_count)
+    );
+
+    if (enabled.get_value() != ToggleParam::ON) {
+        was_enabled = false;
+
+        return input_buffer;
+    }
+
+    if (!was_enabled) {
+        was_enabled = true;
+        clear_state();
+    }
+
+    /*
+    The delay line and the gain envelope need to be flushed before the limiter
+    can go quiet.
+    */
+    if (this->input.is_silent(round, sample_count)) {
+        if (silent_samples > latency + window_size) {
+            return this->input_was_silent(round);
+        }
+
+        silent_samples += sample_count;
+    } else {
+        silent_samples = 0;
+    }
+
+    /* Prevent rounding errors from accumulating in the running sum. */
+    Number gains_sum = 0.0;
+
+    for (Integer i = 0; i != window_size; ++i) {
+        gains_sum += gains[i];
+    }
+
+    this->gains_sum = gains_sum;
+
+    return NULL;
+}
+
+
+template<class InputSignalProducerClass>
+Sample Limiter<InputSignalProducerClass>::detect_true_peak(
+        Sample const* const* const input_buffer,
+        Integer const i
+) noexcept {
+    Integer const channels = this->channels;
+    Integer const fir_history_index = this->fir_history_index;
+    Sample sample_peak = 0.0;
+    Sample interval_peak = 0.0;
+
+    for (Integer c = 0; c != channels; ++c) {
+        Sample* const history = fir_history[c];
+        Sample const input_sample = input_buffer[c][i];
+
+        history[fir_history_index] = input_sample;
+        history[fir_history_index + FIR_TAPS] = input_sample;
+
+        Sample const* const samples = &history[fir_history_index + 1];
+
+        sample_peak = std::max(
+            sample_peak, std::fabs(samples[FIR_TAPS - 1 - FIR_DELAY])
+        );
+
+        for (Integer p = 0; p != FIR_PHASES; ++p) {
+            Sample const* const coefficients = fir[p];
+            Sample interpolated = 0.0;
+
+            for (Integer m = 0; m != FIR_TAPS; ++m) {
+                interpolated += coefficients[m] * samples[m];
+            }
+
+            interval_peak = std::max(interval_peak, std::fabs(interpolated));
+        }
+    }
+
+    this->fir_history_index = (fir_history_index + 1) % FIR_TAPS;
+
+    /*
+    An inter-sample peak is attributed to the samples on both sides of it, so
+    that the gain is low enough at both of them.
+    */
+    Sample const peak = std::max(
+        sample_peak, std::max(interval_peak, previous_interval_peak)
+    );
+
+    previous_interval_peak = interval_peak;
+
+    return peak;
+}
+
+
+/*
+Sliding window maximum using a monotonic deque: the values in the deque are
+decreasing from front to back, so the front is always the maximum of the most
+recent window_size peaks.
+*/
+template<class InputSignalProducerClass>
+void Limiter<InputSignalProducerClass>::push_peak(Sample const peak) noexcept
+{
+    Integer const window_size = this->window_size;
+    Integer const oldest_position = position - window_size;
+
+    while (peaks_length > 0 && peak_positions[peaks_first] <= oldest_position) {
+        peaks_first = (peaks_first + 1) % window_size;
+        --peaks_length;
+    }
+
+    while (peaks_length > 0) {
+        Integer const last = (peaks_first + peaks_length - 1) % window_size;
+
+        if (peaks[last] > peak) {
+            break;
+        }
+
+        --peaks_length;
+    }
+
+    Integer const next = (peaks_first + peaks_length) % window_size;
+
+    peaks[next] = peak;
+    peak_positions[next] = position;
+    ++peaks_length;
+    ++position;
+}
+
+
+template<class InputSignalProducerClass>
+void Limiter<InputSignalProducerClass>::render(
+        Integer const round,
+        Integer const first_sample_index,
+        Integer const last_sample_index,
+        Sample** buffer
+) noexcept {
+    Integer const channels = this->channels;
+    Integer const window_size = this->window_size;
+    Integer const latency = this->latency;
+    Sample const* const* const input_buffer = this->input_buffer;
+    Number const window_size_inv = 1.0 / (Number)window_size;
+    Sample const release_coefficient = this->release_coefficient;
+
+    for (Integer i = first_sample_index; i != last_sample_index; ++i) {
+        push_peak(detect_true_peak(input_buffer, i));
+
+        Sample const max_peak = peaks[peaks_first];
+        Sample const target_gain = max_peak > CEILING ? CEILING / max_peak : 1.0;
+
+        /*
+        The envelope may only rise slower than the target gain, but never above
+        it, so averaging it over the lookahead window yields a smooth gain that
+        is low enough for every peak in the window.
+        */
+        if (target_gain < envelope) {
+            envelope = target_gain;
+        } else {
+            envelope += (target_gain - envelope) * release_coefficient;
+        }
+
+        gains_sum += envelope - gains[gains_index];
+        gains[gains_index] = envelope;
+        gains_index = (gains_index + 1) % window_size;
+
+        Sample const gain = std::min(1.0, gains_sum * window_size_inv);
+
+        for (Integer c = 0; c != channels; ++c) {
+            Sample const delayed_sample = delay_line[c][delay_line_index];
+
+            delay_line[c][delay_line_index] = input_buffer[c][i];
+            buffer[c][i] = gain * delayed_sample;
+        }
+
+        delay_line_index = (delay_line_index + 1) % latency;
+    }
+}
+
+}
+
+#endif
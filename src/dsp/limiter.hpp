@@ -0,0 +1,130 @@
+/*
+ * This file is part of JS80P, a synthesizer plugin.
+ * Copyright (C) 2023, 2024  Attila M. Magyar
+ *
+ * JS80P is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * JS80P is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef JS80P__DSP__LIMITER_HPP
+#define JS80P__DSP__LIMITER_HPP
+
+#include "js80p.hpp"
+
+#include "dsp/filter.hpp"
+#include "dsp/param.hpp"
+#include "dsp/signal_producer.hpp"
+
+
+namespace JS80P
+{
+
+/**
+ * \brief Lookahead brickwall limiter which keeps the true peak (the estimated
+ *        peak of the reconstructed analog signal, including inter-sample
+ *        peaks) of its output below \c CEILING.
+ *
+ * \note The input is delayed by \c get_latency_samples() samples, during
+ *       which the gain reduction ramps down smoothly, so that the gain is
+ *       already low enough by the time a peak reaches the output.
+ */
+template<class InputSignalProducerClass>
+class Limiter : public Filter<InputSignalProducerClass>
+{
+    friend class SignalProducer;
+
+    public:
+        /* Approximately -0.3 dBTP. */
+        static constexpr Sample CEILING = 0.966;
+
+        static constexpr Seconds LOOKAHEAD = 0.0015;
+        static constexpr Seconds RELEASE_TIME = 0.08;
+
+        static constexpr Integer OVERSAMPLING = 4;
+        static constexpr Integer FIR_TAPS = 8;
+        static constexpr Integer FIR_DELAY = FIR_TAPS / 2;
+
+        Limiter(
+            InputSignalProducerClass& input,
+            ToggleParam& enabled
+        ) noexcept;
+
+        virtual ~Limiter();
+
+        virtual void set_sample_rate(Frequency const new_sample_rate) noexcept override;
+        virtual void reset() noexcept override;
+
+        /**
+         * \brief The delay that the limiter introduces, or 0 when it is
+         *        turned off.
+         */
+        Integer get_latency_samples() const noexcept;
+
+        /**
+         * \brief The delay that the limiter introduces while it is turned on.
+         */
+        Integer get_lookahead_latency_samples() const noexcept;
+
+        ToggleParam& enabled;
+
+    protected:
+        Sample const* const* initialize_rendering(
+            Integer const round,
+            Integer const sample_count
+        ) noexcept;
+
+        void render(
+            Integer const round,
+            Integer const first_sample_index,
+            Integer const last_sample_index,
+            Sample** buffer
+        ) noexcept;
+
+    private:
+        static constexpr Integer FIR_PHASES = OVERSAMPLING - 1;
+
+        void initialize_fir() noexcept;
+        void allocate_buffers() noexcept;
+        void free_buffers() noexcept;
+        void clear_state() noexcept;
+
+        Sample detect_true_peak(Sample const* const* input_buffer, Integer const i) noexcept;
+        void push_peak(Sample const peak) noexcept;
+
+        Sample fir[FIR_PHASES][FIR_TAPS];
+
+        Sample** fir_history;
+        Sample** delay_line;
+        Sample* peaks;
+        Integer* peak_positions;
+        Sample* gains;
+
+        Integer window_size;
+        Integer latency;
+        Integer fir_history_index;
+        Integer delay_line_index;
+        Integer position;
+        Integer peaks_first;
+        Integer peaks_length;
+        Integer gains_index;
+        Integer silent_samples;
+        Number gains_sum;
+        Sample envelope;
+        Sample previous_interval_peak;
+        Sample release_coefficient;
+        bool was_enabled;
+};
+
+}
+
+#endif
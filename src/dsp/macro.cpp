@@ -19,6 +19,8 @@
 #ifndef JS80P__DSP__MACRO_CPP
 #define JS80P__DSP__MACRO_CPP
 
+#include <algorithm>
+
 #include "dsp/macro.hpp"
 
 
@@ -56,14 +58,21 @@ Macro::Macro(std::string const& name) noexcept
     distortion_change_index(0),
     randomness_change_index(0),
     distortion_shape_change_index(0),
-    is_updating(false)
+    float_params{
+        &midpoint, &input, &min, &max, &scale, &distortion, &randomness
+    },
+    is_updating(false),
+    is_frozen(false)
 {
+    for (Integer i = 0; i != FLOAT_PARAMS; ++i) {
+        previous_values[i] = float_params[i]->get_value();
+    }
 }
 
 
 void Macro::update() noexcept
 {
-    if (is_updating) {
+    if (is_updating || is_frozen) {
         return;
     }
 
@@ -75,29 +84,165 @@ void Macro::update() noexcept
         return;
     }
 
-    Number const midpoint_value = midpoint.get_value();
-    Number const input_value = input.get_value();
+    Number values[FLOAT_PARAMS];
+
+    for (Integer i = 0; i != FLOAT_PARAMS; ++i) {
+        values[i] = float_params[i]->get_value();
+    }
+
+    Seconds time_offset = -1.0;
+    Seconds next_time_offset;
+
+    while (find_next_event_time_offset(time_offset, next_time_offset)) {
+        Number values_at_time_offset[FLOAT_PARAMS];
+
+        time_offset = next_time_offset;
+
+        for (Integer i = 0; i != FLOAT_PARAMS; ++i) {
+            values_at_time_offset[i] = get_value_at(i, time_offset, values[i]);
+        }
+
+        MidiController::change(time_offset, compute_value(values_at_time_offset));
+    }
+
+    MidiController::change(compute_value(values));
+
+    std::copy_n(values, FLOAT_PARAMS, previous_values);
+
+    is_updating = false;
+}
+
+
+Number Macro::compute_value(Number const* const values) const noexcept
+{
+    Number const midpoint_value = values[0];
+    Number const input_value = values[1];
+    Number const min_value = values[2];
+    Number const max_value = values[3];
+    Number const scale_value = values[4];
+    Number const distortion_value = values[5];
+    Number const randomness_value = values[6];
+
     Number const shifted_input_value = (
         input_value < 0.5
             ? 2.0 * input_value * midpoint_value
             : (midpoint_value + (2.0 * input_value - 1.0) * (1.0 - midpoint_value))
     );
-    Number const min_value = min.get_value();
     Number const computed_value = Math::randomize(
-        randomness.get_value(),
+        randomness_value,
         Math::distort(
-            distortion.get_value(),
+            distortion_value,
             shifted_input_value,
             (Math::DistortionShape)distortion_shape.get_value()
         )
     );
 
-    MidiController::change(
-        min_value
-        + computed_value * scale.get_value() * (max.get_value() - min_value)
+    return min_value + computed_value * scale_value * (max_value - min_value);
+}
+
+
+bool Macro::find_next_event_time_offset(
+        Seconds const time_offset,
+        Seconds& next_time_offset
+) const noexcept {
+    bool is_found = false;
+
+    for (Integer i = 0; i != FLOAT_PARAMS; ++i) {
+        FloatParamB const& param = *float_params[i];
+        MidiController const* const midi_controller = (
+            param.get_midi_controller() != NULL
+                ? param.get_midi_controller()
+                : param.get_macro()
+        );
+
+        if (midi_controller == NULL) {
+            continue;
+        }
+
+        Queue<SignalProducer::Event> const& events = midi_controller->events;
+        Queue<SignalProducer::Event>::SizeType const length = events.length();
+
+        for (Queue<SignalProducer::Event>::SizeType j = 0; j != length; ++j) {
+            Seconds const event_time_offset = events[j].time_offset;
+
+            if (
+                    event_time_offset > time_offset
+                    && (!is_found || event_time_offset < next_time_offset)
+            ) {
+                next_time_offset = event_time_offset;
+                is_found = true;
+            }
+        }
+    }
+
+    return is_found;
+}
+
+
+/*
+A param which has events gets the value of its most recent event that is not
+later than the given time offset, or the value that it had at the previous
+update if all of its events are later. Params without events keep their current
+value during the whole block.
+*/
+Number Macro::get_value_at(
+        Integer const param_index,
+        Seconds const time_offset,
+        Number const current_value
+) const noexcept {
+    FloatParamB const& param = *float_params[param_index];
+    MidiController const* const midi_controller = (
+        param.get_midi_controller() != NULL
+            ? param.get_midi_controller()
+            : param.get_macro()
     );
 
-    is_updating = false;
+    if (midi_controller == NULL || midi_controller->events.is_empty()) {
+        return current_value;
+    }
+
+    Queue<SignalProducer::Event> const& events = midi_controller->events;
+    Queue<SignalProducer::Event>::SizeType const length = events.length();
+    Number value = previous_values[param_index];
+
+    for (Queue<SignalProducer::Event>::SizeType i = 0; i != length; ++i) {
+        if (events[i].time_offset > time_offset) {
+            break;
+        }
+
+        value = param.ratio_to_value(events[i].number_param_1);
+    }
+
+    return value;
+}
+
+
+void Macro::freeze() noexcept
+{
+    is_frozen = true;
+}
+
+
+void Macro::unfreeze() noexcept
+{
+    is_frozen = false;
+}
+
+
+bool Macro::depends_on(Macro const& macro) const noexcept
+{
+    Macro const* const m = &macro;
+
+    return (
+        midpoint.get_macro() == m
+        || input.get_macro() == m
+        || min.get_macro() == m
+        || max.get_macro() == m
+        || scale.get_macro() == m
+        || distortion.get_macro() == m
+        || randomness.get_macro() == m
+        || distortion_shape.get_macro() == m
+    );
 }
 
 
@@ -134,6 +279,109 @@ bool Macro::update_change_index(
     return true;
 }
 
+
+MacroScheduler::MacroScheduler(
+        Macro* const* macros,
+        Integer const count
+) noexcept
+    : macros(macros),
+    count(count),
+    order(count, 0),
+    unresolved_dependencies(count, 0),
+    is_scheduled(count, false),
+    is_order_up_to_date(false)
+{
+}
+
+
+void MacroScheduler::invalidate() noexcept
+{
+    is_order_up_to_date = false;
+}
+
+
+void MacroScheduler::update() noexcept
+{
+    if (JS80P_UNLIKELY(!is_order_up_to_date)) {
+        build_order();
+    }
+
+    for (Integer i = 0; i != count; ++i) {
+        Macro& macro = *macros[order[i]];
+
+        if (!macro.is_assigned()) {
+            continue;
+        }
+
+        macro.update();
+        macro.freeze();
+    }
+}
+
+
+void MacroScheduler::release() noexcept
+{
+    for (Integer i = 0; i != count; ++i) {
+        macros[i]->unfreeze();
+    }
+}
+
+
+/*
+Kahn's algorithm: a macro is scheduled when all the macros that it depends on
+have already been scheduled. Ties are broken by the original index, so that the
+order is deterministic.
+*/
+void MacroScheduler::build_order() noexcept
+{
+    Integer scheduled = 0;
+
+    for (Integer i = 0; i != count; ++i) {
+        Integer dependencies = 0;
+
+        for (Integer j = 0; j != count; ++j) {
+            if (macros[i]->depends_on(*macros[j])) {
+                ++dependencies;
+            }
+        }
+
+        unresolved_dependencies[i] = dependencies;
+        is_scheduled[i] = false;
+    }
+
+    bool is_progressing = true;
+
+    while (is_progressing) {
+        is_progressing = false;
+
+        for (Integer i = 0; i != count; ++i) {
+            if (is_scheduled[i] || unresolved_dependencies[i] != 0) {
+                continue;
+            }
+
+            is_scheduled[i] = true;
+            is_progressing = true;
+            order[scheduled++] = i;
+
+            for (Integer j = 0; j != count; ++j) {
+                if (!is_scheduled[j] && macros[j]->depends_on(*macros[i])) {
+                    --unresolved_dependencies[j];
+                }
+            }
+
+            break;
+        }
+    }
+
+    for (Integer i = 0; i != count; ++i) {
+        if (!is_scheduled[i]) {
+            order[scheduled++] = i;
+        }
+    }
+
+    is_order_up_to_date = true;
+}
+
 }
 
 #endif
@@ -20,6 +20,7 @@
 #define JS80P__DSP__MACRO_HPP
 
 #include <string>
+#include <vector>
 
 #include "js80p.hpp"
 
@@ -35,6 +36,12 @@ namespace JS80P
  * \brief Adjust the value of the \c input \c FloatParamB, so that if that has a
  *        \c MidiController assigned, then the \c Macro can be used as an
  *        adjustable version of that controller.
+ *
+ * \note When the params of the macro are controlled by time-stamped events
+ *       (e.g. from a \c MidiController or another \c Macro), then the macro
+ *       queues its own events at the same time offsets, so that the params
+ *       which are controlled by the macro can follow the changes within a
+ *       rendering block.
  */
 class Macro : public MidiController
 {
@@ -54,6 +61,18 @@ class Macro : public MidiController
 
         void update() noexcept;
 
+        /**
+         * \brief Make \c update() a no-op until \c unfreeze() is called.
+         */
+        void freeze() noexcept;
+        void unfreeze() noexcept;
+
+        /**
+         * \brief Tell whether the value of any of the params of this macro is
+         *        controlled by the given macro.
+         */
+        bool depends_on(Macro const& macro) const noexcept;
+
         FloatParamB midpoint;
         FloatParamB input;
         FloatParamB min;
@@ -64,8 +83,23 @@ class Macro : public MidiController
         DistortionShapeParam distortion_shape;
 
     private:
+        static constexpr Integer FLOAT_PARAMS = 7;
+
         bool update_change_indices() noexcept;
 
+        Number compute_value(Number const* const values) const noexcept;
+
+        bool find_next_event_time_offset(
+            Seconds const time_offset,
+            Seconds& next_time_offset
+        ) const noexcept;
+
+        Number get_value_at(
+            Integer const param_index,
+            Seconds const time_offset,
+            Number const current_value
+        ) const noexcept;
+
         template<class ParamClass>
         bool update_change_index(
             ParamClass& param,
@@ -80,7 +114,58 @@ class Macro : public MidiController
         Integer distortion_change_index;
         Integer randomness_change_index;
         Integer distortion_shape_change_index;
+        FloatParamB* const float_params[FLOAT_PARAMS];
+        Number previous_values[FLOAT_PARAMS];
         bool is_updating;
+        bool is_frozen;
+};
+
+
+/**
+ * \brief Evaluate a set of macros once per rendering round, so that chains of
+ *        macros don't have to be resolved lazily every time a param which is
+ *        controlled by one of them is accessed.
+ *
+ * \note Macros are evaluated in topological order of their dependencies, and
+ *       they are frozen until \c release() is called, so that pulling their
+ *       values from params during rendering becomes cheap. Macros which are
+ *       involved in cyclic dependencies are evaluated in their original order
+ *       after the others, and the cycles are broken up by \c Macro::update()
+ *       the same way as without the scheduler.
+ */
+class MacroScheduler
+{
+    public:
+        MacroScheduler(Macro* const* macros, Integer const count) noexcept;
+
+        /**
+         * \brief Rebuild the evaluation order before the next round, because
+         *        a macro may have been assigned to a param of another one.
+         */
+        void invalidate() noexcept;
+
+        /**
+         * \brief Evaluate the macros which are in use, in dependency order,
+         *        and freeze them.
+         */
+        void update() noexcept;
+
+        /**
+         * \brief Unfreeze the macros that were evaluated by \c update().
+         */
+        void release() noexcept;
+
+    private:
+        void build_order() noexcept;
+
+        Macro* const* const macros;
+        Integer const count;
+
+        std::vector<Integer> order;
+        std::vector<Integer> unresolved_dependencies;
+        std::vector<bool> is_scheduled;
+
+        bool is_order_up_to_date;
 };
 
 }
@@ -797,11 +797,21 @@ Number Math::apply_envelope_shape(
         EnvelopeShape const shape,
         Number const value
 ) noexcept {
-    return lookup(
-        math.envelope_shapes[(int)shape],
-        ENVELOPE_SHAPE_TABLE_MAX_INDEX,
-        value * ENVELOPE_SHAPE_SCALE
+    /*
+    Same as lookup(), but without branching, so that the rendering loops of
+    Envelope can be vectorized.
+    */
+    Number const* const table = math.envelope_shapes[(int)shape];
+    Number const index = std::min(
+        std::max(0.0, value * ENVELOPE_SHAPE_SCALE),
+        ENVELOPE_SHAPE_SCALE
     );
+    int const before_index = std::min(
+        (int)index, ENVELOPE_SHAPE_TABLE_MAX_INDEX - 1
+    );
+    Number const after_weight = index - (Number)before_index;
+
+    return combine(after_weight, table[before_index + 1], table[before_index]);
 }
 
 
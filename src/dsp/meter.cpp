@@ -0,0 +1,331 @@
+/*
+ * This file is part of JS80P, a synthesizer plugin.
+ * Copyright (C) 2023, 2024  Attila M. Magyar
+ *
+ * JS80P is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * JS80P is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef JS80P__DSP__METER_CPP
+#define JS80P__DSP__METER_CPP
+
+#include <algorithm>
+#include <cmath>
+
+#include "dsp/meter.hpp"
+
+#include "dsp/math.hpp"
+#include "dsp/signal_producer.hpp"
+
+
+namespace JS80P
+{
+
+Meter::Snapshot::Snapshot() noexcept
+    : peak(0.0),
+    rms(0.0),
+    loudness(MIN_LOUDNESS)
+{
+}
+
+
+void Meter::KWeightingFilter::reset() noexcept
+{
+    std::fill_n(x_n_m1, MAX_CHANNELS, 0.0);
+    std::fill_n(x_n_m2, MAX_CHANNELS, 0.0);
+    std::fill_n(y_n_m1, MAX_CHANNELS, 0.0);
+    std::fill_n(y_n_m2, MAX_CHANNELS, 0.0);
+}
+
+
+Sample const Meter::SILENCE[Meter::SILENCE_SIZE] = {};
+
+
+Meter::Meter() noexcept : sample_rate(0.0)
+{
+    set_sample_rate(SignalProducer::DEFAULT_SAMPLE_RATE);
+}
+
+
+/*
+The K-weighting filter coefficients for arbitrary sample rates are calculated
+the same way as in libebur128, so that they match the ones in ITU-R BS.1770-4
+at 48 kHz.
+*/
+void Meter::set_sample_rate(Frequency const new_sample_rate) noexcept
+{
+    sample_rate = new_sample_rate;
+
+    Number const high_shelf_k = std::tan(
+        Math::PI * 1681.974450955533 / (Number)sample_rate
+    );
+    Number const high_shelf_q = 0.7071752369554196;
+    Number const vh = std::pow(10.0, 3.999843853973347 / 20.0);
+    Number const vb = std::pow(vh, 0.4996667741545416);
+    Number const high_shelf_k_sqr = high_shelf_k * high_shelf_k;
+    Number const high_shelf_a0 = 1.0 + high_shelf_k / high_shelf_q + high_shelf_k_sqr;
+
+    high_shelf_filter.b0 = (vh + vb * high_shelf_k / high_shelf_q + high_shelf_k_sqr) / high_shelf_a0;
+    high_shelf_filter.b1 = 2.0 * (high_shelf_k_sqr - vh) / high_shelf_a0;
+    high_shelf_filter.b2 = (vh - vb * high_shelf_k / high_shelf_q + high_shelf_k_sqr) / high_shelf_a0;
+    high_shelf_filter.a1 = 2.0 * (high_shelf_k_sqr - 1.0) / high_shelf_a0;
+    high_shelf_filter.a2 = (1.0 - high_shelf_k / high_shelf_q + high_shelf_k_sqr) / high_shelf_a0;
+
+    Number const high_pass_k = std::tan(
+        Math::PI * 38.13547087602444 / (Number)sample_rate
+    );
+    Number const high_pass_q = 0.5003270373238773;
+    Number const high_pass_k_sqr = high_pass_k * high_pass_k;
+    Number const high_pass_a0 = 1.0 + high_pass_k / high_pass_q + high_pass_k_sqr;
+
+    high_pass_filter.b0 = 1.0;
+    high_pass_filter.b1 = -2.0;
+    high_pass_filter.b2 = 1.0;
+    high_pass_filter.a1 = 2.0 * (high_pass_k_sqr - 1.0) / high_pass_a0;
+    high_pass_filter.a2 = (1.0 - high_pass_k / high_pass_q + high_pass_k_sqr) / high_pass_a0;
+
+    loudness_bin_size = std::max(
+        (Integer)1,
+        (Integer)std::round(LOUDNESS_BIN_LENGTH * (Number)sample_rate)
+    );
+
+    reset();
+}
+
+
+void Meter::reset() noexcept
+{
+    high_shelf_filter.reset();
+    high_pass_filter.reset();
+
+    std::fill_n(loudness_bins, LOUDNESS_BINS, 0.0);
+
+    loudness_bin_fill = 0;
+    loudness_bin_index = 0;
+    loudness_bin_sum = 0.0;
+    loudness_window_sum = 0.0;
+
+    peak = 0.0;
+    mean_square = 0.0;
+
+    published.write(Snapshot());
+}
+
+
+void Meter::update(
+        Sample const* const* const buffer,
+        Integer const channels,
+        Integer const sample_count
+) noexcept {
+    JS80P_ASSERT(channels <= MAX_CHANNELS);
+
+    if (JS80P_UNLIKELY(sample_count <= 0 || channels <= 0)) {
+        return;
+    }
+
+    analyze(buffer, channels, sample_count);
+    publish();
+}
+
+
+void Meter::update_with_silence(
+        Integer const channels,
+        Integer const sample_count
+) noexcept {
+    JS80P_ASSERT(channels <= MAX_CHANNELS);
+
+    if (JS80P_UNLIKELY(sample_count <= 0 || channels <= 0)) {
+        return;
+    }
+
+    Sample const* const silence[MAX_CHANNELS] = {SILENCE, SILENCE};
+    Integer remaining_samples = sample_count;
+
+    while (remaining_samples != 0) {
+        Integer const batch_size = std::min(remaining_samples, SILENCE_SIZE);
+
+        analyze(silence, channels, batch_size);
+        remaining_samples -= batch_size;
+    }
+
+    publish();
+}
+
+
+void Meter::analyze(
+        Sample const* const* const buffer,
+        Integer const channels,
+        Integer const sample_count
+) noexcept {
+    Sample block_peak = 0.0;
+    Number sum_of_squares = 0.0;
+
+    /* Keep these loops simple so that they can be turned into SIMD reductions. */
+    for (Integer c = 0; c != channels; ++c) {
+        Sample const* const samples = buffer[c];
+
+        for (Integer i = 0; i != sample_count; ++i) {
+            block_peak = std::max(block_peak, std::fabs(samples[i]));
+        }
+
+        for (Integer i = 0; i != sample_count; ++i) {
+            sum_of_squares += samples[i] * samples[i];
+        }
+    }
+
+    Seconds const block_length = (Seconds)sample_count / (Seconds)sample_rate;
+    Sample const fallen_peak = peak * std::pow(
+        10.0, - (PEAK_FALL_DB / 20.0) * block_length / PEAK_FALL_TIME
+    );
+    Number const block_mean_square = (
+        sum_of_squares / (Number)(sample_count * channels)
+    );
+
+    peak = std::max(block_peak, fallen_peak);
+    mean_square += (
+        (block_mean_square - mean_square)
+        * (1.0 - std::exp(- block_length / RMS_INTEGRATION_TIME))
+    );
+
+    update_loudness(buffer, channels, sample_count);
+}
+
+
+void Meter::update_loudness(
+        Sample const* const* const buffer,
+        Integer const channels,
+        Integer const sample_count
+) noexcept {
+    Integer next_sample_index = 0;
+
+    while (next_sample_index != sample_count) {
+        Integer const batch_size = std::min(
+            sample_count - next_sample_index,
+            loudness_bin_size - loudness_bin_fill
+        );
+        Integer const last_sample_index = next_sample_index + batch_size;
+
+        for (Integer c = 0; c != channels; ++c) {
+            loudness_bin_sum += k_weighted_sum_of_squares(
+                buffer[c], c, next_sample_index, last_sample_index
+            );
+        }
+
+        loudness_bin_fill += batch_size;
+        next_sample_index = last_sample_index;
+
+        if (loudness_bin_fill == loudness_bin_size) {
+            loudness_bins[loudness_bin_index] = loudness_bin_sum;
+            loudness_bin_index = (loudness_bin_index + 1) % LOUDNESS_BINS;
+            loudness_bin_sum = 0.0;
+            loudness_bin_fill = 0;
+
+            /* Summing up from scratch avoids accumulating rounding errors. */
+            Number loudness_window_sum = 0.0;
+
+            for (Integer i = 0; i != LOUDNESS_BINS; ++i) {
+                loudness_window_sum += loudness_bins[i];
+            }
+
+            this->loudness_window_sum = loudness_window_sum;
+        }
+    }
+}
+
+
+void Meter::publish() noexcept
+{
+    Snapshot snapshot;
+    Number const loudness_mean_square = (
+        loudness_window_sum / (Number)(LOUDNESS_BINS * loudness_bin_size)
+    );
+
+    snapshot.peak = peak;
+    snapshot.rms = std::sqrt(mean_square);
+
+    if (loudness_mean_square > 0.0) {
+        snapshot.loudness = std::max(
+            MIN_LOUDNESS, -0.691 + 10.0 * std::log10(loudness_mean_square)
+        );
+    }
+
+    published.write(snapshot);
+}
+
+
+Number Meter::k_weighted_sum_of_squares(
+        Sample const* const samples,
+        Integer const channel,
+        Integer const first_sample_index,
+        Integer const last_sample_index
+) noexcept {
+    KWeightingFilter& hs = high_shelf_filter;
+    KWeightingFilter& hp = high_pass_filter;
+
+    Sample hs_x_n_m1 = hs.x_n_m1[channel];
+    Sample hs_x_n_m2 = hs.x_n_m2[channel];
+    Sample hs_y_n_m1 = hs.y_n_m1[channel];
+    Sample hs_y_n_m2 = hs.y_n_m2[channel];
+
+    Sample hp_y_n_m1 = hp.y_n_m1[channel];
+    Sample hp_y_n_m2 = hp.y_n_m2[channel];
+
+    Number sum_of_squares = 0.0;
+
+    for (Integer i = first_sample_index; i != last_sample_index; ++i) {
+        Sample const x_n = samples[i];
+        Sample const hs_y_n = (
+            hs.b0 * x_n + hs.b1 * hs_x_n_m1 + hs.b2 * hs_x_n_m2
+            - hs.a1 * hs_y_n_m1 - hs.a2 * hs_y_n_m2
+        );
+        Sample const hp_y_n = (
+            hp.b0 * hs_y_n + hp.b1 * hs_y_n_m1 + hp.b2 * hs_y_n_m2
+            - hp.a1 * hp_y_n_m1 - hp.a2 * hp_y_n_m2
+        );
+
+        hs_x_n_m2 = hs_x_n_m1;
+        hs_x_n_m1 = x_n;
+        hs_y_n_m2 = hs_y_n_m1;
+        hs_y_n_m1 = hs_y_n;
+        hp_y_n_m2 = hp_y_n_m1;
+        hp_y_n_m1 = hp_y_n;
+
+        sum_of_squares += hp_y_n * hp_y_n;
+    }
+
+    hs.x_n_m1[channel] = hs_x_n_m1;
+    hs.x_n_m2[channel] = hs_x_n_m2;
+    hs.y_n_m1[channel] = hs_y_n_m1;
+    hs.y_n_m2[channel] = hs_y_n_m2;
+
+    hp.y_n_m1[channel] = hp_y_n_m1;
+    hp.y_n_m2[channel] = hp_y_n_m2;
+
+    return sum_of_squares;
+}
+
+
+bool Meter::get_snapshot(Snapshot& snapshot) const noexcept
+{
+    return published.read(snapshot);
+}
+
+
+bool Meter::is_lock_free() const noexcept
+{
+    return published.is_lock_free();
+}
+
+}
+
+#endif
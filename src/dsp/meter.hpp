@@ -0,0 +1,158 @@
+/*
+ * This file is part of JS80P, a synthesizer plugin.
+ * Copyright (C) 2023, 2024  Attila M. Magyar
+ *
+ * JS80P is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * JS80P is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef JS80P__DSP__METER_HPP
+#define JS80P__DSP__METER_HPP
+
+#include "js80p.hpp"
+#include "seqlock.hpp"
+
+
+namespace JS80P
+{
+
+/**
+ * \brief Measure the peak level, the RMS level, and the short-term loudness
+ *        (ITU-R BS.1770, 3 second window) of a signal, block by block, and
+ *        publish the results for other threads.
+ */
+class Meter
+{
+    public:
+        static constexpr Integer MAX_CHANNELS = 2;
+
+        static constexpr Number MIN_LOUDNESS = -70.0;
+
+        static constexpr Seconds PEAK_FALL_TIME = 1.5;
+        static constexpr Number PEAK_FALL_DB = 20.0;
+        static constexpr Seconds RMS_INTEGRATION_TIME = 0.3;
+
+        static constexpr Seconds LOUDNESS_BIN_LENGTH = 0.1;
+        static constexpr Integer LOUDNESS_BINS = 30;
+
+        class Snapshot
+        {
+            public:
+                Snapshot() noexcept;
+
+                Sample peak;
+                Sample rms;
+                Number loudness;    ///< LUFS
+        };
+
+        Meter() noexcept;
+
+        void set_sample_rate(Frequency const new_sample_rate) noexcept;
+        void reset() noexcept;
+
+        /**
+         * \brief Analyze a block of samples and publish a new \c Snapshot.
+         *
+         * \warning Must only be called from a single (usually the audio)
+         *          thread.
+         */
+        void update(
+            Sample const* const* const buffer,
+            Integer const channels,
+            Integer const sample_count
+        ) noexcept;
+
+        /**
+         * \brief Same as passing \c sample_count samples of silence to
+         *        \c update(), for when the source of the signal doesn't
+         *        render anything.
+         *
+         * \warning Must only be called from the same thread as \c update().
+         */
+        void update_with_silence(
+            Integer const channels,
+            Integer const sample_count
+        ) noexcept;
+
+        /**
+         * \brief Retrieve the most recently published \c Snapshot. Safe to be
+         *        called from any thread, never blocks the audio thread.
+         */
+        bool get_snapshot(Snapshot& snapshot) const noexcept;
+
+        bool is_lock_free() const noexcept;
+
+    private:
+        static constexpr Integer SILENCE_SIZE = 256;
+
+        static Sample const SILENCE[SILENCE_SIZE];
+
+        class KWeightingFilter
+        {
+            public:
+                void reset() noexcept;
+
+                Sample b0;
+                Sample b1;
+                Sample b2;
+                Sample a1;
+                Sample a2;
+
+                Sample x_n_m1[MAX_CHANNELS];
+                Sample x_n_m2[MAX_CHANNELS];
+                Sample y_n_m1[MAX_CHANNELS];
+                Sample y_n_m2[MAX_CHANNELS];
+        };
+
+        Number k_weighted_sum_of_squares(
+            Sample const* const samples,
+            Integer const channel,
+            Integer const first_sample_index,
+            Integer const last_sample_index
+        ) noexcept;
+
+        void analyze(
+            Sample const* const* const buffer,
+            Integer const channels,
+            Integer const sample_count
+        ) noexcept;
+
+        void update_loudness(
+            Sample const* const* const buffer,
+            Integer const channels,
+            Integer const sample_count
+        ) noexcept;
+
+        void publish() noexcept;
+
+        KWeightingFilter high_shelf_filter;
+        KWeightingFilter high_pass_filter;
+
+        Number loudness_bins[LOUDNESS_BINS];
+
+        Frequency sample_rate;
+        Integer loudness_bin_size;
+        Integer loudness_bin_fill;
+        Integer loudness_bin_index;
+        Number loudness_bin_sum;
+        Number loudness_window_sum;
+
+        Sample peak;
+        Number mean_square;
+
+        SeqLock<Snapshot> published;
+};
+
+}
+
+#endif
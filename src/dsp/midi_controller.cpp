@@ -27,6 +27,7 @@ namespace JS80P
 
 MidiController::MidiController() noexcept
     : events_rw(32),
+    channel_controllers(NULL),
     change_index(0),
     assignments(0),
     value(0.5),
@@ -39,10 +40,70 @@ void MidiController::change(
         Seconds const time_offset,
         Number const new_value
 ) noexcept {
+    change(new_value);
+
+    if (merge_into_last_event(time_offset, new_value)) {
+        return;
+    }
+
+    if (events_rw.length() >= (Queue<SignalProducer::Event>::SizeType)MAX_EVENTS) {
+        halve_events();
+    }
+
     SignalProducer::Event event(EVT_CHANGE, time_offset, 0, new_value, 0.0);
 
     events_rw.push(event);
-    change(new_value);
+}
+
+
+bool MidiController::merge_into_last_event(
+        Seconds const time_offset,
+        Number const new_value
+) noexcept {
+    Queue<SignalProducer::Event>::SizeType const length = events_rw.length();
+
+    if (length == 0) {
+        return false;
+    }
+
+    SignalProducer::Event& last_event = events_rw.back();
+
+    if (time_offset <= last_event.time_offset) {
+        last_event.number_param_1 = new_value;
+
+        return true;
+    }
+
+    if (
+            length > 1
+            && last_event.number_param_1 == new_value
+            && events_rw[length - 2].number_param_1 == new_value
+    ) {
+        last_event.time_offset = time_offset;
+
+        return true;
+    }
+
+    return false;
+}
+
+
+/*
+Dropping every other event keeps the queue short regardless of the density of
+the controller stream, while the ramps which are built from the remaining
+events still follow the overall shape of the movement, and the most recent
+value still arrives at its exact time.
+*/
+void MidiController::halve_events() noexcept
+{
+    Queue<SignalProducer::Event>::SizeType const length = events_rw.length();
+    Queue<SignalProducer::Event>::SizeType next = 0;
+
+    for (Queue<SignalProducer::Event>::SizeType i = length & 1; i < length; i += 2) {
+        events_rw[next++] = events_rw[i];
+    }
+
+    events_rw.drop(next);
 }
 
 
@@ -91,6 +152,24 @@ Integer MidiController::is_assigned() const noexcept
     return assignments != 0;
 }
 
+
+void MidiController::set_channel_controllers(
+        MidiController* channel_controllers
+) noexcept {
+    this->channel_controllers = channel_controllers;
+}
+
+
+MidiController* MidiController::get_channel_controller(
+        Byte const channel
+) const noexcept {
+    if (channel_controllers == NULL || channel >= CHANNELS) {
+        return NULL;
+    }
+
+    return &channel_controllers[channel];
+}
+
 }
 
 #endif
@@ -36,11 +36,24 @@ class MidiController
     public:
         static constexpr SignalProducer::Event::Type EVT_CHANGE = 1;
 
+        /**
+         * \brief Dense controller streams are thinned out so that at most
+         *        this many events (ramp segments) are queued in a round.
+         */
+        static constexpr Integer MAX_EVENTS = 16;
+
+        static constexpr Byte CHANNELS = 16;
+        static constexpr Byte INVALID_CHANNEL = 255;
+
         MidiController() noexcept;
 
         /**
          * \brief Store the new value of the controller, and also queue it as
          *        an event with a time offset for sample-exact parameters.
+         *
+         * \note Events which are redundant (e.g. they share the time offset of
+         *       the previous one, or they continue a plateau) are merged with
+         *       the previous event instead of being queued.
          */
         void change(Seconds const time_offset, Number const new_value) noexcept;
         Integer get_change_index() const noexcept;
@@ -51,11 +64,34 @@ class MidiController
         void released() noexcept;
         Integer is_assigned() const noexcept;
 
+        /**
+         * \brief Attach an array of \c CHANNELS controllers which hold the
+         *        per-channel values of this controller (e.g. for MIDI
+         *        Polyphonic Expression).
+         */
+        void set_channel_controllers(MidiController* channel_controllers) noexcept;
+
+        /**
+         * \brief Look up the per-channel counterpart of this controller.
+         *
+         * \return \c NULL when the controller has no per-channel
+         *         counterparts, or the channel is \c INVALID_CHANNEL.
+         */
+        MidiController* get_channel_controller(Byte const channel) const noexcept;
+
     protected:
         void change(Number const new_value) noexcept;
 
     private:
+        bool merge_into_last_event(
+            Seconds const time_offset,
+            Number const new_value
+        ) noexcept;
+
+        void halve_events() noexcept;
+
         Queue<SignalProducer::Event> events_rw;
+        MidiController* channel_controllers;
         Integer change_index;
         Integer assignments;
         Number value;
@@ -29,6 +29,81 @@
 namespace JS80P
 {
 
+Number const CustomWaveform::ZEROS[HARMONICS] = {
+    0.0, 0.0, 0.0, 0.0, 0.0,
+    0.0, 0.0, 0.0, 0.0, 0.0,
+};
+
+
+CustomWaveform::CustomWaveform(
+        FloatParamB& harmonic_0,
+        FloatParamB& harmonic_1,
+        FloatParamB& harmonic_2,
+        FloatParamB& harmonic_3,
+        FloatParamB& harmonic_4,
+        FloatParamB& harmonic_5,
+        FloatParamB& harmonic_6,
+        FloatParamB& harmonic_7,
+        FloatParamB& harmonic_8,
+        FloatParamB& harmonic_9
+) noexcept
+    : wavetable(ZEROS, HARMONICS),
+    round(-1)
+{
+    params[0] = &harmonic_0;
+    params[1] = &harmonic_1;
+    params[2] = &harmonic_2;
+    params[3] = &harmonic_3;
+    params[4] = &harmonic_4;
+    params[5] = &harmonic_5;
+    params[6] = &harmonic_6;
+    params[7] = &harmonic_7;
+    params[8] = &harmonic_8;
+    params[9] = &harmonic_9;
+
+    for (Integer i = 0; i != HARMONICS; ++i) {
+        coefficients[i] = 0.0;
+        change_indices[i] = -1;
+    }
+}
+
+
+void CustomWaveform::update(
+        Integer const round,
+        Integer const sample_count
+) noexcept {
+    if (round == this->round) {
+        return;
+    }
+
+    this->round = round;
+
+    bool has_changed = false;
+
+    for (Integer i = 0; i != HARMONICS; ++i) {
+        Integer const param_change_idx = params[i]->get_change_index();
+
+        if (change_indices[i] != param_change_idx) {
+            coefficients[i] = params[i]->get_value();
+            change_indices[i] = param_change_idx;
+            has_changed = true;
+        }
+
+        FloatParamB::produce_if_not_constant(*params[i], round, sample_count);
+    }
+
+    if (has_changed) {
+        wavetable.update_coefficients(coefficients);
+    }
+}
+
+
+Wavetable const* CustomWaveform::get_wavetable() const noexcept
+{
+    return &wavetable;
+}
+
+
 template<class ModulatorSignalProducerClass, bool is_lfo>
 FloatParamB Oscillator<ModulatorSignalProducerClass, is_lfo>::dummy_param("", 0.0, 1.0, 0.0);
 
@@ -95,19 +170,18 @@ Oscillator<ModulatorSignalProducerClass, is_lfo>::Oscillator(
     harmonic_8(dummy_param),
     harmonic_9(dummy_param),
     tempo_sync(dummy_toggle),
-    center(dummy_toggle)
+    center(dummy_toggle),
+    custom_waveform(NULL),
+    owned_custom_waveform(NULL)
 {
-    initialize_instance();
+    initialize_instance(false);
 }
 
 
 template<class ModulatorSignalProducerClass, bool is_lfo>
-void Oscillator<ModulatorSignalProducerClass, is_lfo>::initialize_instance() noexcept
-{
-    Number const custom_waveform_coefficients[CUSTOM_WAVEFORM_HARMONICS] = {
-        0.0, 0.0, 0.0, 0.0, 0.0,
-        0.0, 0.0, 0.0, 0.0, 0.0,
-    };
+void Oscillator<ModulatorSignalProducerClass, is_lfo>::initialize_instance(
+        bool const has_harmonics
+) noexcept {
     computed_frequency_buffer = NULL;
     computed_amplitude_buffer = NULL;
     phase_buffer = NULL;
@@ -115,6 +189,7 @@ void Oscillator<ModulatorSignalProducerClass, is_lfo>::initialize_instance() noe
     frequency_scale = 1.0;
     is_on_ = false;
     is_starting = false;
+    is_lagrange_interpolation_only = false;
     subharmonic_amplitude_is_constant = true;
     subharmonic_amplitude_buffer = NULL;
     subharmonic_amplitude_value = 0.0;
@@ -128,25 +203,22 @@ void Oscillator<ModulatorSignalProducerClass, is_lfo>::initialize_instance() noe
     register_child(detune);
     register_child(fine_detune);
 
-    custom_waveform_params[0] = &harmonic_0;
-    custom_waveform_params[1] = &harmonic_1;
-    custom_waveform_params[2] = &harmonic_2;
-    custom_waveform_params[3] = &harmonic_3;
-    custom_waveform_params[4] = &harmonic_4;
-    custom_waveform_params[5] = &harmonic_5;
-    custom_waveform_params[6] = &harmonic_6;
-    custom_waveform_params[7] = &harmonic_7;
-    custom_waveform_params[8] = &harmonic_8;
-    custom_waveform_params[9] = &harmonic_9;
-
-    for (int i = 0; i != CUSTOM_WAVEFORM_HARMONICS; ++i) {
-        custom_waveform_change_indices[i] = -1;
+    if (has_harmonics && custom_waveform == NULL) {
+        owned_custom_waveform = new CustomWaveform(
+            harmonic_0,
+            harmonic_1,
+            harmonic_2,
+            harmonic_3,
+            harmonic_4,
+            harmonic_5,
+            harmonic_6,
+            harmonic_7,
+            harmonic_8,
+            harmonic_9
+        );
+        custom_waveform = owned_custom_waveform;
     }
 
-    custom_waveform = new Wavetable(
-        custom_waveform_coefficients, CUSTOM_WAVEFORM_HARMONICS
-    );
-
     wavetables[SINE] = StandardWaveforms::sine();
     wavetables[SAWTOOTH] = StandardWaveforms::sawtooth();
     wavetables[SOFT_SAWTOOTH] = StandardWaveforms::soft_sawtooth();
@@ -156,7 +228,11 @@ void Oscillator<ModulatorSignalProducerClass, is_lfo>::initialize_instance() noe
     wavetables[SOFT_TRIANGLE] = StandardWaveforms::soft_triangle();
     wavetables[SQUARE] = StandardWaveforms::square();
     wavetables[SOFT_SQUARE] = StandardWaveforms::soft_square();
-    wavetables[CUSTOM] = custom_waveform;
+    wavetables[CUSTOM] = (
+        custom_waveform == NULL
+            ? StandardWaveforms::silence()
+            : custom_waveform->get_wavetable()
+    );
 
     allocate_buffers(block_size);
 }
@@ -215,9 +291,11 @@ Oscillator<ModulatorSignalProducerClass, is_lfo>::Oscillator(
     harmonic_8(dummy_param),
     harmonic_9(dummy_param),
     tempo_sync(dummy_toggle),
-    center(dummy_toggle)
+    center(dummy_toggle),
+    custom_waveform(NULL),
+    owned_custom_waveform(NULL)
 {
-    initialize_instance();
+    initialize_instance(false);
 }
 
 
@@ -261,9 +339,11 @@ Oscillator<ModulatorSignalProducerClass, is_lfo>::Oscillator(
     harmonic_8(dummy_param),
     harmonic_9(dummy_param),
     tempo_sync(tempo_sync),
-    center(center)
+    center(center),
+    custom_waveform(NULL),
+    owned_custom_waveform(NULL)
 {
-    initialize_instance();
+    initialize_instance(false);
 }
 
 
@@ -285,7 +365,8 @@ Oscillator<ModulatorSignalProducerClass, is_lfo>::Oscillator(
         FloatParamB& harmonic_7_leader,
         FloatParamB& harmonic_8_leader,
         FloatParamB& harmonic_9_leader,
-        Byte const& voice_status
+        Byte const& voice_status,
+        CustomWaveform* custom_waveform
 ) noexcept
     : SignalProducer(1, NUMBER_OF_CHILDREN, NUMBER_OF_EVENTS),
     waveform(waveform),
@@ -308,9 +389,11 @@ Oscillator<ModulatorSignalProducerClass, is_lfo>::Oscillator(
     harmonic_8(harmonic_8_leader),
     harmonic_9(harmonic_9_leader),
     tempo_sync(dummy_toggle),
-    center(dummy_toggle)
+    center(dummy_toggle),
+    custom_waveform(custom_waveform),
+    owned_custom_waveform(NULL)
 {
-    initialize_instance();
+    initialize_instance(true);
 }
 
 
@@ -335,7 +418,8 @@ Oscillator<ModulatorSignalProducerClass, is_lfo>::Oscillator(
         ModulatorSignalProducerClass& modulator,
         FloatParamS& amplitude_modulation_level_leader,
         FloatParamS& frequency_modulation_level_leader,
-        FloatParamS& phase_modulation_level_leader
+        FloatParamS& phase_modulation_level_leader,
+        CustomWaveform* custom_waveform
 ) noexcept
     : SignalProducer(1, NUMBER_OF_CHILDREN, NUMBER_OF_EVENTS),
     waveform(waveform),
@@ -382,16 +466,22 @@ Oscillator<ModulatorSignalProducerClass, is_lfo>::Oscillator(
     harmonic_8(harmonic_8_leader),
     harmonic_9(harmonic_9_leader),
     tempo_sync(dummy_toggle),
-    center(dummy_toggle)
+    center(dummy_toggle),
+    custom_waveform(custom_waveform),
+    owned_custom_waveform(NULL)
 {
-    initialize_instance();
+    initialize_instance(true);
 }
 
 
 template<class ModulatorSignalProducerClass, bool is_lfo>
 Oscillator<ModulatorSignalProducerClass, is_lfo>::~Oscillator()
 {
-    delete custom_waveform;
+    if (owned_custom_waveform != NULL) {
+        delete owned_custom_waveform;
+        owned_custom_waveform = NULL;
+    }
+
     custom_waveform = NULL;
     wavetables[CUSTOM] = NULL;
     free_buffers();
@@ -470,6 +560,14 @@ bool Oscillator<ModulatorSignalProducerClass, is_lfo>::is_on() const noexcept
 }
 
 
+template<class ModulatorSignalProducerClass, bool is_lfo>
+void Oscillator<ModulatorSignalProducerClass, is_lfo>::use_lagrange_interpolation_only(
+        bool const is_enabled
+) noexcept {
+    is_lagrange_interpolation_only = is_enabled;
+}
+
+
 template<class ModulatorSignalProducerClass, bool is_lfo>
 void Oscillator<ModulatorSignalProducerClass, is_lfo>::skip_round(
         Integer const round,
@@ -575,30 +673,8 @@ Sample const* const* Oscillator<ModulatorSignalProducerClass, is_lfo>::initializ
 
     if constexpr (is_lfo) {
         apply_toggle_params(bpm);
-    } else if (waveform == CUSTOM) {
-        bool has_changed = false;
-
-        for (Integer i = 0; i != CUSTOM_WAVEFORM_HARMONICS; ++i) {
-            Integer const param_change_idx = (
-                custom_waveform_params[i]->get_change_index()
-            );
-
-            if (custom_waveform_change_indices[i] != param_change_idx) {
-                custom_waveform_coefficients[i] = (
-                    custom_waveform_params[i]->get_value()
-                );
-                custom_waveform_change_indices[i] = param_change_idx;
-                has_changed = true;
-            }
-
-            FloatParamB::produce_if_not_constant(
-                *custom_waveform_params[i], round, sample_count
-            );
-        }
-
-        if (has_changed) {
-            custom_waveform->update_coefficients(custom_waveform_coefficients);
-        }
+    } else if (waveform == CUSTOM && custom_waveform != NULL) {
+        custom_waveform->update(round, sample_count);
     }
 
     wavetable = wavetables[waveform];
@@ -973,9 +1049,11 @@ void Oscillator<ModulatorSignalProducerClass, is_lfo>::render(
 ) noexcept {
     if (computed_frequency_is_constant) {
         Wavetable::Interpolation const interpolation = (
-            wavetable->select_interpolation(
-                frequency_scale * computed_frequency_value, nyquist_frequency
-            )
+            is_lagrange_interpolation_only
+                ? Wavetable::Interpolation::LAGRANGE_ONLY
+                : wavetable->select_interpolation(
+                    frequency_scale * computed_frequency_value, nyquist_frequency
+                )
         );
 
         if (JS80P_UNLIKELY(wavetable->has_single_partial())) {
@@ -1019,12 +1097,22 @@ void Oscillator<ModulatorSignalProducerClass, is_lfo>::render(
                     break;
             }
         }
+    } else if (JS80P_UNLIKELY(is_lagrange_interpolation_only)) {
+        if (JS80P_UNLIKELY(wavetable->has_single_partial())) {
+            render_with_changing_frequency<Wavetable::Interpolation::LAGRANGE_ONLY, true, has_subharmonic>(
+                wavetable_state, round, first_sample_index, last_sample_index, buffer
+            );
+        } else {
+            render_with_changing_frequency<Wavetable::Interpolation::LAGRANGE_ONLY, false, has_subharmonic>(
+                wavetable_state, round, first_sample_index, last_sample_index, buffer
+            );
+        }
     } else if (JS80P_UNLIKELY(wavetable->has_single_partial())) {
-        render_with_changing_frequency<true, has_subharmonic>(
+        render_with_changing_frequency<Wavetable::Interpolation::DYNAMIC, true, has_subharmonic>(
             wavetable_state, round, first_sample_index, last_sample_index, buffer
         );
     } else {
-        render_with_changing_frequency<false, has_subharmonic>(
+        render_with_changing_frequency<Wavetable::Interpolation::DYNAMIC, false, has_subharmonic>(
             wavetable_state, round, first_sample_index, last_sample_index, buffer
         );
     }
@@ -1205,7 +1293,7 @@ void Oscillator<ModulatorSignalProducerClass, is_lfo>::render_with_constant_freq
 
 
 template<class ModulatorSignalProducerClass, bool is_lfo>
-template<bool single_partial, bool has_subharmonic>
+template<Wavetable::Interpolation interpolation, bool single_partial, bool has_subharmonic>
 void Oscillator<ModulatorSignalProducerClass, is_lfo>::render_with_changing_frequency(
         WavetableState& wavetable_state,
         Integer const round,
@@ -1233,7 +1321,7 @@ void Oscillator<ModulatorSignalProducerClass, is_lfo>::render_with_changing_freq
                     Sample const subharmonic_amplitude = subharmonic_amplitude_value;
 
                     for (Integer i = first_sample_index; i != last_sample_index; ++i) {
-                        buffer[i] = render_sample<single_partial, true>(
+                        buffer[i] = render_sample<single_partial, true, interpolation>(
                             wavetable_state,
                             amplitude_value,
                             computed_frequency_buffer[i],
@@ -1245,7 +1333,7 @@ void Oscillator<ModulatorSignalProducerClass, is_lfo>::render_with_changing_freq
                     Sample const* const subharmonic_amplitude_buffer = this->subharmonic_amplitude_buffer;
 
                     for (Integer i = first_sample_index; i != last_sample_index; ++i) {
-                        buffer[i] = render_sample<single_partial, true>(
+                        buffer[i] = render_sample<single_partial, true, interpolation>(
                             wavetable_state,
                             amplitude_value,
                             computed_frequency_buffer[i],
@@ -1259,7 +1347,7 @@ void Oscillator<ModulatorSignalProducerClass, is_lfo>::render_with_changing_freq
                     Sample const subharmonic_amplitude = subharmonic_amplitude_value;
 
                     for (Integer i = first_sample_index; i != last_sample_index; ++i) {
-                        buffer[i] = render_sample<single_partial, true>(
+                        buffer[i] = render_sample<single_partial, true, interpolation>(
                             wavetable_state,
                             amplitude_value,
                             computed_frequency_buffer[i],
@@ -1271,7 +1359,7 @@ void Oscillator<ModulatorSignalProducerClass, is_lfo>::render_with_changing_freq
                     Sample const* const subharmonic_amplitude_buffer = this->subharmonic_amplitude_buffer;
 
                     for (Integer i = first_sample_index; i != last_sample_index; ++i) {
-                        buffer[i] = render_sample<single_partial, true>(
+                        buffer[i] = render_sample<single_partial, true, interpolation>(
                             wavetable_state,
                             amplitude_value,
                             computed_frequency_buffer[i],
@@ -1287,7 +1375,7 @@ void Oscillator<ModulatorSignalProducerClass, is_lfo>::render_with_changing_freq
                     Sample const subharmonic_amplitude = subharmonic_amplitude_value;
 
                     for (Integer i = first_sample_index; i != last_sample_index; ++i) {
-                        buffer[i] = render_sample<single_partial, true>(
+                        buffer[i] = render_sample<single_partial, true, interpolation>(
                             wavetable_state,
                             computed_amplitude_buffer[i],
                             computed_frequency_buffer[i],
@@ -1299,7 +1387,7 @@ void Oscillator<ModulatorSignalProducerClass, is_lfo>::render_with_changing_freq
                     Sample const* const subharmonic_amplitude_buffer = this->subharmonic_amplitude_buffer;
 
                     for (Integer i = first_sample_index; i != last_sample_index; ++i) {
-                        buffer[i] = render_sample<single_partial, true>(
+                        buffer[i] = render_sample<single_partial, true, interpolation>(
                             wavetable_state,
                             computed_amplitude_buffer[i],
                             computed_frequency_buffer[i],
@@ -1313,7 +1401,7 @@ void Oscillator<ModulatorSignalProducerClass, is_lfo>::render_with_changing_freq
                     Sample const subharmonic_amplitude = subharmonic_amplitude_value;
 
                     for (Integer i = first_sample_index; i != last_sample_index; ++i) {
-                        buffer[i] = render_sample<single_partial, true>(
+                        buffer[i] = render_sample<single_partial, true, interpolation>(
                             wavetable_state,
                             computed_amplitude_buffer[i],
                             computed_frequency_buffer[i],
@@ -1325,7 +1413,7 @@ void Oscillator<ModulatorSignalProducerClass, is_lfo>::render_with_changing_freq
                     Sample const* const subharmonic_amplitude_buffer = this->subharmonic_amplitude_buffer;
 
                     for (Integer i = first_sample_index; i != last_sample_index; ++i) {
-                        buffer[i] = render_sample<single_partial, true>(
+                        buffer[i] = render_sample<single_partial, true, interpolation>(
                             wavetable_state,
                             computed_amplitude_buffer[i],
                             computed_frequency_buffer[i],
@@ -1344,7 +1432,7 @@ void Oscillator<ModulatorSignalProducerClass, is_lfo>::render_with_changing_freq
                 Sample const phase = phase_value;
 
                 for (Integer i = first_sample_index; i != last_sample_index; ++i) {
-                    buffer[i] = render_sample<single_partial, false>(
+                    buffer[i] = render_sample<single_partial, false, interpolation>(
                         wavetable_state,
                         amplitude_value,
                         computed_frequency_buffer[i],
@@ -1353,7 +1441,7 @@ void Oscillator<ModulatorSignalProducerClass, is_lfo>::render_with_changing_freq
                 }
             } else {
                 for (Integer i = first_sample_index; i != last_sample_index; ++i) {
-                    buffer[i] = render_sample<single_partial, false>(
+                    buffer[i] = render_sample<single_partial, false, interpolation>(
                         wavetable_state,
                         amplitude_value,
                         computed_frequency_buffer[i],
@@ -1364,7 +1452,7 @@ void Oscillator<ModulatorSignalProducerClass, is_lfo>::render_with_changing_freq
         } else {
             if (phase_is_constant) {
                 for (Integer i = first_sample_index; i != last_sample_index; ++i) {
-                    buffer[i] = render_sample<single_partial, false>(
+                    buffer[i] = render_sample<single_partial, false, interpolation>(
                         wavetable_state,
                         computed_amplitude_buffer[i],
                         computed_frequency_buffer[i],
@@ -1373,7 +1461,7 @@ void Oscillator<ModulatorSignalProducerClass, is_lfo>::render_with_changing_freq
                 }
             } else {
                 for (Integer i = first_sample_index; i != last_sample_index; ++i) {
-                    buffer[i] = render_sample<single_partial, false>(
+                    buffer[i] = render_sample<single_partial, false, interpolation>(
                         wavetable_state,
                         computed_amplitude_buffer[i],
                         computed_frequency_buffer[i],
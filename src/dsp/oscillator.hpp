@@ -36,6 +36,56 @@ template<class ModulatorSignalProducerClass, bool is_lfo>
 class Oscillator;
 
 
+/**
+ * \brief A wavetable which is computed from the coefficients of the first few
+ *        harmonics, so that it can be shared between all the oscillators
+ *        which follow the same harmonic leader params.
+ */
+class CustomWaveform
+{
+    public:
+        static constexpr Integer HARMONICS = 10;
+
+        CustomWaveform(
+            FloatParamB& harmonic_0,
+            FloatParamB& harmonic_1,
+            FloatParamB& harmonic_2,
+            FloatParamB& harmonic_3,
+            FloatParamB& harmonic_4,
+            FloatParamB& harmonic_5,
+            FloatParamB& harmonic_6,
+            FloatParamB& harmonic_7,
+            FloatParamB& harmonic_8,
+            FloatParamB& harmonic_9
+        ) noexcept;
+
+        CustomWaveform(CustomWaveform const& custom_waveform) = delete;
+        CustomWaveform(CustomWaveform&& custom_waveform) = delete;
+
+        CustomWaveform& operator=(CustomWaveform const& custom_waveform) = delete;
+        CustomWaveform& operator=(CustomWaveform&& custom_waveform) = delete;
+
+        /**
+         * \brief Recompute the wavetable if any of the harmonics have changed.
+         *        Only the first call in each rendering round does any work,
+         *        the rest of the oscillators which share the waveform will
+         *        find it up-to-date.
+         */
+        void update(Integer const round, Integer const sample_count) noexcept;
+
+        Wavetable const* get_wavetable() const noexcept;
+
+    private:
+        static Number const ZEROS[HARMONICS];
+
+        FloatParamB* params[HARMONICS];
+        Number coefficients[HARMONICS];
+        Integer change_indices[HARMONICS];
+        Wavetable wavetable;
+        Integer round;
+};
+
+
 typedef Oscillator<SignalProducer, false> SimpleOscillator;
 
 
@@ -132,7 +182,8 @@ class Oscillator : public SignalProducer
             FloatParamB& harmonic_7_leader,
             FloatParamB& harmonic_8_leader,
             FloatParamB& harmonic_9_leader,
-            Byte const& voice_status
+            Byte const& voice_status,
+            CustomWaveform* custom_waveform = NULL
         ) noexcept;
 
         Oscillator(
@@ -155,7 +206,8 @@ class Oscillator : public SignalProducer
             ModulatorSignalProducerClass& modulator,
             FloatParamS& amplitude_modulation_level_leader,
             FloatParamS& frequency_modulation_level_leader,
-            FloatParamS& phase_modulation_level_leader
+            FloatParamS& phase_modulation_level_leader,
+            CustomWaveform* custom_waveform = NULL
         ) noexcept;
 
         ~Oscillator() override;
@@ -167,6 +219,13 @@ class Oscillator : public SignalProducer
         void stop(Seconds const time_offset) noexcept;
         bool is_on() const noexcept;
 
+        /**
+         * \brief Use the more expensive, but more accurate Lagrange
+         *        interpolation regardless of the frequency, e.g. when
+         *        rendering offline, where there's no deadline to meet.
+         */
+        void use_lagrange_interpolation_only(bool const is_enabled) noexcept;
+
         void produce_for_lfo_with_envelope(
             WavetableState& wavetable_state,
             Integer const round,
@@ -227,9 +286,7 @@ class Oscillator : public SignalProducer
         static constexpr Integer NUMBER_OF_CHILDREN = 8;
         static constexpr Integer NUMBER_OF_EVENTS = 4;
 
-        static constexpr Integer CUSTOM_WAVEFORM_HARMONICS = 10;
-
-        void initialize_instance() noexcept;
+        void initialize_instance(bool const has_harmonics) noexcept;
         void allocate_buffers(Integer const size) noexcept;
         void free_buffers() noexcept;
 
@@ -292,7 +349,11 @@ class Oscillator : public SignalProducer
             Sample* buffer
         ) noexcept;
 
-        template<bool single_partial, bool has_subharmonic>
+        template<
+            Wavetable::Interpolation interpolation,
+            bool single_partial,
+            bool has_subharmonic
+        >
         void render_with_changing_frequency(
             WavetableState& wavetable_state,
             Integer const round,
@@ -319,14 +380,12 @@ class Oscillator : public SignalProducer
         WavetableState wavetable_state;
         Wavetable const* wavetables[WAVEFORMS];
         Wavetable const* wavetable;
-        Wavetable* custom_waveform;
+        CustomWaveform* custom_waveform;
+        CustomWaveform* owned_custom_waveform;
         Sample* computed_amplitude_buffer;
         Frequency* computed_frequency_buffer;
         Sample* phase_buffer;
         Sample const* subharmonic_amplitude_buffer;
-        FloatParamB* custom_waveform_params[CUSTOM_WAVEFORM_HARMONICS];
-        Number custom_waveform_coefficients[CUSTOM_WAVEFORM_HARMONICS];
-        Integer custom_waveform_change_indices[CUSTOM_WAVEFORM_HARMONICS];
         Number computed_amplitude_value;
         Sample subharmonic_amplitude_value;
         Frequency computed_frequency_value;
@@ -336,6 +395,7 @@ class Oscillator : public SignalProducer
         Sample sample_offset_scale;
         bool is_on_;
         bool is_starting;
+        bool is_lagrange_interpolation_only;
         bool computed_frequency_is_constant;
         bool computed_amplitude_is_constant;
         bool phase_is_constant;
@@ -461,6 +461,7 @@ FloatParam<evaluation>::FloatParam(
     leader(NULL),
     envelopes(envelopes),
     envelope_state(envelopes != NULL ? new EnvelopeState(envelopes) : NULL),
+    envelope_render_cache(envelopes != NULL ? new EnvelopeRenderCache() : NULL),
     round_to(round_to),
     round_to_inv(round_to > 0.0 ? 1.0 / round_to : 0.0),
     log_scale_toggle(log_scale_toggle),
@@ -505,6 +506,7 @@ void FloatParam<evaluation>::initialize_instance() noexcept
     constantness = false;
 
     latest_event_type = EVT_SET_VALUE;
+    channel = MidiController::INVALID_CHANNEL;
 }
 
 
@@ -542,6 +544,7 @@ FloatParam<evaluation>::FloatParam(
             ? new EnvelopeState(leader.get_envelopes())
             : NULL
     ),
+    envelope_render_cache(NULL),
     round_to(0.0),
     round_to_inv(0.0),
     log_scale_toggle(leader.get_log_scale_toggle()),
@@ -582,6 +585,10 @@ FloatParam<evaluation>::~FloatParam()
 
         delete envelope_state;
     }
+
+    if (envelope_render_cache != NULL) {
+        delete envelope_render_cache;
+    }
 }
 
 
@@ -653,7 +660,54 @@ bool FloatParam<evaluation>::is_following_leader() const noexcept
         return false;
     }
 
-    return !leader->is_polyphonic();
+    return !leader->is_polyphonic() && get_channel_midi_controller() == NULL;
+}
+
+
+template<ParamEvaluation evaluation>
+MidiController* FloatParam<evaluation>::get_channel_midi_controller() const noexcept
+{
+    if (leader == NULL || channel == MidiController::INVALID_CHANNEL) {
+        return NULL;
+    }
+
+    MidiController const* const midi_controller = leader->midi_controller;
+
+    if (midi_controller == NULL) {
+        return NULL;
+    }
+
+    return midi_controller->get_channel_controller(channel);
+}
+
+
+template<ParamEvaluation evaluation>
+void FloatParam<evaluation>::set_channel(
+        Seconds const time_offset,
+        Byte const channel
+) noexcept {
+    bool const was_following_leader = is_following_leader();
+
+    this->channel = channel;
+
+    MidiController const* const midi_controller = get_channel_midi_controller();
+
+    if (midi_controller == NULL) {
+        return;
+    }
+
+    /*
+    Until the note starts, the param keeps the value that it had so far, even if
+    it used to take it from the leader.
+    */
+    if (was_following_leader) {
+        this->cancel_events();
+        set_value(leader->get_value());
+    } else {
+        this->cancel_events_at(time_offset);
+    }
+
+    schedule_value(time_offset, ratio_to_value(midi_controller->get_value()));
 }
 
 
@@ -779,6 +833,71 @@ Number FloatParam<evaluation>::ratio_to_value(Number const ratio) const noexcept
 }
 
 
+/*
+The value of a logarithmic param is an exponential function of its ratio:
+
+    value = 2 ^ (ratio * log_range - log_min_minus) - log_scale_value_offset
+
+so a linear ramp of the ratio becomes a geometric progression, which can be
+rendered without per-sample table lookups.
+*/
+template<ParamEvaluation evaluation>
+Integer FloatParam<evaluation>::render_log_ramp(
+        Integer const first_sample_index,
+        Integer const last_sample_index,
+        Sample* buffer
+) noexcept {
+    LinearRampState& ramp = linear_ramp_state;
+
+    if (ramp.is_done || first_sample_index == last_sample_index) {
+        return first_sample_index;
+    }
+
+    Integer const remaining_samples = std::max(
+        (Integer)1, (Integer)std::ceil(ramp.duration_in_samples - ramp.done_samples)
+    );
+    Integer const sample_count = std::min(
+        remaining_samples, last_sample_index - first_sample_index
+    );
+    Number const log_range = 1.0 / log_range_inv;
+    Number const log_offset = log_scale_value_offset;
+    Number const ratio_step = ramp.speed * ramp.delta;
+    Number const first_ratio = (
+        ramp.initial_value + (ramp.done_samples * ramp.speed) * ramp.delta
+    );
+    Number const step = std::exp2(ratio_step * log_range);
+
+    Number factors[LOG_RAMP_CHUNK_SIZE];
+
+    factors[0] = 1.0;
+
+    for (Integer j = 1; j != LOG_RAMP_CHUNK_SIZE; ++j) {
+        factors[j] = factors[j - 1] * step;
+    }
+
+    for (Integer done = 0; done < sample_count; done += LOG_RAMP_CHUNK_SIZE) {
+        Integer const chunk_size = std::min(LOG_RAMP_CHUNK_SIZE, sample_count - done);
+        Number const anchor = std::exp2(
+            (first_ratio + (Number)done * ratio_step) * log_range - log_min_minus
+        );
+        Sample* const chunk = &buffer[first_sample_index + done];
+
+        for (Integer j = 0; j != chunk_size; ++j) {
+            chunk[j] = anchor * factors[j] - log_offset;
+        }
+    }
+
+    ramp.done_samples += (Number)sample_count;
+
+    if (ramp.done_samples >= ramp.duration_in_samples) {
+        ramp.done_samples = ramp.duration_in_samples;
+        ramp.is_done = true;
+    }
+
+    return first_sample_index + sample_count;
+}
+
+
 template<ParamEvaluation evaluation>
 Number FloatParam<evaluation>::ratio_to_value_log(Number const ratio) const noexcept
 {
@@ -937,6 +1056,12 @@ bool FloatParam<evaluation>::is_constant_until(
         );
     }
 
+    MidiController const* const channel_midi_controller = get_channel_midi_controller();
+
+    if (channel_midi_controller != NULL) {
+        return channel_midi_controller->events.is_empty();
+    }
+
     if (this->midi_controller != NULL) {
         return this->midi_controller->events.is_empty();
     }
@@ -2163,6 +2288,8 @@ void FloatParam<evaluation>::reset() noexcept
 {
     SignalProducer::reset();
 
+    invalidate_envelope_render_cache();
+
     if (envelope_state != NULL) {
         check_leaked_envelope_snapshots("reset");
         clear_envelope_state();
@@ -2178,14 +2305,21 @@ Sample const* const* FloatParam<evaluation>::initialize_rendering(
     Param<Number, evaluation>::initialize_rendering(round, sample_count);
 
     LFO* const lfo = get_lfo();
+    MidiController const* const channel_midi_controller = get_channel_midi_controller();
 
     if (lfo != NULL) {
         return process_lfo(*lfo, round, sample_count);
+    } else if (channel_midi_controller != NULL) {
+        if (is_logarithmic()) {
+            process_midi_controller_events<true>(*channel_midi_controller);
+        } else {
+            process_midi_controller_events<false>(*channel_midi_controller);
+        }
     } else if (this->midi_controller != NULL) {
         if (is_logarithmic()) {
-            process_midi_controller_events<true>();
+            process_midi_controller_events<true>(*this->midi_controller);
         } else {
-            process_midi_controller_events<false>();
+            process_midi_controller_events<false>(*this->midi_controller);
         }
     } else if (this->macro != NULL) {
         process_macro(sample_count);
@@ -2250,22 +2384,23 @@ Sample const* const* FloatParam<evaluation>::process_lfo(
 
 template<ParamEvaluation evaluation>
 template<bool is_logarithmic_>
-void FloatParam<evaluation>::process_midi_controller_events() noexcept
-{
+void FloatParam<evaluation>::process_midi_controller_events(
+        MidiController const& midi_controller
+) noexcept {
     Queue<SignalProducer::Event>::SizeType const number_of_ctl_events = (
-        this->midi_controller->events.length()
+        midi_controller.events.length()
     );
 
     if (number_of_ctl_events == 0) {
         return;
     }
 
-    this->cancel_events_at(this->midi_controller->events[0].time_offset);
+    this->cancel_events_at(midi_controller.events[0].time_offset);
 
     if (should_round) {
         for (Queue<SignalProducer::Event>::SizeType i = 0; i != number_of_ctl_events; ++i) {
-            Seconds const time_offset = this->midi_controller->events[i].time_offset;
-            Number const controller_value = this->midi_controller->events[i].number_param_1;
+            Seconds const time_offset = midi_controller.events[i].time_offset;
+            Number const controller_value = midi_controller.events[i].number_param_1;
 
             if constexpr (is_logarithmic_) {
                 schedule_value(time_offset, ratio_to_value_log(controller_value));
@@ -2285,13 +2420,13 @@ void FloatParam<evaluation>::process_midi_controller_events() noexcept
     Number previous_ratio = value_to_ratio(this->get_raw_value());
 
     for (Queue<SignalProducer::Event>::SizeType i = 0; i != number_of_ctl_events; ++i) {
-        Seconds time_offset = this->midi_controller->events[i].time_offset;
+        Seconds time_offset = midi_controller.events[i].time_offset;
 
         while (i != last_ctl_event_index) {
             ++i;
 
             Seconds const delta = std::fabs(
-                this->midi_controller->events[i].time_offset - time_offset
+                midi_controller.events[i].time_offset - time_offset
             );
 
             if (delta >= MIDI_CTL_SMALL_CHANGE_DURATION) {
@@ -2300,10 +2435,10 @@ void FloatParam<evaluation>::process_midi_controller_events() noexcept
             }
         }
 
-        time_offset = this->midi_controller->events[i].time_offset;
+        time_offset = midi_controller.events[i].time_offset;
 
         Number const controller_value = (
-            this->midi_controller->events[i].number_param_1
+            midi_controller.events[i].number_param_1
         );
         Seconds const duration = smooth_change_duration(
             previous_ratio,
@@ -2336,6 +2471,16 @@ void FloatParam<evaluation>::process_macro(Integer const sample_count) noexcept
 
     this->macro_change_index = new_change_index;
 
+    if (!this->macro->events.is_empty()) {
+        if (is_logarithmic()) {
+            process_midi_controller_events<true>(*this->macro);
+        } else {
+            process_midi_controller_events<false>(*this->macro);
+        }
+
+        return;
+    }
+
     this->cancel_events_at(0.0);
 
     Number const macro_value = this->macro->get_value();
@@ -2407,6 +2552,8 @@ void FloatParam<evaluation>::render(
     LFO* const lfo = get_lfo();
 
     if (lfo != NULL) {
+        invalidate_envelope_render_cache(first_sample_index, last_sample_index);
+
         if (envelope_state != NULL && envelope_state->lfo_has_envelope) {
             render_with_lfo_envelope(
                 *lfo, round, first_sample_index, last_sample_index, buffer[0]
@@ -2415,10 +2562,12 @@ void FloatParam<evaluation>::render(
             render_with_lfo(round, first_sample_index, last_sample_index, buffer);
         }
     } else if (is_ramping()) {
+        invalidate_envelope_render_cache(first_sample_index, last_sample_index);
         render_linear_ramp(round, first_sample_index, last_sample_index, buffer);
     } else if (get_envelope() != NULL) {
         render_with_envelope(round, first_sample_index, last_sample_index, buffer);
     } else {
+        invalidate_envelope_render_cache(first_sample_index, last_sample_index);
         Param<Number, evaluation>::render(
             round, first_sample_index, last_sample_index, buffer
         );
@@ -2495,10 +2644,18 @@ void FloatParam<evaluation>::render_linear_ramp(
     Sample sample;
 
     if (linear_ramp_state.is_logarithmic) {
-        for (Integer i = first_sample_index; i != last_sample_index; ++i) {
-            buffer[0][i] = sample = (
-                (Sample)ratio_to_value_log(linear_ramp_state.advance())
-            );
+        Integer const ramp_end_index = render_log_ramp(
+            first_sample_index, last_sample_index, buffer[0]
+        );
+
+        if (ramp_end_index != last_sample_index) {
+            sample = (Sample)ratio_to_value_log(linear_ramp_state.target_value);
+
+            for (Integer i = ramp_end_index; i != last_sample_index; ++i) {
+                buffer[0][i] = sample;
+            }
+        } else if (last_sample_index != first_sample_index) {
+            sample = buffer[0][last_sample_index - 1];
         }
     } else {
         for (Integer i = first_sample_index; i != last_sample_index; ++i) {
@@ -2522,6 +2679,7 @@ void FloatParam<evaluation>::render_with_envelope(
     JS80P_ASSERT(envelope_state != NULL);
 
     if (envelope_state->active_snapshot_id == INVALID_ENVELOPE_SNAPSHOT_ID) {
+        invalidate_envelope_render_cache(first_sample_index, last_sample_index);
         Param<Number, evaluation>::render(
             round, first_sample_index, last_sample_index, buffer
         );
@@ -2531,21 +2689,73 @@ void FloatParam<evaluation>::render_with_envelope(
 
     Sample* buffer_ = buffer[0];
     Sample ratio = value_to_ratio(this->get_raw_value());
+    EnvelopeSnapshot const& snapshot = envelope_state->get_active_snapshot();
 
-    Envelope::render<Envelope::RenderingMode::OVERWRITE>(
-        envelope_state->get_active_snapshot(),
-        envelope_state->time,
-        envelope_state->stage,
-        envelope_state->is_constant,
-        ratio,
-        this->sample_rate,
-        this->sampling_period,
-        first_sample_index,
-        last_sample_index,
-        buffer_
+    /*
+    Only the followers share a buffer, so caching makes no sense for a param
+    which doesn't have a leader.
+    */
+    EnvelopeRenderCache* const cache = (
+        leader == NULL ? NULL : leader->envelope_render_cache
     );
 
-    ratios_to_values(buffer_, first_sample_index, last_sample_index);
+    if (
+            cache != NULL
+            && cache->matches(
+                round,
+                first_sample_index,
+                last_sample_index,
+                snapshot,
+                envelope_state->time,
+                envelope_state->stage,
+                ratio
+            )
+    ) {
+        envelope_state->time = cache->time_after;
+        envelope_state->stage = cache->stage_after;
+        envelope_state->is_constant = cache->is_constant_after;
+        ratio = cache->ratio_after;
+
+#ifdef JS80P_ASSERTIONS
+        ++cache->hits;
+#endif
+    } else {
+        invalidate_envelope_render_cache();
+
+        Seconds const time_before = envelope_state->time;
+        EnvelopeStage const stage_before = envelope_state->stage;
+        Number const ratio_before = ratio;
+
+        Envelope::render<Envelope::RenderingMode::OVERWRITE>(
+            snapshot,
+            envelope_state->time,
+            envelope_state->stage,
+            envelope_state->is_constant,
+            ratio,
+            this->sample_rate,
+            this->sampling_period,
+            first_sample_index,
+            last_sample_index,
+            buffer_
+        );
+
+        ratios_to_values(buffer_, first_sample_index, last_sample_index);
+
+        if (cache != NULL) {
+            cache->snapshot = snapshot;
+            cache->time_before = time_before;
+            cache->time_after = envelope_state->time;
+            cache->ratio_before = ratio_before;
+            cache->ratio_after = ratio;
+            cache->round = round;
+            cache->first_sample_index = first_sample_index;
+            cache->last_sample_index = last_sample_index;
+            cache->stage_before = stage_before;
+            cache->stage_after = envelope_state->stage;
+            cache->is_constant_after = envelope_state->is_constant;
+            cache->is_valid = true;
+        }
+    }
 
     if (is_ratio_same_as_value) {
         this->store_new_value(ratio);
@@ -2563,6 +2773,99 @@ void FloatParam<evaluation>::render_with_envelope(
 }
 
 
+template<ParamEvaluation evaluation>
+void FloatParam<evaluation>::invalidate_envelope_render_cache() noexcept
+{
+    EnvelopeRenderCache* const cache = (
+        leader == NULL ? envelope_render_cache : leader->envelope_render_cache
+    );
+
+    if (cache != NULL) {
+        cache->is_valid = false;
+    }
+}
+
+
+template<ParamEvaluation evaluation>
+void FloatParam<evaluation>::invalidate_envelope_render_cache(
+        Integer const first_sample_index,
+        Integer const last_sample_index
+) noexcept {
+    EnvelopeRenderCache* const cache = (
+        leader == NULL ? envelope_render_cache : leader->envelope_render_cache
+    );
+
+    /*
+    Followers often render a few samples without an envelope before the event
+    which starts their envelope, but that doesn't affect the block that the
+    previous follower has rendered after the same event.
+    */
+    if (
+            cache != NULL
+            && first_sample_index < cache->last_sample_index
+            && cache->first_sample_index < last_sample_index
+    ) {
+        cache->is_valid = false;
+    }
+}
+
+
+#ifdef JS80P_ASSERTIONS
+template<ParamEvaluation evaluation>
+Integer FloatParam<evaluation>::get_envelope_render_cache_hits() const noexcept
+{
+    EnvelopeRenderCache const* const cache = (
+        leader == NULL ? envelope_render_cache : leader->envelope_render_cache
+    );
+
+    return cache == NULL ? 0 : cache->hits;
+}
+#endif
+
+
+template<ParamEvaluation evaluation>
+FloatParam<evaluation>::EnvelopeRenderCache::EnvelopeRenderCache() noexcept
+    : time_before(0.0),
+    time_after(0.0),
+    ratio_before(0.0),
+    ratio_after(0.0),
+    round(-1),
+    first_sample_index(0),
+    last_sample_index(0),
+    stage_before(EnvelopeStage::ENV_STG_NONE),
+    stage_after(EnvelopeStage::ENV_STG_NONE),
+    is_constant_after(true),
+    is_valid(false)
+{
+#ifdef JS80P_ASSERTIONS
+    hits = 0;
+#endif
+}
+
+
+template<ParamEvaluation evaluation>
+bool FloatParam<evaluation>::EnvelopeRenderCache::matches(
+        Integer const round,
+        Integer const first_sample_index,
+        Integer const last_sample_index,
+        EnvelopeSnapshot const& snapshot,
+        Seconds const time,
+        EnvelopeStage const stage,
+        Number const ratio
+) const noexcept {
+    return (
+        is_valid
+        && this->round == round
+        && this->first_sample_index == first_sample_index
+        && this->last_sample_index == last_sample_index
+        && time_before == time
+        && stage_before == stage
+        && ratio_before == ratio
+        && this->snapshot == snapshot
+    );
+}
+
+
 template<ParamEvaluation evaluation>
 FloatParam<evaluation>::LinearRampState::LinearRampState() noexcept
     : start_time_offset(0.0),
@@ -2861,6 +3164,9 @@ void ModulatableFloatParam<ModulatorSignalProducerClass>::render(
         return;
     }
 
+    /* The envelope block in the shared buffer is about to be modified. */
+    this->invalidate_envelope_render_cache();
+
     Sample const* mod = modulator_buffer;
     Sample const* mod_level = modulation_level_buffer;
 
@@ -2888,6 +3194,17 @@ void ModulatableFloatParam<ModulatorSignalProducerClass>::set_random_seed(
 }
 
 
+template<class ModulatorSignalProducerClass>
+void ModulatableFloatParam<ModulatorSignalProducerClass>::set_channel(
+        Seconds const time_offset,
+        Byte const channel
+) noexcept {
+    FloatParamS::set_channel(time_offset, channel);
+
+    modulation_level.set_channel(time_offset, channel);
+}
+
+
 template<class ModulatorSignalProducerClass>
 void ModulatableFloatParam<ModulatorSignalProducerClass>::start_envelope(
         Seconds const time_offset,
@@ -207,6 +207,8 @@ class EnvelopeSnapshot
         EnvelopeSnapshot& operator=(EnvelopeSnapshot const& snapshot) noexcept = default;
         EnvelopeSnapshot& operator=(EnvelopeSnapshot&& snapshot) noexcept = default;
 
+        bool operator==(EnvelopeSnapshot const& snapshot) const noexcept;
+
         Number initial_value;
         Number peak_value;
         Number sustain_value;
@@ -441,6 +443,19 @@ class FloatParam : public Param<Number, evaluation>
 
         bool is_polyphonic() const noexcept;
 
+        /**
+         * \brief Make a follower evaluate the per-channel counterpart of its
+         *        leader's MIDI controller for the given channel, instead of
+         *        using the leader's buffer (e.g. for MIDI Polyphonic
+         *        Expression), starting at the given time offset. Has no
+         *        effect while the leader's controller has no per-channel
+         *        counterparts.
+         *
+         * \note Use \c MidiController::INVALID_CHANNEL to follow the leader
+         *       again.
+         */
+        void set_channel(Seconds const time_offset, Byte const channel) noexcept;
+
         void start_envelope(
             Seconds const time_offset,
             Number const random_1,
@@ -458,6 +473,15 @@ class FloatParam : public Param<Number, evaluation>
 
         virtual void reset() noexcept override;
 
+#ifdef JS80P_ASSERTIONS
+        /**
+         * \brief Number of times when a follower could reuse the envelope
+         *        block that was rendered into the leader's buffer by another
+         *        follower.
+         */
+        Integer get_envelope_render_cache_hits() const noexcept;
+#endif
+
     protected:
         Sample const* const* initialize_rendering(
             Integer const round,
@@ -475,6 +499,13 @@ class FloatParam : public Param<Number, evaluation>
 
         bool should_update_envelope(Envelope const& envelope) const noexcept;
 
+        void invalidate_envelope_render_cache() noexcept;
+
+        void invalidate_envelope_render_cache(
+            Integer const first_sample_index,
+            Integer const last_sample_index
+        ) noexcept;
+
     private:
         class LinearRampState
         {
@@ -544,8 +575,56 @@ class FloatParam : public Param<Number, evaluation>
                 bool lfo_has_envelope;
         };
 
+        /**
+         * \brief Polyphonic voices which are triggered at the same time with
+         *        the same envelope settings would render identical envelope
+         *        blocks into the leader's buffer. The leader remembers the
+         *        inputs and the outputs of the envelope rendering that
+         *        produced the current contents of its buffer, so that the
+         *        followers can skip rendering the same block again.
+         */
+        class EnvelopeRenderCache
+        {
+            public:
+                EnvelopeRenderCache() noexcept;
+
+                bool matches(
+                    Integer const round,
+                    Integer const first_sample_index,
+                    Integer const last_sample_index,
+                    EnvelopeSnapshot const& snapshot,
+                    Seconds const time,
+                    EnvelopeStage const stage,
+                    Number const ratio
+                ) const noexcept;
+
+                EnvelopeSnapshot snapshot;
+                Seconds time_before;
+                Seconds time_after;
+                Number ratio_before;
+                Number ratio_after;
+                Integer round;
+                Integer first_sample_index;
+                Integer last_sample_index;
+                EnvelopeStage stage_before;
+                EnvelopeStage stage_after;
+                bool is_constant_after;
+                bool is_valid;
+
+#ifdef JS80P_ASSERTIONS
+                Integer hits;
+#endif
+        };
+
         static constexpr Integer INVALID_ENVELOPE_SNAPSHOT_ID = -1;
 
+        /*
+        Logarithmic ramps are rendered as a geometric progression which is
+        re-anchored to the exact value at the start of every chunk, so that
+        rounding errors cannot accumulate.
+        */
+        static constexpr Integer LOG_RAMP_CHUNK_SIZE = 16;
+
         void initialize_instance() noexcept;
 
         Number round_value(Number const value) const noexcept;
@@ -587,6 +666,8 @@ class FloatParam : public Param<Number, evaluation>
 
         bool is_following_leader() const noexcept;
 
+        MidiController* get_channel_midi_controller() const noexcept;
+
         Sample const* const* process_lfo(
             LFO& lfo,
             Integer const round,
@@ -594,7 +675,9 @@ class FloatParam : public Param<Number, evaluation>
         ) noexcept;
 
         template<bool is_logarithmic_>
-        void process_midi_controller_events() noexcept;
+        void process_midi_controller_events(
+            MidiController const& midi_controller
+        ) noexcept;
 
         void process_macro(Integer const sample_count) noexcept;
 
@@ -640,6 +723,12 @@ class FloatParam : public Param<Number, evaluation>
             Sample** buffer
         ) noexcept;
 
+        Integer render_log_ramp(
+            Integer const first_sample_index,
+            Integer const last_sample_index,
+            Sample* buffer
+        ) noexcept;
+
         void render_with_envelope(
             Integer const round,
             Integer const first_sample_index,
@@ -688,6 +777,7 @@ class FloatParam : public Param<Number, evaluation>
         FloatParam<evaluation>* const leader;
         Envelope* const* const envelopes;
         EnvelopeState* const envelope_state;
+        EnvelopeRenderCache* const envelope_render_cache;
         Number const round_to;
         Number const round_to_inv;
         ToggleParam const* const log_scale_toggle;
@@ -707,6 +797,7 @@ class FloatParam : public Param<Number, evaluation>
         Envelope* envelope;
         Integer constantness_round;
         SignalProducer::Event::Type latest_event_type;
+        Byte channel;
         bool constantness;
 };
 
@@ -751,6 +842,7 @@ class ModulatableFloatParam : public FloatParamS
         void skip_round(Integer const round, Integer const sample_count) noexcept;
 
         void set_random_seed(Number const seed) noexcept;
+        void set_channel(Seconds const time_offset, Byte const channel) noexcept;
 
         void start_envelope(
             Seconds const time_offset,
@@ -308,6 +308,33 @@ void Reverb<InputSignalProducerClass>::reset() noexcept
 }
 
 
+template<class InputSignalProducerClass>
+void Reverb<InputSignalProducerClass>::use_delay_buffer_pool(
+        DelayBufferPool& delay_buffer_pool
+) noexcept {
+    for (Integer i = 0; i != COMB_FILTERS; ++i) {
+        comb_filters[i].delay.use_delay_buffer_pool(delay_buffer_pool);
+    }
+}
+
+
+template<class InputSignalProducerClass>
+bool Reverb<InputSignalProducerClass>::is_tail_silent() const noexcept
+{
+    if (this->is_compressing()) {
+        return false;
+    }
+
+    for (Integer i = 0; i != COMB_FILTERS; ++i) {
+        if (!comb_filters[i].delay.is_delay_buffer_silent()) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
 template<class InputSignalProducerClass>
 Sample const* const* Reverb<InputSignalProducerClass>::initialize_rendering(
         Integer const round,
@@ -320,6 +347,10 @@ Sample const* const* Reverb<InputSignalProducerClass>::initialize_rendering(
     );
 
     if (buffer != NULL) {
+        for (Integer i = 0; i != COMB_FILTERS; ++i) {
+            comb_filters[i].delay.release_delay_buffer();
+        }
+
         return buffer;
     }
 
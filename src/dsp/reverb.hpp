@@ -79,6 +79,19 @@ class Reverb : public SideChainCompressableEffect<InputSignalProducerClass>
 
         virtual void reset() noexcept override;
 
+        /**
+         * \brief Lease the delay buffers from the given pool only while the
+         *        effect is in use.
+         */
+        void use_delay_buffer_pool(DelayBufferPool& delay_buffer_pool) noexcept;
+
+        /**
+         * \brief Tell whether the effect has nothing left to render from the
+         *        signal that it has received so far.
+         */
+        bool is_tail_silent() const noexcept;
+
+
         TypeParam type;
         FloatParamS room_size;
         FloatParamS room_reflectivity;
@@ -37,21 +37,68 @@ SideChainCompressableEffect<InputSignalProducerClass>::SideChainCompressableEffe
 ) : Effect<InputSignalProducerClass>(
         name,
         input,
-        number_of_children + 5,
+        number_of_children + 4,
         buffer_owner
     ),
     side_chain_compression_threshold(name + "CTH", -120.0, 0.0, -18.0),
     side_chain_compression_attack_time(name + "CAT", 0.001, 3.0, 0.02),
     side_chain_compression_release_time(name + "CRL", 0.001, 3.0, 0.20),
     side_chain_compression_ratio(name + "CR", 1.0, 120.0, NO_OP_RATIO),
-    gain(name + "G", 0.0, 1.0, BYPASS_GAIN),
-    previous_action(Action::BYPASS_OR_RELEASE)
+    gain_buffer_rw(NULL),
+    gain_buffer(NULL),
+    previous_action(Action::BYPASS_OR_RELEASE),
+    is_bypassing(true)
 {
     this->register_child(side_chain_compression_threshold);
     this->register_child(side_chain_compression_attack_time);
     this->register_child(side_chain_compression_release_time);
     this->register_child(side_chain_compression_ratio);
-    this->register_child(gain);
+
+    gain_buffer_rw = new Sample[this->block_size];
+
+    fast_bypass();
+}
+
+
+template<class InputSignalProducerClass>
+SideChainCompressableEffect<InputSignalProducerClass>::~SideChainCompressableEffect()
+{
+    delete[] gain_buffer_rw;
+
+    gain_buffer_rw = NULL;
+}
+
+
+template<class InputSignalProducerClass>
+void SideChainCompressableEffect<InputSignalProducerClass>::set_block_size(
+        Integer const new_block_size
+) noexcept {
+    Integer const old_block_size = this->block_size;
+
+    Effect<InputSignalProducerClass>::set_block_size(new_block_size);
+
+    if (old_block_size != new_block_size) {
+        delete[] gain_buffer_rw;
+
+        gain_buffer_rw = new Sample[new_block_size];
+    }
+}
+
+
+template<class InputSignalProducerClass>
+void SideChainCompressableEffect<InputSignalProducerClass>::reset() noexcept
+{
+    Effect<InputSignalProducerClass>::reset();
+
+    peak_tracker.reset();
+    fast_bypass();
+}
+
+
+template<class InputSignalProducerClass>
+bool SideChainCompressableEffect<InputSignalProducerClass>::is_compressing() const noexcept
+{
+    return !is_bypassing;
 }
 
 
@@ -67,7 +114,6 @@ Sample const* const* SideChainCompressableEffect<InputSignalProducerClass>::init
     );
 
     if (buffer != NULL) {
-        FloatParamS::produce_if_not_constant(gain, round, sample_count);
         fast_bypass();
 
         return buffer;
@@ -75,34 +121,56 @@ Sample const* const* SideChainCompressableEffect<InputSignalProducerClass>::init
 
     Number const ratio_value = side_chain_compression_ratio.get_value();
 
-    is_bypassing = this->is_dry || Math::is_close(ratio_value, NO_OP_RATIO);
-
-    if (is_bypassing) {
+    if (this->is_dry || Math::is_close(ratio_value, NO_OP_RATIO)) {
         fast_bypass();
-    } else {
-        Number const threshold_db = side_chain_compression_threshold.get_value();
 
-        Sample peak;
-        Integer peak_index;
+        return NULL;
+    }
 
-        SignalProducer::find_peak(
-            this->input_buffer, this->channels, sample_count, peak, peak_index
+    Number const threshold_db = side_chain_compression_threshold.get_value();
+    Sample const* const* const input_buffer = this->input_buffer;
+    Integer const channels = this->channels;
+    Seconds const sampling_period = this->sampling_period;
+    Sample const initial_gain_value = gain_value;
+    bool is_gain_constant = true;
+
+    for (Integer chunk_start = 0; chunk_start < sample_count; chunk_start += CHUNK_SIZE) {
+        Integer const chunk_end = std::min(chunk_start + CHUNK_SIZE, sample_count);
+
+        peak_tracker.update(
+            SignalProducer::find_abs_max(
+                input_buffer, channels, chunk_start, chunk_end
+            ),
+            0,
+            chunk_end - chunk_start,
+            sampling_period
         );
-        peak_tracker.update(peak, peak_index, sample_count, this->sampling_period);
-        peak = peak_tracker.get_peak();
 
+        Sample const peak = peak_tracker.get_peak();
         Number const diff_db = Math::linear_to_db(peak) - threshold_db;
 
         if (diff_db > 0.0) {
             compress(peak, threshold_db, diff_db, ratio_value);
         } else if (previous_action == Action::COMPRESS) {
             release();
-        } else if (Math::is_close(gain.get_value(), BYPASS_GAIN)) {
-            fast_bypass();
+        } else if (Math::is_close(gain_value, BYPASS_GAIN)) {
+            gain_value = BYPASS_GAIN;
+            gain_target = BYPASS_GAIN;
+            gain_delta = 0.0;
         }
+
+        is_gain_constant = is_gain_constant && gain_delta == 0.0;
+
+        render_gain_envelope(chunk_start, chunk_end);
     }
 
-    gain_buffer = FloatParamS::produce_if_not_constant(gain, round, sample_count);
+    is_gain_constant = is_gain_constant && gain_value == initial_gain_value;
+    is_bypassing = (
+        is_gain_constant
+        && gain_value == BYPASS_GAIN
+        && previous_action != Action::COMPRESS
+    );
+    gain_buffer = is_gain_constant ? NULL : gain_buffer_rw;
 
     return NULL;
 }
@@ -111,8 +179,10 @@ Sample const* const* SideChainCompressableEffect<InputSignalProducerClass>::init
 template<class InputSignalProducerClass>
 void SideChainCompressableEffect<InputSignalProducerClass>::fast_bypass() noexcept
 {
-    gain.cancel_events_at(0.0);
-    gain.set_value(BYPASS_GAIN);
+    gain_value = BYPASS_GAIN;
+    gain_target = BYPASS_GAIN;
+    gain_delta = 0.0;
+    gain_buffer = NULL;
     previous_action = Action::BYPASS_OR_RELEASE;
     is_bypassing = true;
 }
@@ -132,12 +202,11 @@ void SideChainCompressableEffect<InputSignalProducerClass>::compress(
         peak > 0.000001 ? std::min(BYPASS_GAIN, new_peak / peak) : BYPASS_GAIN
     );
 
-    gain.cancel_events_at(0.0);
-
-    if (!Math::is_close(gain.get_value(), target_gain, 0.005)) {
-        Seconds const attack_time = side_chain_compression_attack_time.get_value();
-
-        gain.schedule_linear_ramp(attack_time, target_gain);
+    if (Math::is_close(gain_value, target_gain, 0.005)) {
+        gain_target = gain_value;
+        gain_delta = 0.0;
+    } else {
+        ramp_gain_to(target_gain, side_chain_compression_attack_time.get_value());
     }
 
     previous_action = Action::COMPRESS;
@@ -147,14 +216,69 @@ void SideChainCompressableEffect<InputSignalProducerClass>::compress(
 template<class InputSignalProducerClass>
 void SideChainCompressableEffect<InputSignalProducerClass>::release() noexcept
 {
-    Seconds const release_time = side_chain_compression_release_time.get_value();
-
-    gain.cancel_events_at(0.0);
-    gain.schedule_linear_ramp(release_time, BYPASS_GAIN);
+    ramp_gain_to(BYPASS_GAIN, side_chain_compression_release_time.get_value());
     previous_action = Action::BYPASS_OR_RELEASE;
 }
 
 
+template<class InputSignalProducerClass>
+void SideChainCompressableEffect<InputSignalProducerClass>::ramp_gain_to(
+        Sample const target,
+        Seconds const duration
+) noexcept {
+    Number const duration_in_samples = std::max(
+        1.0, (Number)duration * (Number)this->sample_rate
+    );
+
+    gain_target = target;
+    gain_delta = (target - gain_value) / duration_in_samples;
+}
+
+
+template<class InputSignalProducerClass>
+void SideChainCompressableEffect<InputSignalProducerClass>::render_gain_envelope(
+        Integer const first_sample_index,
+        Integer const last_sample_index
+) noexcept {
+    Sample* const gain_buffer = gain_buffer_rw;
+    Sample const gain_value = this->gain_value;
+    Sample const gain_target = this->gain_target;
+    Sample const gain_delta = this->gain_delta;
+
+    if (gain_delta == 0.0) {
+        std::fill_n(
+            &gain_buffer[first_sample_index],
+            last_sample_index - first_sample_index,
+            gain_value
+        );
+
+        return;
+    }
+
+    Sample const start = gain_value - (Sample)first_sample_index * gain_delta;
+
+    if (gain_delta > 0.0) {
+        for (Integer i = first_sample_index; i != last_sample_index; ++i) {
+            gain_buffer[i] = std::min(
+                gain_target, start + (Sample)(i + 1) * gain_delta
+            );
+        }
+    } else {
+        for (Integer i = first_sample_index; i != last_sample_index; ++i) {
+            gain_buffer[i] = std::max(
+                gain_target, start + (Sample)(i + 1) * gain_delta
+            );
+        }
+    }
+
+    this->gain_value = gain_buffer[last_sample_index - 1];
+
+    if (this->gain_value == gain_target) {
+        this->gain_delta = 0.0;
+    }
+}
+
+
 template<class InputSignalProducerClass>
 void SideChainCompressableEffect<InputSignalProducerClass>::render(
         Integer const round,
@@ -183,7 +307,7 @@ void SideChainCompressableEffect<InputSignalProducerClass>::render(
             Sample const dry_level = this->dry.get_value();
 
             if (gain_buffer == NULL) {
-                Sample const gain_value = wet_level * gain.get_value();
+                Sample const gain_value = wet_level * this->gain_value;
 
                 for (Integer c = 0; c != channels; ++c) {
                     for (Integer i = first_sample_index; i != last_sample_index; ++i) {
@@ -203,7 +327,7 @@ void SideChainCompressableEffect<InputSignalProducerClass>::render(
                 }
             }
         } else if (gain_buffer == NULL) {
-            Sample const gain_value = wet_level * gain.get_value();
+            Sample const gain_value = wet_level * this->gain_value;
 
             for (Integer c = 0; c != channels; ++c) {
                 for (Integer i = first_sample_index; i != last_sample_index; ++i) {
@@ -227,7 +351,7 @@ void SideChainCompressableEffect<InputSignalProducerClass>::render(
         Sample const dry_level = this->dry.get_value();
 
         if (gain_buffer == NULL) {
-            Sample const gain_value = gain.get_value();
+            Sample const gain_value = this->gain_value;
 
             for (Integer c = 0; c != channels; ++c) {
                 for (Integer i = first_sample_index; i != last_sample_index; ++i) {
@@ -248,7 +372,7 @@ void SideChainCompressableEffect<InputSignalProducerClass>::render(
             }
         }
     } else if (gain_buffer == NULL) {
-        Sample const gain_value = gain.get_value();
+        Sample const gain_value = this->gain_value;
 
         for (Integer c = 0; c != channels; ++c) {
             for (Integer i = first_sample_index; i != last_sample_index; ++i) {
@@ -45,6 +45,13 @@ class SideChainCompressableEffect : public Effect<InputSignalProducerClass>
             SignalProducer* const buffer_owner = NULL
         );
 
+        virtual ~SideChainCompressableEffect();
+
+        virtual void set_block_size(Integer const new_block_size) noexcept override;
+        virtual void reset() noexcept override;
+
+        bool is_compressing() const noexcept;
+
         FloatParamB side_chain_compression_threshold;
         FloatParamB side_chain_compression_attack_time;
         FloatParamB side_chain_compression_release_time;
@@ -72,6 +79,13 @@ class SideChainCompressableEffect : public Effect<InputSignalProducerClass>
         static constexpr Number NO_OP_RATIO = 1.0;
         static constexpr Number BYPASS_GAIN = 1.0;
 
+        /*
+        The side-chain signal is analyzed in chunks of this many samples, and
+        the gain envelope may change its course at the chunk boundaries, so
+        that the attack can start in the middle of a long block.
+        */
+        static constexpr Integer CHUNK_SIZE = 32;
+
         void fast_bypass() noexcept;
 
         void compress(
@@ -83,9 +97,19 @@ class SideChainCompressableEffect : public Effect<InputSignalProducerClass>
 
         void release() noexcept;
 
-        FloatParamS gain;
+        void ramp_gain_to(Sample const target, Seconds const duration) noexcept;
+
+        void render_gain_envelope(
+            Integer const first_sample_index,
+            Integer const last_sample_index
+        ) noexcept;
+
         PeakTracker peak_tracker;
+        Sample* gain_buffer_rw;
         Sample const* gain_buffer;
+        Sample gain_value;
+        Sample gain_target;
+        Sample gain_delta;
         Action previous_action;
         bool is_bypassing;
 };
@@ -20,6 +20,7 @@
 #define JS80P__DSP__SIGNAL_PRODUCER_CPP
 
 #include <algorithm>
+#include <cmath>
 
 #include "dsp/signal_producer.hpp"
 
@@ -107,12 +108,32 @@ void SignalProducer::find_peak(
         }
     }
 
-    if (peak > 1000.0) {
-        peak = 1000.0;
+    if (peak > PEAK_MAX) {
+        peak = PEAK_MAX;
     }
 }
 
 
+Sample SignalProducer::find_abs_max(
+        Sample const* const* samples,
+        Integer const channels,
+        Integer const first_sample_index,
+        Integer const last_sample_index
+) noexcept {
+    Sample peak = 0.0;
+
+    for (Integer c = 0; c != channels; ++c) {
+        Sample const* const channel = samples[c];
+
+        for (Integer i = first_sample_index; i != last_sample_index; ++i) {
+            peak = std::max(peak, std::fabs(channel[i]));
+        }
+    }
+
+    return std::min(peak, PEAK_MAX);
+}
+
+
 SignalProducer::SignalProducer(
         Integer const channels,
         Integer const number_of_children,
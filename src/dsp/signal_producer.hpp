@@ -76,6 +76,13 @@ class SignalProducer
             std::exp(SILENCE_THRESHOLD_DB * std::log(2.0) / 6.0)
         );
 
+        /*
+        Peaks are capped, because they are usually converted to decibels via
+        Math::linear_to_db() which turns its argument into a table index, and
+        converting an infinite or huge value to int is undefined behaviour.
+        */
+        static constexpr Sample PEAK_MAX = 1000.0;
+
         /*
         Default to 60, so that 1 beat = 1 second, so when no BPM info is
         available, then toggling tempo-sync becomes no-op.
@@ -125,6 +132,20 @@ class SignalProducer
             Integer& peak_index
         ) noexcept;
 
+        /**
+         * \brief Find the largest absolute value among the samples of all
+         *        channels in the given range. Unlike \c find_peak(), this
+         *        doesn't track where the peak is, so the compiler can turn it
+         *        into a vectorized reduction. Like \c find_peak(), it caps
+         *        the result at \c PEAK_MAX.
+         */
+        static Sample find_abs_max(
+            Sample const* const* samples,
+            Integer const channels,
+            Integer const first_sample_index,
+            Integer const last_sample_index
+        ) noexcept;
+
         explicit SignalProducer(
             Integer const channels,
             Integer const number_of_children = 0,
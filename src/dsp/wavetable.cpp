@@ -145,6 +145,10 @@ void Wavetable::normalize() noexcept
         }
     }
 
+    if (max < 0.000001) {
+        return;
+    }
+
     for (Integer i = 0; i != partials; ++i) {
         for (Integer j = 0; j != SIZE; ++j) {
             samples[i][j] /= max;
@@ -454,11 +458,18 @@ Wavetable const* StandardWaveforms::soft_square() noexcept
 }
 
 
+Wavetable const* StandardWaveforms::silence() noexcept
+{
+    return standard_waveforms.silence_wt;
+}
+
+
 StandardWaveforms::StandardWaveforms() noexcept
 {
     Wavetable::initialize();
 
     Number sine_coefficients[] = {1.0};
+    Number silence_coefficients[] = {0.0};
     Number sawtooth_coefficients[Wavetable::PARTIALS];
     Number soft_sawtooth_coefficients[Wavetable::SOFT_PARTIALS];
     Number inverse_sawtooth_coefficients[Wavetable::PARTIALS];
@@ -508,6 +519,7 @@ StandardWaveforms::StandardWaveforms() noexcept
     soft_square_wt = new Wavetable(
         soft_square_coefficients, Wavetable::SOFT_PARTIALS
     );
+    silence_wt = new Wavetable(silence_coefficients, 1);
 }
 
 
@@ -522,6 +534,7 @@ StandardWaveforms::~StandardWaveforms()
     delete soft_triangle_wt;
     delete square_wt;
     delete soft_square_wt;
+    delete silence_wt;
 
     sine_wt = NULL;
     sawtooth_wt = NULL;
@@ -532,6 +545,7 @@ StandardWaveforms::~StandardWaveforms()
     soft_triangle_wt = NULL;
     square_wt = NULL;
     soft_square_wt = NULL;
+    silence_wt = NULL;
 }
 
 }
@@ -195,6 +195,7 @@ class StandardWaveforms
         static Wavetable const* soft_triangle() noexcept;
         static Wavetable const* square() noexcept;
         static Wavetable const* soft_square() noexcept;
+        static Wavetable const* silence() noexcept;
 
         StandardWaveforms() noexcept;
         ~StandardWaveforms();
@@ -227,6 +228,7 @@ class StandardWaveforms
         Wavetable const* soft_triangle_wt;
         Wavetable const* square_wt;
         Wavetable const* soft_square_wt;
+        Wavetable const* silence_wt;
 };
 
 }
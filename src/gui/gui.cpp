@@ -19,6 +19,7 @@
 #define JS80P__GUI__GUI_CPP
 
 #include <algorithm>
+#include <cmath>
 #include <cstdio>
 #include <cstring>
 
@@ -1086,6 +1087,9 @@ char const* const GUI::PARAMS[Synth::ParamId::PARAM_ID_COUNT] = {
     [Synth::ParamId::CFX4] = "Carrier Fine Detune x4",
     [Synth::ParamId::EER1] = "Echo Delay 1 Reversed",
     [Synth::ParamId::EER2] = "Echo Delay 2 Reversed",
+    [Synth::ParamId::ELIM] = "Limiter",
+    [Synth::ParamId::MPE] = "MIDI Polyphonic Expression",
+    [Synth::ParamId::ZLAT] = "Zero Latency",
 };
 
 
@@ -1260,6 +1264,77 @@ void GUI::initialize_controllers_by_id()
 }
 
 
+std::mutex GUI::shared_images_mutex;
+
+GUI::SharedImages GUI::shared_images;
+
+
+GUI::SharedImage::SharedImage(std::string const& name, Image image)
+    : name(name),
+    image(image),
+    references(1)
+{
+}
+
+
+GUI::Image GUI::acquire_image(
+        WidgetBase* widget,
+        PlatformData platform_data,
+        char const* name
+) {
+    std::lock_guard<std::mutex> lock(shared_images_mutex);
+
+    for (SharedImages::iterator it = shared_images.begin(); it != shared_images.end(); ++it) {
+        if (it->name == name) {
+            ++it->references;
+
+            return it->image;
+        }
+    }
+
+    Image const image = widget->load_image(platform_data, name);
+
+    if (image != NULL) {
+        shared_images.push_back(SharedImage(name, image));
+    }
+
+    return image;
+}
+
+
+void GUI::release_image(WidgetBase* widget, Image image)
+{
+    if (image == NULL) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(shared_images_mutex);
+
+    for (SharedImages::iterator it = shared_images.begin(); it != shared_images.end(); ++it) {
+        if (it->image == image) {
+            --it->references;
+
+            if (it->references == 0) {
+                widget->delete_image(image);
+                shared_images.erase(it);
+            }
+
+            return;
+        }
+    }
+
+    widget->delete_image(image);
+}
+
+
+size_t GUI::get_shared_images_count()
+{
+    std::lock_guard<std::mutex> lock(shared_images_mutex);
+
+    return shared_images.size();
+}
+
+
 constexpr GUI::Color GUI::rgb(
         ColorComponent const red,
         ColorComponent const green,
@@ -1682,6 +1757,22 @@ constexpr int pos_rel_offset_top = 0;
         )                                                           \
     )
 
+#define TOGL(owner, left, top, w, h, box_left, param_id, label)     \
+    owner->own(                                                     \
+        new ToggleSwitchParamEditor(                                \
+            *this,                                                  \
+            GUI::PARAMS[param_id],                                  \
+            pos_rel_offset_left + left,                             \
+            pos_rel_offset_top + top,                               \
+            w,                                                      \
+            h,                                                      \
+            box_left,                                               \
+            synth,                                                  \
+            param_id,                                               \
+            label                                                   \
+        )                                                           \
+    )
+
 #define DPEI(owner, left, top, w, h, vleft, vwidth, param_id, imgs) \
     owner->own(                                                     \
         new DiscreteParamEditor(                                    \
@@ -1798,11 +1889,14 @@ GUI::GUI(
     synth_body(NULL),
     status_line(NULL),
     active_voices_count(0),
+    is_default_status_line_shown(true),
     synth(synth),
     platform_data(platform_data)
 {
     default_status_line[0] = '\x00';
+    synth.start_metering();
     update_active_voices_count();
+    refresh_params_snapshot();
 
     initialize();
 
@@ -1810,10 +1904,10 @@ GUI::GUI(
 
     knob_states = new ParamStateImages(
         dummy_widget,
-        dummy_widget->load_image(this->platform_data, "KNOBSTATESFREE"),
-        dummy_widget->load_image(this->platform_data, "KNOBSTATESCONTROLLED"),
+        acquire_image(dummy_widget, this->platform_data, "KNOBSTATESFREE"),
+        acquire_image(dummy_widget, this->platform_data, "KNOBSTATESCONTROLLED"),
         NULL,
-        dummy_widget->load_image(this->platform_data, "KNOBSTATESNONE"),
+        acquire_image(dummy_widget, this->platform_data, "KNOBSTATESNONE"),
         128,
         48,
         48
@@ -1821,9 +1915,9 @@ GUI::GUI(
 
     screw_states = new ParamStateImages(
         dummy_widget,
-        dummy_widget->load_image(this->platform_data, "SCREWSTATES"),
+        acquire_image(dummy_widget, this->platform_data, "SCREWSTATES"),
         NULL,
-        dummy_widget->load_image(this->platform_data, "SCREWSTATESSYNCED"),
+        acquire_image(dummy_widget, this->platform_data, "SCREWSTATESSYNCED"),
         NULL,
         61,
         SCREW_W,
@@ -1832,7 +1926,7 @@ GUI::GUI(
 
     envelope_shapes_01 = new ParamStateImages(
         dummy_widget,
-        dummy_widget->load_image(this->platform_data, "ENVSHAPES01"),
+        acquire_image(dummy_widget, this->platform_data, "ENVSHAPES01"),
         NULL,
         NULL,
         NULL,
@@ -1843,7 +1937,7 @@ GUI::GUI(
 
     envelope_shapes_10 = new ParamStateImages(
         dummy_widget,
-        dummy_widget->load_image(this->platform_data, "ENVSHAPES10"),
+        acquire_image(dummy_widget, this->platform_data, "ENVSHAPES10"),
         NULL,
         NULL,
         NULL,
@@ -1854,7 +1948,7 @@ GUI::GUI(
 
     macro_distortions = new ParamStateImages(
         dummy_widget,
-        dummy_widget->load_image(this->platform_data, "MACRODIST"),
+        acquire_image(dummy_widget, this->platform_data, "MACRODIST"),
         NULL,
         NULL,
         NULL,
@@ -1865,7 +1959,7 @@ GUI::GUI(
 
     macro_midpoint_states = new ParamStateImages(
         dummy_widget,
-        dummy_widget->load_image(this->platform_data, "MACROMID"),
+        acquire_image(dummy_widget, this->platform_data, "MACROMID"),
         NULL,
         NULL,
         NULL,
@@ -1876,7 +1970,7 @@ GUI::GUI(
 
     reversed_toggle_states = new ParamStateImages(
         dummy_widget,
-        dummy_widget->load_image(this->platform_data, "REVERSED"),
+        acquire_image(dummy_widget, this->platform_data, "REVERSED"),
         NULL,
         NULL,
         NULL,
@@ -1885,16 +1979,16 @@ GUI::GUI(
         18
     );
 
-    about_image = dummy_widget->load_image(this->platform_data, "ABOUT");
-    macros_1_image = dummy_widget->load_image(this->platform_data, "MACROS1");
-    macros_2_image = dummy_widget->load_image(this->platform_data, "MACROS2");
-    macros_3_image = dummy_widget->load_image(this->platform_data, "MACROS3");
-    effects_image = dummy_widget->load_image(this->platform_data, "EFFECTS");
-    envelopes_1_image = dummy_widget->load_image(this->platform_data, "ENVELOPES1");
-    envelopes_2_image = dummy_widget->load_image(this->platform_data, "ENVELOPES2");
-    lfos_image = dummy_widget->load_image(this->platform_data, "LFOS");
-    synth_image = dummy_widget->load_image(this->platform_data, "SYNTH");
-    vst_logo_image = dummy_widget->load_image(this->platform_data, "VSTLOGO");
+    about_image = acquire_image(dummy_widget, this->platform_data, "ABOUT");
+    macros_1_image = acquire_image(dummy_widget, this->platform_data, "MACROS1");
+    macros_2_image = acquire_image(dummy_widget, this->platform_data, "MACROS2");
+    macros_3_image = acquire_image(dummy_widget, this->platform_data, "MACROS3");
+    effects_image = acquire_image(dummy_widget, this->platform_data, "EFFECTS");
+    envelopes_1_image = acquire_image(dummy_widget, this->platform_data, "ENVELOPES1");
+    envelopes_2_image = acquire_image(dummy_widget, this->platform_data, "ENVELOPES2");
+    lfos_image = acquire_image(dummy_widget, this->platform_data, "LFOS");
+    synth_image = acquire_image(dummy_widget, this->platform_data, "SYNTH");
+    vst_logo_image = acquire_image(dummy_widget, this->platform_data, "VSTLOGO");
 
     background = new Background();
 
@@ -2641,6 +2735,7 @@ void GUI::build_effects_body(
     TOGG(effects_body, 381, 425, 136, 24,  0, Synth::ParamId::ERLOG);
 
     KNOB(effects_body, 905 + KNOB_W * 0,   453, Synth::ParamId::EV3V,   MML_C,      "%.2f", 100.0, knob_states);
+    TOGL(effects_body, 806, 425,  74, 24,  0, Synth::ParamId::ELIM, "LIMITER");
 
     effects_body->hide();
 }
@@ -3234,6 +3329,8 @@ void GUI::build_synth_body(ParamStateImages const* knob_states, ParamStateImages
     KNOB(synth_body,  87 + KNOB_W * 9,     316, Synth::ParamId::CWID,   MM___,      "%.2f", 100.0, knob_states);
     KNOB(synth_body,  87 + KNOB_W * 10,    316, Synth::ParamId::CPAN,   MMLEC,      "%.2f", 100.0, knob_states);
     TOGG(synth_body, 630, 287, 63, 24, 42, Synth::ParamId::CFX4);
+    TOGL(synth_body, 492, 287, 48, 24, 0, Synth::ParamId::MPE, "MPE");
+    TOGL(synth_body, 544, 287, 78, 24, 0, Synth::ParamId::ZLAT, "ZERO LAT");
     DPET(synth_body, 419, 288, 60, 21, 0, 60, Synth::ParamId::CDTYP, dt, dtc);
 
     KNOB(synth_body, 735 + KNOB_W * 0,     316, Synth::ParamId::CF1TYP, MM___,      ft, ftc, knob_states);
@@ -3272,6 +3369,8 @@ void GUI::build_synth_body(ParamStateImages const* knob_states, ParamStateImages
 
 GUI::~GUI()
 {
+    synth.stop_metering();
+
     delete parent_window;
 
     delete knob_states;
@@ -3282,16 +3381,16 @@ GUI::~GUI()
     delete macro_midpoint_states;
     delete reversed_toggle_states;
 
-    dummy_widget->delete_image(about_image);
-    dummy_widget->delete_image(macros_1_image);
-    dummy_widget->delete_image(macros_2_image);
-    dummy_widget->delete_image(macros_3_image);
-    dummy_widget->delete_image(effects_image);
-    dummy_widget->delete_image(envelopes_1_image);
-    dummy_widget->delete_image(envelopes_2_image);
-    dummy_widget->delete_image(lfos_image);
-    dummy_widget->delete_image(synth_image);
-    dummy_widget->delete_image(vst_logo_image);
+    release_image(dummy_widget, about_image);
+    release_image(dummy_widget, macros_1_image);
+    release_image(dummy_widget, macros_2_image);
+    release_image(dummy_widget, macros_3_image);
+    release_image(dummy_widget, effects_image);
+    release_image(dummy_widget, envelopes_1_image);
+    release_image(dummy_widget, envelopes_2_image);
+    release_image(dummy_widget, lfos_image);
+    release_image(dummy_widget, synth_image);
+    release_image(dummy_widget, vst_logo_image);
 
     delete dummy_widget;
 
@@ -3309,37 +3408,86 @@ void GUI::show()
 
 void GUI::update_active_voices_count()
 {
-    Integer const old_active_voices_count = active_voices_count;
+    char new_default_status_line[DEFAULT_STATUS_LINE_MAX_LENGTH];
+    Meter::Snapshot output_meter;
 
     active_voices_count = synth.get_active_voices_count();
 
-    if (active_voices_count == old_active_voices_count) {
+    if (!synth.get_meter_snapshot(Synth::MeterId::METER_OUT, output_meter)) {
+        /* The audio thread is busy publishing a new snapshot, try next time. */
         return;
     }
 
-    if (active_voices_count < 1) {
-        default_status_line[0] = '\x00';
-    } else {
+    Number const peak_db = (
+        output_meter.peak > 0.0
+            ? 20.0 * std::log10(output_meter.peak)
+            : Meter::MIN_LOUDNESS
+    );
+
+    if (peak_db > Meter::MIN_LOUDNESS) {
+        snprintf(
+            new_default_status_line,
+            DEFAULT_STATUS_LINE_MAX_LENGTH,
+            "Voices: %d / %d | Out: %.1f dB, %.1f LUFS",
+            (int)active_voices_count,
+            (int)Synth::POLYPHONY,
+            peak_db,
+            output_meter.loudness
+        );
+    } else if (active_voices_count > 0) {
         snprintf(
-            default_status_line,
+            new_default_status_line,
             DEFAULT_STATUS_LINE_MAX_LENGTH,
             "Voices: %d / %d",
             (int)active_voices_count,
             (int)Synth::POLYPHONY
         );
-        default_status_line[DEFAULT_STATUS_LINE_MAX_LENGTH - 1] = '\x00';
+    } else {
+        new_default_status_line[0] = '\x00';
+    }
+
+    new_default_status_line[DEFAULT_STATUS_LINE_MAX_LENGTH - 1] = '\x00';
+
+    if (strncmp(new_default_status_line, default_status_line, DEFAULT_STATUS_LINE_MAX_LENGTH) == 0) {
+        return;
     }
 
-    if (status_line != NULL) {
-        set_status_line(default_status_line);
+    strncpy(default_status_line, new_default_status_line, DEFAULT_STATUS_LINE_MAX_LENGTH);
+
+    if (status_line != NULL && is_default_status_line_shown) {
+        set_status_line("");
         redraw_status_line();
     }
 }
 
 
+void GUI::refresh_params_snapshot()
+{
+    /*
+    When the audio thread is busy publishing a new snapshot, then the widgets
+    keep showing the previous state until the next refresh.
+    */
+    synth.get_params_snapshot(params_snapshot);
+}
+
+
+Number GUI::get_param_ratio(Synth::ParamId const param_id) const
+{
+    return params_snapshot.ratios[param_id];
+}
+
+
+Synth::ControllerId GUI::get_param_controller_id(Synth::ParamId const param_id) const
+{
+    return (Synth::ControllerId)params_snapshot.controller_ids[param_id];
+}
+
+
 void GUI::set_status_line(char const* text)
 {
-    if (text[0] == '\x00') {
+    is_default_status_line_shown = text[0] == '\x00';
+
+    if (is_default_status_line_shown) {
         status_line->set_text(default_status_line);
     } else {
         status_line->set_text(text);
@@ -20,6 +20,8 @@
 #define JS80P__GUI__GUI_HPP
 
 #include <cstddef>
+#include <mutex>
+#include <string>
 #include <vector>
 
 #include "js80p.hpp"
@@ -188,6 +190,27 @@ class GUI
 
         static Color controller_id_to_bg_color(Synth::ControllerId const controller_id);
 
+        /**
+         * \brief Load the image with the given name, or if it's already
+         *        loaded by another GUI in the process, then return the same
+         *        image. Images are never modified after loading, so there's
+         *        no need to keep a separate copy for each plugin instance.
+         */
+        static Image acquire_image(
+            WidgetBase* widget,
+            PlatformData platform_data,
+            char const* name
+        );
+
+        /**
+         * \brief Delete the image when it is no longer in use by any of the
+         *        GUIs. Images which were not acquired via \c acquire_image()
+         *        are deleted immediately.
+         */
+        static void release_image(WidgetBase* widget, Image image);
+
+        static size_t get_shared_images_count();
+
         GUI(
             char const* sdk_version,
             PlatformData platform_data,
@@ -203,6 +226,16 @@ class GUI
 
         void update_active_voices_count();
 
+        /**
+         * \brief Take a new copy of the parameters of the synth, so that the
+         *        widgets can be refreshed from a consistent state without
+         *        reading each parameter separately.
+         */
+        void refresh_params_snapshot();
+
+        Number get_param_ratio(Synth::ParamId const param_id) const;
+        Synth::ControllerId get_param_controller_id(Synth::ParamId const param_id) const;
+
         void set_status_line(char const* text);
         void redraw_status_line();
 
@@ -211,7 +244,7 @@ class GUI
         PlatformData get_platform_data() const;
 
     private:
-        static constexpr size_t DEFAULT_STATUS_LINE_MAX_LENGTH = 32;
+        static constexpr size_t DEFAULT_STATUS_LINE_MAX_LENGTH = 64;
 
         static void initialize_controllers_by_id();
 
@@ -243,9 +276,24 @@ class GUI
             size_t const buffer_size
         );
 
+        class SharedImage
+        {
+            public:
+                SharedImage(std::string const& name, Image image);
+
+                std::string name;
+                Image image;
+                size_t references;
+        };
+
+        typedef std::vector<SharedImage> SharedImages;
+
         static Controller const* controllers_by_id[Synth::ControllerId::CONTROLLER_ID_COUNT];
         static bool controllers_by_id_initialized;
 
+        static std::mutex shared_images_mutex;
+        static SharedImages shared_images;
+
         void initialize();
         void destroy();
 
@@ -331,7 +379,9 @@ class GUI
         TabBody* lfos_body;
         TabBody* synth_body;
         StatusLine* status_line;
+        Synth::ParamsSnapshot params_snapshot;
         Integer active_voices_count;
+        bool is_default_status_line_shown;
 
         Synth& synth;
         JS80P::GUI::PlatformData platform_data;
@@ -194,6 +194,8 @@ void TabBody::stop_editing()
 
 void TabBody::refresh_controlled_knob_param_editors()
 {
+    gui->refresh_params_snapshot();
+
     for (GUI::KnobParamEditors::iterator it = knob_param_editors.begin(); it != knob_param_editors.end(); ++it) {
         KnobParamEditor* editor = *it;
 
@@ -206,6 +208,8 @@ void TabBody::refresh_controlled_knob_param_editors()
 
 void TabBody::refresh_all_params()
 {
+    gui->refresh_params_snapshot();
+
     for (GUI::KnobParamEditors::iterator it = knob_param_editors.begin(); it != knob_param_editors.end(); ++it) {
         (*it)->refresh();
     }
@@ -376,7 +380,7 @@ void ControllerSelector::select_controller(
         KnobParamEditor* knob_param_editor
 ) {
     Synth::ControllerId const selected_controller_id = (
-        synth.get_param_controller_id_atomic(param_id)
+        gui->get_param_controller_id(param_id)
     );
 
     GUI::Controller const* const controller = GUI::get_controller(
@@ -628,26 +632,26 @@ ParamStateImages::~ParamStateImages()
     if (free_image != NULL) {
         free_images = free_images_(free_images);
 
-        widget->delete_image(free_image);
+        GUI::release_image(widget, free_image);
         free_image = NULL;
     }
 
     if (controlled_image != NULL) {
         controlled_images = free_images_(controlled_images);
 
-        widget->delete_image(controlled_image);
+        GUI::release_image(widget, controlled_image);
         controlled_image = NULL;
     }
 
     if (synced_image != NULL) {
         synced_images = free_images_(synced_images);
 
-        widget->delete_image(synced_image);
+        GUI::release_image(widget, synced_image);
         synced_image = NULL;
     }
 
     if (none_image != NULL) {
-        widget->delete_image(none_image);
+        GUI::release_image(widget, none_image);
         none_image = NULL;
     }
 }
@@ -791,8 +795,8 @@ void KnobParamEditor::set_up(GUI::PlatformData platform_data, WidgetBase* parent
 
     own(knob);
     update_editor(
-        synth.get_param_ratio_atomic(param_id),
-        synth.get_param_controller_id_atomic(param_id),
+        gui->get_param_ratio(param_id),
+        gui->get_param_controller_id(param_id),
         should_be_scaled_x4()
     );
 }
@@ -817,9 +821,9 @@ void KnobParamEditor::refresh()
     }
 
     Synth::ControllerId const new_controller_id = (
-        synth.get_param_controller_id_atomic(param_id)
+        gui->get_param_controller_id(param_id)
     );
-    Number const new_ratio = synth.get_param_ratio_atomic(param_id);
+    Number const new_ratio = gui->get_param_ratio(param_id);
     bool const new_is_scaled_x4 = should_be_scaled_x4();
 
     has_controller_ = new_controller_id > Synth::Synth::ControllerId::NONE;
@@ -831,19 +835,6 @@ void KnobParamEditor::refresh()
             || new_is_scaled_x4 != is_scaled_x4
     ) {
         update_editor(new_ratio, new_controller_id, new_is_scaled_x4);
-    } else {
-        synth.push_message(
-            Synth::MessageType::REFRESH_PARAM, param_id, 0.0, 0
-        );
-
-        if (can_scale_x4) {
-            synth.push_message(
-                Synth::MessageType::REFRESH_PARAM,
-                scale_x4_toggle_param_id,
-                0.0,
-                0
-            );
-        }
     }
 }
 
@@ -854,7 +845,7 @@ bool KnobParamEditor::should_be_scaled_x4() const
         return false;
     }
 
-    Number const ratio = synth.get_param_ratio_atomic(scale_x4_toggle_param_id);
+    Number const ratio = gui->get_param_ratio(scale_x4_toggle_param_id);
     Byte const toggle = synth.byte_param_ratio_to_display_value(
         scale_x4_toggle_param_id, ratio
     );
@@ -1140,7 +1131,7 @@ bool KnobParamEditor::Knob::update_sync_status()
     is_synced = (
         sync_param_id != Synth::ParamId::INVALID_PARAM_ID
         && ratio > 0.0
-        && std::fabs(ratio - editor.synth.get_param_ratio_atomic(sync_param_id)) < 0.000001
+        && std::fabs(ratio - gui->get_param_ratio(sync_param_id)) < 0.000001
     );
 
     return was_synced != is_synced;
@@ -1428,10 +1419,12 @@ ToggleSwitchParamEditor::ToggleSwitchParamEditor(
         int const height,
         int const box_left,
         Synth& synth,
-        Synth::ParamId const param_id
+        Synth::ParamId const param_id,
+        char const* const label
 ) : TransparentWidget(text, left, top, width, height, Type::TOGGLE_SWITCH),
     param_id(param_id),
     box_left(box_left),
+    label(label),
     synth(synth),
     is_editing_(false)
 {
@@ -1457,15 +1450,11 @@ void ToggleSwitchParamEditor::refresh()
         return;
     }
 
-    Number const new_ratio = synth.get_param_ratio_atomic(param_id);
+    Number const new_ratio = gui->get_param_ratio(param_id);
 
     if (new_ratio != ratio) {
         ratio = GUI::clamp_ratio(new_ratio);
         redraw();
-    } else {
-        synth.push_message(
-            Synth::MessageType::REFRESH_PARAM, param_id, 0.0, 0
-        );
     }
 
     update_title();
@@ -1481,6 +1470,25 @@ bool ToggleSwitchParamEditor::paint()
         toggle == ToggleParam::ON ? GUI::TOGGLE_ON_COLOR : GUI::TOGGLE_OFF_COLOR
     );
 
+    if (label != NULL) {
+        fill_rectangle(0, 2, width, height - 4, GUI::TEXT_BACKGROUND);
+        fill_rectangle(box_left + 3, 6, 15, 12, GUI::TEXT_COLOR);
+        fill_rectangle(box_left + 4, 7, 13, 10, GUI::TEXT_BACKGROUND);
+        draw_text(
+            label,
+            10,
+            box_left + 21,
+            2,
+            width - box_left - 21,
+            height - 4,
+            GUI::TEXT_COLOR,
+            GUI::TEXT_BACKGROUND,
+            FontWeight::NORMAL,
+            0,
+            TextAlignment::LEFT
+        );
+    }
+
     fill_rectangle(box_left + 5, 8, 11, 8, color);
 
     return true;
@@ -1664,17 +1672,13 @@ void DiscreteParamEditor::refresh()
         return;
     }
 
-    Number const new_ratio = synth.get_param_ratio_atomic(param_id);
+    Number const new_ratio = gui->get_param_ratio(param_id);
     bool const is_changed = std::fabs(new_ratio - ratio) > 0.000001;
 
     if (is_changed) {
         ratio = GUI::clamp_ratio(new_ratio);
         update();
         redraw();
-    } else {
-        synth.push_message(
-            Synth::MessageType::REFRESH_PARAM, param_id, 0.0, 0
-        );
     }
 }
 
@@ -1849,7 +1853,7 @@ void TuningSelector::refresh()
         return;
     }
 
-    Number const new_ratio = synth.get_param_ratio_atomic(param_id);
+    Number const new_ratio = gui->get_param_ratio(param_id);
     bool const new_is_mts_esp_connected = gui->is_mts_esp_connected();
 
     bool const is_changed = (
@@ -1862,10 +1866,6 @@ void TuningSelector::refresh()
         is_mts_esp_connected = new_is_mts_esp_connected;
         update();
         redraw();
-    } else {
-        synth.push_message(
-            Synth::MessageType::REFRESH_PARAM, param_id, 0.0, 0
-        );
     }
 }
 
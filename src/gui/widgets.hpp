@@ -573,6 +573,10 @@ class StatusLine : public TransparentWidget
 class ToggleSwitchParamEditor: public TransparentWidget
 {
     public:
+        /**
+         * \brief When \c label is not \c NULL, the switch draws its own box
+         *        and label instead of relying on the background image.
+         */
         ToggleSwitchParamEditor(
             GUI& gui,
             char const* const text,
@@ -582,7 +586,8 @@ class ToggleSwitchParamEditor: public TransparentWidget
             int const height,
             int const box_left,
             Synth& synth,
-            Synth::ParamId const param_id
+            Synth::ParamId const param_id,
+            char const* const label = NULL
         );
 
         void refresh();
@@ -611,6 +616,7 @@ class ToggleSwitchParamEditor: public TransparentWidget
         void stop_editing();
 
         int const box_left;
+        char const* const label;
 
         Synth& synth;
 
@@ -19,6 +19,7 @@
 #ifndef JS80P__MIDI_HPP
 #define JS80P__MIDI_HPP
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
 
@@ -37,10 +38,29 @@ typedef Byte Controller;
 typedef Byte Command;
 
 
+constexpr Channel CHANNEL_MAX                       = 15;
+constexpr Channel CHANNELS                          = CHANNEL_MAX + 1;
+constexpr Channel INVALID_CHANNEL                   = 255;
+
+/* Controllers 0-31 may be paired with an LSB which is sent as controller 32-63. */
+constexpr Byte HIGH_RESOLUTION_CONTROLLERS          = 32;
+
+constexpr Word INVALID_NRPN                         = 0xffff;
+
+
 class EventHandler
 {
     public:
-        EventHandler() : running_status(0) {}
+        EventHandler()
+            : running_status(0)
+        {
+            std::fill_n(
+                &controller_msbs[0][0],
+                CHANNELS * HIGH_RESOLUTION_CONTROLLERS,
+                0
+            );
+            std::fill_n(nrpns, CHANNELS, INVALID_NRPN);
+        }
 
         void note_off(
             Seconds const time_offset,
@@ -70,6 +90,31 @@ class EventHandler
             Byte const new_value
         ) noexcept {}
 
+        /**
+         * \brief Called when the LSB of a 14-bit controller (0-31) is
+         *        received, after the MSB has already been dispatched as a
+         *        regular \c control_change().
+         */
+        void control_change_14_bit(
+            Seconds const time_offset,
+            Channel const channel,
+            Controller const controller,
+            Word const new_value
+        ) noexcept {}
+
+        /**
+         * \brief Called when the MSB or the LSB of the data entry controller
+         *        is received while a non-registered parameter is selected.
+         *        Until the LSB arrives, the MSB is repeated in the low 7
+         *        bits of the value.
+         */
+        void nrpn_change(
+            Seconds const time_offset,
+            Channel const channel,
+            Word const parameter,
+            Word const new_value
+        ) noexcept {}
+
         void program_change(
             Seconds const time_offset,
             Channel const channel,
@@ -114,6 +159,8 @@ class EventHandler
         ) noexcept {}
 
         Byte running_status;
+        Byte controller_msbs[CHANNELS][HIGH_RESOLUTION_CONTROLLERS];
+        Word nrpns[CHANNELS];
 };
 
 
@@ -196,6 +243,14 @@ class EventDispatcher
             size_t& next_byte
         ) noexcept;
 
+        static void process_high_resolution_control_change(
+            EventHandlerClass& event_handler,
+            Seconds const time_offset,
+            Byte const channel,
+            Byte const controller,
+            Byte const new_value
+        ) noexcept;
+
         static size_t process_program_change(
             EventHandlerClass& event_handler,
             Seconds const time_offset,
@@ -246,10 +301,6 @@ class EventDispatcher
 };
 
 
-constexpr Channel CHANNEL_MAX                       = 15;
-constexpr Channel CHANNELS                          = CHANNEL_MAX + 1;
-constexpr Channel INVALID_CHANNEL                   = 255;
-
 constexpr Note NOTE_MAX                             = 127;
 constexpr Note NOTES                                = NOTE_MAX + 1;
 constexpr Note INVALID_NOTE                         = 255;
@@ -567,6 +618,7 @@ constexpr Controller UNDEFINED_13                   = 28;
 constexpr Controller UNDEFINED_14                   = 29;
 constexpr Controller UNDEFINED_15                   = 30;
 constexpr Controller UNDEFINED_16                   = 31;
+constexpr Controller DATA_ENTRY_LSB                 = 38;
 constexpr Controller SUSTAIN_PEDAL                  = 64;
 constexpr Controller SOUND_1                        = 70;
 constexpr Controller SOUND_2                        = 71;
@@ -590,6 +642,10 @@ constexpr Controller FX_2                           = 92;
 constexpr Controller FX_3                           = 93;
 constexpr Controller FX_4                           = 94;
 constexpr Controller FX_5                           = 95;
+constexpr Controller NRPN_LSB                       = 98;
+constexpr Controller NRPN_MSB                       = 99;
+constexpr Controller RPN_LSB                        = 100;
+constexpr Controller RPN_MSB                        = 101;
 constexpr Controller UNDEFINED_23                   = 102;
 constexpr Controller UNDEFINED_24                   = 103;
 constexpr Controller UNDEFINED_25                   = 104;
@@ -827,9 +883,24 @@ size_t EventDispatcher<EventHandlerClass>::process_control_change(
         restrictions that are imposed by hosts which swallow most of the raw CC
         messages and instead, require plugins to export parameters that can be
         assigned to MIDI controllers (for example, FL Studio 21).
+
+        Data entry messages which belong to a selected NRPN are only delivered
+        as NRPN changes though, otherwise they would also move whatever is
+        assigned to the plain Data Entry controller.
         */
 
-        event_handler.control_change(time_offset, channel, (Controller)d1, d2);
+        bool const is_nrpn_data_entry = (
+            (d1 == DATA_ENTRY || d1 == DATA_ENTRY_LSB)
+            && event_handler.nrpns[channel] != INVALID_NRPN
+        );
+
+        if (!is_nrpn_data_entry) {
+            event_handler.control_change(time_offset, channel, (Controller)d1, d2);
+        }
+
+        process_high_resolution_control_change(
+            event_handler, time_offset, channel, d1, d2
+        );
     } else {
         switch ((Command)d1) {
             case CONTROL_CHANGE_ALL_SOUND_OFF:
@@ -865,6 +936,79 @@ size_t EventDispatcher<EventHandlerClass>::process_control_change(
 }
 
 
+/*
+The MSB of a 14-bit controller is dispatched immediately with a 7-bit value, so
+that senders which never send an LSB keep working, then the LSB refines it.
+NRPN parameter numbers and data entry values are assembled the same way. Since
+most NRPN senders only send the data entry MSB, its 7 bits are repeated in the
+low bits until the LSB arrives, so that 0x7f maps to the maximum value, 0x3fff,
+just like a 7-bit controller value of 0x7f maps to the maximum.
+*/
+template<class EventHandlerClass>
+void EventDispatcher<EventHandlerClass>::process_high_resolution_control_change(
+        EventHandlerClass& event_handler,
+        Seconds const time_offset,
+        Byte const channel,
+        Byte const controller,
+        Byte const new_value
+) noexcept {
+    Word& nrpn = event_handler.nrpns[channel];
+
+    if (controller < HIGH_RESOLUTION_CONTROLLERS) {
+        event_handler.controller_msbs[channel][controller] = new_value;
+
+        if (controller == DATA_ENTRY && nrpn != INVALID_NRPN) {
+            event_handler.nrpn_change(
+                time_offset,
+                channel,
+                nrpn,
+                ((Word)new_value << 7) | (Word)new_value
+            );
+        }
+
+        return;
+    }
+
+    if (controller < HIGH_RESOLUTION_CONTROLLERS * 2) {
+        Controller const msb_controller = (
+            controller - HIGH_RESOLUTION_CONTROLLERS
+        );
+        Word const value = (
+            ((Word)event_handler.controller_msbs[channel][msb_controller] << 7)
+            | (Word)new_value
+        );
+
+        if (msb_controller != DATA_ENTRY) {
+            event_handler.control_change_14_bit(
+                time_offset, channel, msb_controller, value
+            );
+        } else if (nrpn != INVALID_NRPN) {
+            event_handler.nrpn_change(time_offset, channel, nrpn, value);
+        }
+
+        return;
+    }
+
+    switch (controller) {
+        case NRPN_MSB:
+            nrpn = ((Word)new_value << 7) | (nrpn == INVALID_NRPN ? 0 : nrpn & 0x7f);
+            break;
+
+        case NRPN_LSB:
+            nrpn = (nrpn == INVALID_NRPN ? 0 : nrpn & 0x3f80) | (Word)new_value;
+            break;
+
+        case RPN_MSB:
+        case RPN_LSB:
+            nrpn = INVALID_NRPN;
+            break;
+
+        default:
+            break;
+    }
+}
+
+
 template<class EventHandlerClass>
 size_t EventDispatcher<EventHandlerClass>::process_program_change(
         EventHandlerClass& event_handler,
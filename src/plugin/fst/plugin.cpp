@@ -484,13 +484,16 @@ FstPlugin::FstPlugin(
     platform_data(platform_data),
     gui(NULL),
     renderer(synth),
+    note_events(*this, MAX_NOTE_EVENTS),
     to_audio_messages(1024),
     to_audio_string_messages(256),
     to_gui_messages(1024),
     mts_esp(synth),
     serialized_bank(""),
     current_patch(""),
+    unreleased_payload(NULL),
     current_program_index(0),
+    patch_generation(0),
     min_samples_before_next_cc_ui_update(8192),
     remaining_samples_before_next_cc_ui_update(0),
     min_samples_before_next_bank_update(16384),
@@ -509,16 +512,61 @@ FstPlugin::FstPlugin(
 
     populate_parameters(synth, parameters);
 
+    renderer.set_min_sub_block_size(MIN_SUB_BLOCK_SIZE);
+
     serialized_bank = bank.serialize();
     current_patch = bank[current_program_index].serialize();
 
-    program_names.import_names(serialized_bank);
+    gui_bank.import(serialized_bank);
 }
 
 
 FstPlugin::~FstPlugin()
 {
     close_gui();
+
+    release_pending_payloads(to_audio_string_messages);
+    release_pending_payloads(to_gui_messages);
+
+    delete unreleased_payload;
+}
+
+
+void FstPlugin::release_pending_payloads(SPSCQueue<Message>& messages) noexcept
+{
+    Message message;
+
+    while (messages.pop(message)) {
+        delete message.get_payload();
+    }
+}
+
+
+void FstPlugin::push_message(
+        SPSCQueue<Message>& messages,
+        Message const& message
+) noexcept {
+    if (!messages.push(message)) {
+        delete message.get_payload();
+    }
+}
+
+
+/*
+Freeing memory may block, so when the GUI thread is lagging behind, the payload
+is kept until the next rendering round instead.
+*/
+bool FstPlugin::release_payload_in_audio_thread(std::string* const payload) noexcept
+{
+    if (to_gui_messages.push(Message(MessageType::RELEASE_PAYLOAD, 0, payload))) {
+        unreleased_payload = NULL;
+
+        return true;
+    }
+
+    unreleased_payload = payload;
+
+    return false;
 }
 
 
@@ -562,6 +610,12 @@ void FstPlugin::process_internal_messages_in_audio_thread(
             default:
                 break;
         }
+
+        std::string* const payload = message.get_payload();
+
+        if (payload != NULL && !release_payload_in_audio_thread(payload)) {
+            break;
+        }
     }
 }
 
@@ -581,10 +635,25 @@ void FstPlugin::handle_change_program(size_t const new_program) noexcept
     std::string const new_patch(bank[new_program].serialize());
 
     synth.process_messages();
-    bank[old_program].import(Serializer::serialize(synth));
-    Serializer::import_patch_in_audio_thread(synth, new_patch);
-    synth.clear_dirty_flag();
-    renderer.reset();
+
+    std::string* const old_patch = new std::string(Serializer::serialize(synth));
+
+    bank[old_program].import(*old_patch);
+
+    /*
+    Once the new program is loaded, the GUI thread can no longer serialize the
+    old one from the synth's parameter snapshot, so the changes which it hasn't
+    seen yet would be lost.
+    */
+    if (
+            !to_gui_messages.push(
+                Message(MessageType::PROGRAM_SAVED, old_program, old_patch)
+            )
+    ) {
+        delete old_patch;
+    }
+
+    replace_patch_in_audio_thread(new_patch);
     bank.set_current_program_index(new_program);
 
     need_bank_update = true;
@@ -634,9 +703,7 @@ void FstPlugin::handle_import_patch(std::string const& patch) noexcept
 {
     size_t const current_program = bank.get_current_program_index();
 
-    Serializer::import_patch_in_audio_thread(synth, patch);
-    synth.clear_dirty_flag();
-    renderer.reset();
+    replace_patch_in_audio_thread(patch);
 
     std::string const& serialized_patch(Serializer::serialize(synth));
 
@@ -652,16 +719,22 @@ void FstPlugin::handle_import_bank(std::string const& serialized_bank) noexcept
 
     bank.import(serialized_bank);
 
-    Serializer::import_patch_in_audio_thread(
-        synth, bank[current_program].serialize()
-    );
-    synth.clear_dirty_flag();
-    renderer.reset();
+    replace_patch_in_audio_thread(bank[current_program].serialize());
 
     need_bank_update = true;
 }
 
 
+void FstPlugin::replace_patch_in_audio_thread(std::string const& patch) noexcept
+{
+    patch_generation.store(patch_generation.load() + 1);
+
+    Serializer::import_patch_in_audio_thread(synth, patch);
+    synth.clear_dirty_flag();
+    renderer.reset();
+}
+
+
 void FstPlugin::process_internal_messages_in_gui_thread() noexcept
 {
     SPSCQueue<Message>::SizeType const message_count = to_gui_messages.length();
@@ -675,13 +748,7 @@ void FstPlugin::process_internal_messages_in_gui_thread() noexcept
 
         switch (message.get_type()) {
             case MessageType::PROGRAM_CHANGED:
-                handle_program_changed(
-                    message.get_index(), message.get_serialized_data()
-                );
-                break;
-
-            case MessageType::BANK_CHANGED:
-                handle_bank_changed(message.get_serialized_data());
+                handle_program_changed(message.get_index());
                 break;
 
             case MessageType::PARAMS_CHANGED:
@@ -689,27 +756,39 @@ void FstPlugin::process_internal_messages_in_gui_thread() noexcept
                 break;
 
             case MessageType::SYNTH_WAS_DIRTY:
-                handle_synth_was_dirty();
+                handle_synth_was_dirty(
+                    message.get_index(), message.get_generation()
+                );
+                break;
+
+            case MessageType::PROGRAM_SAVED:
+                handle_program_saved(
+                    message.get_index(), message.get_serialized_data()
+                );
                 break;
 
             default:
                 break;
         }
+
+        delete message.get_payload();
     }
 }
 
 
-void FstPlugin::handle_program_changed(
-        size_t const new_program,
-        std::string const& patch
-) noexcept {
-    Bank::Program program;
+/*
+Imports and renames are mirrored in the GUI thread's bank when they are sent to
+the audio thread, so only the program index needs to be passed back.
+*/
+void FstPlugin::handle_program_changed(size_t const new_program) noexcept
+{
+    if (new_program >= Bank::NUMBER_OF_PROGRAMS) {
+        return;
+    }
 
     current_program_index = new_program;
-    current_patch = patch;
-
-    program.import(patch);
-    program_names[current_program_index].set_name(program.get_name());
+    current_patch = gui_bank[current_program_index].serialize();
+    serialized_bank = gui_bank.serialize();
 
     parameters[0].set_value(
         Bank::program_index_to_normalized_parameter_value(new_program)
@@ -717,22 +796,41 @@ void FstPlugin::handle_program_changed(
 }
 
 
-void FstPlugin::handle_bank_changed(std::string const& serialized_bank) noexcept
-{
-    this->serialized_bank = serialized_bank;
-
-    program_names.import_names(serialized_bank);
-}
-
-
 void FstPlugin::handle_params_changed() noexcept
 {
     need_host_update = true;
 }
 
 
-void FstPlugin::handle_synth_was_dirty() noexcept
-{
+/*
+Turning the synth's parameters into text is too slow for the audio thread, so
+the patch and the bank are serialized here, from the most recent parameter
+snapshot that the synth has published. If the audio thread has loaded another
+patch since the message was sent, then the snapshot belongs to that one, and
+the final state of the old program arrives in a PROGRAM_SAVED message instead.
+The generation is checked again after serializing, because the audio thread
+may switch patches in the meantime.
+*/
+void FstPlugin::handle_synth_was_dirty(
+        size_t const program,
+        size_t const generation
+) noexcept {
+    if (
+            program < Bank::NUMBER_OF_PROGRAMS
+            && generation == patch_generation.load()
+    ) {
+        std::string const patch(Serializer::serialize(synth));
+
+        if (generation == patch_generation.load()) {
+            gui_bank[program].import(patch);
+            serialized_bank = gui_bank.serialize();
+
+            if (program == current_program_index) {
+                current_patch = patch;
+            }
+        }
+    }
+
     Parameter& dirty = parameters[PATCH_CHANGED_PARAMETER_INDEX];
 
     float const new_value = dirty.get_value() + 0.01f;
@@ -748,6 +846,23 @@ void FstPlugin::handle_synth_was_dirty() noexcept
 }
 
 
+void FstPlugin::handle_program_saved(
+        size_t const program,
+        std::string const& patch
+) noexcept {
+    if (program >= Bank::NUMBER_OF_PROGRAMS) {
+        return;
+    }
+
+    gui_bank[program].import(patch);
+    serialized_bank = gui_bank.serialize();
+
+    if (program == current_program_index) {
+        current_patch = gui_bank[program].serialize();
+    }
+}
+
+
 VstInt32 FstPlugin::get_latency_samples() const noexcept
 {
     return (VstInt32)renderer.get_latency_samples();
@@ -773,6 +888,7 @@ VstIntPtr FstPlugin::idle() noexcept
 {
     process_internal_messages_in_gui_thread();
     update_host_display();
+    update_latency();
 
     return 1;
 }
@@ -818,15 +934,26 @@ void FstPlugin::suspend() noexcept
     synth.running_status = 0;
     this->running_status = 0;
     renderer.reset();
+    note_events.clear();
 }
 
 
 void FstPlugin::resume() noexcept
 {
+    /*
+    Hosts switch between real-time and offline processing (e.g. for bouncing)
+    while the plugin is suspended, so this is the place where the rendering
+    profile can be changed safely.
+    */
+    synth.set_offline_rendering(
+        host_callback(audioMasterGetCurrentProcessLevel)
+            == kVstProcessLevelOffline
+    );
     synth.resume();
     synth.running_status = 0;
     this->running_status = 0;
     renderer.reset();
+    update_latency();
     host_callback(audioMasterWantMidi, 0, 1);
     process_internal_messages_in_gui_thread();
     need_idle();
@@ -877,6 +1004,13 @@ void FstPlugin::clear_received_midi_cc() noexcept
 
 void FstPlugin::process_vst_midi_event(VstMidiEvent const* const event) noexcept
 {
+    if (
+            should_hold_back(event)
+            && note_events.push((Integer)event->deltaFrames, *event)
+    ) {
+        return;
+    }
+
     Seconds const time_offset = (
         synth.sample_count_to_time_offset((Integer)event->deltaFrames)
     );
@@ -891,6 +1025,36 @@ void FstPlugin::process_vst_midi_event(VstMidiEvent const* const event) noexcept
 }
 
 
+/*
+Once an event is held back, all the later ones in the same buffer must be held
+back as well, otherwise e.g. a sustain pedal or an All Notes Off message would
+take effect before the notes that precede it.
+*/
+bool FstPlugin::should_hold_back(VstMidiEvent const* const event) const noexcept
+{
+    Midi::Command const command = (Midi::Command)(event->midiData[0] & 0xf0);
+
+    return (
+        (
+            command == Midi::NOTE_ON
+            || command == Midi::NOTE_OFF
+            || !note_events.is_empty()
+        )
+        && event->deltaFrames > 0
+        && synth.is_zero_latency()
+    );
+}
+
+
+void FstPlugin::handle_event(VstMidiEvent const& event) noexcept
+{
+    Midi::Byte const* const midi_bytes = (Midi::Byte const*)event.midiData;
+
+    Midi::EventDispatcher<FstPlugin>::dispatch_event(*this, 0.0, midi_bytes, 4);
+    Midi::EventDispatcher<Synth>::dispatch_event(synth, 0.0, midi_bytes, 4);
+}
+
+
 template<typename NumberType>
 void FstPlugin::generate_samples(
         VstInt32 const sample_count,
@@ -898,11 +1062,22 @@ void FstPlugin::generate_samples(
         NumberType** out_samples
 ) noexcept {
     if (sample_count < 1) {
+        note_events.flush();
+
         return;
     }
 
     prepare_rendering(sample_count);
-    renderer.render<NumberType>(sample_count, in_samples, out_samples);
+
+    if (note_events.is_empty()) {
+        renderer.render<NumberType>(sample_count, in_samples, out_samples);
+    } else {
+        renderer.render<NumberType>(
+            sample_count, in_samples, out_samples, note_events
+        );
+        note_events.flush();
+    }
+
     finalize_rendering(sample_count);
 
     /*
@@ -926,7 +1101,13 @@ void FstPlugin::prepare_rendering(Integer const sample_count) noexcept
 
     received_midi_cc_cleared = false;
 
-    process_internal_messages_in_audio_thread(to_audio_string_messages);
+    if (
+            unreleased_payload == NULL
+            || release_payload_in_audio_thread(unreleased_payload)
+    ) {
+        process_internal_messages_in_audio_thread(to_audio_string_messages);
+    }
+
     process_internal_messages_in_audio_thread(to_audio_messages);
 
     update_bpm();
@@ -964,23 +1145,29 @@ void FstPlugin::finalize_rendering(Integer const sample_count) noexcept
     }
 
     remaining_samples_before_next_bank_update = min_samples_before_next_bank_update;
-    need_bank_update = false;
     synth.clear_dirty_flag();
 
     size_t const current_program = bank.get_current_program_index();
-    std::string const& current_patch = Serializer::serialize(synth);
-
-    bank[current_program].import(current_patch);
 
-    std::string const& serialized_bank(bank.serialize());
-
-    to_gui_messages.push(
-        Message(MessageType::PROGRAM_CHANGED, current_program, current_patch)
-    );
-    to_gui_messages.push(Message(MessageType::BANK_CHANGED, 0, serialized_bank));
+    /*
+    The handlers of program changes and imports keep the audio thread's bank up
+    to date, and the patch and the bank are serialized by the GUI thread.
+    */
+    if (need_bank_update) {
+        need_bank_update = !to_gui_messages.push(
+            Message(MessageType::PROGRAM_CHANGED, current_program)
+        );
+    }
 
     if (is_dirty) {
-        to_gui_messages.push(Message(MessageType::SYNTH_WAS_DIRTY));
+        to_gui_messages.push(
+            Message(
+                MessageType::SYNTH_WAS_DIRTY,
+                current_program,
+                NULL,
+                patch_generation.load()
+            )
+        );
     }
 }
 
@@ -1017,19 +1204,47 @@ void FstPlugin::update_host_display() noexcept
 }
 
 
+void FstPlugin::update_latency() noexcept
+{
+    /*
+    Like audioMasterNeedIdle, this opcode is missing from FST, but its value is
+    well known.
+    */
+    constexpr int audioMasterIOChanged = 13;
+
+    VstInt32 const latency = get_latency_samples();
+
+    if (effect->initialDelay != latency) {
+        effect->initialDelay = latency;
+        host_callback(audioMasterIOChanged);
+    }
+}
+
+
 void FstPlugin::generate_and_add_samples(
         VstInt32 const sample_count,
         float const* const* const in_samples,
         float** out_samples
 ) noexcept {
     if (sample_count < 1) {
+        note_events.flush();
+
         return;
     }
 
     prepare_rendering(sample_count);
-    renderer.render<float, Renderer::Operation::ADD>(
-        sample_count, in_samples, out_samples
-    );
+
+    if (note_events.is_empty()) {
+        renderer.render<float, Renderer::Operation::ADD>(
+            sample_count, in_samples, out_samples
+        );
+    } else {
+        renderer.render<float, Renderer::Operation::ADD>(
+            sample_count, in_samples, out_samples, note_events
+        );
+        note_events.flush();
+    }
+
     finalize_rendering(sample_count);
 }
 
@@ -1042,7 +1257,7 @@ VstIntPtr FstPlugin::get_chunk(void** chunk, bool is_preset) noexcept
         Bank::Program program;
 
         program.import(current_patch);
-        program.set_name(program_names[current_program_index].get_name());
+        program.set_name(gui_bank[current_program_index].get_name());
 
         current_patch = program.serialize();
 
@@ -1071,21 +1286,25 @@ void FstPlugin::set_chunk(void const* chunk, VstIntPtr const size, bool is_prese
 
         std::string const& name(program.get_name());
 
-        program_names[current_program_index].set_name(name);
+        gui_bank[current_program_index].import(current_patch);
+        gui_bank[current_program_index].set_name(name);
 
-        to_audio_string_messages.push(
-            Message(MessageType::IMPORT_PATCH, 0, current_patch)
+        push_message(
+            to_audio_string_messages,
+            Message(MessageType::IMPORT_PATCH, 0, new std::string(current_patch))
         );
-        to_audio_string_messages.push(
-            Message(MessageType::RENAME_PROGRAM, 0, name)
+        push_message(
+            to_audio_string_messages,
+            Message(MessageType::RENAME_PROGRAM, 0, new std::string(name))
         );
     } else {
         serialized_bank = buffer;
 
-        program_names.import_names(serialized_bank);
+        gui_bank.import(serialized_bank);
 
-        to_audio_string_messages.push(
-            Message(MessageType::IMPORT_BANK, 0, serialized_bank)
+        push_message(
+            to_audio_string_messages,
+            Message(MessageType::IMPORT_BANK, 0, new std::string(serialized_bank))
         );
     }
 }
@@ -1170,7 +1389,7 @@ VstIntPtr FstPlugin::get_program_name(char* name, size_t index) noexcept
 
     strncpy(
         name,
-        program_names[index].get_name().c_str(),
+        gui_bank[index].get_name().c_str(),
         kVstMaxProgNameLen - 1
     );
     name[kVstMaxProgNameLen - 1] = '\x00';
@@ -1185,7 +1404,7 @@ void FstPlugin::get_program_name(char* name) noexcept
 
     strncpy(
         name,
-        program_names[current_program_index].get_name().c_str(),
+        gui_bank[current_program_index].get_name().c_str(),
         kVstMaxProgNameLen - 1
     );
     name[kVstMaxProgNameLen - 1] = '\x00';
@@ -1196,8 +1415,11 @@ void FstPlugin::set_program_name(const char* name)
 {
     process_internal_messages_in_gui_thread();
 
-    to_audio_string_messages.push(Message(MessageType::RENAME_PROGRAM, 0, name));
-    program_names[current_program_index].set_name(name);
+    push_message(
+        to_audio_string_messages,
+        Message(MessageType::RENAME_PROGRAM, 0, new std::string(name))
+    );
+    gui_bank[current_program_index].set_name(name);
 }
 
 
@@ -1215,6 +1437,7 @@ void FstPlugin::gui_idle()
 {
     process_internal_messages_in_gui_thread();
     update_host_display();
+    update_latency();
 
     /*
     Some hosts (e.g. Ardour 5.12.0) send an effEditIdle message before sending
@@ -1390,7 +1613,7 @@ void FstPlugin::get_param_display(size_t index, char* buffer) noexcept
         if (program_index < Bank::NUMBER_OF_PROGRAMS) {
             strncpy(
                 buffer,
-                program_names[program_index].get_short_name().c_str(),
+                gui_bank[program_index].get_short_name().c_str(),
                 kVstMaxParamStrLen - 1
             );
         } else {
@@ -1423,11 +1646,13 @@ FstPlugin::Message::Message() : Message(MessageType::NONE)
 FstPlugin::Message::Message(
         MessageType const type,
         size_t const index,
-        std::string const& serialized_data
-) : serialized_data(serialized_data),
+        std::string* const payload,
+        size_t const generation
+) : payload(payload),
     midi_controller(NULL),
     new_value(0.0),
     index(index),
+    generation(generation),
     type(type),
     controller_id(0)
 {
@@ -1438,10 +1663,11 @@ FstPlugin::Message::Message(
         Midi::Controller const controller_id,
         Number const new_value,
         MidiController* const midi_controller
-) : serialized_data(""),
+) : payload(NULL),
     midi_controller(midi_controller),
     new_value(new_value),
     index(0),
+    generation(0),
     type(MessageType::CHANGE_PARAM),
     controller_id(controller_id)
 {
@@ -1460,9 +1686,23 @@ size_t FstPlugin::Message::get_index() const noexcept
 }
 
 
+size_t FstPlugin::Message::get_generation() const noexcept
+{
+    return generation;
+}
+
+
+std::string* FstPlugin::Message::get_payload() const noexcept
+{
+    return payload;
+}
+
+
 std::string const& FstPlugin::Message::get_serialized_data() const noexcept
 {
-    return serialized_data;
+    JS80P_ASSERT(payload != NULL);
+
+    return *payload;
 }
 
 
@@ -20,7 +20,9 @@
 #ifndef JS80P__PLUGIN__FST__PLUGIN_HPP
 #define JS80P__PLUGIN__FST__PLUGIN_HPP
 
+#include <atomic>
 #include <string>
+#include <type_traits>
 #include <bitset>
 
 #include <fst/fst.h>
@@ -166,6 +168,12 @@ class FstPlugin : public Midi::EventHandler
         void process_vst_events(VstEvents const* const events) noexcept;
         void process_vst_midi_event(VstMidiEvent const* const event) noexcept;
 
+        /**
+         * \brief Apply a note event which was held back until the event
+         *        splitting \c Renderer::render() reached its sample offset.
+         */
+        void handle_event(VstMidiEvent const& event) noexcept;
+
         template<typename NumberType>
         void generate_samples(
             VstInt32 const sample_count,
@@ -241,6 +249,13 @@ class FstPlugin : public Midi::EventHandler
             1.0 / HOST_CC_UI_UPDATE_FREQUENCY
         );
 
+        /*
+        In zero-latency mode, note events are held back until the rendering
+        reaches them, so that voices start and stop on the exact sample.
+        */
+        static constexpr size_t MAX_NOTE_EVENTS = 1024;
+        static constexpr Integer MIN_SUB_BLOCK_SIZE = 32;
+
         static constexpr Frequency BANK_UPDATE_FREQUENCY = 3.0;
         static constexpr Seconds BANK_UPDATE_FREQUENCY_INV = (
             1.0 / BANK_UPDATE_FREQUENCY
@@ -258,11 +273,29 @@ class FstPlugin : public Midi::EventHandler
 
             /* from Audio to GUI */
             PROGRAM_CHANGED = 6,
-            BANK_CHANGED = 7,
-            PARAMS_CHANGED = 8,
-            SYNTH_WAS_DIRTY = 9,
+            PARAMS_CHANGED = 7,
+            SYNTH_WAS_DIRTY = 8,
+            RELEASE_PAYLOAD = 9,
+            PROGRAM_SAVED = 10,
         };
 
+        /**
+         * \brief Fixed size message, so that passing it through an
+         *        \c SPSCQueue never allocates or frees memory.
+         *
+         * \note Large payloads (patches, banks, names) are allocated by the
+         *       sender, and their ownership is passed along with the message.
+         *       The audio thread never frees a payload: it hands them back to
+         *       the GUI thread via a \c RELEASE_PAYLOAD message instead. The
+         *       only payload that the audio thread allocates is the final
+         *       state of the program that it is switching away from, which it
+         *       needs to serialize for its own bank anyway, and which it hands
+         *       over in a \c PROGRAM_SAVED message.
+         *
+         * \note Messages which refer to the synth's parameters carry the
+         *       generation of the patch that was loaded when they were sent,
+         *       see \c FstPlugin::patch_generation.
+         */
         class Message
         {
             public:
@@ -271,7 +304,8 @@ class FstPlugin : public Midi::EventHandler
                 explicit Message(
                     MessageType const type,
                     size_t const index = 0,
-                    std::string const& serialized_data = ""
+                    std::string* const payload = NULL,
+                    size_t const generation = 0
                 );
 
                 Message(
@@ -289,6 +323,8 @@ class FstPlugin : public Midi::EventHandler
                 MessageType get_type() const noexcept;
 
                 size_t get_index() const noexcept;
+                size_t get_generation() const noexcept;
+                std::string* get_payload() const noexcept;
                 std::string const& get_serialized_data() const noexcept;
 
                 Midi::Controller get_controller_id() const noexcept;
@@ -296,14 +332,20 @@ class FstPlugin : public Midi::EventHandler
                 MidiController* get_midi_controller() const noexcept;
 
             private:
-                std::string serialized_data;
+                std::string* payload;
                 MidiController* midi_controller;
                 Number new_value;
                 size_t index;
+                size_t generation;
                 MessageType type;
                 Midi::Controller controller_id;
         };
 
+        static_assert(
+            std::is_trivially_copyable<Message>::value,
+            "FstPlugin::Message must be trivially copyable"
+        );
+
         static Parameter create_midi_ctl_param(
             Synth::ControllerId const controller_id,
             MidiController* midi_controller,
@@ -326,6 +368,7 @@ class FstPlugin : public Midi::EventHandler
         void update_bpm() noexcept;
 
         void update_host_display() noexcept;
+        void update_latency() noexcept;
 
         void process_internal_messages_in_audio_thread(
             SPSCQueue<Message>& messages
@@ -333,6 +376,18 @@ class FstPlugin : public Midi::EventHandler
 
         void process_internal_messages_in_gui_thread() noexcept;
 
+        /**
+         * \warning Must only be called from the GUI thread, since the payload
+         *          is freed when the queue is full.
+         */
+        void push_message(
+            SPSCQueue<Message>& messages,
+            Message const& message
+        ) noexcept;
+
+        bool release_payload_in_audio_thread(std::string* const payload) noexcept;
+        void release_pending_payloads(SPSCQueue<Message>& messages) noexcept;
+
         void handle_change_program(size_t const new_program) noexcept;
         void handle_rename_program(std::string const& name) noexcept;
 
@@ -345,14 +400,21 @@ class FstPlugin : public Midi::EventHandler
         void handle_import_patch(std::string const& patch) noexcept;
         void handle_import_bank(std::string const& serialized_bank) noexcept;
 
-        void handle_program_changed(
-            size_t const new_program,
+        void handle_program_changed(size_t const new_program) noexcept;
+        void handle_params_changed() noexcept;
+        void handle_synth_was_dirty(
+            size_t const program,
+            size_t const generation
+        ) noexcept;
+
+        void handle_program_saved(
+            size_t const program,
             std::string const& patch
         ) noexcept;
 
-        void handle_bank_changed(std::string const& serialized_bank) noexcept;
-        void handle_params_changed() noexcept;
-        void handle_synth_was_dirty() noexcept;
+        void replace_patch_in_audio_thread(std::string const& patch) noexcept;
+
+        bool should_hold_back(VstMidiEvent const* const event) const noexcept;
 
         Midi::Byte float_to_midi_byte(float const value) const noexcept;
 
@@ -366,15 +428,26 @@ class FstPlugin : public Midi::EventHandler
         std::bitset<Midi::MAX_CONTROLLER_ID + 1> midi_cc_received;
         GUI* gui;
         Renderer renderer;
+        HostEvents<VstMidiEvent, FstPlugin> note_events;
         SPSCQueue<Message> to_audio_messages;
         SPSCQueue<Message> to_audio_string_messages;
         SPSCQueue<Message> to_gui_messages;
         Bank bank;
-        Bank program_names;
+        Bank gui_bank;
         MtsEsp mts_esp;
         std::string serialized_bank;
         std::string current_patch;
+        std::string* unreleased_payload;
         size_t current_program_index;
+
+        /*
+        Incremented by the audio thread before it replaces the synth's patch,
+        so that the GUI thread can tell whether the most recently published
+        parameter snapshot still belongs to the program that a message refers
+        to.
+        */
+        std::atomic<size_t> patch_generation;
+
         Integer min_samples_before_next_cc_ui_update;
         Integer remaining_samples_before_next_cc_ui_update;
         Integer min_samples_before_next_bank_update;
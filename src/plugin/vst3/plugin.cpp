@@ -90,7 +90,7 @@ ViewRect const Vst3Plugin::GUI::rect(0, 0, JS80P::GUI::WIDTH, JS80P::GUI::HEIGHT
 
 
 Vst3Plugin::Event::Event()
-    : time_offset(0.0),
+    : sample_offset(0),
     velocity_or_value(0.0),
     type(Type::UNDEFINED),
     note_or_ctl(0),
@@ -101,11 +101,11 @@ Vst3Plugin::Event::Event()
 
 Vst3Plugin::Event::Event(
         Type const type,
-        Seconds const time_offset,
+        Integer const sample_offset,
         Midi::Byte const note_or_ctl,
         Midi::Channel const channel,
         Number const velocity_or_value
-) : time_offset(time_offset),
+) : sample_offset(sample_offset),
     velocity_or_value(velocity_or_value),
     type(type),
     note_or_ctl(note_or_ctl),
@@ -114,9 +114,44 @@ Vst3Plugin::Event::Event(
 }
 
 
-bool Vst3Plugin::Event::operator<(Event const& event) const noexcept
+Vst3Plugin::Processor::EventRun::EventRun() noexcept : next(0), end(0)
 {
-    return time_offset < event.time_offset;
+}
+
+
+Vst3Plugin::Processor::EventRun::EventRun(
+        size_t const next,
+        size_t const end
+) noexcept
+    : next(next),
+    end(end)
+{
+}
+
+
+Vst3Plugin::Processor::EventRunComparator::EventRunComparator(
+        std::vector<Event> const& events
+) noexcept : events(events)
+{
+}
+
+
+bool Vst3Plugin::Processor::EventRunComparator::operator()(
+        EventRun const& a,
+        EventRun const& b
+) const noexcept {
+    /*
+    The standard heap algorithms build a max-heap, so "less" means "later"
+    here. Runs occupy disjoint, increasing ranges of the events vector, so
+    comparing positions preserves the collection order on ties.
+    */
+    Integer const a_sample_offset = events[a.next].sample_offset;
+    Integer const b_sample_offset = events[b.next].sample_offset;
+
+    return (
+        a_sample_offset > b_sample_offset
+        || (a_sample_offset == b_sample_offset && a.next > b.next)
+    );
 }
 
 
@@ -129,12 +164,20 @@ FUnknown* Vst3Plugin::Processor::createInstance(void* unused)
 Vst3Plugin::Processor::Processor()
     : synth(),
     renderer(synth),
+    note_events(*this, MAX_NOTE_EVENTS),
     mts_esp(synth),
     bank(NULL),
-    events(4096),
+    events(),
+    event_runs(),
+    event_run_begin(0),
     new_program(0),
     need_to_load_new_program(false)
 {
+    events.reserve(MAX_EVENTS);
+    event_runs.reserve(MAX_EVENT_RUNS);
+
+    renderer.set_min_sub_block_size(MIN_SUB_BLOCK_SIZE);
+
     setControllerClass(Controller::ID);
     processContextRequirements.needTempo();
 }
@@ -201,8 +244,8 @@ tresult PLUGIN_API Vst3Plugin::Processor::notify(Vst::IMessage* message)
         double program;
 
         if (message->getAttributes()->getFloat(MSG_PROGRAM_CHANGE_PROGRAM, program) == kResultOk) {
-            events.push_back(
-                Event(Event::Type::PROGRAM_CHANGE, 0.0, 0, 0, (Number)program)
+            push_event(
+                Event(Event::Type::PROGRAM_CHANGE, 0, 0, 0, (Number)program)
             );
         }
     } else if (FIDStringsEqual(message->getMessageID(), MSG_CTL_READY)) {
@@ -234,6 +277,7 @@ tresult PLUGIN_API Vst3Plugin::Processor::canProcessSampleSize(int32 symbolic_sa
 tresult PLUGIN_API Vst3Plugin::Processor::setupProcessing(Vst::ProcessSetup& setup)
 {
     synth.set_sample_rate((Frequency)setup.sampleRate);
+    synth.set_offline_rendering(setup.processMode == Vst::kOffline);
     renderer.reset();
 
     return AudioEffect::setupProcessing(setup);
@@ -248,6 +292,7 @@ tresult PLUGIN_API Vst3Plugin::Processor::setActive(TBool state)
     } else {
         synth.suspend();
         renderer.reset();
+        note_events.clear();
     }
 
     return AudioEffect::setActive(state);
@@ -264,11 +309,12 @@ void Vst3Plugin::Processor::share_synth() noexcept
 
 tresult PLUGIN_API Vst3Plugin::Processor::process(Vst::ProcessData& data)
 {
+    /* Events that were pushed by notify() since the last call make up a run. */
+    end_event_run();
+
     collect_param_change_events(data);
     collect_note_events(data);
-    std::sort(events.begin(), events.end());
     process_events();
-    events.clear();
 
     if (bank != NULL && need_to_load_new_program) {
         need_to_load_new_program = false;
@@ -280,6 +326,8 @@ tresult PLUGIN_API Vst3Plugin::Processor::process(Vst::ProcessData& data)
     }
 
     if (data.numOutputs == 0 || data.numSamples < 1) {
+        note_events.flush();
+
         return kResultOk;
     }
 
@@ -360,21 +408,25 @@ void Vst3Plugin::Processor::collect_param_change_events_as(
     Vst::ParamValue value;
     int32 sample_offset;
 
+    begin_event_run();
+
     for (int32 i = 0; i < number_of_points; ++i) {
         if (param_queue->getPoint(i, sample_offset, value) != kResultTrue) {
             continue;
         }
 
-        events.push_back(
+        push_event(
             Event(
                 event_type,
-                synth.sample_count_to_time_offset(sample_offset),
+                (Integer)sample_offset,
                 midi_controller,
                 0,
                 (Number)value
             )
         );
     }
+
+    end_event_run();
 }
 
 
@@ -389,6 +441,8 @@ void Vst3Plugin::Processor::collect_note_events(Vst::ProcessData& data) noexcept
     int32 count = input_events->getEventCount();
     Vst::Event event;
 
+    begin_event_run();
+
     for (int32 i = 0; i < count; ++i) {
         if (input_events->getEvent(i, event) != kResultTrue) {
             continue;
@@ -396,10 +450,10 @@ void Vst3Plugin::Processor::collect_note_events(Vst::ProcessData& data) noexcept
 
         switch (event.type) {
             case Vst::Event::EventTypes::kNoteOnEvent:
-                events.push_back(
+                push_event(
                     Event(
                         Event::Type::NOTE_ON,
-                        synth.sample_count_to_time_offset(event.sampleOffset),
+                        (Integer)event.sampleOffset,
                         (Midi::Byte)event.noteOn.pitch,
                         (Midi::Channel)(event.noteOn.channel & 0xff),
                         (Number)event.noteOn.velocity
@@ -408,10 +462,10 @@ void Vst3Plugin::Processor::collect_note_events(Vst::ProcessData& data) noexcept
                 break;
 
             case Vst::Event::EventTypes::kNoteOffEvent:
-                events.push_back(
+                push_event(
                     Event(
                         Event::Type::NOTE_OFF,
-                        synth.sample_count_to_time_offset(event.sampleOffset),
+                        (Integer)event.sampleOffset,
                         (Midi::Byte)event.noteOff.pitch,
                         (Midi::Channel)(event.noteOff.channel & 0xff),
                         (Number)event.noteOff.velocity
@@ -420,10 +474,10 @@ void Vst3Plugin::Processor::collect_note_events(Vst::ProcessData& data) noexcept
                 break;
 
             case Vst::Event::EventTypes::kPolyPressureEvent:
-                events.push_back(
+                push_event(
                     Event(
                         Event::Type::NOTE_PRESSURE,
-                        synth.sample_count_to_time_offset(event.sampleOffset),
+                        (Integer)event.sampleOffset,
                         (Midi::Byte)event.polyPressure.pitch,
                         (Midi::Channel)(event.polyPressure.channel & 0xff),
                         (Number)event.polyPressure.pressure
@@ -435,28 +489,123 @@ void Vst3Plugin::Processor::collect_note_events(Vst::ProcessData& data) noexcept
                 break;
         }
     }
+
+    end_event_run();
 }
 
 
+bool Vst3Plugin::Processor::push_event(Event const& event) noexcept
+{
+    if (JS80P_UNLIKELY(events.size() == MAX_EVENTS)) {
+        return false;
+    }
+
+    events.push_back(event);
+
+    return true;
+}
+
+
+void Vst3Plugin::Processor::begin_event_run() noexcept
+{
+    event_run_begin = events.size();
+}
+
+
+void Vst3Plugin::Processor::end_event_run() noexcept
+{
+    size_t const event_run_end = events.size();
+
+    if (event_run_end == event_run_begin) {
+        return;
+    }
+
+    if (JS80P_UNLIKELY(event_runs.size() == MAX_EVENT_RUNS)) {
+        events.resize(event_run_begin);
+
+        return;
+    }
+
+    event_runs.push_back(EventRun(event_run_begin, event_run_end));
+    event_run_begin = event_run_end;
+}
+
+
+/*
+Each parameter queue and the event list are already time-ordered, so instead
+of sorting all the events, the runs are merged using a heap of their cursors.
+*/
 void Vst3Plugin::Processor::process_events() noexcept
 {
-    for (std::vector<Event>::const_iterator it = events.begin(); it != events.end(); ++it) {
-        process_event(*it);
+    EventRunComparator const is_later(events);
+    bool const is_zero_latency = synth.is_zero_latency();
+
+    std::make_heap(event_runs.begin(), event_runs.end(), is_later);
+
+    while (!event_runs.empty()) {
+        std::pop_heap(event_runs.begin(), event_runs.end(), is_later);
+
+        EventRun& event_run = event_runs.back();
+        Event const& event = events[event_run.next];
+
+        if (!(is_zero_latency && hold_back(event))) {
+            process_event(
+                event, synth.sample_count_to_time_offset(event.sample_offset)
+            );
+        }
+
+        ++event_run.next;
+
+        if (event_run.next == event_run.end) {
+            event_runs.pop_back();
+        } else {
+            std::push_heap(event_runs.begin(), event_runs.end(), is_later);
+        }
     }
+
+    events.clear();
+    event_run_begin = 0;
+}
+
+
+/*
+Events are processed in time order, so once a note event is held back, the rest
+of the buffer (e.g. sustain pedal changes, All Notes Off) must follow it into
+the queue, or else they would overtake it.
+*/
+bool Vst3Plugin::Processor::hold_back(Event const& event) noexcept
+{
+    return (
+        (
+            event.type == Event::Type::NOTE_ON
+            || event.type == Event::Type::NOTE_OFF
+            || !note_events.is_empty()
+        )
+        && event.sample_offset > 0
+        && note_events.push(event.sample_offset, event)
+    );
 }
 
 
-void Vst3Plugin::Processor::process_event(Event const& event) noexcept
+void Vst3Plugin::Processor::handle_event(Event const& event) noexcept
 {
+    process_event(event, 0.0);
+}
+
+
+void Vst3Plugin::Processor::process_event(
+        Event const& event,
+        Seconds const time_offset
+) noexcept {
     switch (event.type) {
         case Event::Type::NOTE_ON: {
             mts_esp.update_note_tuning(event.channel, event.note_or_ctl);
             Midi::Byte const velocity = float_to_midi_byte(event.velocity_or_value);
 
             if (velocity == 0) {
-                synth.note_off(event.time_offset, event.channel, event.note_or_ctl, 64);
+                synth.note_off(time_offset, event.channel, event.note_or_ctl, 64);
             } else {
-                synth.note_on(event.time_offset, event.channel, event.note_or_ctl, velocity);
+                synth.note_on(time_offset, event.channel, event.note_or_ctl, velocity);
             }
 
             break;
@@ -464,7 +613,7 @@ void Vst3Plugin::Processor::process_event(Event const& event) noexcept
 
         case Event::Type::NOTE_PRESSURE:
             synth.aftertouch(
-                event.time_offset,
+                time_offset,
                 event.channel,
                 event.note_or_ctl,
                 float_to_midi_byte(event.velocity_or_value)
@@ -473,7 +622,7 @@ void Vst3Plugin::Processor::process_event(Event const& event) noexcept
 
         case Event::Type::NOTE_OFF:
             synth.note_off(
-                event.time_offset,
+                time_offset,
                 event.channel,
                 event.note_or_ctl,
                 float_to_midi_byte(event.velocity_or_value)
@@ -482,7 +631,7 @@ void Vst3Plugin::Processor::process_event(Event const& event) noexcept
 
         case Event::Type::PITCH_WHEEL:
             synth.pitch_wheel_change(
-                event.time_offset,
+                time_offset,
                 0,
                 float_to_midi_word(event.velocity_or_value)
             );
@@ -490,7 +639,7 @@ void Vst3Plugin::Processor::process_event(Event const& event) noexcept
 
         case Event::Type::CONTROL_CHANGE:
             synth.control_change(
-                event.time_offset,
+                time_offset,
                 0,
                 event.note_or_ctl,
                 float_to_midi_byte(event.velocity_or_value)
@@ -499,7 +648,7 @@ void Vst3Plugin::Processor::process_event(Event const& event) noexcept
 
         case Event::Type::CHANNEL_PRESSURE:
             synth.channel_pressure(
-                event.time_offset,
+                time_offset,
                 0,
                 float_to_midi_byte(event.velocity_or_value)
             );
@@ -553,19 +702,32 @@ void Vst3Plugin::Processor::update_bpm(Vst::ProcessData& data) noexcept
 void Vst3Plugin::Processor::generate_samples(Vst::ProcessData& data) noexcept
 {
     if (processSetup.symbolicSampleSize == Vst::SymbolicSampleSizes::kSample64) {
-        renderer.render<double>(
-            (Integer)data.numSamples,
-            (double**)getChannelBuffersPointer(processSetup, data.inputs[0]),
-            (double**)getChannelBuffersPointer(processSetup, data.outputs[0])
-        );
+        generate_samples<double>(data);
     } else if (processSetup.symbolicSampleSize == Vst::SymbolicSampleSizes::kSample32) {
-        renderer.render<float>(
-            (Integer)data.numSamples,
-            (float**)getChannelBuffersPointer(processSetup, data.inputs[0]),
-            (float**)getChannelBuffersPointer(processSetup, data.outputs[0])
-        );
+        generate_samples<float>(data);
+    }
+
+    note_events.flush();
+}
+
+
+template<typename NumberType>
+void Vst3Plugin::Processor::generate_samples(Vst::ProcessData& data) noexcept
+{
+    Integer const sample_count = (Integer)data.numSamples;
+    NumberType** const in_samples = (
+        (NumberType**)getChannelBuffersPointer(processSetup, data.inputs[0])
+    );
+    NumberType** const out_samples = (
+        (NumberType**)getChannelBuffersPointer(processSetup, data.outputs[0])
+    );
+
+    if (note_events.is_empty()) {
+        renderer.render<NumberType>(sample_count, in_samples, out_samples);
     } else {
-        return;
+        renderer.render<NumberType>(
+            sample_count, in_samples, out_samples, note_events
+        );
     }
 }
 
@@ -715,7 +877,11 @@ FUnknown* Vst3Plugin::Controller::createInstance(void* unused)
 }
 
 
-Vst3Plugin::Controller::Controller() : bank(), synth(NULL)
+Vst3Plugin::Controller::Controller()
+    : bank(),
+    synth(NULL),
+    latency_samples(0),
+    is_zero_latency(false)
 {
 }
 
@@ -945,6 +1111,7 @@ tresult PLUGIN_API Vst3Plugin::Controller::notify(Vst::IMessage* message)
 
         setParamNormalized(PATCH_CHANGED_PARAM_ID, new_value < 1.0 ? new_value : 0.0);
         setDirty(true);
+        update_latency();
 
         return kResultOk;
     }
@@ -953,6 +1120,35 @@ tresult PLUGIN_API Vst3Plugin::Controller::notify(Vst::IMessage* message)
 }
 
 
+void Vst3Plugin::Controller::update_latency()
+{
+    if (synth == NULL) {
+        return;
+    }
+
+    /*
+    Parameter changes which affect the latency (e.g. toggling the limiter) also
+    make the synth dirty, so it's enough to check here.
+    */
+    Integer const new_latency_samples = synth->get_latency_samples_atomic();
+    bool const new_is_zero_latency = synth->is_zero_latency_atomic();
+
+    if (
+            new_latency_samples == latency_samples
+            && new_is_zero_latency == is_zero_latency
+    ) {
+        return;
+    }
+
+    latency_samples = new_latency_samples;
+    is_zero_latency = new_is_zero_latency;
+
+    if (componentHandler != NULL) {
+        componentHandler->restartComponent(Vst::kLatencyChanged);
+    }
+}
+
+
 IPlugView* PLUGIN_API Vst3Plugin::Controller::createView(FIDString name)
 {
     if (FIDStringsEqual(name, Vst::ViewType::kEditor)) {
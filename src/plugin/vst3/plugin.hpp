@@ -84,7 +84,7 @@ class Vst3Plugin
                 Event();
                 Event(
                     Type const type,
-                    Seconds const time_offset,
+                    Integer const sample_offset,
                     Midi::Byte const note_or_ctl,
                     Midi::Channel const channel,
                     Number const velocity_or_value
@@ -94,9 +94,8 @@ class Vst3Plugin
 
                 Event& operator=(Event const& event) noexcept = default;
                 Event& operator=(Event&& event) noexcept = default;
-                bool operator<(Event const& event) const noexcept;
 
-                Seconds time_offset;
+                Integer sample_offset;
                 Number velocity_or_value;
                 Type type;
                 Midi::Byte note_or_ctl;
@@ -106,6 +105,25 @@ class Vst3Plugin
         class Processor : public Vst::AudioEffect
         {
             public:
+                static constexpr size_t MAX_EVENTS = 4096;
+
+                /*
+                In zero-latency mode, note events are held back until the
+                rendering reaches them, so that voices start and stop on the
+                exact sample.
+                */
+                static constexpr size_t MAX_NOTE_EVENTS = 1024;
+                static constexpr Integer MIN_SUB_BLOCK_SIZE = 32;
+
+                /*
+                One for each MIDI controller, pitch bend, channel pressure, and
+                program change parameter queue, one for the note events, and
+                one for the program changes that arrive via notify().
+                */
+                static constexpr size_t MAX_EVENT_RUNS = (
+                    Synth::MIDI_CONTROLLERS + 5
+                );
+
                 static FUID const ID;
 
                 static FUnknown* createInstance(void* unused);
@@ -135,7 +153,50 @@ class Vst3Plugin
                 tresult PLUGIN_API setState(IBStream* state) SMTG_OVERRIDE;
                 tresult PLUGIN_API getState(IBStream* state) SMTG_OVERRIDE;
 
+                /**
+                 * \brief Apply a note event which was held back until the
+                 *        event splitting \c Renderer::render() reached its
+                 *        sample offset.
+                 */
+                void handle_event(Event const& event) noexcept;
+
             private:
+                /**
+                 * \brief A time-ordered range of \c events, collected from a
+                 *        single source (a parameter queue, or the event list),
+                 *        and the position of the next event to be processed.
+                 */
+                class EventRun
+                {
+                    public:
+                        EventRun() noexcept;
+                        EventRun(size_t const next, size_t const end) noexcept;
+
+                        size_t next;
+                        size_t end;
+                };
+
+                /**
+                 * \brief Orders a heap of \c EventRun objects so that the run
+                 *        with the earliest next event is at the top. Ties are
+                 *        broken by the collection order.
+                 */
+                class EventRunComparator
+                {
+                    public:
+                        explicit EventRunComparator(
+                            std::vector<Event> const& events
+                        ) noexcept;
+
+                        bool operator()(
+                            EventRun const& a,
+                            EventRun const& b
+                        ) const noexcept;
+
+                    private:
+                        std::vector<Event> const& events;
+                };
+
                 void share_synth() noexcept;
 
                 void collect_param_change_events(Vst::ProcessData& data) noexcept;
@@ -147,8 +208,18 @@ class Vst3Plugin
                 ) noexcept;
 
                 void collect_note_events(Vst::ProcessData& data) noexcept;
+
+                bool push_event(Event const& event) noexcept;
+                void begin_event_run() noexcept;
+                void end_event_run() noexcept;
+
                 void process_events() noexcept;
-                void process_event(Event const& event) noexcept;
+                bool hold_back(Event const& event) noexcept;
+
+                void process_event(
+                    Event const& event,
+                    Seconds const time_offset
+                ) noexcept;
 
                 Midi::Byte float_to_midi_byte(Number const number) const noexcept;
                 Midi::Word float_to_midi_word(Number const number) const noexcept;
@@ -157,13 +228,19 @@ class Vst3Plugin
 
                 void generate_samples(Vst::ProcessData& data) noexcept;
 
+                template<typename NumberType>
+                void generate_samples(Vst::ProcessData& data) noexcept;
+
                 void import_patch(std::string const& serialized) noexcept;
 
                 Synth synth;
                 Renderer renderer;
+                HostEvents<Event, Processor> note_events;
                 MtsEsp mts_esp;
                 Bank const* bank;
                 std::vector<Event> events;
+                std::vector<EventRun> event_runs;
+                size_t event_run_begin;
                 size_t new_program;
                 bool need_to_load_new_program;
 
@@ -248,9 +325,13 @@ class Vst3Plugin
 
                 Vst::RangeParameter* set_up_patch_changed_param() const;
 
+                void update_latency();
+
                 Bank const bank;
 
                 Synth* synth;
+                Integer latency_samples;
+                bool is_zero_latency;
 
             public:
                 OBJ_METHODS(Controller, Vst::EditControllerEx1)
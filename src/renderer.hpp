@@ -20,6 +20,9 @@
 #define JS80P__RENDERER_HPP
 
 #include <algorithm>
+#include <limits>
+#include <type_traits>
+#include <vector>
 
 #include "js80p.hpp"
 
@@ -43,7 +46,161 @@ class Renderer
             synth(synth),
             rendered(NULL),
             next_synth_sample_index(block_size),
-            round(0)
+            round(0),
+            min_sub_block_size(1)
+        {
+            allocate_input();
+        }
+
+        ~Renderer()
+        {
+            free_input();
+        }
+
+        /**
+         * \brief Number of samples by which the rendered signal is delayed.
+         *        In zero-latency mode, only the latency of the effects chain
+         *        (e.g. the lookahead limiter) is reported. Safe to be called
+         *        from any thread.
+         */
+        Integer get_latency_samples() const noexcept
+        {
+            return (
+                (synth.is_zero_latency_atomic() ? 0 : block_size)
+                + synth.get_latency_samples_atomic()
+            );
+        }
+
+        /**
+         * \brief Set the smallest number of samples that the event splitting
+         *        \c render() may render between two dispatches of events.
+         *        Events which fall into a shorter sub-block are dispatched
+         *        together at its end, so dense controller streams turn into
+         *        parameter changes between sub-blocks.
+         */
+        void set_min_sub_block_size(Integer const min_sub_block_size) noexcept
+        {
+            this->min_sub_block_size = std::max((Integer)1, min_sub_block_size);
+        }
+
+        Integer get_min_sub_block_size() const noexcept
+        {
+            return min_sub_block_size;
+        }
+
+        template<typename NumberType, Operation operation = Operation::OVERWRITE>
+        void render(
+                Integer const sample_count,
+                NumberType const* const* const in_samples,
+                NumberType** out_samples
+        ) noexcept {
+            if (JS80P_UNLIKELY(sample_count <= 0)) {
+                return;
+            }
+
+            render_sub_block<NumberType, operation>(
+                synth.is_zero_latency(), 0, sample_count, in_samples, out_samples
+            );
+        }
+
+        /**
+         * \brief Same as \c render(), but the rendering is split up at the
+         *        sample offsets of the events of \c event_dispatcher, so that
+         *        the events which take effect immediately (e.g. voice
+         *        assignment on note-on) happen exactly where they should.
+         *
+         * \note \c EventDispatcherClass must have an
+         *       <tt>Integer dispatch_events(Integer const sample_index)</tt>
+         *       method which processes all the pending events that have a
+         *       sample offset (relative to the beginning of the host's buffer)
+         *       not greater than \c sample_index, as if they happened right
+         *       now, and returns the sample offset of the next pending event,
+         *       or a negative number when there are no more events. (See
+         *       \c HostEvents.)
+         *
+         * \note Sub-blocks are at least \c get_min_sub_block_size() long,
+         *       except for the last one.
+         *
+         * \note Events are sample accurate only in zero-latency mode. In
+         *       block-aligned mode, the synth is already ahead of the host by
+         *       up to a block when an event is dispatched.
+         */
+        template<
+            typename NumberType,
+            Operation operation = Operation::OVERWRITE,
+            class EventDispatcherClass
+        >
+        void render(
+                Integer const sample_count,
+                NumberType const* const* const in_samples,
+                NumberType** out_samples,
+                EventDispatcherClass& event_dispatcher
+        ) noexcept {
+            Integer next_event = event_dispatcher.dispatch_events(0);
+
+            if (JS80P_UNLIKELY(sample_count <= 0)) {
+                return;
+            }
+
+            bool const is_zero_latency = synth.is_zero_latency();
+            Integer const min_sub_block_size = this->min_sub_block_size;
+            Integer first_sample_index = 0;
+
+            while (first_sample_index != sample_count) {
+                Integer const last_sample_index = (
+                    next_event > first_sample_index
+                        ? std::min(
+                            sample_count,
+                            std::max(next_event, first_sample_index + min_sub_block_size)
+                        )
+                        : sample_count
+                );
+
+                render_sub_block<NumberType, operation>(
+                    is_zero_latency,
+                    first_sample_index,
+                    last_sample_index,
+                    in_samples,
+                    out_samples
+                );
+
+                first_sample_index = last_sample_index;
+
+                if (next_event >= 0 && next_event <= first_sample_index) {
+                    next_event = event_dispatcher.dispatch_events(
+                        first_sample_index
+                    );
+                }
+            }
+        }
+
+        /**
+         * \brief Drop the partially consumed block of the synth, and pick up
+         *        its block size if it has changed.
+         *
+         * \warning Not real-time safe when the block size of the synth has
+         *          changed.
+         */
+        void reset() noexcept
+        {
+            if (JS80P_UNLIKELY(block_size != synth.get_block_size())) {
+                free_input();
+                block_size = synth.get_block_size();
+                allocate_input();
+            }
+
+            rendered = NULL;
+            next_synth_sample_index = block_size;
+
+            for (Integer c = 0; c != channels; ++c) {
+                std::fill_n(input[c], block_size, 0.0);
+            }
+        }
+
+    private:
+        static constexpr Integer ROUND_MASK = 0x7fffff;
+
+        void allocate_input() noexcept
         {
             input = new Sample*[channels];
 
@@ -54,7 +211,7 @@ class Renderer
             }
         }
 
-        ~Renderer()
+        void free_input() noexcept
         {
             for (Integer c = 0; c != channels; ++c) {
                 delete[] input[c];
@@ -67,9 +224,57 @@ class Renderer
             input = NULL;
         }
 
-        Integer get_latency_samples() const noexcept
-        {
-            return block_size;
+        /*
+        When the synth is idle, there's nothing to render as long as the input
+        stays silent, so the whole graph is skipped. MIDI events and messages
+        wake the synth up, and since the skipped rounds don't move the block
+        boundaries, it resumes on the same sample as if it had been rendering
+        all along.
+        */
+        template<typename NumberType, Operation operation>
+        void render_sub_block(
+                bool const is_zero_latency,
+                Integer const first_sample_index,
+                Integer const last_sample_index,
+                NumberType const* const* const in_samples,
+                NumberType** out_samples
+        ) noexcept {
+            bool const is_idle = (
+                rendered != NULL
+                && synth.is_idle()
+                && is_input_silent<NumberType>(
+                    in_samples, first_sample_index, last_sample_index
+                )
+            );
+
+            if (is_zero_latency) {
+                if (is_idle) {
+                    next_synth_sample_index = block_size;
+                    synth.skip_idle_samples(
+                        last_sample_index - first_sample_index
+                    );
+                    clear_output<NumberType, operation>(
+                        out_samples,
+                        first_sample_index,
+                        last_sample_index - first_sample_index
+                    );
+                } else {
+                    render_zero_latency<NumberType, operation>(
+                        first_sample_index,
+                        last_sample_index,
+                        in_samples,
+                        out_samples
+                    );
+                }
+            } else if (is_idle) {
+                render_block_aligned<NumberType, operation, true>(
+                    first_sample_index, last_sample_index, in_samples, out_samples
+                );
+            } else {
+                render_block_aligned<NumberType, operation, false>(
+                    first_sample_index, last_sample_index, in_samples, out_samples
+                );
+            }
         }
 
         /*
@@ -78,84 +283,234 @@ class Renderer
         after a shorter one, so we split up rendering batches into equal sized
         chunks.
         */
-        template<typename NumberType, Operation operation = Operation::OVERWRITE>
-        void render(
-                Integer const sample_count,
+        template<typename NumberType, Operation operation, bool is_idle>
+        void render_block_aligned(
+                Integer const first_sample_index,
+                Integer const last_sample_index,
                 NumberType const* const* const in_samples,
                 NumberType** out_samples
         ) noexcept {
-            if (JS80P_UNLIKELY(sample_count <= 0)) {
-                return;
-            }
-
             Integer const block_size = this->block_size;
 
             Integer next_synth_sample_index = this->next_synth_sample_index;
-            Integer next_host_sample_index = 0;
+            Integer next_host_sample_index = first_sample_index;
 
-            while (next_host_sample_index != sample_count) {
+            while (next_host_sample_index != last_sample_index) {
                 if (next_synth_sample_index == block_size) {
                     next_synth_sample_index = 0;
-                    round = (round + 1) & ROUND_MASK;
-                    rendered = synth.generate_samples(round, block_size, input);
+
+                    if constexpr (is_idle) {
+                        synth.skip_idle_samples(block_size);
+                    } else {
+                        round = (round + 1) & ROUND_MASK;
+                        rendered = synth.generate_unclipped_samples(
+                            round, block_size, input
+                        );
+                    }
                 }
 
                 Integer const batch_size = std::min(
-                    sample_count - next_host_sample_index,
+                    last_sample_index - next_host_sample_index,
                     block_size - next_synth_sample_index
                 );
 
-                if (JS80P_LIKELY(input != NULL)) {
-                    for (Integer c = 0; c != Synth::IN_CHANNELS; ++c) {
-                        NumberType const* const src_channel = in_samples[c];
-                        Sample* const dst_channel = input[c];
+                copy_input<NumberType>(
+                    in_samples,
+                    next_host_sample_index,
+                    next_synth_sample_index,
+                    batch_size
+                );
 
-                        for (Integer i = 0; i != batch_size; ++i) {
-                            dst_channel[next_synth_sample_index + i] = (
-                                (Sample)src_channel[next_host_sample_index + i]
-                            );
-                        }
-                    }
+                if constexpr (is_idle) {
+                    clear_output<NumberType, operation>(
+                        out_samples, next_host_sample_index, batch_size
+                    );
+                } else {
+                    copy_output<NumberType, operation>(
+                        out_samples,
+                        next_host_sample_index,
+                        next_synth_sample_index,
+                        batch_size
+                    );
                 }
 
-                for (Integer c = 0; c != Synth::OUT_CHANNELS; ++c) {
-                    Sample const* const src_channel = rendered[c];
-                    NumberType* const dst_channel = out_samples[c];
+                next_synth_sample_index += batch_size;
+                next_host_sample_index += batch_size;
+            }
 
-                    for (Integer i = 0; i != batch_size; ++i) {
-                        if constexpr (operation == Operation::OVERWRITE) {
-                            dst_channel[next_host_sample_index + i] = (
-                                (NumberType)src_channel[next_synth_sample_index + i]
-                            );
-                        } else {
-                            dst_channel[next_host_sample_index + i] += (
-                                (NumberType)src_channel[next_synth_sample_index + i]
-                            );
+            this->next_synth_sample_index = next_synth_sample_index;
+        }
+
+        /*
+        The synth renders exactly as many samples as the host asks for, in
+        chunks of at most one block. Delay lines keep their feedback one full
+        block ahead of their input, so the varying chunk sizes cannot make
+        them run out of feedback samples.
+        */
+        template<typename NumberType, Operation operation>
+        void render_zero_latency(
+                Integer const first_sample_index,
+                Integer const last_sample_index,
+                NumberType const* const* const in_samples,
+                NumberType** out_samples
+        ) noexcept {
+            Integer const block_size = this->block_size;
+
+            Integer next_host_sample_index = first_sample_index;
+
+            /*
+            Samples that were rendered ahead in block-aligned mode are dropped
+            when switching modes.
+            */
+            next_synth_sample_index = block_size;
+
+            while (next_host_sample_index != last_sample_index) {
+                Integer const batch_size = std::min(
+                    last_sample_index - next_host_sample_index,
+                    block_size
+                );
+
+                round = (round + 1) & ROUND_MASK;
+
+                if constexpr (std::is_same<NumberType, Sample>::value) {
+                    /*
+                    The synth consumes the input immediately, so when it's in
+                    the right format already, then there's no need to copy it.
+                    */
+                    if (JS80P_LIKELY(in_samples != NULL)) {
+                        Sample const* host_input[Synth::IN_CHANNELS];
+
+                        for (Integer c = 0; c != Synth::IN_CHANNELS; ++c) {
+                            host_input[c] = &in_samples[c][next_host_sample_index];
                         }
+
+                        rendered = synth.generate_unclipped_samples(
+                            round, batch_size, host_input
+                        );
+                    } else {
+                        rendered = synth.generate_unclipped_samples(
+                            round, batch_size, input
+                        );
                     }
+                } else {
+                    copy_input<NumberType>(
+                        in_samples, next_host_sample_index, 0, batch_size
+                    );
+
+                    rendered = synth.generate_unclipped_samples(
+                        round, batch_size, input
+                    );
                 }
 
-                next_synth_sample_index += batch_size;
+                copy_output<NumberType, operation>(
+                    out_samples, next_host_sample_index, 0, batch_size
+                );
+
                 next_host_sample_index += batch_size;
             }
+        }
 
-            this->next_synth_sample_index = next_synth_sample_index;
+        template<typename NumberType>
+        void copy_input(
+                NumberType const* const* const in_samples,
+                Integer const host_sample_index,
+                Integer const synth_sample_index,
+                Integer const batch_size
+        ) noexcept {
+            if (JS80P_UNLIKELY(in_samples == NULL)) {
+                return;
+            }
+
+            for (Integer c = 0; c != Synth::IN_CHANNELS; ++c) {
+                NumberType const* const src_channel = &in_samples[c][host_sample_index];
+                Sample* const dst_channel = &input[c][synth_sample_index];
+
+                if constexpr (std::is_same<NumberType, Sample>::value) {
+                    std::copy_n(src_channel, batch_size, dst_channel);
+                } else {
+                    for (Integer i = 0; i != batch_size; ++i) {
+                        dst_channel[i] = (Sample)src_channel[i];
+                    }
+                }
+            }
         }
 
-        void reset() noexcept
-        {
-            rendered = NULL;
-            next_synth_sample_index = block_size;
+        template<typename NumberType>
+        bool is_input_silent(
+                NumberType const* const* const in_samples,
+                Integer const first_sample_index,
+                Integer const last_sample_index
+        ) const noexcept {
+            if (JS80P_UNLIKELY(in_samples == NULL)) {
+                return true;
+            }
 
-            for (Integer c = 0; c != channels; ++c) {
-                std::fill_n(input[c], block_size, 0.0);
+            for (Integer c = 0; c != Synth::IN_CHANNELS; ++c) {
+                NumberType const* const channel = in_samples[c];
+
+                for (Integer i = first_sample_index; i != last_sample_index; ++i) {
+                    if (
+                            !Math::is_abs_small(
+                                (Number)channel[i], SignalProducer::SILENCE_THRESHOLD
+                            )
+                    ) {
+                        return false;
+                    }
+                }
             }
+
+            return true;
         }
 
-    private:
-        static constexpr Integer ROUND_MASK = 0x7fffff;
+        template<typename NumberType, Operation operation>
+        void clear_output(
+                NumberType** out_samples,
+                Integer const host_sample_index,
+                Integer const batch_size
+        ) noexcept {
+            if constexpr (operation == Operation::OVERWRITE) {
+                for (Integer c = 0; c != Synth::OUT_CHANNELS; ++c) {
+                    std::fill_n(
+                        &out_samples[c][host_sample_index],
+                        batch_size,
+                        (NumberType)0.0
+                    );
+                }
+            }
+        }
 
-        Integer const block_size;
+        template<typename NumberType, Operation operation>
+        void copy_output(
+                NumberType** out_samples,
+                Integer const host_sample_index,
+                Integer const synth_sample_index,
+                Integer const batch_size
+        ) noexcept {
+            /*
+            The synth leaves the clipping of the output to us, so that it can
+            be done in the same pass as the conversion to the host's format.
+            Keep these loops simple so that they can be vectorized.
+            */
+            for (Integer c = 0; c != Synth::OUT_CHANNELS; ++c) {
+                Sample const* const src_channel = &rendered[c][synth_sample_index];
+                NumberType* const dst_channel = &out_samples[c][host_sample_index];
+
+                for (Integer i = 0; i != batch_size; ++i) {
+                    NumberType const sample = (NumberType)std::min(
+                        Synth::OUTPUT_CLIPPING_LEVEL,
+                        std::max(-Synth::OUTPUT_CLIPPING_LEVEL, src_channel[i])
+                    );
+
+                    if constexpr (operation == Operation::OVERWRITE) {
+                        dst_channel[i] = sample;
+                    } else {
+                        dst_channel[i] += sample;
+                    }
+                }
+            }
+        }
+
+        Integer block_size;
         Integer const channels;
 
         Synth& synth;
@@ -163,6 +518,119 @@ class Renderer
         Sample** input;
         Integer next_synth_sample_index;
         Integer round;
+        Integer min_sub_block_size;
+};
+
+
+/**
+ * \brief Collects the events of a host buffer in the order of their sample
+ *        offsets, and dispatches them to \c EventHandlerClass when the
+ *        event splitting \c Renderer::render() reaches them.
+ *
+ * \note \c EventHandlerClass must have a
+ *       <tt>void handle_event(EventClass const& event)</tt> method, which
+ *       should apply the event right away, i.e. with a time offset of 0.
+ *
+ * \note Hosts usually send events in order, so insertion is O(1) in the
+ *       common case. No memory is allocated after construction; events that
+ *       don't fit are dropped.
+ */
+template<class EventClass, class EventHandlerClass>
+class HostEvents
+{
+    public:
+        HostEvents(EventHandlerClass& event_handler, size_t const capacity)
+            : event_handler(event_handler),
+            capacity(capacity),
+            next_event_index(0)
+        {
+            events.reserve(capacity);
+        }
+
+        void clear() noexcept
+        {
+            events.clear();
+            next_event_index = 0;
+        }
+
+        bool is_empty() const noexcept
+        {
+            return events.empty();
+        }
+
+        size_t length() const noexcept
+        {
+            return events.size();
+        }
+
+        bool push(Integer const sample_offset, EventClass const& event) noexcept
+        {
+            if (JS80P_UNLIKELY(events.size() == capacity)) {
+                return false;
+            }
+
+            events.push_back(Entry(sample_offset, event));
+
+            for (size_t i = events.size() - 1; i != 0; --i) {
+                if (events[i - 1].sample_offset <= sample_offset) {
+                    break;
+                }
+
+                std::swap(events[i - 1], events[i]);
+            }
+
+            return true;
+        }
+
+        Integer dispatch_events(Integer const sample_index) noexcept
+        {
+            size_t const events_count = events.size();
+
+            while (
+                    next_event_index != events_count
+                    && events[next_event_index].sample_offset <= sample_index
+            ) {
+                event_handler.handle_event(events[next_event_index].event);
+                ++next_event_index;
+            }
+
+            return (
+                next_event_index == events_count
+                    ? -1
+                    : events[next_event_index].sample_offset
+            );
+        }
+
+        /**
+         * \brief Dispatch the events which the rendering did not reach (e.g.
+         *        because the host sent a sample offset beyond the end of its
+         *        buffer, or there was nothing to render), then get ready to
+         *        collect the events of the next buffer.
+         */
+        void flush() noexcept
+        {
+            dispatch_events(std::numeric_limits<Integer>::max());
+            clear();
+        }
+
+    private:
+        class Entry
+        {
+            public:
+                Entry(Integer const sample_offset, EventClass const& event)
+                    : sample_offset(sample_offset),
+                    event(event)
+                {
+                }
+
+                Integer sample_offset;
+                EventClass event;
+        };
+
+        EventHandlerClass& event_handler;
+        size_t const capacity;
+        std::vector<Entry> events;
+        size_t next_event_index;
 };
 
 }
@@ -0,0 +1,149 @@
+/*
+ * This file is part of JS80P, a synthesizer plugin.
+ * Copyright (C) 2023, 2024  Attila M. Magyar
+ *
+ * JS80P is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * JS80P is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef JS80P__SEQLOCK_CPP
+#define JS80P__SEQLOCK_CPP
+
+#include <algorithm>
+#include <cstring>
+
+#include "seqlock.hpp"
+
+
+namespace JS80P
+{
+
+template<class ItemClass>
+SeqLock<ItemClass>::SeqLock() noexcept : sequence(0)
+{
+    Word buffer[WORDS];
+    ItemClass const item = ItemClass();
+
+    std::fill_n(buffer, WORDS, 0);
+    memcpy((void*)buffer, (void const*)&item, sizeof(ItemClass));
+
+    for (size_t i = 0; i != WORDS; ++i) {
+        words[i].store(buffer[i]);
+    }
+}
+
+
+template<class ItemClass>
+bool SeqLock<ItemClass>::is_lock_free() const noexcept
+{
+    return sequence.is_lock_free() && words[0].is_lock_free();
+}
+
+
+template<class ItemClass>
+void SeqLock<ItemClass>::write(ItemClass const& item) noexcept
+{
+    Word buffer[WORDS];
+
+    buffer[WORDS - 1] = 0;
+    memcpy((void*)buffer, (void const*)&item, sizeof(ItemClass));
+
+    Word const old_sequence = sequence.load(std::memory_order_relaxed);
+
+    /* An odd sequence number indicates that writing is in progress. */
+    sequence.store(old_sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    for (size_t i = 0; i != WORDS; ++i) {
+        words[i].store(buffer[i], std::memory_order_relaxed);
+    }
+
+    sequence.store(old_sequence + 2, std::memory_order_release);
+}
+
+
+template<class ItemClass>
+bool SeqLock<ItemClass>::read(ItemClass& item) const noexcept
+{
+    Word buffer[WORDS];
+
+    for (int attempt = 0; attempt != MAX_READ_ATTEMPTS; ++attempt) {
+        Word const sequence_before = sequence.load(std::memory_order_acquire);
+
+        if ((sequence_before & 1) != 0) {
+            continue;
+        }
+
+        for (size_t i = 0; i != WORDS; ++i) {
+            buffer[i] = words[i].load(std::memory_order_relaxed);
+        }
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+
+        if (sequence.load(std::memory_order_relaxed) == sequence_before) {
+            memcpy((void*)&item, (void const*)buffer, sizeof(ItemClass));
+
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+template<class ItemClass>
+template<class FieldClass>
+void SeqLock<ItemClass>::read_field(
+        size_t const offset,
+        FieldClass& field
+) const noexcept {
+    static_assert(
+        std::is_trivially_copyable<FieldClass>::value
+        && sizeof(FieldClass) <= sizeof(Word),
+        "SeqLock can only read fields which fit in a single word"
+    );
+
+    /*
+    A naturally aligned field never straddles two words, and each word is stored
+    atomically, so even a failed attempt sees a value which was written as a
+    whole.
+    */
+    size_t const word_index = offset / sizeof(Word);
+    size_t const offset_in_word = offset % sizeof(Word);
+    Word word = 0;
+
+    for (int attempt = 0; attempt != MAX_READ_ATTEMPTS; ++attempt) {
+        Word const sequence_before = sequence.load(std::memory_order_acquire);
+
+        word = words[word_index].load(std::memory_order_relaxed);
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+
+        if (
+                (sequence_before & 1) == 0
+                && sequence.load(std::memory_order_relaxed) == sequence_before
+        ) {
+            break;
+        }
+    }
+
+    memcpy(
+        (void*)&field,
+        (void const*)((unsigned char const*)&word + offset_in_word),
+        sizeof(FieldClass)
+    );
+}
+
+}
+
+#endif
@@ -0,0 +1,102 @@
+/*
+ * This file is part of JS80P, a synthesizer plugin.
+ * Copyright (C) 2023, 2024  Attila M. Magyar
+ *
+ * JS80P is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * JS80P is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef JS80P__SEQLOCK_HPP
+#define JS80P__SEQLOCK_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+
+namespace JS80P
+{
+
+/*
+See Hans-J. Boehm [MSPC 2012]: Can Seqlocks Get Along With Programming Language
+Memory Models?
+  https://www.hpl.hp.com/techreports/2012/HPL-2012-68.pdf
+*/
+
+/**
+ * \brief Publish the most recent version of a small, trivially copyable
+ *        object from a single writer thread to any number of reader threads
+ *        without ever blocking the writer.
+ */
+template<class ItemClass>
+class SeqLock
+{
+    static_assert(
+        std::is_trivially_copyable<ItemClass>::value,
+        "SeqLock can only hold trivially copyable objects"
+    );
+
+    public:
+        static constexpr int MAX_READ_ATTEMPTS = 64;
+
+        SeqLock() noexcept;
+
+        SeqLock(SeqLock<ItemClass> const& seqlock) = delete;
+
+        bool is_lock_free() const noexcept;
+
+        /**
+         * \warning Must only be called from a single thread.
+         */
+        void write(ItemClass const& item) noexcept;
+
+        /**
+         * \brief Copy the most recently written item into \c item.
+         *
+         * \return  \c false if a consistent copy could not be made within
+         *          \c MAX_READ_ATTEMPTS attempts because the writer kept
+         *          overwriting the item, in which case \c item is left
+         *          unchanged.
+         */
+        bool read(ItemClass& item) const noexcept;
+
+        /**
+         * \brief Copy a single field of the most recently written item into
+         *        \c field, without copying the rest of the item.
+         *
+         * \note Never fails: if the writer keeps overwriting the item during
+         *       all the \c MAX_READ_ATTEMPTS attempts, then the value that
+         *       was seen by the last attempt is used, which is the field's
+         *       value either from the previous or from the new item.
+         *
+         * \warning \c offset must be the offset of a naturally aligned field
+         *          within \c ItemClass (e.g. obtained with \c offsetof()).
+         */
+        template<class FieldClass>
+        void read_field(size_t const offset, FieldClass& field) const noexcept;
+
+    private:
+        typedef uint64_t Word;
+
+        static constexpr size_t WORDS = (
+            (sizeof(ItemClass) + sizeof(Word) - 1) / sizeof(Word)
+        );
+
+        std::atomic<Word> sequence;
+        std::atomic<Word> words[WORDS];
+};
+
+}
+
+#endif
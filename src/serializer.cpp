@@ -42,6 +42,23 @@ std::string Serializer::serialize(Synth const& synth) noexcept
     constexpr size_t line_size = 128;
     char line[line_size];
     std::string serialized("");
+    Synth::ParamsSnapshot params_snapshot;
+
+    /*
+    Reading only fails when the audio thread keeps publishing new snapshots
+    during the read attempts. Instead of spinning until it calms down, the
+    params are then read one by one, each from the latest snapshot.
+    */
+    if (!synth.get_params_snapshot(params_snapshot)) {
+        for (int i = 0; i != Synth::ParamId::PARAM_ID_COUNT; ++i) {
+            Synth::ParamId const param_id = (Synth::ParamId)i;
+
+            params_snapshot.ratios[i] = synth.get_param_ratio_atomic(param_id);
+            params_snapshot.controller_ids[i] = (
+                (Byte)synth.get_param_controller_id_atomic(param_id)
+            );
+        }
+    }
 
     serialized.reserve(MAX_SIZE);
     serialized += "[";
@@ -53,13 +70,13 @@ std::string Serializer::serialize(Synth const& synth) noexcept
         Synth::ParamId const param_id = (Synth::ParamId)i;
         std::string const param_name = synth.get_param_name(param_id);
 
-        if (param_name.length() > 0) {
+        if (param_name.length() > 0 && !synth.is_instance_setting(param_id)) {
             Synth::ControllerId const controller_id = (
-                synth.get_param_controller_id_atomic(param_id)
+                (Synth::ControllerId)params_snapshot.controller_ids[param_id]
             );
 
             if (controller_id == Synth::ControllerId::NONE) {
-                Number const set_ratio = synth.get_param_ratio_atomic(param_id);
+                Number const set_ratio = params_snapshot.ratios[param_id];
                 Number const default_ratio = synth.get_param_default_ratio(param_id);
 
                 if (std::fabs(default_ratio - set_ratio) > 0.000001) {
@@ -319,6 +336,10 @@ void Serializer::process_lines(Synth& synth, Lines* lines) noexcept
             send_message<thread>(synth, *it);
         }
     }
+
+    if constexpr (thread == Thread::AUDIO) {
+        synth.publish_params_snapshot();
+    }
 }
 
 
@@ -432,6 +453,7 @@ void Serializer::process_line(
 
     if (
             param_id == Synth::ParamId::INVALID_PARAM_ID
+            || synth.is_instance_setting(param_id)
             || (suffix[0] != '\x00' && !is_controller_assignment)
     ) {
         return;
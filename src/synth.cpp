@@ -32,6 +32,7 @@
 #include "dsp/biquad_filter.cpp"
 #include "dsp/chorus.cpp"
 #include "dsp/delay.cpp"
+#include "dsp/delay_buffer_pool.cpp"
 #include "dsp/distortion.cpp"
 #include "dsp/echo.cpp"
 #include "dsp/effect.cpp"
@@ -41,8 +42,10 @@
 #include "dsp/gain.cpp"
 #include "dsp/lfo.cpp"
 #include "dsp/lfo_envelope_list.cpp"
+#include "dsp/limiter.cpp"
 #include "dsp/macro.cpp"
 #include "dsp/math.cpp"
+#include "dsp/meter.cpp"
 #include "dsp/midi_controller.cpp"
 #include "dsp/mixer.cpp"
 #include "dsp/oscillator.cpp"
@@ -56,8 +59,11 @@
 #include "dsp/wavetable.cpp"
 
 #include "note_stack.cpp"
+#include "seqlock.cpp"
 #include "spscqueue.cpp"
 #include "voice.cpp"
+#include "voice_param_bank.cpp"
+#include "worker_pool.cpp"
 
 
 namespace JS80P
@@ -159,7 +165,7 @@ Synth::ModeParam::ModeParam(std::string const& name) noexcept
 Synth::Synth(Integer const samples_between_gc) noexcept
     : SignalProducer(
         OUT_CHANNELS,
-        8                           /* NH + MODE + MIX + PM + FM + AM + INVOL + bus */
+        9                           /* NH + MODE + MIX + PM + FM + AM + INVOL + bus + voice params */
         + 43 * 2                    /* Modulator::Params + Carrier::Params  */
         + POLYPHONY * 2             /* modulators + carriers                */
         + 1                         /* effects                              */
@@ -174,6 +180,8 @@ Synth::Synth(Integer const samples_between_gc) noexcept
         NOTE_HANDLING_POLYPHONIC
     ),
     mode("MODE"),
+    mpe("MPE", ToggleParam::OFF),
+    zero_latency("ZLAT", ToggleParam::OFF),
     modulator_add_volume(
         "MIX",
         0.0,
@@ -212,6 +220,7 @@ Synth::Synth(Integer const samples_between_gc) noexcept
     carrier_params("C", (Envelope* const*)&envelopes_rw),
     input_volume("IN", 0.0, 1.0, 0.0),
     messages(MESSAGE_QUEUE_SIZE),
+    voice_param_bank(POLYPHONY * 2),
     bus(
         OUT_CHANNELS,
         modulators,
@@ -219,11 +228,14 @@ Synth::Synth(Integer const samples_between_gc) noexcept
         carriers,
         carrier_params,
         POLYPHONY,
+        voice_param_bank,
         modulator_add_volume,
         input_volume
     ),
+    active_params_count(0),
     samples_since_gc(0),
     samples_between_gc(samples_between_gc),
+    silent_samples(0),
     next_voice(0),
     next_note_id(0),
     previous_note(Midi::NOTE_MAX + 1),
@@ -231,7 +243,17 @@ Synth::Synth(Integer const samples_between_gc) noexcept
     is_sustain_pedal_on(false),
     is_polyphonic_(true),
     is_holding_(false),
+    is_mpe_on_(false),
     is_dirty_(false),
+    is_params_snapshot_dirty(true),
+    are_voice_buffers_released_(false),
+    is_rendering_offline_(false),
+    is_clipping_output(true),
+    worker_deque(NULL),
+    pitch_wheel_expression(channel_pitch_wheels, 0.5),
+    channel_pressure_expression(channel_pressure_ctls, 0.0),
+    timbre_expression(channel_timbres, 0.5),
+    macro_scheduler((Macro* const*)macros_rw, MACROS),
     effects(
         "E",
         bus,
@@ -244,15 +266,14 @@ Synth::Synth(Integer const samples_between_gc) noexcept
     lfos((LFO* const*)lfos_rw)
 {
     is_mts_esp_connected_.store(false);
+    is_metering.store(false);
+    limiter_latency_samples.store(effects.limiter.get_lookahead_latency_samples());
 
     deferred_note_offs.reserve(2 * POLYPHONY);
 
     allocate_buffers();
 
     for (int i = 0; i != (int)ParamId::PARAM_ID_COUNT; ++i) {
-        param_ratios[i].store(0.0);
-        controller_assignments[i].store(ControllerId::NONE);
-
         sample_evaluated_float_params[i] = NULL;
         block_evaluated_float_params[i] = NULL;
         byte_params[i] = NULL;
@@ -262,12 +283,16 @@ Synth::Synth(Integer const samples_between_gc) noexcept
 
     build_frequency_table();
     register_main_params();
+    register_child(voice_param_bank);
     register_child(bus);
     register_modulator_params();
     register_carrier_params();
     register_child(effects);
     register_effects_params();
 
+    effects.use_delay_buffer_pool(delay_buffer_pool);
+    delay_buffer_pool.allocate();
+
     create_envelopes();
     create_lfos();
     create_voices();
@@ -284,6 +309,15 @@ Synth::Synth(Integer const samples_between_gc) noexcept
     channel_pressure_ctl.change(0.0, 0.0);
     channel_pressure_ctl.clear();
 
+    for (Midi::Channel channel = 0; channel != Midi::CHANNELS; ++channel) {
+        channel_pressure_ctls[channel].change(0.0, 0.0);
+        channel_pressure_ctls[channel].clear();
+    }
+
+    pitch_wheel.set_channel_controllers(channel_pitch_wheels);
+    channel_pressure_ctl.set_channel_controllers(channel_pressure_ctls);
+    midi_controllers_rw[Midi::SOUND_5]->set_channel_controllers(channel_timbres);
+
     midi_controllers_rw[Midi::SUSTAIN_PEDAL]->change(0.0, 0.0);
     midi_controllers_rw[Midi::SUSTAIN_PEDAL]->clear();
 
@@ -303,6 +337,12 @@ Synth::Synth(Integer const samples_between_gc) noexcept
     vol_3_peak.clear();
 
     update_param_states();
+
+    std::fill_n(is_param_active, (int)ParamId::EV3V, false);
+
+    for (int i = 0; i != (int)ParamId::EV3V; ++i) {
+        activate_param((ParamId)i);
+    }
 }
 
 
@@ -340,6 +380,8 @@ void Synth::register_main_params() noexcept
 {
     register_param_as_child<ByteParam>(ParamId::NH, note_handling);
     register_param_as_child<ModeParam>(ParamId::MODE, mode);
+    register_param<ToggleParam>(ParamId::MPE, mpe);
+    register_param<ToggleParam>(ParamId::ZLAT, zero_latency);
     register_param_as_child<FloatParamS>(ParamId::MIX, modulator_add_volume);
     register_param_as_child<FloatParamS>(ParamId::PM, phase_modulation_level);
     register_param_as_child<FloatParamS>(ParamId::FM, frequency_modulation_level);
@@ -539,6 +581,7 @@ void Synth::register_effects_params() noexcept
     register_param<ToggleParam>(ParamId::ERLHQ, effects.reverb.log_scale_high_pass_q);
 
     register_param<FloatParamS>(ParamId::EV3V, effects.volume_3_gain);
+    register_param<ToggleParam>(ParamId::ELIM, effects.limiter_enabled);
 }
 
 
@@ -556,7 +599,9 @@ void Synth::create_voices() noexcept
             calculate_inaccuracy_seed((i + 23) % POLYPHONY),
             modulator_params,
             &biquad_filter_shared_buffers[0],
-            &biquad_filter_shared_buffers[1]
+            &biquad_filter_shared_buffers[1],
+            &voice_param_bank,
+            i
         );
         register_child(*modulators[i]);
 
@@ -571,7 +616,9 @@ void Synth::create_voices() noexcept
             frequency_modulation_level,
             phase_modulation_level,
             &biquad_filter_shared_buffers[2],
-            &biquad_filter_shared_buffers[3]
+            &biquad_filter_shared_buffers[3],
+            &voice_param_bank,
+            POLYPHONY + i
         );
         register_child(*carriers[i]);
     }
@@ -880,6 +927,8 @@ Synth::ParamType Synth::find_param_type(ParamId const param_id) const noexcept
 
 Synth::~Synth()
 {
+    WorkerPool::release_deque(worker_deque);
+
     for (Integer i = 0; i != POLYPHONY; ++i) {
         delete carriers[i];
         delete modulators[i];
@@ -913,6 +962,14 @@ void Synth::set_sample_rate(Frequency const new_sample_rate) noexcept
     SignalProducer::set_sample_rate(new_sample_rate);
 
     samples_between_gc = std::max((Integer)5000, (Integer)(new_sample_rate * 0.2));
+
+    for (Integer i = 0; i != MeterId::METERS; ++i) {
+        meters[i].set_sample_rate(new_sample_rate);
+    }
+
+    limiter_latency_samples.store(effects.limiter.get_lookahead_latency_samples());
+
+    delay_buffer_pool.allocate();
 }
 
 
@@ -924,7 +981,16 @@ void Synth::set_block_size(Integer const new_block_size) noexcept
 
     SignalProducer::set_block_size(new_block_size);
 
+    if (are_voice_buffers_released_) {
+        /* The voices are children, so they were resized along the synth. */
+        for (Integer v = 0; v != POLYPHONY; ++v) {
+            modulators[v]->set_block_size(RELEASED_VOICE_BLOCK_SIZE);
+            carriers[v]->set_block_size(RELEASED_VOICE_BLOCK_SIZE);
+        }
+    }
+
     reallocate_buffers();
+    delay_buffer_pool.allocate();
 }
 
 
@@ -933,6 +999,7 @@ void Synth::reset() noexcept
     SignalProducer::reset();
 
     next_voice = 0;
+    silent_samples = 0;
 
     osc_1_peak_tracker.reset();
     osc_2_peak_tracker.reset();
@@ -947,20 +1014,15 @@ void Synth::reset() noexcept
 #ifdef JS80P_ASSERTIONS
 bool Synth::is_lock_free() const noexcept
 {
-    bool is_lock_free = true;
-
-    for (int i = 0; is_lock_free && i != ParamId::PARAM_ID_COUNT; ++i) {
-        is_lock_free = (
-            param_ratios[i].is_lock_free()
-            && controller_assignments[i].is_lock_free()
-        );
-    }
-
     return (
-        is_lock_free
+        params_snapshot.is_lock_free()
         && messages.is_lock_free()
         && is_mts_esp_connected_.is_lock_free()
         && active_voices_count.is_lock_free()
+        && is_metering.is_lock_free()
+        && limiter_latency_samples.is_lock_free()
+        && meters[0].is_lock_free()
+        && delay_buffer_pool.is_lock_free()
     );
 }
 #endif
@@ -981,11 +1043,20 @@ void Synth::clear_dirty_flag() noexcept
 void Synth::suspend() noexcept
 {
     stop_lfos();
+
+    /*
+    The delay lines are cleared anyways, so the memory that they have touched
+    can be given back while there's nothing to render. Resetting the effects
+    makes them lease their buffers again when rendering is resumed.
+    */
+    delay_buffer_pool.trim();
+
     this->reset();
     clear_midi_controllers();
     clear_midi_note_to_voice_assignments();
     clear_sustain();
     clear_note_stack();
+    release_voice_buffers();
 }
 
 
@@ -1001,6 +1072,7 @@ void Synth::stop_lfos() noexcept
 
 void Synth::resume() noexcept
 {
+    restore_voice_buffers();
     this->reset();
     clear_midi_controllers();
     clear_midi_note_to_voice_assignments();
@@ -1010,12 +1082,203 @@ void Synth::resume() noexcept
 }
 
 
+bool Synth::are_voice_buffers_released() const noexcept
+{
+    return are_voice_buffers_released_;
+}
+
+
+void Synth::release_voice_buffers() noexcept
+{
+    if (are_voice_buffers_released_) {
+        return;
+    }
+
+    /*
+    The voices make up the bulk of the memory of an instance, but while the
+    synth is suspended, there's nothing to render, so the buffers can be
+    shrunk to the minimum. The buffers which are shared between the voices
+    are owned by the synth, so they are not affected.
+    */
+    for (Integer v = 0; v != POLYPHONY; ++v) {
+        modulators[v]->set_block_size(RELEASED_VOICE_BLOCK_SIZE);
+        carriers[v]->set_block_size(RELEASED_VOICE_BLOCK_SIZE);
+    }
+
+    bus.set_voices_suspended(true);
+    are_voice_buffers_released_ = true;
+}
+
+
+void Synth::restore_voice_buffers() noexcept
+{
+    if (!are_voice_buffers_released_) {
+        return;
+    }
+
+    for (Integer v = 0; v != POLYPHONY; ++v) {
+        modulators[v]->set_block_size(this->block_size);
+        carriers[v]->set_block_size(this->block_size);
+    }
+
+    bus.set_voices_suspended(false);
+    are_voice_buffers_released_ = false;
+}
+
+
+void Synth::set_parallel_rendering(bool const is_enabled) noexcept
+{
+    if (is_enabled == (worker_deque != NULL)) {
+        return;
+    }
+
+    if (is_enabled) {
+        worker_deque = WorkerPool::acquire_deque();
+    } else {
+        WorkerPool::release_deque(worker_deque);
+        worker_deque = NULL;
+    }
+}
+
+
+bool Synth::is_rendering_in_parallel() const noexcept
+{
+    return worker_deque != NULL;
+}
+
+
+void Synth::set_offline_rendering(bool const is_enabled) noexcept
+{
+    if (is_enabled == is_rendering_offline_) {
+        return;
+    }
+
+    is_rendering_offline_ = is_enabled;
+
+    for (Integer v = 0; v != POLYPHONY; ++v) {
+        modulators[v]->use_lagrange_interpolation_only(is_enabled);
+        carriers[v]->use_lagrange_interpolation_only(is_enabled);
+    }
+
+    set_parallel_rendering(is_enabled);
+}
+
+
+bool Synth::is_rendering_offline() const noexcept
+{
+    return is_rendering_offline_;
+}
+
+
 Integer Synth::get_active_voices_count() const noexcept
 {
     return active_voices_count.load();
 }
 
 
+Integer Synth::get_active_params_count() const noexcept
+{
+    return active_params_count;
+}
+
+
+Integer Synth::get_latency_samples() const noexcept
+{
+    return effects.get_latency_samples();
+}
+
+
+Integer Synth::get_latency_samples_atomic() const noexcept
+{
+    if (get_param_ratio_atomic(ParamId::ELIM) < 0.5) {
+        return 0;
+    }
+
+    return limiter_latency_samples.load();
+}
+
+
+bool Synth::is_zero_latency() const noexcept
+{
+    return zero_latency.get_value() == ToggleParam::ON;
+}
+
+
+bool Synth::is_zero_latency_atomic() const noexcept
+{
+    return get_param_ratio_atomic(ParamId::ZLAT) >= 0.5;
+}
+
+
+bool Synth::is_idle() const noexcept
+{
+    return (
+        silent_samples > get_latency_samples() + get_block_size()
+        && messages.is_empty()
+    );
+}
+
+
+void Synth::skip_idle_samples(Integer const sample_count) noexcept
+{
+    if (is_metering.load()) {
+        for (Integer i = 0; i != MeterId::METERS; ++i) {
+            meters[i].update_with_silence(channels, sample_count);
+        }
+    }
+
+    publish_params_snapshot();
+}
+
+
+void Synth::stop_idling() noexcept
+{
+    silent_samples = 0;
+}
+
+
+size_t Synth::get_delay_buffer_pool_size() const noexcept
+{
+    return delay_buffer_pool.get_size();
+}
+
+
+size_t Synth::get_leased_delay_buffer_size() const noexcept
+{
+    return delay_buffer_pool.get_leased_size();
+}
+
+
+void Synth::start_metering() noexcept
+{
+    is_metering.store(true);
+}
+
+
+void Synth::stop_metering() noexcept
+{
+    is_metering.store(false);
+}
+
+
+bool Synth::get_meter_snapshot(
+        MeterId const meter_id,
+        Meter::Snapshot& snapshot
+) const noexcept {
+    if (JS80P_UNLIKELY(meter_id < 0 || meter_id >= MeterId::METERS)) {
+        return false;
+    }
+
+    return meters[meter_id].get_snapshot(snapshot);
+}
+
+
+bool Synth::get_params_snapshot(ParamsSnapshot& snapshot) const noexcept
+{
+    return params_snapshot.read(snapshot);
+}
+
+
 bool Synth::has_mts_esp_tuning() const noexcept
 {
     return (
@@ -1128,6 +1391,8 @@ void Synth::note_on(
         Midi::Note const note,
         Midi::Byte const velocity
 ) noexcept {
+    stop_idling();
+
     Number const velocity_float = midi_byte_to_float(velocity);
 
     reset_voice_statuses();
@@ -1266,6 +1531,13 @@ void Synth::trigger_note_on_voice(
         }
     }
 
+    Midi::Channel const expression_channel = (
+        is_expression_channel(channel) ? channel : Midi::INVALID_CHANNEL
+    );
+
+    modulators[voice]->set_expression_channel(time_offset, expression_channel);
+    carriers[voice]->set_expression_channel(time_offset, expression_channel);
+
     previous_note = note;
 }
 
@@ -1364,6 +1636,11 @@ void Synth::trigger_note_on_voice_monophonic(
             time_offset, next_note_id, note, channel, velocity, previous_note, should_sync_oscillator_inaccuracy
         );
     }
+
+    voice.set_expression_channel(
+        time_offset,
+        is_expression_channel(channel) ? channel : Midi::INVALID_CHANNEL
+    );
 }
 
 
@@ -1379,12 +1656,25 @@ Number Synth::midi_word_to_float(Midi::Word const midi_word) const noexcept
 }
 
 
+/*
+Unlike the pitch wheel, whose center must map to exactly 0.5, a 14-bit
+controller must be able to reach 1.0, the same as its 7-bit counterpart.
+*/
+Number Synth::midi_14_bit_controller_value_to_float(
+        Midi::Word const midi_word
+) const noexcept {
+    return (Number)midi_word * MIDI_14_BIT_CONTROLLER_SCALE;
+}
+
+
 void Synth::aftertouch(
         Seconds const time_offset,
         Midi::Channel const channel,
         Midi::Note const note,
         Midi::Byte const pressure
 ) noexcept {
+    stop_idling();
+
     // if (midi_note_to_voice_assignments[channel][note] == INVALID_VOICE) {
         // return;
     // }
@@ -1398,6 +1688,19 @@ void Synth::channel_pressure(
         Midi::Channel const channel,
         Midi::Byte const pressure
 ) noexcept {
+    stop_idling();
+
+    if (is_expression_channel(channel)) {
+        channel_pressure_expression.change_member(
+            time_offset,
+            channel,
+            midi_byte_to_float(pressure),
+            channel_pressure_ctl.get_value()
+        );
+
+        return;
+    }
+
     if (
             is_repeated_midi_controller_message(
                 ControllerId::CHANNEL_PRESSURE, time_offset, channel, pressure
@@ -1407,6 +1710,12 @@ void Synth::channel_pressure(
     }
 
     channel_pressure_ctl.change(time_offset, midi_byte_to_float(pressure));
+
+    if (is_mpe_on()) {
+        channel_pressure_expression.change_manager(
+            time_offset, channel_pressure_ctl.get_value()
+        );
+    }
 }
 
 
@@ -1439,6 +1748,8 @@ void Synth::note_off(
         Midi::Note const note,
         Midi::Byte const velocity
 ) noexcept {
+    stop_idling();
+
     Integer const voice = midi_note_to_voice_assignments[channel][note];
     bool const was_note_stack_top = note_stack.is_top(channel, note);
 
@@ -1518,6 +1829,43 @@ void Synth::control_change(
         Midi::Controller const controller,
         Midi::Byte const new_value
 ) noexcept {
+    stop_idling();
+
+    if (!is_supported_midi_controller(controller)) {
+        return;
+    }
+
+    if (controller == Midi::SOUND_5 && is_expression_channel(channel)) {
+        timbre_expression.change_member(
+            time_offset,
+            channel,
+            midi_byte_to_float(new_value),
+            midi_controllers_rw[Midi::SOUND_5]->get_value()
+        );
+
+        return;
+    }
+
+    if (
+            is_repeated_midi_controller_message(
+                (ControllerId)controller, time_offset, channel, new_value
+            )
+    ) {
+        return;
+    }
+
+    change_midi_controller(time_offset, controller, midi_byte_to_float(new_value));
+}
+
+
+void Synth::control_change_14_bit(
+        Seconds const time_offset,
+        Midi::Channel const channel,
+        Midi::Controller const controller,
+        Midi::Word const new_value
+) noexcept {
+    stop_idling();
+
     if (!is_supported_midi_controller(controller)) {
         return;
     }
@@ -1530,20 +1878,53 @@ void Synth::control_change(
         return;
     }
 
+    change_midi_controller(
+        time_offset, controller, midi_14_bit_controller_value_to_float(new_value)
+    );
+}
+
+
+/*
+Per-note expression messages are routed via fixed lookup tables: the channel
+selects the per-channel controller, and the parameters of each voice look up
+the controller which belongs to the channel of their note.
+*/
+bool Synth::is_expression_channel(Midi::Channel const channel) const noexcept
+{
+    return is_mpe_on() && channel != MPE_MANAGER_CHANNEL;
+}
+
+
+bool Synth::is_mpe_on() const noexcept
+{
+    return mpe.get_value() == ToggleParam::ON;
+}
+
+
+void Synth::change_midi_controller(
+        Seconds const time_offset,
+        Midi::Controller const controller,
+        Number const new_value
+) noexcept {
     if (is_learning) {
         for (int i = 0; i != ParamId::PARAM_ID_COUNT; ++i) {
-            if (controller_assignments[i].load() == ControllerId::MIDI_LEARN) {
+            if (params_snapshot_rw.controller_ids[i] == ControllerId::MIDI_LEARN) {
                 handle_assign_controller((ParamId)i, controller);
             }
         }
 
         is_learning = false;
+        publish_params_snapshot();
     }
 
-    midi_controllers_rw[controller]->change(time_offset, midi_byte_to_float(new_value));
+    midi_controllers_rw[controller]->change(time_offset, new_value);
 
-    if (controller == Midi::SUSTAIN_PEDAL) {
-        if (new_value < 64) {
+    if (controller == Midi::SOUND_5 && is_mpe_on()) {
+        timbre_expression.change_manager(
+            time_offset, midi_controllers_rw[controller]->get_value()
+        );
+    } else if (controller == Midi::SUSTAIN_PEDAL) {
+        if (new_value < 0.5) {
             sustain_off(time_offset);
         } else {
             sustain_on(time_offset);
@@ -1668,6 +2049,19 @@ void Synth::pitch_wheel_change(
         Midi::Channel const channel,
         Midi::Word const new_value
 ) noexcept {
+    stop_idling();
+
+    if (is_expression_channel(channel)) {
+        pitch_wheel_expression.change_member(
+            time_offset,
+            channel,
+            midi_word_to_float(new_value),
+            pitch_wheel.get_value()
+        );
+
+        return;
+    }
+
     if (
             is_repeated_midi_controller_message(
                 ControllerId::PITCH_WHEEL, time_offset, channel, new_value
@@ -1677,6 +2071,10 @@ void Synth::pitch_wheel_change(
     }
 
     pitch_wheel.change(time_offset, midi_word_to_float(new_value));
+
+    if (is_mpe_on()) {
+        pitch_wheel_expression.change_manager(time_offset, pitch_wheel.get_value());
+    }
 }
 
 
@@ -1684,8 +2082,17 @@ void Synth::all_sound_off(
         Seconds const time_offset,
         Midi::Channel const channel
 ) noexcept {
-    suspend();
-    resume();
+    /*
+    Same as suspend() and resume(), but without giving back and reacquiring
+    memory, since this runs in the audio thread.
+    */
+    stop_lfos();
+    this->reset();
+    clear_midi_controllers();
+    clear_midi_note_to_voice_assignments();
+    clear_sustain();
+    clear_note_stack();
+    start_lfos();
 }
 
 
@@ -1700,6 +2107,8 @@ void Synth::all_notes_off(
         Seconds const time_offset,
         Midi::Channel const channel
 ) noexcept {
+    stop_idling();
+
     for (Integer voice = 0; voice != POLYPHONY; ++voice) {
         Modulator* const modulator = modulators[voice];
 
@@ -1732,6 +2141,8 @@ void Synth::mono_mode_on(
         Seconds const time_offset,
         Midi::Channel const channel
 ) noexcept {
+    stop_idling();
+
     note_handling.set_value(
         note_handling.get_value() & (~NOTE_HANDLING_MASK_POLY_OR_RETRIG)
     );
@@ -1743,6 +2154,8 @@ void Synth::mono_mode_off(
         Seconds const time_offset,
         Midi::Channel const channel
 ) noexcept {
+    stop_idling();
+
     note_handling.set_value(
         note_handling.get_value() | NOTE_HANDLING_MASK_POLYPHONIC
     );
@@ -1761,6 +2174,19 @@ Sample const* const* Synth::generate_samples(
 }
 
 
+Sample const* const* Synth::generate_unclipped_samples(
+        Integer const round,
+        Integer const sample_count,
+        Sample const* const* const input
+) noexcept {
+    is_clipping_output = false;
+    generate_samples(round, sample_count, input);
+    is_clipping_output = true;
+
+    return raw_output;
+}
+
+
 void Synth::push_message(
         MessageType const type,
         ParamId const param_id,
@@ -1806,7 +2232,14 @@ void Synth::get_param_id_hash_table_statistics(
 
 Number Synth::get_param_ratio_atomic(ParamId const param_id) const noexcept
 {
-    return param_ratios[param_id].load();
+    Number ratio;
+
+    params_snapshot.read_field(
+        offsetof(ParamsSnapshot, ratios) + (size_t)param_id * sizeof(Number),
+        ratio
+    );
+
+    return ratio;
 }
 
 
@@ -1841,6 +2274,12 @@ bool Synth::is_discrete_param(ParamId const param_id) const noexcept
 }
 
 
+bool Synth::is_instance_setting(ParamId const param_id) const noexcept
+{
+    return param_id == ParamId::ZLAT;
+}
+
+
 Number Synth::get_param_max_value(ParamId const param_id) const noexcept
 {
     size_t const index = (size_t)param_id;
@@ -1929,7 +2368,17 @@ Byte Synth::byte_param_ratio_to_display_value(
 Synth::ControllerId Synth::get_param_controller_id_atomic(
         ParamId const param_id
 ) const noexcept {
-    return (ControllerId)controller_assignments[param_id].load();
+    Byte controller_id;
+
+    params_snapshot.read_field(
+        (
+            offsetof(ParamsSnapshot, controller_ids)
+            + (size_t)param_id * sizeof(Byte)
+        ),
+        controller_id
+    );
+
+    return (ControllerId)controller_id;
 }
 
 
@@ -1938,6 +2387,8 @@ void Synth::update_param_states() noexcept
     for (int i = 0; i != ParamId::PARAM_ID_COUNT; ++i) {
         handle_refresh_param((ParamId)i);
     }
+
+    publish_params_snapshot();
 }
 
 
@@ -1947,6 +2398,8 @@ Sample const* const* Synth::initialize_rendering(
 ) noexcept {
     process_messages();
 
+    macro_scheduler.update();
+
     samples_since_gc += sample_count;
 
     if (samples_since_gc > samples_between_gc) {
@@ -1954,21 +2407,18 @@ Sample const* const* Synth::initialize_rendering(
         samples_since_gc = 0;
     }
 
+    if (worker_deque != NULL && can_render_voices_in_parallel()) {
+        prepare_parallel_rendering(round, sample_count);
+        bus.set_worker_deque(worker_deque);
+    } else {
+        bus.set_worker_deque(NULL);
+    }
+
     raw_output = SignalProducer::produce< Effects::Effects<Bus> >(
         effects, round, sample_count
     );
 
-    for (int i = 0; i != (int)ParamId::EV3V; ++i) {
-        if (sample_evaluated_float_params[i] != NULL) {
-            FloatParamS::produce_if_not_constant(
-                *sample_evaluated_float_params[i], round, sample_count
-            );
-        } else if (block_evaluated_float_params[i] != NULL) {
-            FloatParamB::produce_if_not_constant(
-                *block_evaluated_float_params[i], round, sample_count
-            );
-        }
-    }
+    produce_active_params(round, sample_count);
 
     for (Byte i = 0; i != Constants::LFOS; ++i) {
         lfos_rw[i]->skip_round(round, sample_count);
@@ -1982,6 +2432,116 @@ Sample const* const* Synth::initialize_rendering(
 }
 
 
+bool Synth::can_render_voices_in_parallel() const noexcept
+{
+    /*
+    Polyphonic LFOs are rendered for each voice by the same LFO objects, so
+    voices which use them cannot be rendered concurrently.
+    */
+    for (Byte i = 0; i != Constants::LFOS; ++i) {
+        if (lfos_rw[i]->has_envelope()) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+void Synth::prepare_parallel_rendering(
+        Integer const round,
+        Integer const sample_count
+) noexcept {
+    /*
+    The modulators and the carriers have their own param leaders, but they
+    may share LFOs and envelopes. LFOs are rendered once per round and then
+    they are cached, envelopes lazily update their state when they are first
+    used, so these are done up front, before the voices start to race for
+    them.
+    */
+    for (Integer i = 0; i != active_params_count; ++i) {
+        ParamId const param_id = active_params[i];
+        LFO* const lfo = (
+            sample_evaluated_float_params[param_id] != NULL
+                ? sample_evaluated_float_params[param_id]->get_lfo()
+                : block_evaluated_float_params[param_id]->get_lfo()
+        );
+
+        if (lfo != NULL) {
+            SignalProducer::produce<LFO>(*lfo, round, sample_count);
+        }
+    }
+
+    for (Byte i = 0; i != Constants::ENVELOPES; ++i) {
+        envelopes_rw[i]->update();
+    }
+}
+
+
+void Synth::activate_param(ParamId const param_id) noexcept
+{
+    if ((int)param_id >= (int)ParamId::EV3V || is_param_active[param_id]) {
+        return;
+    }
+
+    if (
+            sample_evaluated_float_params[param_id] == NULL
+            && block_evaluated_float_params[param_id] == NULL
+    ) {
+        return;
+    }
+
+    is_param_active[param_id] = true;
+    active_params[active_params_count++] = param_id;
+}
+
+
+void Synth::produce_active_params(
+        Integer const round,
+        Integer const sample_count
+) noexcept {
+    Integer i = 0;
+
+    while (i != active_params_count) {
+        ParamId const param_id = active_params[i];
+        bool const is_active = (
+            sample_evaluated_float_params[param_id] != NULL
+                ? produce_if_active<FloatParamS>(
+                    *sample_evaluated_float_params[param_id], round, sample_count
+                )
+                : produce_if_active<FloatParamB>(
+                    *block_evaluated_float_params[param_id], round, sample_count
+                )
+        );
+
+        if (is_active) {
+            ++i;
+        } else {
+            is_param_active[param_id] = false;
+            active_params[i] = active_params[--active_params_count];
+        }
+    }
+}
+
+
+template<class FloatParamClass>
+bool Synth::produce_if_active(
+        FloatParamClass& param,
+        Integer const round,
+        Integer const sample_count
+) noexcept {
+    FloatParamClass::produce_if_not_constant(param, round, sample_count);
+
+    return (
+        !param.is_constant_in_next_round(round, sample_count)
+        || param.get_midi_controller() != NULL
+        || param.get_macro() != NULL
+        || param.get_lfo() != NULL
+        || param.get_envelope() != NULL
+    );
+}
+
+
 void Synth::stop_polyphonic_notes() noexcept
 {
     bool found_note = false;
@@ -2016,6 +2576,15 @@ void Synth::stop_polyphonic_notes() noexcept
 }
 
 
+void Synth::unbind_expression_channels() noexcept
+{
+    for (Integer voice = 0; voice != POLYPHONY; ++voice) {
+        modulators[voice]->set_expression_channel(0.0, Midi::INVALID_CHANNEL);
+        carriers[voice]->set_expression_channel(0.0, Midi::INVALID_CHANNEL);
+    }
+}
+
+
 void Synth::garbage_collect_voices() noexcept
 {
     for (Integer voice = 0; voice != POLYPHONY; ++voice) {
@@ -2066,7 +2635,7 @@ void Synth::process_messages() noexcept
         Message message;
 
         if (messages.pop(message)) {
-            process_message(message);
+            handle_message(message);
         }
     }
 
@@ -2077,12 +2646,21 @@ void Synth::process_messages() noexcept
         stop_polyphonic_notes();
     }
 
+    bool const was_mpe_on = is_mpe_on_;
+    is_mpe_on_ = is_mpe_on();
+
+    if (was_mpe_on && !is_mpe_on_) {
+        unbind_expression_channels();
+    }
+
     bool const was_holding = is_holding_;
     is_holding_ = is_holding();
 
     if (was_holding && !(is_holding_ || is_sustain_pedal_on)) {
         release_held_notes(0.0);
     }
+
+    publish_params_snapshot();
 }
 
 
@@ -2099,6 +2677,12 @@ void Synth::process_message(
 
 
 void Synth::process_message(Message const& message) noexcept
+{
+    handle_message(message);
+}
+
+
+void Synth::handle_message(Message const& message) noexcept
 {
     switch (message.type) {
         case MessageType::SET_PARAM:
@@ -2144,10 +2728,12 @@ void Synth::handle_set_param(ParamId const param_id, Number const ratio) noexcep
         case ParamType::SAMPLE_EVALUATED_FLOAT:
             sample_evaluated_float_params[index]->cancel_events();
             sample_evaluated_float_params[index]->set_ratio(ratio);
+            activate_param(param_id);
             break;
 
         case ParamType::BLOCK_EVALUATED_FLOAT:
             block_evaluated_float_params[index]->set_ratio(ratio);
+            activate_param(param_id);
             break;
 
         case ParamType::BYTE:
@@ -2174,13 +2760,16 @@ void Synth::handle_set_param_smoothly(ParamId const param_id, Number const ratio
 
             param.cancel_events();
             param.schedule_linear_ramp(0.0125, param.ratio_to_value(ratio));
-            param_ratios[param_id].store(ratio);
+            params_snapshot_rw.ratios[param_id] = ratio;
+            is_params_snapshot_dirty = true;
+            activate_param(param_id);
 
             break;
         }
 
         case ParamType::BLOCK_EVALUATED_FLOAT:
             block_evaluated_float_params[index]->set_ratio(ratio);
+            activate_param(param_id);
             handle_refresh_param(param_id);
             break;
 
@@ -2235,7 +2824,11 @@ void Synth::handle_assign_controller(
         return;
     }
 
-    controller_assignments[param_id].store(controller_id);
+    macro_scheduler.invalidate();
+    activate_param(param_id);
+
+    params_snapshot_rw.controller_ids[param_id] = controller_id;
+    is_params_snapshot_dirty = true;
 
     if ((ControllerId)controller_id == ControllerId::MIDI_LEARN) {
         is_learning = true;
@@ -2336,7 +2929,37 @@ bool Synth::may_be_controllable(
 
 void Synth::handle_refresh_param(ParamId const param_id) noexcept
 {
-    param_ratios[param_id].store(get_param_ratio(param_id));
+    params_snapshot_rw.ratios[param_id] = get_param_ratio(param_id);
+    is_params_snapshot_dirty = true;
+}
+
+
+/*
+The ratios of the parameters which have a controller assigned to them may
+change in any block, so they are re-read before every publication. All other
+changes go through the messages, which keep the working copy up to date.
+*/
+void Synth::publish_params_snapshot() noexcept
+{
+    for (int i = 0; i != ParamId::PARAM_ID_COUNT; ++i) {
+        if (params_snapshot_rw.controller_ids[i] == ControllerId::NONE) {
+            continue;
+        }
+
+        Number const ratio = get_param_ratio((ParamId)i);
+
+        if (ratio != params_snapshot_rw.ratios[i]) {
+            params_snapshot_rw.ratios[i] = ratio;
+            is_params_snapshot_dirty = true;
+        }
+    }
+
+    if (!is_params_snapshot_dirty) {
+        return;
+    }
+
+    params_snapshot.write(params_snapshot_rw);
+    is_params_snapshot_dirty = false;
 }
 
 
@@ -2353,6 +2976,10 @@ void Synth::handle_clear() noexcept
     for (int i = 0; i != ParamId::PARAM_ID_COUNT; ++i) {
         ParamId const param_id = (ParamId)i;
 
+        if (is_instance_setting(param_id)) {
+            continue;
+        }
+
         handle_assign_controller(param_id, no_controller);
 
         if (param_id != ParamId::MTUN && param_id != ParamId::CTUN) {
@@ -2724,6 +3351,16 @@ void Synth::clear_midi_controllers() noexcept
             midi_controllers_rw[i]->clear();
         }
     }
+
+    for (Integer i = 0; i != MACROS; ++i) {
+        macros_rw[i]->clear();
+    }
+
+    for (Midi::Channel channel = 0; channel != Midi::CHANNELS; ++channel) {
+        channel_pitch_wheels[channel].clear();
+        channel_pressure_ctls[channel].clear();
+        channel_timbres[channel].clear();
+    }
 }
 
 
@@ -2836,6 +3473,10 @@ void Synth::render(
         Integer const last_sample_index,
         Sample** buffer
 ) noexcept {
+    if (!is_clipping_output) {
+        return;
+    }
+
     for (Integer c = 0; c != channels; ++c) {
         Sample* const out = buffer[c];
         Sample const* const raw = raw_output[c];
@@ -2850,7 +3491,9 @@ void Synth::render(
             that happening to us, we are forcing digital clipping here at
             around 9 dB.
             */
-            out[i] = std::min(2.8, std::max(-2.8, raw[i]));
+            out[i] = std::min(
+                OUTPUT_CLIPPING_LEVEL, std::max(-OUTPUT_CLIPPING_LEVEL, raw[i])
+            );
         }
     }
 }
@@ -2865,6 +3508,8 @@ void Synth::finalize_rendering(
     Sample peak;
     Integer peak_index;
 
+    macro_scheduler.release();
+
     if (osc_1_peak.is_assigned()) {
         bus.find_modulators_peak(sample_count, peak, peak_index);
         osc_1_peak_tracker.update(peak, peak_index, sample_count, sampling_period);
@@ -2895,7 +3540,100 @@ void Synth::finalize_rendering(
         vol_3_peak.change(0.0, std::min(1.0, vol_3_peak_tracker.get_peak()));
     }
 
+    if (is_metering.load()) {
+        update_meters(round, sample_count);
+    }
+
+    delay_buffer_pool.clear_released_slots();
+
     active_voices_count.store((Integer)bus.get_active_voices_count());
+
+    if (is_rendering_silence(round, sample_count)) {
+        if (silent_samples <= get_latency_samples() + get_block_size()) {
+            silent_samples += sample_count;
+        }
+    } else {
+        silent_samples = 0;
+    }
+}
+
+
+bool Synth::is_rendering_silence(
+        Integer const round,
+        Integer const sample_count
+) noexcept {
+    if (
+            bus.get_active_voices_count() != 0
+            || !bus.is_silent(round, sample_count)
+            || !is_silent(raw_output, sample_count, channels)
+            || !effects.is_tail_silent()
+    ) {
+        return false;
+    }
+
+    for (Integer i = 0; i != active_params_count; ++i) {
+        ParamId const param_id = active_params[i];
+        bool const is_changing = (
+            sample_evaluated_float_params[param_id] != NULL
+                ? is_changing_without_lfo<FloatParamS>(
+                    *sample_evaluated_float_params[param_id], round, sample_count
+                )
+                : is_changing_without_lfo<FloatParamB>(
+                    *block_evaluated_float_params[param_id], round, sample_count
+                )
+        );
+
+        if (is_changing) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+/*
+LFOs are free-running, so their phase doesn't matter while there is no sound,
+but ramps and envelopes must not be paused halfway.
+*/
+template<class FloatParamClass>
+bool Synth::is_changing_without_lfo(
+        FloatParamClass& param,
+        Integer const round,
+        Integer const sample_count
+) noexcept {
+    return (
+        param.get_lfo() == NULL
+        && !param.is_constant_in_next_round(round, sample_count)
+    );
+}
+
+
+void Synth::update_meters(Integer const round, Integer const sample_count) noexcept
+{
+    /* These have already been rendered in this round, so they are cached. */
+    meters[MeterId::METER_VOL_1].update(
+        SignalProducer::produce< Effects::Volume1<Bus> >(
+            effects.volume_1, round, sample_count
+        ),
+        channels,
+        sample_count
+    );
+    meters[MeterId::METER_VOL_2].update(
+        SignalProducer::produce< Effects::Volume2<Bus> >(
+            effects.volume_2, round, sample_count
+        ),
+        channels,
+        sample_count
+    );
+    meters[MeterId::METER_VOL_3].update(
+        SignalProducer::produce< Effects::Volume3<Bus> >(
+            effects.volume_3, round, sample_count
+        ),
+        channels,
+        sample_count
+    );
+    meters[MeterId::METER_OUT].update(raw_output, channels, sample_count);
 }
 
 
@@ -2909,6 +3647,13 @@ std::string const Synth::to_string(Integer const n) const noexcept
 }
 
 
+Synth::ParamsSnapshot::ParamsSnapshot() noexcept
+{
+    std::fill_n(ratios, ParamId::PARAM_ID_COUNT, 0.0);
+    std::fill_n(controller_ids, ParamId::PARAM_ID_COUNT, (Byte)ControllerId::NONE);
+}
+
+
 Synth::Message::Message() noexcept
     : type(MessageType::INVALID_MESSAGE_TYPE),
     param_id(ParamId::INVALID_PARAM_ID),
@@ -2939,6 +3684,7 @@ Synth::Bus::Bus(
         Carrier* const* const carriers,
         Carrier::Params const& carrier_params,
         Integer const polyphony,
+        VoiceParamBank& voice_param_bank,
         FloatParamS& modulator_add_volume,
         FloatParamS& input_volume
 ) noexcept
@@ -2950,6 +3696,13 @@ Synth::Bus::Bus(
     carrier_params(carrier_params),
     input(NULL),
     active_voices_count(0),
+    ready_carriers_count(0),
+    submitted_carriers_count(0),
+    deferred_carriers_count(0),
+    worker_deque(NULL),
+    are_voices_suspended(false),
+    carriers_job(*this),
+    voice_param_bank(voice_param_bank),
     modulator_add_volume(modulator_add_volume),
     input_volume(input_volume),
     modulators_buffer(NULL),
@@ -3043,6 +3796,18 @@ size_t Synth::Bus::get_active_voices_count() const noexcept
 }
 
 
+void Synth::Bus::set_worker_deque(WorkerPool::Deque* const worker_deque) noexcept
+{
+    this->worker_deque = worker_deque;
+}
+
+
+void Synth::Bus::set_voices_suspended(bool const are_suspended) noexcept
+{
+    are_voices_suspended = are_suspended;
+}
+
+
 void Synth::Bus::reallocate_buffers() noexcept
 {
     free_buffers();
@@ -3056,6 +3821,12 @@ Sample const* const* Synth::Bus::initialize_rendering(
 ) noexcept {
     collect_active_voices();
 
+    /*
+    The voices would advance the bank on their own when they are rendered, but
+    they may be rendered concurrently, so it must be done in advance.
+    */
+    voice_param_bank.advance(round, sample_count);
+
     modulator_add_volume_buffer = FloatParamS::produce_if_not_constant(
         modulator_add_volume, round, sample_count
     );
@@ -3069,19 +3840,15 @@ Sample const* const* Synth::Bus::initialize_rendering(
 
     if (Synth::should_sync_oscillator_inaccuracy(modulator_params, carrier_params)) {
         if (Synth::should_sync_oscillator_instability(modulator_params, carrier_params)) {
-            render_voices<Modulator, true, true>(active_modulators, active_modulators_count, modulator_params, round, sample_count);
-            render_voices<Carrier, true, true>(active_carriers, active_carriers_count, carrier_params, round, sample_count);
+            render_voices<true, true>(round, sample_count);
         } else {
-            render_voices<Modulator, true, false>(active_modulators, active_modulators_count, modulator_params, round, sample_count);
-            render_voices<Carrier, true, false>(active_carriers, active_carriers_count, carrier_params, round, sample_count);
+            render_voices<true, false>(round, sample_count);
         }
     } else {
         if (Synth::should_sync_oscillator_instability(modulator_params, carrier_params)) {
-            render_voices<Modulator, false, true>(active_modulators, active_modulators_count, modulator_params, round, sample_count);
-            render_voices<Carrier, false, true>(active_carriers, active_carriers_count, carrier_params, round, sample_count);
+            render_voices<false, true>(round, sample_count);
         } else {
-            render_voices<Modulator, false, false>(active_modulators, active_modulators_count, modulator_params, round, sample_count);
-            render_voices<Carrier, false, false>(active_carriers, active_carriers_count, carrier_params, round, sample_count);
+            render_voices<false, false>(round, sample_count);
         }
     }
 
@@ -3105,18 +3872,28 @@ void Synth::Bus::collect_active_voices() noexcept
     active_carriers_count = 0;
     active_voices_count = 0;
 
+    if (JS80P_UNLIKELY(are_voices_suspended)) {
+        return;
+    }
+
     for (Integer v = 0; v != polyphony; ++v) {
         bool const is_modulator_on = modulators[v]->is_on();
 
+        is_modulator_active[v] = is_modulator_on;
+
         if (is_modulator_on) {
             active_modulators[active_modulators_count] = modulators[v];
+            active_modulator_voices[active_modulators_count] = v;
             ++active_modulators_count;
         }
 
         bool const is_carrier_on = carriers[v]->is_on();
 
+        is_carrier_active[v] = is_carrier_on;
+
         if (is_carrier_on) {
             active_carriers[active_carriers_count] = carriers[v];
+            active_carrier_voices[active_carriers_count] = v;
             ++active_carriers_count;
         }
 
@@ -3127,42 +3904,189 @@ void Synth::Bus::collect_active_voices() noexcept
 }
 
 
+template<bool should_sync_oscillator_inaccuracy, bool should_sync_oscillator_instability>
+void Synth::Bus::render_voices(Integer const round, Integer const sample_count) noexcept
+{
+    if (
+            worker_deque == NULL
+            || active_modulators_count == 0
+            || active_carriers_count == 0
+    ) {
+        prepare_voices<Modulator, should_sync_oscillator_inaccuracy, should_sync_oscillator_instability>(
+            active_modulators, active_modulators_count, modulator_params, round
+        );
+        render_voices<Modulator>(active_modulators, active_modulators_count, round, sample_count);
+
+        prepare_voices<Carrier, should_sync_oscillator_inaccuracy, should_sync_oscillator_instability>(
+            active_carriers, active_carriers_count, carrier_params, round
+        );
+        render_voices<Carrier>(active_carriers, active_carriers_count, round, sample_count);
+
+        return;
+    }
+
+    /*
+    The voices of a group share the scratch buffers of their param leaders, so
+    the voices within a group must be rendered one after the other, but the
+    two groups can be rendered concurrently. (The synced oscillator inaccuracy
+    is shared between the groups, so its updates are done before forking.)
+    */
+    prepare_voices<Modulator, should_sync_oscillator_inaccuracy, should_sync_oscillator_instability>(
+        active_modulators, active_modulators_count, modulator_params, round
+    );
+    prepare_voices<Carrier, should_sync_oscillator_inaccuracy, should_sync_oscillator_instability>(
+        active_carriers, active_carriers_count, carrier_params, round
+    );
+
+    render_voices_in_parallel(round, sample_count);
+}
+
+
 template<class VoiceClass, bool should_sync_oscillator_inaccuracy, bool should_sync_oscillator_instability>
-void Synth::Bus::render_voices(
+void Synth::Bus::prepare_voices(
         VoiceClass* (&voices)[POLYPHONY],
         size_t const voices_count,
         typename VoiceClass::Params const& params,
+        Integer const round
+) noexcept {
+    if (voices_count == 0) {
+        return;
+    }
+
+    if (params.tuning.get_value() == VoiceClass::TUNING_MTS_ESP_CONTINUOUS) {
+        for (size_t v = 0; v != voices_count; ++v) {
+            voices[v]->template update_note_frequency_for_continuous_mts_esp<should_sync_oscillator_inaccuracy, should_sync_oscillator_instability>(round);
+        }
+    }
+
+    if (params.oscillator_instability.get_value() != 0) {
+        for (size_t v = 0; v != voices_count; ++v) {
+            voices[v]->template update_unstable_note_frequency<should_sync_oscillator_instability>(round);
+        }
+    }
+}
+
+
+template<class VoiceClass>
+void Synth::Bus::render_voices(
+        VoiceClass* const* const voices,
+        size_t const voices_count,
         Integer const round,
         Integer const sample_count
 ) noexcept {
-    if (voices_count > 0) {
-        /*
-        Rendering oscillators together seems to be more cache-friendly. Cannot group
-        modulators and carriers though, because when there is actual modulation,
-        then rendering carrier oscillators would trigger rendering the whole signal
-        chain of the corresponding modulator.
-        */
+    /*
+    Rendering oscillators together seems to be more cache-friendly. Cannot group
+    modulators and carriers though, because when there is actual modulation,
+    then rendering carrier oscillators would trigger rendering the whole signal
+    chain of the corresponding modulator.
+    */
 
-        if (params.tuning.get_value() == VoiceClass::TUNING_MTS_ESP_CONTINUOUS) {
-            for (size_t v = 0; v != voices_count; ++v) {
-                voices[v]->template update_note_frequency_for_continuous_mts_esp<should_sync_oscillator_inaccuracy, should_sync_oscillator_instability>(round);
-            }
-        }
+    for (size_t v = 0; v != voices_count; ++v) {
+        voices[v]->render_oscillator(round, sample_count);
+    }
 
-        if (params.oscillator_instability.get_value() != 0) {
-            for (size_t v = 0; v != voices_count; ++v) {
-                voices[v]->template update_unstable_note_frequency<should_sync_oscillator_instability>(round);
-            }
+    for (size_t v = 0; v != voices_count; ++v) {
+        SignalProducer::produce<VoiceClass>(*voices[v], round, sample_count);
+    }
+}
+
+
+void Synth::Bus::render_voices_in_parallel(
+        Integer const round,
+        Integer const sample_count
+) noexcept {
+    ready_carriers_count = 0;
+    submitted_carriers_count = 0;
+    deferred_carriers_count = 0;
+
+    /*
+    A carrier may render its modulator on demand, even when the modulator is
+    not active. The carriers of inactive modulators are rendered only after
+    the modulators are done, so that nothing else touches the modulators'
+    param leaders in the meantime.
+    */
+    for (size_t c = 0; c != active_carriers_count; ++c) {
+        Integer const voice = active_carrier_voices[c];
+
+        if (!is_modulator_active[voice]) {
+            deferred_carriers[deferred_carriers_count] = active_carriers[c];
+            ++deferred_carriers_count;
         }
+    }
 
-        for (size_t v = 0; v != voices_count; ++v) {
-            voices[v]->render_oscillator(round, sample_count);
+    for (size_t m = 0; m != active_modulators_count; ++m) {
+        active_modulators[m]->render_oscillator(round, sample_count);
+    }
+
+    /*
+    Each carrier may need the output of its modulator, so a carrier is handed
+    over to the workers only after its modulator is finished, and the workers
+    never have to wait for the modulators. The carriers share the scratch
+    buffers of their param leaders, so there's at most one job in flight; the
+    carriers which become ready in the meantime go into the next one.
+    */
+    for (size_t m = 0; m != active_modulators_count; ++m) {
+        Integer const voice = active_modulator_voices[m];
+
+        SignalProducer::produce<Modulator>(*active_modulators[m], round, sample_count);
+
+        if (is_carrier_active[voice]) {
+            ready_carriers[ready_carriers_count] = carriers[voice];
+            ++ready_carriers_count;
         }
 
-        for (size_t v = 0; v != voices_count; ++v) {
-            SignalProducer::produce<VoiceClass>(*voices[v], round, sample_count);
+        if (carriers_job.is_done()) {
+            submit_ready_carriers(round, sample_count);
         }
     }
+
+    worker_deque->join(carriers_job);
+
+    render_voices<Carrier>(
+        &ready_carriers[submitted_carriers_count],
+        ready_carriers_count - submitted_carriers_count,
+        round,
+        sample_count
+    );
+    render_voices<Carrier>(deferred_carriers, deferred_carriers_count, round, sample_count);
+}
+
+
+void Synth::Bus::submit_ready_carriers(
+        Integer const round,
+        Integer const sample_count
+) noexcept {
+    if (submitted_carriers_count == ready_carriers_count) {
+        return;
+    }
+
+    carriers_job.round = round;
+    carriers_job.sample_count = sample_count;
+    carriers_job.first_carrier = submitted_carriers_count;
+    carriers_job.carriers_count = ready_carriers_count - submitted_carriers_count;
+
+    submitted_carriers_count = ready_carriers_count;
+
+    worker_deque->submit(carriers_job);
+}
+
+
+Synth::Bus::CarriersJob::CarriersJob(Bus& bus) noexcept
+    : WorkerPool::Job(),
+    round(0),
+    sample_count(0),
+    first_carrier(0),
+    carriers_count(0),
+    bus(bus)
+{
+}
+
+
+void Synth::Bus::CarriersJob::run() noexcept
+{
+    bus.render_voices<Carrier>(
+        &bus.ready_carriers[first_carrier], carriers_count, round, sample_count
+    );
 }
 
 
@@ -3592,4 +4516,58 @@ Integer Synth::DeferredNoteOff::get_voice() const noexcept
     return voice;
 }
 
+
+Synth::ExpressionController::ExpressionController(
+        MidiController* const channel_controllers,
+        Number const neutral_value
+) noexcept
+    : channel_controllers(channel_controllers),
+    neutral_value(neutral_value)
+{
+    std::fill_n(member_values, Midi::CHANNELS, neutral_value);
+}
+
+
+void Synth::ExpressionController::change_member(
+        Seconds const time_offset,
+        Midi::Channel const channel,
+        Number const new_value,
+        Number const manager_value
+) noexcept {
+    member_values[channel] = new_value;
+    update(time_offset, channel, manager_value);
+}
+
+
+void Synth::ExpressionController::change_manager(
+        Seconds const time_offset,
+        Number const manager_value
+) noexcept {
+    for (Midi::Channel channel = 0; channel != Midi::CHANNELS; ++channel) {
+        if (channel != MPE_MANAGER_CHANNEL) {
+            update(time_offset, channel, manager_value);
+        }
+    }
+}
+
+
+/*
+Both values are offsets from the neutral position of the controller (e.g. the
+center of the pitch wheel), so a pitch bend on the manager channel shifts the
+per-note pitch bends, and pressure on the manager channel adds to the per-note
+pressure.
+*/
+void Synth::ExpressionController::update(
+        Seconds const time_offset,
+        Midi::Channel const channel,
+        Number const manager_value
+) noexcept {
+    channel_controllers[channel].change(
+        time_offset,
+        std::min(
+            1.0, std::max(0.0, manager_value + member_values[channel] - neutral_value)
+        )
+    );
+}
+
 }
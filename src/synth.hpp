@@ -22,18 +22,23 @@
 #include <atomic>
 #include <cstddef>
 #include <string>
+#include <type_traits>
 #include <vector>
 
 #include "js80p.hpp"
 #include "midi.hpp"
 #include "note_stack.hpp"
+#include "seqlock.hpp"
 #include "spscqueue.hpp"
 #include "voice.hpp"
+#include "voice_param_bank.hpp"
+#include "worker_pool.hpp"
 
 #include "dsp/envelope.hpp"
 #include "dsp/biquad_filter.hpp"
 #include "dsp/chorus.hpp"
 #include "dsp/delay.hpp"
+#include "dsp/delay_buffer_pool.hpp"
 #include "dsp/distortion.hpp"
 #include "dsp/echo.hpp"
 #include "dsp/effect.hpp"
@@ -44,6 +49,7 @@
 #include "dsp/lfo_envelope_list.hpp"
 #include "dsp/macro.hpp"
 #include "dsp/math.hpp"
+#include "dsp/meter.hpp"
 #include "dsp/midi_controller.hpp"
 #include "dsp/mixer.hpp"
 #include "dsp/oscillator.hpp"
@@ -80,9 +86,23 @@ class Synth : public Midi::EventHandler, public SignalProducer
 
         static constexpr Integer MIDI_CONTROLLERS = 128;
 
+        /**
+         * \brief In MPE mode, per-note pitch bend, channel pressure, and
+         *        CC 74 messages are received on all the other channels, while
+         *        messages on this channel affect all voices.
+         */
+        static constexpr Midi::Channel MPE_MANAGER_CHANNEL = 0;
+
         static constexpr Integer MACROS = 30;
         static constexpr Integer MACRO_PARAMS = 8;
 
+        /**
+         * \brief The output is clipped at around 9 dB in order to avoid
+         *        hosts turning off the plugin when a filter misconfiguration
+         *        makes it blow up.
+         */
+        static constexpr Sample OUTPUT_CLIPPING_LEVEL = 2.8;
+
         enum MessageType {
             SET_PARAM = 1,          ///< Set the given parameter's ratio to
                                     ///< \c number_param.
@@ -93,9 +113,9 @@ class Synth : public Midi::EventHandler, public SignalProducer
             ASSIGN_CONTROLLER = 3,  ///< Assign the controller identified by
                                     ///< \c byte_param to the given parameter.
 
-            REFRESH_PARAM = 4,      ///< Make sure that \c get_param_ratio_atomic()
-                                    ///< will return the most recent value of
-                                    ///< the given parameter.
+            REFRESH_PARAM = 4,      ///< Re-read the ratio of the given
+                                    ///< parameter after it was modified
+                                    ///< directly, bypassing the messages.
 
             CLEAR = 5,              ///< Clear all buffers, release all
                                     ///< controller assignments, and reset all
@@ -865,8 +885,11 @@ class Synth : public Midi::EventHandler, public SignalProducer
             CFX4 = 701,      ///< Carrier Fine Detune x4
             EER1 = 702,      ///< Effects Echo Reversed 1
             EER2 = 703,      ///< Effects Echo Reversed 2
+            ELIM = 704,      ///< Effects Limiter
+            MPE = 705,       ///< MIDI Polyphonic Expression
+            ZLAT = 706,      ///< Zero Latency
 
-            PARAM_ID_COUNT = 704,
+            PARAM_ID_COUNT = 707,
             INVALID_PARAM_ID = PARAM_ID_COUNT,
         };
 
@@ -1024,6 +1047,15 @@ class Synth : public Midi::EventHandler, public SignalProducer
             INVALID_CONTROLLER_ID =     CONTROLLER_ID_COUNT,
         };
 
+        enum MeterId {
+            METER_VOL_1 = 0,    ///< Output of Volume 1 (start of the effects chain)
+            METER_VOL_2 = 1,    ///< Output of Volume 2 (after the filters)
+            METER_VOL_3 = 2,    ///< Output of Volume 3 (after the reverb)
+            METER_OUT = 3,      ///< Output of the effects chain
+
+            METERS = 4,
+        };
+
         static constexpr Byte MODE_MIX_AND_MOD = 0;
         static constexpr Byte MODE_SPLIT_AT_C3 = 1;
         static constexpr Byte MODE_SPLIT_AT_Db3 = 2;
@@ -1084,6 +1116,24 @@ class Synth : public Midi::EventHandler, public SignalProducer
                 Byte byte_param;
         };
 
+        static_assert(
+            std::is_trivially_copyable<Message>::value,
+            "Synth::Message must be trivially copyable"
+        );
+
+        /**
+         * \brief The ratios and the controller assignments of all the
+         *        parameters, published by the audio thread once per block.
+         */
+        class ParamsSnapshot
+        {
+            public:
+                ParamsSnapshot() noexcept;
+
+                Number ratios[ParamId::PARAM_ID_COUNT];
+                Byte controller_ids[ParamId::PARAM_ID_COUNT];
+        };
+
         class ModeParam : public ByteParam
         {
             public:
@@ -1149,11 +1199,161 @@ class Synth : public Midi::EventHandler, public SignalProducer
         bool is_dirty() const noexcept;
         void clear_dirty_flag() noexcept;
 
+        /**
+         * \brief Stop all sounds, and release most of the memory of the
+         *        voices until \c resume() is called. (Rendering without
+         *        resuming first is possible, but the voices remain silent,
+         *        because their buffers are only reallocated by \c resume().)
+         */
         void suspend() noexcept;
         void resume() noexcept;
 
+        bool are_voice_buffers_released() const noexcept;
+
+        /**
+         * \brief Turn on or off offloading a part of the voice rendering to
+         *        the process-wide \c WorkerPool which is shared by all the
+         *        instances. Must not be called while rendering is in
+         *        progress.
+         *
+         * \note Meant for offline rendering only: the plugins turn it on
+         *       and off via \c set_offline_rendering(). When all the workers
+         *       are busy, the voices are rendered on the calling thread, but
+         *       a job that a worker has already picked up must still be
+         *       waited for, and the workers don't run with real-time
+         *       priority, so the wait is not bounded.
+         *
+         * \warning Not real-time safe.
+         */
+        void set_parallel_rendering(bool const is_enabled) noexcept;
+
+        /**
+         * \brief Whether parallel rendering is turned on and the worker pool
+         *        was able to provide a deque for the instance.
+         */
+        bool is_rendering_in_parallel() const noexcept;
+
+        /**
+         * \brief Switch between the cheap settings which are suitable for
+         *        real-time rendering, and the settings for offline rendering
+         *        (e.g. bouncing), where the quality and the throughput matter
+         *        more than the latency: Lagrange interpolation for all
+         *        oscillator frequencies, and parallel rendering. Must not be
+         *        called while rendering is in progress.
+         *
+         * \note The block size is left unchanged, because the feedback of
+         *       the delay based effects lags behind by one block, so a
+         *       different block size would change the timing of the echoes
+         *       and of the reverb.
+         *
+         * \warning Not real-time safe.
+         */
+        void set_offline_rendering(bool const is_enabled) noexcept;
+
+        bool is_rendering_offline() const noexcept;
+
         Integer get_active_voices_count() const noexcept;
 
+        /**
+         * \brief Number of synth level params which are rendered in every
+         *        round, because they are changing or they have a controller.
+         */
+        Integer get_active_params_count() const noexcept;
+
+        /**
+         * \brief Number of samples by which the effects chain (e.g. the
+         *        lookahead limiter) delays the output signal.
+         */
+        Integer get_latency_samples() const noexcept;
+
+        /**
+         * \brief Same as \c get_latency_samples(), but it is based on the
+         *        most recently published \c ParamsSnapshot, so it is safe to
+         *        be called from any thread.
+         */
+        Integer get_latency_samples_atomic() const noexcept;
+
+        /**
+         * \brief Whether the \c Renderer should render exactly as many
+         *        samples as the host asks for instead of rendering whole
+         *        blocks ahead.
+         *
+         * \warning Must only be called from the audio thread, use
+         *          \c is_zero_latency_atomic() from other threads.
+         */
+        bool is_zero_latency() const noexcept;
+
+        /**
+         * \brief Same as \c is_zero_latency(), but it is based on the most
+         *        recently published \c ParamsSnapshot, so it is safe to be
+         *        called from any thread.
+         */
+        bool is_zero_latency_atomic() const noexcept;
+
+        /**
+         * \brief Whether the synth has been producing nothing but silence for
+         *        longer than its latency: there are no voices, the input and
+         *        the effect tails are silent, and no parameter is changing on
+         *        its own, so rendering may be skipped until the next MIDI
+         *        event or message arrives.
+         *
+         * \note LFOs are paused while the synth is idle, just like when they
+         *       are not used by any parameter.
+         *
+         * \warning Must only be called from the audio thread.
+         */
+        bool is_idle() const noexcept;
+
+        /**
+         * \brief Account for \c sample_count samples which were not rendered
+         *        because the synth was idle: the meters are fed silence, and
+         *        changes which didn't wake the synth up (e.g. a
+         *        \c MidiController being changed by the host) are published.
+         *
+         * \warning Must only be called from the audio thread.
+         */
+        void skip_idle_samples(Integer const sample_count) noexcept;
+
+        /**
+         * \brief Size of the memory arena from which the chorus, echo, and
+         *        reverb effects lease their delay buffers while they are in
+         *        use, in bytes. Safe to be called from any thread.
+         */
+        size_t get_delay_buffer_pool_size() const noexcept;
+
+        /**
+         * \brief Size of the delay buffers which are currently leased by the
+         *        effects, in bytes. Safe to be called from any thread.
+         */
+        size_t get_leased_delay_buffer_size() const noexcept;
+
+        /**
+         * \brief Turn on or off analyzing the signal for the meters. Safe to
+         *        be called from any thread.
+         */
+        void start_metering() noexcept;
+        void stop_metering() noexcept;
+
+        /**
+         * \brief Retrieve the latest measurements of the given meter. Safe to
+         *        be called from any thread, it never blocks the audio thread.
+         */
+        bool get_meter_snapshot(
+            MeterId const meter_id,
+            Meter::Snapshot& snapshot
+        ) const noexcept;
+
+        /**
+         * \brief Retrieve a consistent copy of the most recently published
+         *        ratios and controller assignments of all the parameters.
+         *        Safe to be called from any thread, it never blocks the audio
+         *        thread.
+         *
+         * \return \c false if the audio thread was busy publishing a new
+         *         snapshot, in which case \c snapshot is left unchanged.
+         */
+        bool get_params_snapshot(ParamsSnapshot& snapshot) const noexcept;
+
         bool has_mts_esp_tuning() const noexcept;
         bool has_continuous_mts_esp_tuning() const noexcept;
         bool is_mts_esp_connected() const noexcept;
@@ -1175,6 +1375,19 @@ class Synth : public Midi::EventHandler, public SignalProducer
             Sample const* const* const input = NULL
         ) noexcept;
 
+        /**
+         * \brief Same as \c generate_samples(), but the final clipping pass
+         *        is skipped, and the output of the effects chain is returned,
+         *        so that the caller can clip the samples at
+         *        \c OUTPUT_CLIPPING_LEVEL while it is converting them to its
+         *        own format anyways, instead of making an extra copy.
+         */
+        Sample const* const* generate_unclipped_samples(
+            Integer const round,
+            Integer const sample_count,
+            Sample const* const* const input = NULL
+        ) noexcept;
+
         /**
          * \brief Thread-safe way to change the state of the synthesizer outside
          *        the audio thread.
@@ -1206,9 +1419,21 @@ class Synth : public Midi::EventHandler, public SignalProducer
 
         /**
          * \brief Process a state changing message inside the audio thread.
+         *
+         * \note The new state of the parameters is published at the end of
+         *       the next \c process_messages() call, or when
+         *       \c publish_params_snapshot() is called, so that a batch of
+         *       messages (e.g. a patch being loaded) is published only once.
          */
         void process_message(Message const& message) noexcept;
 
+        /**
+         * \brief Publish the state of the parameters to other threads if it
+         *        has changed since the last publication. Must be called from
+         *        the audio thread.
+         */
+        void publish_params_snapshot() noexcept;
+
         std::string const& get_param_name(ParamId const param_id) const noexcept;
         ParamId get_param_id(std::string const& name) const noexcept;
 
@@ -1236,10 +1461,29 @@ class Synth : public Midi::EventHandler, public SignalProducer
 
         bool is_discrete_param(ParamId const param_id) const noexcept;
 
+        /**
+         * \brief Instance settings (e.g. the zero latency mode) belong to the
+         *        plugin instance rather than to the sound: they are not saved
+         *        in patches, not loaded from them, and they are kept when the
+         *        synth is cleared for loading a new patch.
+         */
+        bool is_instance_setting(ParamId const param_id) const noexcept;
+
         Number get_param_max_value(ParamId const param_id) const noexcept;
+        /**
+         * \note Reads only the requested field of the most recently published
+         *       \c ParamsSnapshot, use \c get_params_snapshot() when multiple
+         *       parameters need to be read consistently.
+         */
         Number get_param_ratio_atomic(ParamId const param_id) const noexcept;
+
         Number get_param_default_ratio(ParamId const param_id) const noexcept;
 
+        /**
+         * \note Reads only the requested field of the most recently published
+         *       \c ParamsSnapshot, use \c get_params_snapshot() when multiple
+         *       parameters need to be read consistently.
+         */
         ControllerId get_param_controller_id_atomic(
             ParamId const param_id
         ) const noexcept;
@@ -1272,6 +1516,21 @@ class Synth : public Midi::EventHandler, public SignalProducer
             Midi::Byte const new_value
         ) noexcept;
 
+        /**
+         * \brief High resolution values of MIDI controllers 0-31.
+         *
+         * \note Non-registered parameters (NRPN) don't have controllers of
+         *       their own, so they are ignored instead of being mixed up
+         *       with the MIDI controllers which happen to have the same
+         *       number (e.g. NRPN 64 must not move the sustain pedal).
+         */
+        void control_change_14_bit(
+            Seconds const time_offset,
+            Midi::Channel const channel,
+            Midi::Controller const controller,
+            Midi::Word const new_value
+        ) noexcept;
+
         void channel_pressure(
             Seconds const time_offset,
             Midi::Channel const channel,
@@ -1311,6 +1570,8 @@ class Synth : public Midi::EventHandler, public SignalProducer
 
         ByteParam note_handling;
         ModeParam mode;
+        ToggleParam mpe;
+        ToggleParam zero_latency;
         FloatParamS modulator_add_volume;
         FloatParamS phase_modulation_level;
         FloatParamS frequency_modulation_level;
@@ -1333,6 +1594,10 @@ class Synth : public Midi::EventHandler, public SignalProducer
         MidiController vol_2_peak;
         MidiController vol_3_peak;
 
+        MidiController channel_pitch_wheels[Midi::CHANNELS];
+        MidiController channel_pressure_ctls[Midi::CHANNELS];
+        MidiController channel_timbres[Midi::CHANNELS];
+
     protected:
         Sample const* const* initialize_rendering(
             Integer const round,
@@ -1367,6 +1632,7 @@ class Synth : public Midi::EventHandler, public SignalProducer
                     Carrier* const* const carriers,
                     Carrier::Params const& carrier_params,
                     Integer const polyphony,
+                    VoiceParamBank& voice_param_bank,
                     FloatParamS& modulator_add_volume,
                     FloatParamS& input_volume
                 ) noexcept;
@@ -1398,6 +1664,20 @@ class Synth : public Midi::EventHandler, public SignalProducer
 
                 size_t get_active_voices_count() const noexcept;
 
+                /**
+                 * \brief Hand the carriers over to the worker pool in the
+                 *        next round as soon as their modulators are rendered
+                 *        on the calling thread, or render everything on the
+                 *        calling thread when \c worker_deque is \c NULL.
+                 */
+                void set_worker_deque(WorkerPool::Deque* const worker_deque) noexcept;
+
+                /**
+                 * \brief Skip rendering the voices while their buffers are
+                 *        too small for the block size.
+                 */
+                void set_voices_suspended(bool const are_suspended) noexcept;
+
             protected:
                 Sample const* const* initialize_rendering(
                     Integer const round,
@@ -1412,17 +1692,53 @@ class Synth : public Midi::EventHandler, public SignalProducer
                 ) noexcept;
 
             private:
+                class CarriersJob : public WorkerPool::Job
+                {
+                    public:
+                        explicit CarriersJob(Bus& bus) noexcept;
+
+                        virtual void run() noexcept override;
+
+                        Integer round;
+                        Integer sample_count;
+                        size_t first_carrier;
+                        size_t carriers_count;
+
+                    private:
+                        Bus& bus;
+                };
+
                 void allocate_buffers() noexcept;
                 void free_buffers() noexcept;
                 void reallocate_buffers() noexcept;
 
                 void collect_active_voices() noexcept;
 
+                template<bool should_sync_oscillator_inaccuracy, bool should_sync_oscillator_instability>
+                void render_voices(Integer const round, Integer const sample_count) noexcept;
+
                 template<class VoiceClass, bool should_sync_oscillator_inaccuracy, bool should_sync_oscillator_instability>
-                void render_voices(
+                void prepare_voices(
                     VoiceClass* (&voices)[POLYPHONY],
                     size_t const voices_count,
                     typename VoiceClass::Params const& params,
+                    Integer const round
+                ) noexcept;
+
+                template<class VoiceClass>
+                void render_voices(
+                    VoiceClass* const* const voices,
+                    size_t const voices_count,
+                    Integer const round,
+                    Integer const sample_count
+                ) noexcept;
+
+                void render_voices_in_parallel(
+                    Integer const round,
+                    Integer const sample_count
+                ) noexcept;
+
+                void submit_ready_carriers(
                     Integer const round,
                     Integer const sample_count
                 ) noexcept;
@@ -1456,9 +1772,22 @@ class Synth : public Midi::EventHandler, public SignalProducer
                 Sample const* const* input;
                 Modulator* active_modulators[POLYPHONY];
                 Carrier* active_carriers[POLYPHONY];
+                Carrier* ready_carriers[POLYPHONY];
+                Carrier* deferred_carriers[POLYPHONY];
+                Integer active_modulator_voices[POLYPHONY];
+                Integer active_carrier_voices[POLYPHONY];
+                bool is_modulator_active[POLYPHONY];
+                bool is_carrier_active[POLYPHONY];
                 size_t active_modulators_count;
                 size_t active_carriers_count;
                 size_t active_voices_count;
+                size_t ready_carriers_count;
+                size_t submitted_carriers_count;
+                size_t deferred_carriers_count;
+                WorkerPool::Deque* worker_deque;
+                bool are_voices_suspended;
+                CarriersJob carriers_job;
+                VoiceParamBank& voice_param_bank;
                 FloatParamS& modulator_add_volume;
                 FloatParamS& input_volume;
                 Sample const* modulator_add_volume_buffer;
@@ -1569,6 +1898,44 @@ class Synth : public Midi::EventHandler, public SignalProducer
                 Midi::Byte velocity;
         };
 
+        /**
+         * \brief In MPE mode, the per-channel value of an expression
+         *        controller is the value that was received on the member
+         *        channel, combined with the value of the same controller on
+         *        the manager channel.
+         */
+        class ExpressionController
+        {
+            public:
+                ExpressionController(
+                    MidiController* const channel_controllers,
+                    Number const neutral_value
+                ) noexcept;
+
+                void change_member(
+                    Seconds const time_offset,
+                    Midi::Channel const channel,
+                    Number const new_value,
+                    Number const manager_value
+                ) noexcept;
+
+                void change_manager(
+                    Seconds const time_offset,
+                    Number const manager_value
+                ) noexcept;
+
+            private:
+                void update(
+                    Seconds const time_offset,
+                    Midi::Channel const channel,
+                    Number const manager_value
+                ) noexcept;
+
+                MidiController* const channel_controllers;
+                Number const neutral_value;
+                Number member_values[Midi::CHANNELS];
+        };
+
         enum ParamType {
             OTHER = 0,
             SAMPLE_EVALUATED_FLOAT = 1,
@@ -1580,10 +1947,13 @@ class Synth : public Midi::EventHandler, public SignalProducer
         static constexpr SPSCQueue<Message>::SizeType MESSAGE_QUEUE_SIZE = 8192;
 
         static constexpr Number MIDI_WORD_SCALE = 1.0 / 16384.0;
+        static constexpr Number MIDI_14_BIT_CONTROLLER_SCALE = 1.0 / 16383.0;
         static constexpr Number MIDI_BYTE_SCALE = 1.0 / 127.0;
 
         static constexpr Integer INVALID_VOICE = -1;
 
+        static constexpr Integer RELEASED_VOICE_BLOCK_SIZE = 1;
+
         static constexpr Integer NOTE_ID_MASK = 0x7fffffff;
 
         static constexpr Integer BIQUAD_FILTER_SHARED_BUFFERS = 6;
@@ -1639,6 +2009,19 @@ class Synth : public Midi::EventHandler, public SignalProducer
         Number midi_byte_to_float(Midi::Byte const midi_byte) const noexcept;
         Number midi_word_to_float(Midi::Word const midi_word) const noexcept;
 
+        Number midi_14_bit_controller_value_to_float(
+            Midi::Word const midi_word
+        ) const noexcept;
+
+        bool is_expression_channel(Midi::Channel const channel) const noexcept;
+        bool is_mpe_on() const noexcept;
+
+        void change_midi_controller(
+            Seconds const time_offset,
+            Midi::Controller const controller,
+            Number const new_value
+        ) noexcept;
+
         void sustain_on(Seconds const time_offset) noexcept;
         void sustain_off(Seconds const time_offset) noexcept;
 
@@ -1652,6 +2035,9 @@ class Synth : public Midi::EventHandler, public SignalProducer
         void stop_lfos() noexcept;
         void start_lfos() noexcept;
 
+        void release_voice_buffers() noexcept;
+        void restore_voice_buffers() noexcept;
+
         void handle_set_param(
             ParamId const param_id,
             Number const ratio
@@ -1667,6 +2053,7 @@ class Synth : public Midi::EventHandler, public SignalProducer
             Byte const controller_id
         ) noexcept;
 
+        void handle_message(Message const& message) noexcept;
         void handle_refresh_param(ParamId const param_id) noexcept;
 
         void handle_clear() noexcept;
@@ -1752,16 +2139,62 @@ class Synth : public Midi::EventHandler, public SignalProducer
 
         void stop_polyphonic_notes() noexcept;
 
+        void unbind_expression_channels() noexcept;
+
         void release_held_notes(Seconds const time_offset) noexcept;
 
         void update_param_states() noexcept;
 
+        /**
+         * \brief Make sure that the given param will be rendered in the next
+         *        round even if no voice or effect needs it. Params which are
+         *        constant and have no controller are dropped from the active
+         *        set after rendering, until they are touched again.
+         */
+        void activate_param(ParamId const param_id) noexcept;
+
+        void produce_active_params(
+            Integer const round,
+            Integer const sample_count
+        ) noexcept;
+
+        template<class FloatParamClass>
+        bool produce_if_active(
+            FloatParamClass& param,
+            Integer const round,
+            Integer const sample_count
+        ) noexcept;
+
+        void stop_idling() noexcept;
+
+        bool is_rendering_silence(
+            Integer const round,
+            Integer const sample_count
+        ) noexcept;
+
+        template<class FloatParamClass>
+        bool is_changing_without_lfo(
+            FloatParamClass& param,
+            Integer const round,
+            Integer const sample_count
+        ) noexcept;
+
+        bool can_render_voices_in_parallel() const noexcept;
+
+        void prepare_parallel_rendering(
+            Integer const round,
+            Integer const sample_count
+        ) noexcept;
+
         void garbage_collect_voices() noexcept;
 
+        void update_meters(Integer const round, Integer const sample_count) noexcept;
+
         std::string const to_string(Integer const) const noexcept;
 
         std::vector<DeferredNoteOff> deferred_note_offs;
         SPSCQueue<Message> messages;
+        VoiceParamBank voice_param_bank;
         Bus bus;
         NoteStack note_stack;
         PeakTracker osc_1_peak_tracker;
@@ -1769,6 +2202,7 @@ class Synth : public Midi::EventHandler, public SignalProducer
         PeakTracker vol_1_peak_tracker;
         PeakTracker vol_2_peak_tracker;
         PeakTracker vol_3_peak_tracker;
+        Meter meters[MeterId::METERS];
 
         Sample const* const* raw_output;
         MidiControllerMessage previous_controller_message[ControllerId::CONTROLLER_ID_COUNT];
@@ -1776,8 +2210,10 @@ class Synth : public Midi::EventHandler, public SignalProducer
         FloatParamS* sample_evaluated_float_params[ParamId::PARAM_ID_COUNT];
         FloatParamB* block_evaluated_float_params[ParamId::PARAM_ID_COUNT];
         ByteParam* byte_params[ParamId::PARAM_ID_COUNT];
-        std::atomic<Number> param_ratios[ParamId::PARAM_ID_COUNT];
-        std::atomic<Byte> controller_assignments[ParamId::PARAM_ID_COUNT];
+        ParamsSnapshot params_snapshot_rw;
+        SeqLock<ParamsSnapshot> params_snapshot;
+        ParamId active_params[ParamId::EV3V];
+        bool is_param_active[ParamId::EV3V];
         Envelope* envelopes_rw[Constants::ENVELOPES];
         LFO* lfos_rw[Constants::LFOS];
         Macro* macros_rw[MACROS];
@@ -1788,8 +2224,10 @@ class Synth : public Midi::EventHandler, public SignalProducer
         Carrier* carriers[POLYPHONY];
         NoteTunings active_note_tunings;
         std::atomic<Integer> active_voices_count;
+        Integer active_params_count;
         Integer samples_since_gc;
         Integer samples_between_gc;
+        Integer silent_samples;
         Integer next_voice;
         Integer next_note_id;
         Midi::Note previous_note;
@@ -1797,8 +2235,24 @@ class Synth : public Midi::EventHandler, public SignalProducer
         bool is_sustain_pedal_on;
         bool is_polyphonic_;
         bool is_holding_;
+        bool is_mpe_on_;
         bool is_dirty_;
+        bool is_params_snapshot_dirty;
+        bool are_voice_buffers_released_;
+        bool is_rendering_offline_;
+        bool is_clipping_output;
+        WorkerPool::Deque* worker_deque;
+        ExpressionController pitch_wheel_expression;
+        ExpressionController channel_pressure_expression;
+        ExpressionController timbre_expression;
         std::atomic<bool> is_mts_esp_connected_;
+        std::atomic<bool> is_metering;
+        std::atomic<Integer> limiter_latency_samples;
+
+        MacroScheduler macro_scheduler;
+
+        /* Must be declared before the effects, so that it outlives them. */
+        DelayBufferPool delay_buffer_pool;
 
     public:
         Effects::Effects<Bus> effects;
@@ -255,6 +255,19 @@ Voice<ModulatorSignalProducerClass>::Params::Params(
     harmonic_8(name + "C9", -1.0, 1.0, 0.0),
     harmonic_9(name + "C10", -1.0, 1.0, 0.0),
 
+    custom_waveform(
+        harmonic_0,
+        harmonic_1,
+        harmonic_2,
+        harmonic_3,
+        harmonic_4,
+        harmonic_5,
+        harmonic_6,
+        harmonic_7,
+        harmonic_8,
+        harmonic_9
+    ),
+
     filter_1_type(name + "F1TYP"),
     filter_1_freq_log_scale(name + "F1LOG", ToggleParam::OFF),
     filter_1_q_log_scale(name + "F1QLG", ToggleParam::OFF),
@@ -343,13 +356,15 @@ Voice<ModulatorSignalProducerClass>::Params::Params(
 template<class ModulatorSignalProducerClass>
 Voice<ModulatorSignalProducerClass>::VolumeApplier::VolumeApplier(
         Filter2& input,
-        FloatParamS& velocity,
+        VoiceParamBank& note_params,
+        Integer const note_params_lane,
         FloatParamS& volume,
         SignalProducer* const buffer_owner
 ) noexcept
     : Filter<Filter2>(input, 0, 0, buffer_owner),
     volume(volume),
-    velocity(velocity)
+    note_params(note_params),
+    note_params_lane(note_params_lane)
 {
 }
 
@@ -369,12 +384,16 @@ Sample const* const* Voice<ModulatorSignalProducerClass>::VolumeApplier::initial
         volume_value = (Sample)volume.get_value();
     }
 
-    velocity_buffer = FloatParamS::produce_if_not_constant<FloatParamS>(
-        velocity, round, sample_count
+    note_params.advance(round, sample_count);
+
+    velocity_buffer = note_params.get_buffer(
+        VoiceParamBank::NOTE_VELOCITY, note_params_lane
     );
 
     if (velocity_buffer == NULL) {
-        velocity_value = (Sample)velocity.get_value();
+        velocity_value = (Sample)note_params.get_value(
+            VoiceParamBank::NOTE_VELOCITY, note_params_lane
+        );
     }
 
     return NULL;
@@ -444,7 +463,9 @@ Voice<ModulatorSignalProducerClass>::Voice(
         Number const oscillator_inaccuracy_seed,
         Params& param_leaders,
         BiquadFilterSharedBuffers* filter_1_shared_buffers,
-        BiquadFilterSharedBuffers* filter_2_shared_buffers
+        BiquadFilterSharedBuffers* filter_2_shared_buffers,
+        VoiceParamBank* const note_params,
+        Integer const note_params_lane
 ) noexcept
     : SignalProducer(CHANNELS, NUMBER_OF_CHILDREN),
     oscillator_inaccuracy_seed(oscillator_inaccuracy_seed),
@@ -469,7 +490,8 @@ Voice<ModulatorSignalProducerClass>::Voice(
         param_leaders.harmonic_7,
         param_leaders.harmonic_8,
         param_leaders.harmonic_9,
-        status
+        status,
+        &param_leaders.custom_waveform
     ),
     filter_1(
         oscillator,
@@ -498,11 +520,14 @@ Voice<ModulatorSignalProducerClass>::Voice(
         &param_leaders.filter_2_q_inaccuracy,
         &oscillator
     ),
-    note_velocity("NV", 0.0, 1.0, 1.0),
-    note_panning("NP", -1.0, 1.0, 0.0),
+    own_note_params(note_params == NULL ? new VoiceParamBank(1) : NULL),
+    note_params(note_params == NULL ? *own_note_params : *note_params),
+    note_params_lane(note_params == NULL ? 0 : note_params_lane),
     panning(param_leaders.panning, status),
     volume(param_leaders.volume, status),
-    volume_applier(filter_2, note_velocity, volume, &oscillator),
+    volume_applier(
+        filter_2, this->note_params, this->note_params_lane, volume, &oscillator
+    ),
     is_drifting(false),
     modulation_out((ModulationOut&)volume_applier)
 {
@@ -522,7 +547,9 @@ Voice<ModulatorSignalProducerClass>::Voice(
         FloatParamS& frequency_modulation_level_leader,
         FloatParamS& phase_modulation_level_leader,
         BiquadFilterSharedBuffers* filter_1_shared_buffers,
-        BiquadFilterSharedBuffers* filter_2_shared_buffers
+        BiquadFilterSharedBuffers* filter_2_shared_buffers,
+        VoiceParamBank* const note_params,
+        Integer const note_params_lane
 ) noexcept
     : SignalProducer(CHANNELS, NUMBER_OF_CHILDREN),
     oscillator_inaccuracy_seed(oscillator_inaccuracy_seed),
@@ -550,7 +577,8 @@ Voice<ModulatorSignalProducerClass>::Voice(
         modulator,
         amplitude_modulation_level_leader,
         frequency_modulation_level_leader,
-        phase_modulation_level_leader
+        phase_modulation_level_leader,
+        &param_leaders.custom_waveform
     ),
     filter_1(
         oscillator,
@@ -587,11 +615,14 @@ Voice<ModulatorSignalProducerClass>::Voice(
         &param_leaders.filter_2_q_inaccuracy,
         &oscillator
     ),
-    note_velocity("NV", 0.0, 1.0, 1.0),
-    note_panning("NP", -1.0, 1.0, 0.0),
+    own_note_params(note_params == NULL ? new VoiceParamBank(1) : NULL),
+    note_params(note_params == NULL ? *own_note_params : *note_params),
+    note_params_lane(note_params == NULL ? 0 : note_params_lane),
     panning(param_leaders.panning, status),
     volume(param_leaders.volume, status),
-    volume_applier(filter_2, note_velocity, volume, &oscillator),
+    volume_applier(
+        filter_2, this->note_params, this->note_params_lane, volume, &oscillator
+    ),
     is_drifting(false),
     modulation_out((ModulationOut&)volume_applier)
 {
@@ -639,8 +670,10 @@ void Voice<ModulatorSignalProducerClass>::initialize_instance(
     note = 0;
     channel = 0;
 
-    register_child(note_velocity);
-    register_child(note_panning);
+    if (own_note_params != NULL) {
+        register_child(*own_note_params);
+    }
+
     register_child(panning);
     register_child(volume);
 
@@ -665,11 +698,20 @@ Number Voice<ModulatorSignalProducerClass>::make_random_seed(
 }
 
 
+template<class ModulatorSignalProducerClass>
+Voice<ModulatorSignalProducerClass>::~Voice()
+{
+    delete own_note_params;
+}
+
+
 template<class ModulatorSignalProducerClass>
 void Voice<ModulatorSignalProducerClass>::reset() noexcept
 {
     SignalProducer::reset();
 
+    note_params.reset_lane(note_params_lane);
+
     synced_oscillator_inaccuracy.reset();
     oscillator_inaccuracy = oscillator_inaccuracy_seed;
     state = State::OFF;
@@ -732,11 +774,25 @@ void Voice<ModulatorSignalProducerClass>::note_on(
     filter_1.update_inaccuracy(1.0 - random_1, random_2);
     filter_2.update_inaccuracy(1.0 - random_2, random_1);
 
-    note_velocity.cancel_events_at(time_offset);
-    note_velocity.schedule_value(time_offset, calculate_note_velocity(velocity));
+    note_params.cancel_events_at(
+        VoiceParamBank::NOTE_VELOCITY, note_params_lane, time_offset
+    );
+    note_params.schedule_value(
+        VoiceParamBank::NOTE_VELOCITY,
+        note_params_lane,
+        time_offset,
+        calculate_note_velocity(velocity)
+    );
 
-    note_panning.cancel_events_at(time_offset);
-    note_panning.schedule_value(time_offset, calculate_note_panning(note));
+    note_params.cancel_events_at(
+        VoiceParamBank::NOTE_PANNING, note_params_lane, time_offset
+    );
+    note_params.schedule_value(
+        VoiceParamBank::NOTE_PANNING,
+        note_params_lane,
+        time_offset,
+        calculate_note_panning(note)
+    );
 
     oscillator.cancel_events_at(time_offset);
 
@@ -1022,16 +1078,26 @@ void Voice<ModulatorSignalProducerClass>::glide_to(
     filter_2.q.update_envelope(time_offset);
     filter_2.gain.update_envelope(time_offset);
 
-    note_velocity.cancel_events_at(time_offset);
-    note_panning.cancel_events_at(time_offset);
+    note_params.cancel_events_at(
+        VoiceParamBank::NOTE_VELOCITY, note_params_lane, time_offset
+    );
+    note_params.cancel_events_at(
+        VoiceParamBank::NOTE_PANNING, note_params_lane, time_offset
+    );
 
     oscillator.frequency.cancel_events_at(time_offset);
 
-    note_velocity.schedule_linear_ramp(
-        portamento_length, calculate_note_velocity(velocity)
+    note_params.schedule_linear_ramp(
+        VoiceParamBank::NOTE_VELOCITY,
+        note_params_lane,
+        portamento_length,
+        calculate_note_velocity(velocity)
     );
-    note_panning.schedule_linear_ramp(
-        portamento_length, calculate_note_panning(note)
+    note_params.schedule_linear_ramp(
+        VoiceParamBank::NOTE_PANNING,
+        note_params_lane,
+        portamento_length,
+        calculate_note_panning(note)
     );
 
     nominal_frequency = get_note_frequency(note, channel);
@@ -1268,6 +1334,52 @@ Midi::Channel Voice<ModulatorSignalProducerClass>::get_channel() const noexcept
 }
 
 
+template<class ModulatorSignalProducerClass>
+void Voice<ModulatorSignalProducerClass>::set_expression_channel(
+        Seconds const time_offset,
+        Midi::Channel const channel
+) noexcept {
+    static_assert(
+        Midi::CHANNELS == MidiController::CHANNELS
+        && Midi::INVALID_CHANNEL == MidiController::INVALID_CHANNEL,
+        "MidiController must use the same channel numbering as Midi"
+    );
+
+    oscillator.modulated_amplitude.set_channel(time_offset, channel);
+    oscillator.amplitude.set_channel(time_offset, channel);
+    oscillator.subharmonic_amplitude.set_channel(time_offset, channel);
+    oscillator.frequency.set_channel(time_offset, channel);
+    oscillator.phase.set_channel(time_offset, channel);
+    oscillator.detune.set_channel(time_offset, channel);
+    oscillator.fine_detune.set_channel(time_offset, channel);
+
+    filter_1.frequency.set_channel(time_offset, channel);
+    filter_1.q.set_channel(time_offset, channel);
+    filter_1.gain.set_channel(time_offset, channel);
+
+    wavefolder.folding.set_channel(time_offset, channel);
+
+    if constexpr (IS_CARRIER) {
+        distortion.level.set_channel(time_offset, channel);
+    }
+
+    filter_2.frequency.set_channel(time_offset, channel);
+    filter_2.q.set_channel(time_offset, channel);
+    filter_2.gain.set_channel(time_offset, channel);
+
+    panning.set_channel(time_offset, channel);
+    volume.set_channel(time_offset, channel);
+}
+
+
+template<class ModulatorSignalProducerClass>
+void Voice<ModulatorSignalProducerClass>::use_lagrange_interpolation_only(
+        bool const is_enabled
+) noexcept {
+    oscillator.use_lagrange_interpolation_only(is_enabled);
+}
+
+
 template<class ModulatorSignalProducerClass>
 Number Voice<ModulatorSignalProducerClass>::get_inaccuracy() const noexcept
 {
@@ -1406,12 +1518,14 @@ Sample const* const* Voice<ModulatorSignalProducerClass>::initialize_rendering(
         panning_value = panning.get_value();
     }
 
-    note_panning_buffer = FloatParamS::produce_if_not_constant<FloatParamS>(
-        note_panning, round, sample_count
+    note_panning_buffer = note_params.get_buffer(
+        VoiceParamBank::NOTE_PANNING, note_params_lane
     );
 
     if (note_panning_buffer == NULL) {
-        note_panning_value = note_panning.get_value();
+        note_panning_value = note_params.get_value(
+            VoiceParamBank::NOTE_PANNING, note_params_lane
+        );
     }
 
     return NULL;
@@ -24,6 +24,7 @@
 
 #include "js80p.hpp"
 #include "midi.hpp"
+#include "voice_param_bank.hpp"
 
 #include "dsp/biquad_filter.hpp"
 #include "dsp/distortion.hpp"
@@ -109,7 +110,7 @@ class Voice : public SignalProducer
 
         static constexpr bool IS_CARRIER = !IS_MODULATOR;
 
-        static constexpr Integer NUMBER_OF_CHILDREN = 10;
+        static constexpr Integer NUMBER_OF_CHILDREN = 9;
 
     public:
         enum State {
@@ -189,6 +190,8 @@ class Voice : public SignalProducer
                 FloatParamB harmonic_8;
                 FloatParamB harmonic_9;
 
+                CustomWaveform custom_waveform;
+
                 BiquadFilterTypeParam filter_1_type;
                 ToggleParam filter_1_freq_log_scale;
                 ToggleParam filter_1_q_log_scale;
@@ -219,7 +222,8 @@ class Voice : public SignalProducer
             public:
                 VolumeApplier(
                     Filter2& input,
-                    FloatParamS& velocity,
+                    VoiceParamBank& note_params,
+                    Integer const note_params_lane,
                     FloatParamS& volume,
                     SignalProducer* const buffer_owner = NULL
                 ) noexcept;
@@ -239,7 +243,8 @@ class Voice : public SignalProducer
 
             private:
                 FloatParamS& volume;
-                FloatParamS& velocity;
+                VoiceParamBank& note_params;
+                Integer const note_params_lane;
 
                 Sample const* volume_buffer;
                 Sample const* velocity_buffer;
@@ -263,7 +268,9 @@ class Voice : public SignalProducer
             Number const oscillator_inaccuracy_seed,
             Params& param_leaders,
             BiquadFilterSharedBuffers* filter_1_shared_buffers = NULL,
-            BiquadFilterSharedBuffers* filter_2_shared_buffers = NULL
+            BiquadFilterSharedBuffers* filter_2_shared_buffers = NULL,
+            VoiceParamBank* const note_params = NULL,
+            Integer const note_params_lane = 0
         ) noexcept;
 
         Voice(
@@ -277,9 +284,13 @@ class Voice : public SignalProducer
             FloatParamS& frequency_modulation_level_leader,
             FloatParamS& phase_modulation_level_leader,
             BiquadFilterSharedBuffers* filter_1_shared_buffers = NULL,
-            BiquadFilterSharedBuffers* filter_2_shared_buffers = NULL
+            BiquadFilterSharedBuffers* filter_2_shared_buffers = NULL,
+            VoiceParamBank* const note_params = NULL,
+            Integer const note_params_lane = 0
         ) noexcept;
 
+        virtual ~Voice();
+
         virtual void reset() noexcept override;
 
         bool is_on() const noexcept;
@@ -337,6 +348,21 @@ class Voice : public SignalProducer
         Integer get_note_id() const noexcept;
         Midi::Note get_note() const noexcept;
         Midi::Channel get_channel() const noexcept;
+
+        /**
+         * \brief Make the parameters of the voice use the per-channel
+         *        values of those controllers which have them (e.g. for MIDI
+         *        Polyphonic Expression) from the given time offset, or
+         *        follow the synth-level values again when \c channel is
+         *        \c Midi::INVALID_CHANNEL.
+         */
+        void set_expression_channel(
+            Seconds const time_offset,
+            Midi::Channel const channel
+        ) noexcept;
+
+        void use_lagrange_interpolation_only(bool const is_enabled) noexcept;
+
         Number get_velocity() const noexcept;
         Number get_inaccuracy() const noexcept;
 
@@ -420,8 +446,10 @@ class Voice : public SignalProducer
         Wavefolder_ wavefolder;
         DistortionInstance distortion;
         Filter2 filter_2;
-        FloatParamS note_velocity;
-        FloatParamS note_panning;
+        /* NULL when the voice uses a lane of a bank shared with other voices. */
+        VoiceParamBank* const own_note_params;
+        VoiceParamBank& note_params;
+        Integer const note_params_lane;
         FloatParamS panning;
         FloatParamS volume;
         VolumeApplier volume_applier;
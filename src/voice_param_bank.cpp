@@ -0,0 +1,438 @@
+/*
+ * This file is part of JS80P, a synthesizer plugin.
+ * Copyright (C) 2023, 2024  Attila M. Magyar
+ *
+ * JS80P is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * JS80P is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef JS80P__VOICE_PARAM_BANK_CPP
+#define JS80P__VOICE_PARAM_BANK_CPP
+
+#include <algorithm>
+#include <cmath>
+
+#include "voice_param_bank.hpp"
+
+
+namespace JS80P
+{
+
+VoiceParamBank::VoiceParamBank(Integer const lanes) noexcept
+    : SignalProducer(0),
+    lanes(lanes),
+    slots(lanes * PARAMS),
+    values((size_t)slots, 0.0),
+    ramp_initial_values((size_t)slots, 0.0),
+    ramp_target_values((size_t)slots, 0.0),
+    ramp_deltas((size_t)slots, 0.0),
+    ramp_speeds((size_t)slots, 0.0),
+    ramp_done_samples((size_t)slots, 0.0),
+    ramp_durations_in_samples((size_t)slots, 0.0),
+    ramp_start_time_offsets((size_t)slots, 0.0),
+    ramp_durations((size_t)slots, 0.0),
+    event_counts((size_t)slots, 0),
+    is_ramping((size_t)slots, 0),
+    is_ramp_done((size_t)slots, 0),
+    is_constant((size_t)slots, 1),
+    lane_events((size_t)(slots * MAX_EVENTS)),
+    buffers((size_t)(slots * block_size), 0.0),
+    rendered_round(-1)
+{
+    for (Integer p = 0; p != PARAMS; ++p) {
+        std::fill_n(&values[(size_t)(p * lanes)], lanes, DEFAULT_VALUES[p]);
+    }
+}
+
+
+void VoiceParamBank::set_block_size(Integer const new_block_size) noexcept
+{
+    if (new_block_size == block_size) {
+        return;
+    }
+
+    SignalProducer::set_block_size(new_block_size);
+
+    buffers.assign((size_t)(slots * new_block_size), 0.0);
+    std::fill(is_constant.begin(), is_constant.end(), 1);
+    rendered_round = -1;
+}
+
+
+void VoiceParamBank::reset() noexcept
+{
+    SignalProducer::reset();
+
+    for (Integer lane = 0; lane != lanes; ++lane) {
+        reset_lane(lane);
+    }
+
+    rendered_round = -1;
+}
+
+
+Integer VoiceParamBank::get_lanes() const noexcept
+{
+    return lanes;
+}
+
+
+void VoiceParamBank::reset_lane(Integer const lane) noexcept
+{
+    for (Integer p = 0; p != PARAMS; ++p) {
+        Integer const slot = get_slot((Param)p, lane);
+
+        if (event_counts[slot] == 0) {
+            continue;
+        }
+
+        event_counts[slot] = 0;
+        push_event(slot, CANCEL, 0.0);
+    }
+}
+
+
+Integer VoiceParamBank::get_slot(Param const param, Integer const lane) const noexcept
+{
+    JS80P_ASSERT(0 <= lane && lane < lanes);
+
+    return (Integer)param * lanes + lane;
+}
+
+
+void VoiceParamBank::cancel_events_at(
+        Param const param,
+        Integer const lane,
+        Seconds const time_offset
+) noexcept {
+    Integer const slot = get_slot(param, lane);
+    LaneEvent const* const events = &lane_events[(size_t)(slot * MAX_EVENTS)];
+    Integer const count = event_counts[slot];
+
+    for (Integer i = 0; i != count; ++i) {
+        if (events[i].time_offset >= time_offset) {
+            event_counts[slot] = i;
+            break;
+        }
+    }
+
+    push_event(slot, CANCEL, time_offset);
+}
+
+
+void VoiceParamBank::schedule_value(
+        Param const param,
+        Integer const lane,
+        Seconds const time_offset,
+        Number const new_value
+) noexcept {
+    push_event(get_slot(param, lane), SET_VALUE, time_offset, 0.0, new_value);
+}
+
+
+void VoiceParamBank::schedule_linear_ramp(
+        Param const param,
+        Integer const lane,
+        Seconds const duration,
+        Number const target_value
+) noexcept {
+    Integer const slot = get_slot(param, lane);
+    Integer const count = event_counts[slot];
+    Seconds const last_event_time_offset = (
+        count == 0
+            ? 0.0
+            : lane_events[(size_t)(slot * MAX_EVENTS + count - 1)].time_offset
+    );
+
+    push_event(slot, LINEAR_RAMP, last_event_time_offset, duration, target_value);
+    push_event(
+        slot, SET_VALUE, last_event_time_offset + duration, 0.0, target_value
+    );
+}
+
+
+void VoiceParamBank::push_event(
+        Integer const slot,
+        EventType const type,
+        Seconds const time_offset,
+        Number const number_param_1,
+        Number const number_param_2
+) noexcept {
+    Integer const count = event_counts[slot];
+    Integer const index = count == MAX_EVENTS ? count - 1 : count;
+    LaneEvent& event = lane_events[(size_t)(slot * MAX_EVENTS + index)];
+
+    event.time_offset = time_offset;
+    event.number_param_1 = number_param_1;
+    event.number_param_2 = number_param_2;
+    event.type = type;
+
+    event_counts[slot] = index + 1;
+}
+
+
+void VoiceParamBank::advance(Integer const round, Integer const sample_count) noexcept
+{
+    if (round == rendered_round) {
+        return;
+    }
+
+    rendered_round = round;
+
+    Seconds const last_sample_time_offset = (
+        (Seconds)(sample_count - 1) * sampling_period
+    );
+    Seconds const elapsed = (Seconds)sample_count * sampling_period;
+
+    /*
+    Most lanes belong to voices which are either off or which are sustaining a
+    note without gliding, so this pass over the flat arrays is usually all the
+    work that needs to be done for a round.
+    */
+    for (Integer slot = 0; slot != slots; ++slot) {
+        is_constant[slot] = (
+            !is_ramping[slot]
+            && (
+                event_counts[slot] == 0
+                || (
+                    lane_events[(size_t)(slot * MAX_EVENTS)].time_offset
+                    > last_sample_time_offset
+                )
+            )
+        );
+    }
+
+    for (Integer slot = 0; slot != slots; ++slot) {
+        if (!is_constant[slot]) {
+            advance_slot(slot, sample_count);
+        }
+    }
+
+    for (Integer slot = 0; slot != slots; ++slot) {
+        LaneEvent* const events = &lane_events[(size_t)(slot * MAX_EVENTS)];
+        Integer const count = event_counts[slot];
+
+        for (Integer i = 0; i != count; ++i) {
+            events[i].time_offset -= elapsed;
+        }
+
+        if (is_ramping[slot]) {
+            ramp_start_time_offsets[slot] -= elapsed;
+        }
+    }
+}
+
+
+void VoiceParamBank::advance_slot(Integer const slot, Integer const sample_count) noexcept
+{
+    Param const param = (Param)(slot / lanes);
+    LaneEvent* const events = &lane_events[(size_t)(slot * MAX_EVENTS)];
+    Sample* const buffer = &buffers[(size_t)(slot * block_size)];
+    Integer current_sample_index = 0;
+
+    while (current_sample_index != sample_count) {
+        Seconds const current_time = (
+            (Seconds)current_sample_index * sampling_period
+        );
+        Integer next_stop = sample_count;
+        Integer handled = 0;
+        Integer const count = event_counts[slot];
+
+        for (; handled != count; ++handled) {
+            LaneEvent const& event = events[handled];
+
+            if (event.time_offset > current_time) {
+                next_stop = current_sample_index + (Integer)std::ceil(
+                    (event.time_offset - current_time) * sample_rate
+                );
+
+                if (next_stop > sample_count) {
+                    next_stop = sample_count;
+                }
+
+                break;
+            }
+
+            handle_lane_event(slot, param, event, current_time);
+        }
+
+        if (handled != 0) {
+            std::copy(events + handled, events + count, events);
+            event_counts[slot] = count - handled;
+        }
+
+        if (is_ramping[slot]) {
+            render_linear_ramp(slot, current_sample_index, next_stop, buffer);
+        } else {
+            std::fill(
+                buffer + current_sample_index, buffer + next_stop, (Sample)values[slot]
+            );
+        }
+
+        current_sample_index = next_stop;
+    }
+}
+
+
+void VoiceParamBank::handle_lane_event(
+        Integer const slot,
+        Param const param,
+        LaneEvent const& event,
+        Seconds const current_time
+) noexcept {
+    switch (event.type) {
+        case SET_VALUE:
+            values[slot] = std::min(
+                MAX_VALUES[param], std::max(MIN_VALUES[param], event.number_param_2)
+            );
+            is_ramping[slot] = 0;
+            break;
+
+        case CANCEL:
+            if (is_ramping[slot]) {
+                Seconds const time_offset = (
+                    event.time_offset - ramp_start_time_offsets[slot]
+                );
+                Seconds const duration = ramp_durations[slot];
+
+                if (duration > 0.0 && time_offset <= duration) {
+                    values[slot] = (
+                        ramp_initial_values[slot]
+                        + (time_offset / duration) * ramp_deltas[slot]
+                    );
+                } else {
+                    values[slot] = ramp_target_values[slot];
+                }
+            }
+
+            is_ramping[slot] = 0;
+            break;
+
+        case LINEAR_RAMP: {
+            Number const value = values[slot];
+            Seconds duration = (Seconds)event.number_param_1;
+            Number target_value = event.number_param_2;
+
+            if (target_value < MIN_VALUES[param]) {
+                duration *= (Seconds)(
+                    (MIN_VALUES[param] - value) / (target_value - value)
+                );
+                target_value = MIN_VALUES[param];
+            } else if (target_value > MAX_VALUES[param]) {
+                duration *= (Seconds)(
+                    (MAX_VALUES[param] - value) / (target_value - value)
+                );
+                target_value = MAX_VALUES[param];
+            }
+
+            Number const duration_in_samples = (Number)duration * (Number)sample_rate;
+
+            is_ramping[slot] = 1;
+            ramp_target_values[slot] = target_value;
+
+            if (duration_in_samples > 0.0) {
+                is_ramp_done[slot] = 0;
+                ramp_start_time_offsets[slot] = event.time_offset;
+                ramp_done_samples[slot] = (
+                    (Number)(current_time - event.time_offset) * (Number)sample_rate
+                );
+                ramp_initial_values[slot] = value;
+                ramp_durations_in_samples[slot] = duration_in_samples;
+                ramp_durations[slot] = duration;
+                ramp_deltas[slot] = target_value - value;
+                ramp_speeds[slot] = 1.0 / duration_in_samples;
+            } else {
+                is_ramp_done[slot] = 1;
+                ramp_done_samples[slot] = 0.0;
+                ramp_durations_in_samples[slot] = 0.0;
+            }
+
+            break;
+        }
+
+        default:
+            break;
+    }
+}
+
+
+void VoiceParamBank::render_linear_ramp(
+        Integer const slot,
+        Integer const first_sample_index,
+        Integer const last_sample_index,
+        Sample* const buffer
+) noexcept {
+    if (first_sample_index == last_sample_index) {
+        return;
+    }
+
+    Integer ramp_end_index = first_sample_index;
+
+    if (!is_ramp_done[slot]) {
+        Number const initial_value = ramp_initial_values[slot];
+        Number const delta = ramp_deltas[slot];
+        Number const speed = ramp_speeds[slot];
+        Number const done_samples = ramp_done_samples[slot];
+        Number const duration_in_samples = ramp_durations_in_samples[slot];
+        Integer const remaining_samples = std::max(
+            (Integer)1, (Integer)std::ceil(duration_in_samples - done_samples)
+        );
+
+        ramp_end_index = std::min(
+            last_sample_index, first_sample_index + remaining_samples
+        );
+
+        for (Integer i = first_sample_index; i != ramp_end_index; ++i) {
+            Number const done = done_samples + (Number)(i - first_sample_index);
+
+            buffer[i] = (Sample)(initial_value + (done * speed) * delta);
+        }
+
+        if (ramp_end_index - first_sample_index == remaining_samples) {
+            ramp_done_samples[slot] = duration_in_samples;
+            is_ramp_done[slot] = 1;
+        } else {
+            ramp_done_samples[slot] = (
+                done_samples + (Number)(ramp_end_index - first_sample_index)
+            );
+        }
+    }
+
+    std::fill(
+        buffer + ramp_end_index,
+        buffer + last_sample_index,
+        (Sample)ramp_target_values[slot]
+    );
+
+    values[slot] = (Number)buffer[last_sample_index - 1];
+}
+
+
+Sample const* VoiceParamBank::get_buffer(
+        Param const param,
+        Integer const lane
+) const noexcept {
+    Integer const slot = get_slot(param, lane);
+
+    return is_constant[slot] ? NULL : &buffers[(size_t)(slot * block_size)];
+}
+
+
+Number VoiceParamBank::get_value(Param const param, Integer const lane) const noexcept
+{
+    return values[get_slot(param, lane)];
+}
+
+}
+
+#endif
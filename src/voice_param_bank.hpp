@@ -0,0 +1,197 @@
+/*
+ * This file is part of JS80P, a synthesizer plugin.
+ * Copyright (C) 2023, 2024  Attila M. Magyar
+ *
+ * JS80P is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * JS80P is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef JS80P__VOICE_PARAM_BANK_HPP
+#define JS80P__VOICE_PARAM_BANK_HPP
+
+#include <vector>
+
+#include "js80p.hpp"
+
+#include "dsp/signal_producer.hpp"
+
+
+namespace JS80P
+{
+
+/**
+ * \brief Structure-of-arrays storage for those parameters which belong to a
+ *        single voice and which don't follow a leader (e.g. the velocity and
+ *        the panning of the note that the voice is playing).
+ *
+ * \note Each voice is assigned a lane in the bank, and the value, the linear
+ *       ramp state, and the scheduled events of each parameter are stored in
+ *       arrays which are indexed by the lane, so the parameters of all the
+ *       voices can be advanced in one pass over contiguous memory, and the
+ *       lanes which are constant during a round don't need to be touched
+ *       beyond a single flag. The scheduling and the rendering follow the
+ *       rules of \c FloatParam, so a lane produces the same signal as a
+ *       \c FloatParamS with the same events would.
+ *
+ * \warning Scheduling events for a lane and rendering the bank must only be
+ *          done from the audio thread, and all the voices which share a bank
+ *          must use the same round and sample count.
+ */
+class VoiceParamBank : public SignalProducer
+{
+    public:
+        enum Param {
+            NOTE_VELOCITY = 0,
+            NOTE_PANNING = 1,
+        };
+
+        static constexpr Integer PARAMS = 2;
+
+        /**
+         * \brief The maximum number of pending events per parameter per lane.
+         *        Scheduling more events than this overwrites the last one.
+         */
+        static constexpr Integer MAX_EVENTS = 8;
+
+        explicit VoiceParamBank(Integer const lanes) noexcept;
+
+        VoiceParamBank(VoiceParamBank const& bank) = delete;
+        VoiceParamBank(VoiceParamBank&& bank) = delete;
+
+        VoiceParamBank& operator=(VoiceParamBank const& bank) = delete;
+        VoiceParamBank& operator=(VoiceParamBank&& bank) = delete;
+
+        virtual void set_block_size(Integer const new_block_size) noexcept override;
+        virtual void reset() noexcept override;
+
+        Integer get_lanes() const noexcept;
+
+        /**
+         * \brief Cancel the pending events of all the parameters of a lane,
+         *        and stop their ramps. (Like \c FloatParam::reset(), this
+         *        doesn't restore the default values.)
+         */
+        void reset_lane(Integer const lane) noexcept;
+
+        void cancel_events_at(
+            Param const param,
+            Integer const lane,
+            Seconds const time_offset
+        ) noexcept;
+
+        void schedule_value(
+            Param const param,
+            Integer const lane,
+            Seconds const time_offset,
+            Number const new_value
+        ) noexcept;
+
+        void schedule_linear_ramp(
+            Param const param,
+            Integer const lane,
+            Seconds const duration,
+            Number const target_value
+        ) noexcept;
+
+        /**
+         * \brief Advance all the parameters of all the lanes by
+         *        \c sample_count samples, unless the bank has already been
+         *        advanced in the given round.
+         */
+        void advance(Integer const round, Integer const sample_count) noexcept;
+
+        /**
+         * \brief Return the samples of the parameter from the last round,
+         *        or \c NULL if it was constant during that round, in which
+         *        case \c get_value() tells its value.
+         */
+        Sample const* get_buffer(Param const param, Integer const lane) const noexcept;
+
+        Number get_value(Param const param, Integer const lane) const noexcept;
+
+    private:
+        enum EventType {
+            SET_VALUE = 0,
+            LINEAR_RAMP = 1,
+            CANCEL = 2,
+        };
+
+        class LaneEvent
+        {
+            public:
+                Seconds time_offset;
+                Number number_param_1;
+                Number number_param_2;
+                EventType type;
+        };
+
+        static constexpr Number MIN_VALUES[PARAMS] = {0.0, -1.0};
+        static constexpr Number MAX_VALUES[PARAMS] = {1.0, 1.0};
+        static constexpr Number DEFAULT_VALUES[PARAMS] = {1.0, 0.0};
+
+        Integer get_slot(Param const param, Integer const lane) const noexcept;
+
+        void push_event(
+            Integer const slot,
+            EventType const type,
+            Seconds const time_offset,
+            Number const number_param_1 = 0.0,
+            Number const number_param_2 = 0.0
+        ) noexcept;
+
+        void advance_slot(Integer const slot, Integer const sample_count) noexcept;
+
+        void handle_lane_event(
+            Integer const slot,
+            Param const param,
+            LaneEvent const& event,
+            Seconds const current_time
+        ) noexcept;
+
+        void render_linear_ramp(
+            Integer const slot,
+            Integer const first_sample_index,
+            Integer const last_sample_index,
+            Sample* const buffer
+        ) noexcept;
+
+        Integer const lanes;
+        Integer const slots;
+
+        /* Indexed by slot = param * lanes + lane. */
+        std::vector<Number> values;
+        std::vector<Number> ramp_initial_values;
+        std::vector<Number> ramp_target_values;
+        std::vector<Number> ramp_deltas;
+        std::vector<Number> ramp_speeds;
+        std::vector<Number> ramp_done_samples;
+        std::vector<Number> ramp_durations_in_samples;
+        std::vector<Seconds> ramp_start_time_offsets;
+        std::vector<Seconds> ramp_durations;
+        std::vector<Integer> event_counts;
+        std::vector<char> is_ramping;
+        std::vector<char> is_ramp_done;
+        std::vector<char> is_constant;
+
+        /* MAX_EVENTS events per slot. */
+        std::vector<LaneEvent> lane_events;
+
+        /* block_size samples per slot. */
+        std::vector<Sample> buffers;
+
+        Integer rendered_round;
+};
+
+}
+
+#endif
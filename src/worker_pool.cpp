@@ -0,0 +1,366 @@
+/*
+ * This file is part of JS80P, a synthesizer plugin.
+ * Copyright (C) 2023, 2024  Attila M. Magyar
+ *
+ * JS80P is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * JS80P is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef JS80P__WORKER_POOL_CPP
+#define JS80P__WORKER_POOL_CPP
+
+#include <algorithm>
+#include <chrono>
+
+#include "worker_pool.hpp"
+
+
+namespace JS80P
+{
+
+std::mutex WorkerPool::instance_mutex;
+
+WorkerPool* WorkerPool::instance = NULL;
+
+Integer WorkerPool::workers_count_override = 0;
+
+
+WorkerPool::Job::Job() noexcept : is_done_(true)
+{
+}
+
+
+WorkerPool::Job::~Job()
+{
+}
+
+
+bool WorkerPool::Job::is_done() const noexcept
+{
+    return is_done_.load();
+}
+
+
+void WorkerPool::Job::execute() noexcept
+{
+    run();
+    is_done_.store(true);
+}
+
+
+WorkerPool::Deque::Deque() noexcept : pool(NULL), top(0), bottom(0)
+{
+    for (Integer i = 0; i != CAPACITY; ++i) {
+        jobs[i].store(NULL);
+    }
+}
+
+
+void WorkerPool::Deque::submit(Job& job) noexcept
+{
+    job.is_done_.store(false);
+
+    /*
+    When the other instances keep all the workers busy, the job would only sit
+    in the deque until the join() picks it up anyways.
+    */
+    if (
+            JS80P_UNLIKELY(
+                (pool != NULL && pool->are_all_workers_busy())
+                || !push(&job)
+            )
+    ) {
+        job.execute();
+
+        return;
+    }
+
+    if (pool != NULL) {
+        pool->wake_up_worker();
+    }
+}
+
+
+void WorkerPool::Deque::join(Job& job) noexcept
+{
+    while (!job.is_done()) {
+        /*
+        Any job that is still in the owner's deque is one that has not been
+        picked up by the workers yet, so it's faster to just do it here than
+        to wait for a worker to become available.
+        */
+        Job* const unstolen_job = pop();
+
+        if (unstolen_job != NULL) {
+            unstolen_job->execute();
+        } else {
+            std::this_thread::yield();
+        }
+    }
+}
+
+
+bool WorkerPool::Deque::push(Job* const job) noexcept
+{
+    Integer const b = bottom.load();
+    Integer const t = top.load();
+
+    if (b - t >= CAPACITY) {
+        return false;
+    }
+
+    jobs[b & MASK].store(job);
+    bottom.store(b + 1);
+
+    return true;
+}
+
+
+WorkerPool::Job* WorkerPool::Deque::pop() noexcept
+{
+    Integer const b = bottom.load() - 1;
+
+    bottom.store(b);
+
+    Integer t = top.load();
+
+    if (t > b) {
+        bottom.store(b + 1);
+
+        return NULL;
+    }
+
+    Job* job = jobs[b & MASK].load();
+
+    if (t == b) {
+        /* Racing against the thieves for the last job. */
+        if (!top.compare_exchange_strong(t, t + 1)) {
+            job = NULL;
+        }
+
+        bottom.store(b + 1);
+    }
+
+    return job;
+}
+
+
+WorkerPool::Job* WorkerPool::Deque::steal() noexcept
+{
+    Integer t = top.load();
+    Integer const b = bottom.load();
+
+    if (t >= b) {
+        return NULL;
+    }
+
+    Job* const job = jobs[t & MASK].load();
+
+    if (!top.compare_exchange_strong(t, t + 1)) {
+        return NULL;
+    }
+
+    return job;
+}
+
+
+WorkerPool::Deque* WorkerPool::acquire_deque() noexcept
+{
+    std::lock_guard<std::mutex> lock(instance_mutex);
+
+    if (instance == NULL) {
+        Integer const workers_count = calculate_workers_count();
+
+        if (workers_count < 1) {
+            return NULL;
+        }
+
+        instance = new WorkerPool(workers_count);
+    }
+
+    for (Integer i = 0; i != MAX_DEQUES; ++i) {
+        if (!instance->is_deque_in_use[i]) {
+            instance->is_deque_in_use[i] = true;
+            ++instance->deques_count;
+
+            return &instance->deques[i];
+        }
+    }
+
+    return NULL;
+}
+
+
+Integer WorkerPool::calculate_workers_count() noexcept
+{
+    if (workers_count_override > 0) {
+        return std::min(workers_count_override, MAX_WORKERS);
+    }
+
+    Integer const cores = (Integer)std::thread::hardware_concurrency();
+
+    /* The rendering threads of the host also need a core. */
+    return std::min(cores - 1, MAX_WORKERS);
+}
+
+
+void WorkerPool::release_deque(Deque* const deque) noexcept
+{
+    if (deque == NULL) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(instance_mutex);
+
+    JS80P_ASSERT(instance != NULL);
+    JS80P_ASSERT(deque->pool == instance);
+    JS80P_ASSERT(deque->top.load() == deque->bottom.load());
+
+    Integer const index = (Integer)(deque - instance->deques);
+
+    JS80P_ASSERT(instance->is_deque_in_use[index]);
+
+    instance->is_deque_in_use[index] = false;
+    --instance->deques_count;
+
+    if (instance->deques_count == 0) {
+        delete instance;
+        instance = NULL;
+    }
+}
+
+
+Integer WorkerPool::get_workers_count() noexcept
+{
+    std::lock_guard<std::mutex> lock(instance_mutex);
+
+    return instance == NULL ? 0 : instance->workers_count;
+}
+
+
+void WorkerPool::override_workers_count(Integer const count) noexcept
+{
+    std::lock_guard<std::mutex> lock(instance_mutex);
+
+    workers_count_override = count;
+}
+
+
+WorkerPool::WorkerPool(Integer const workers_count) noexcept
+    : workers_count(workers_count),
+    deques_count(0),
+    sleeping_workers_count(0),
+    busy_workers_count(0),
+    is_stopping(false)
+{
+    for (Integer i = 0; i != MAX_DEQUES; ++i) {
+        deques[i].pool = this;
+        is_deque_in_use[i] = false;
+    }
+
+    for (Integer i = 0; i != workers_count; ++i) {
+        workers[i] = std::thread(&WorkerPool::work, this, i);
+    }
+}
+
+
+WorkerPool::~WorkerPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        is_stopping.store(true);
+    }
+
+    wake_up.notify_all();
+
+    for (Integer i = 0; i != workers_count; ++i) {
+        workers[i].join();
+    }
+}
+
+
+void WorkerPool::work(Integer const worker_index) noexcept
+{
+    /*
+    Workers start looking for jobs at different deques, so that they don't
+    keep competing for the jobs of the same instance.
+    */
+    Integer const first_deque = (worker_index * MAX_DEQUES) / workers_count;
+    Integer idle_rounds = 0;
+
+    while (!is_stopping.load()) {
+        Job* const job = steal(first_deque);
+
+        if (job != NULL) {
+            busy_workers_count.fetch_add(1);
+            job->execute();
+            busy_workers_count.fetch_sub(1);
+            idle_rounds = 0;
+
+            continue;
+        }
+
+        ++idle_rounds;
+
+        if (idle_rounds < SPIN_ROUNDS) {
+            std::this_thread::yield();
+
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(mutex);
+
+        if (is_stopping.load()) {
+            break;
+        }
+
+        sleeping_workers_count.fetch_add(1);
+        wake_up.wait_for(lock, std::chrono::microseconds(SLEEP_MICROSECONDS));
+        sleeping_workers_count.fetch_sub(1);
+
+        idle_rounds = 0;
+    }
+}
+
+
+WorkerPool::Job* WorkerPool::steal(Integer const first_deque) noexcept
+{
+    for (Integer i = 0; i != MAX_DEQUES; ++i) {
+        Job* const job = deques[(first_deque + i) % MAX_DEQUES].steal();
+
+        if (job != NULL) {
+            return job;
+        }
+    }
+
+    return NULL;
+}
+
+
+void WorkerPool::wake_up_worker() noexcept
+{
+    if (sleeping_workers_count.load() > 0) {
+        wake_up.notify_one();
+    }
+}
+
+
+bool WorkerPool::are_all_workers_busy() const noexcept
+{
+    return busy_workers_count.load() >= workers_count;
+}
+
+}
+
+#endif
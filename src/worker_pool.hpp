@@ -0,0 +1,206 @@
+/*
+ * This file is part of JS80P, a synthesizer plugin.
+ * Copyright (C) 2023, 2024  Attila M. Magyar
+ *
+ * JS80P is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * JS80P is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef JS80P__WORKER_POOL_HPP
+#define JS80P__WORKER_POOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "js80p.hpp"
+
+
+namespace JS80P
+{
+
+/*
+See David Chase, Yossi Lev [SPAA 2005]: Dynamic Circular Work-Stealing Deque
+  https://www.dre.vanderbilt.edu/~schmidt/PDF/work-stealing-dequeue.pdf
+*/
+
+/**
+ * \brief A process-wide pool of worker threads which steal jobs from the
+ *        deques of the rendering threads of all plugin instances, so that
+ *        loading many instances does not oversubscribe the CPU cores.
+ */
+class WorkerPool
+{
+    public:
+        static constexpr Integer MAX_WORKERS = 8;
+        static constexpr Integer MAX_DEQUES = 128;
+
+        /**
+         * \brief Number of rounds that an idle worker spends looking for
+         *        jobs before going to sleep.
+         */
+        static constexpr Integer SPIN_ROUNDS = 2000;
+
+        /**
+         * \brief Upper limit for the time that a sleeping worker may miss
+         *        a wake-up call for.
+         */
+        static constexpr Integer SLEEP_MICROSECONDS = 1000;
+
+        class Job
+        {
+            friend class WorkerPool;
+
+            public:
+                Job() noexcept;
+                virtual ~Job();
+
+                Job(Job const& job) = delete;
+                Job(Job&& job) = delete;
+
+                Job& operator=(Job const& job) = delete;
+                Job& operator=(Job&& job) = delete;
+
+                virtual void run() noexcept = 0;
+
+                bool is_done() const noexcept;
+
+            private:
+                void execute() noexcept;
+
+                std::atomic<bool> is_done_;
+        };
+
+        /**
+         * \brief A bounded work-stealing deque. Only its owner thread may
+         *        push and pop jobs (at the bottom), any other thread may
+         *        steal them (from the top).
+         */
+        class Deque
+        {
+            friend class WorkerPool;
+
+            public:
+                static constexpr Integer CAPACITY = 64;
+
+                Deque() noexcept;
+
+                Deque(Deque const& deque) = delete;
+                Deque(Deque&& deque) = delete;
+
+                Deque& operator=(Deque const& deque) = delete;
+                Deque& operator=(Deque&& deque) = delete;
+
+                /**
+                 * \brief Hand a job over to the workers. When all the
+                 *        workers are busy running other jobs, or the deque
+                 *        is full, the job is run on the calling thread
+                 *        instead.
+                 *
+                 * \warning Must only be called by the owner of the deque.
+                 */
+                void submit(Job& job) noexcept;
+
+                /**
+                 * \brief Wait until the given job is finished. Jobs which
+                 *        have not been picked up by any worker yet are run
+                 *        on the calling thread, so that the wait never
+                 *        depends on how busy the workers are.
+                 *
+                 * \warning Must only be called by the owner of the deque.
+                 */
+                void join(Job& job) noexcept;
+
+                /**
+                 * \warning Must only be called by the owner of the deque.
+                 */
+                bool push(Job* const job) noexcept;
+
+                /**
+                 * \warning Must only be called by the owner of the deque.
+                 */
+                Job* pop() noexcept;
+
+                Job* steal() noexcept;
+
+            private:
+                static constexpr Integer MASK = CAPACITY - 1;
+
+                WorkerPool* pool;
+                std::atomic<Integer> top;
+                std::atomic<Integer> bottom;
+                std::atomic<Job*> jobs[CAPACITY];
+        };
+
+        /**
+         * \brief Obtain a deque for submitting jobs to the process-wide
+         *        pool. The workers are started when the first deque is
+         *        acquired.
+         *
+         * \return  \c NULL when there are no free deques, or when the
+         *          machine doesn't have enough CPU cores for parallel
+         *          rendering to make sense.
+         *
+         * \warning Not real-time safe.
+         */
+        static Deque* acquire_deque() noexcept;
+
+        /**
+         * \brief Give back a deque which has no unfinished jobs. The workers
+         *        are stopped when the last deque is released.
+         *
+         * \warning Not real-time safe.
+         */
+        static void release_deque(Deque* const deque) noexcept;
+
+        static Integer get_workers_count() noexcept;
+
+        /**
+         * \brief Use the given number of workers instead of deciding based
+         *        on the number of CPU cores, starting from the next time
+         *        when the workers are started. Zero restores the automatic
+         *        detection.
+         */
+        static void override_workers_count(Integer const count) noexcept;
+
+    private:
+        static Integer calculate_workers_count() noexcept;
+
+        static std::mutex instance_mutex;
+        static WorkerPool* instance;
+        static Integer workers_count_override;
+
+        explicit WorkerPool(Integer const workers_count) noexcept;
+        ~WorkerPool();
+
+        void work(Integer const worker_index) noexcept;
+        Job* steal(Integer const first_deque) noexcept;
+        void wake_up_worker() noexcept;
+        bool are_all_workers_busy() const noexcept;
+
+        Integer const workers_count;
+        Integer deques_count;
+        std::thread workers[MAX_WORKERS];
+        Deque deques[MAX_DEQUES];
+        bool is_deque_in_use[MAX_DEQUES];
+        std::mutex mutex;
+        std::condition_variable wake_up;
+        std::atomic<Integer> sleeping_workers_count;
+        std::atomic<Integer> busy_workers_count;
+        std::atomic<bool> is_stopping;
+};
+
+}
+
+#endif
@@ -0,0 +1,239 @@
+/*
+ * This file is part of JS80P, a synthesizer plugin.
+ * Copyright (C) 2023, 2024  Attila M. Magyar
+ *
+ * JS80P is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * JS80P is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "js80p.hpp"
+
+#include "midi.hpp"
+#include "renderer.hpp"
+#include "synth.hpp"
+
+
+using namespace JS80P;
+
+
+constexpr Integer HOST_BUFFER_SIZE = 1024;
+constexpr Frequency SAMPLE_RATE = 44100.0;
+constexpr Frequency CC_RATE = 1000.0;
+constexpr Number SAMPLES_PER_CC = SAMPLE_RATE / CC_RATE;
+constexpr size_t MAX_EVENTS = (size_t)(HOST_BUFFER_SIZE / SAMPLES_PER_CC) + 2;
+
+constexpr Midi::Note NOTES[] = {
+    Midi::NOTE_C_3,
+    Midi::NOTE_G_3,
+    Midi::NOTE_C_4,
+    Midi::NOTE_E_FLAT_4,
+    Midi::NOTE_G_4,
+};
+
+
+class ControlChangeHandler
+{
+    public:
+        explicit ControlChangeHandler(Synth& synth) : synth(synth)
+        {
+        }
+
+        void handle_event(Midi::Byte const& value) noexcept
+        {
+            synth.control_change(0.0, 1, Midi::MODULATION_WHEEL, value);
+        }
+
+    private:
+        Synth& synth;
+};
+
+
+void usage(char const* name)
+{
+    fprintf(stderr, "Usage: %s strategy min_sub_block_size seconds\n", name);
+    fprintf(stderr, "\n");
+    fprintf(stderr, "Render a chord while the modulation wheel is moved by a %.0f Hz stream\n", CC_RATE);
+    fprintf(stderr, "of control change messages, and report the rendering time.\n");
+    fprintf(stderr, "\n");
+    fprintf(stderr, "    strategy             \"scheduled\": events are scheduled with time offsets,\n");
+    fprintf(stderr, "                         \"split\": rendering is split up at event boundaries\n");
+    fprintf(stderr, "    min_sub_block_size   minimum sub-block size for the \"split\" strategy\n");
+    fprintf(stderr, "    seconds              length of the rendered sound\n");
+}
+
+
+Midi::Byte cc_value(Integer const cc_index)
+{
+    return (Midi::Byte)(63.5 + 63.5 * std::sin((Number)cc_index * 0.01));
+}
+
+
+double render(bool const split, Integer const min_sub_block_size, Number const seconds)
+{
+    Synth synth;
+    Renderer renderer(synth);
+    ControlChangeHandler event_handler(synth);
+    HostEvents<Midi::Byte, ControlChangeHandler> host_events(event_handler, MAX_EVENTS);
+    Sample* input[Synth::IN_CHANNELS];
+    Sample* output[Synth::OUT_CHANNELS];
+    Integer const buffers = (Integer)std::ceil(
+        seconds * SAMPLE_RATE / (Number)HOST_BUFFER_SIZE
+    );
+    Integer cc_index = 0;
+    Number next_cc = 0.0;
+    Sample checksum = 0.0;
+
+    for (Integer c = 0; c != Synth::OUT_CHANNELS; ++c) {
+        input[c] = new Sample[HOST_BUFFER_SIZE];
+        output[c] = new Sample[HOST_BUFFER_SIZE];
+
+        std::fill_n(input[c], HOST_BUFFER_SIZE, 0.0);
+    }
+
+    synth.suspend();
+    synth.set_sample_rate(SAMPLE_RATE);
+    synth.resume();
+
+    synth.zero_latency.set_value(ToggleParam::ON);
+    synth.push_message(
+        Synth::MessageType::ASSIGN_CONTROLLER,
+        Synth::ParamId::MIX,
+        0.0,
+        Synth::ControllerId::MODULATION_WHEEL
+    );
+    synth.push_message(
+        Synth::MessageType::ASSIGN_CONTROLLER,
+        Synth::ParamId::MF1FRQ,
+        0.0,
+        Synth::ControllerId::MODULATION_WHEEL
+    );
+    synth.process_messages();
+
+    renderer.set_min_sub_block_size(min_sub_block_size);
+
+    for (Midi::Note const note : NOTES) {
+        synth.note_on(0.0, 1, note, 100);
+    }
+
+    std::chrono::time_point<std::chrono::steady_clock> const begin = (
+        std::chrono::steady_clock::now()
+    );
+
+    for (Integer b = 0; b != buffers; ++b) {
+        host_events.clear();
+
+        while (next_cc < (Number)HOST_BUFFER_SIZE) {
+            Integer const sample_offset = (Integer)next_cc;
+            Midi::Byte const value = cc_value(cc_index++);
+
+            if (split) {
+                host_events.push(sample_offset, value);
+            } else {
+                synth.control_change(
+                    synth.sample_count_to_time_offset(sample_offset),
+                    1,
+                    Midi::MODULATION_WHEEL,
+                    value
+                );
+            }
+
+            next_cc += SAMPLES_PER_CC;
+        }
+
+        next_cc -= (Number)HOST_BUFFER_SIZE;
+
+        if (split) {
+            renderer.render<Sample>(HOST_BUFFER_SIZE, input, output, host_events);
+        } else {
+            renderer.render<Sample>(HOST_BUFFER_SIZE, input, output);
+        }
+
+        checksum += output[0][0] + output[1][HOST_BUFFER_SIZE - 1];
+    }
+
+    std::chrono::duration<double> const elapsed = (
+        std::chrono::steady_clock::now() - begin
+    );
+
+    fprintf(stderr, "checksum\t%f\n", checksum);
+
+    for (Integer c = 0; c != Synth::OUT_CHANNELS; ++c) {
+        delete[] input[c];
+        delete[] output[c];
+    }
+
+    return elapsed.count();
+}
+
+
+int main(int const argc, char const* argv[])
+{
+    if (argc < 4) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    char const* const strategy = argv[1];
+    int const min_sub_block_size = atoi(argv[2]);
+    double const seconds = atof(argv[3]);
+    bool split;
+
+    if (0 == strcmp(strategy, "scheduled")) {
+        split = false;
+    } else if (0 == strcmp(strategy, "split")) {
+        split = true;
+    } else {
+        fprintf(stderr, "ERROR: unknown strategy: \"%s\"\n\n", strategy);
+        return 2;
+    }
+
+    if (min_sub_block_size < 1) {
+        fprintf(
+            stderr,
+            "ERROR: min_sub_block_size must be a positive integer, got: %d (interpreted from \"%s\")\n\n",
+            min_sub_block_size,
+            argv[2]
+        );
+        return 3;
+    }
+
+    if (seconds <= 0.0) {
+        fprintf(
+            stderr,
+            "ERROR: seconds must be positive, got: %f (interpreted from \"%s\")\n\n",
+            seconds,
+            argv[3]
+        );
+        return 4;
+    }
+
+    double const elapsed = render(split, (Integer)min_sub_block_size, (Number)seconds);
+
+    fprintf(
+        stderr,
+        "%s\t%d\t%f\t%f\n",
+        strategy,
+        min_sub_block_size,
+        elapsed,
+        elapsed / seconds
+    );
+
+    return 0;
+}
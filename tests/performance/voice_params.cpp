@@ -0,0 +1,218 @@
+/*
+ * This file is part of JS80P, a synthesizer plugin.
+ * Copyright (C) 2023, 2024  Attila M. Magyar
+ *
+ * JS80P is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * JS80P is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "js80p.hpp"
+
+#include "dsp/envelope.cpp"
+#include "dsp/lfo.cpp"
+#include "dsp/lfo_envelope_list.cpp"
+#include "dsp/macro.cpp"
+#include "dsp/math.cpp"
+#include "dsp/midi_controller.cpp"
+#include "dsp/oscillator.cpp"
+#include "dsp/param.cpp"
+#include "dsp/queue.cpp"
+#include "dsp/signal_producer.cpp"
+#include "dsp/wavetable.cpp"
+
+#include "voice_param_bank.cpp"
+
+
+using namespace JS80P;
+
+
+constexpr Integer VOICES = 128;
+constexpr Integer BLOCK_SIZE = 128;
+constexpr Frequency SAMPLE_RATE = 44100.0;
+constexpr Seconds GLIDE_DURATION = 0.05;
+
+
+void usage(char const* name)
+{
+    fprintf(stderr, "Usage: %s strategy glide_interval_blocks seconds\n", name);
+    fprintf(stderr, "\n");
+    fprintf(stderr, "Advance the note velocity and note panning parameters of %d voices,\n", (int)VOICES);
+    fprintf(stderr, "starting a glide in one of the voices every few blocks, and report the\n");
+    fprintf(stderr, "time that it took.\n");
+    fprintf(stderr, "\n");
+    fprintf(stderr, "    strategy                \"objects\": one FloatParamS object per parameter\n");
+    fprintf(stderr, "                            per voice,\n");
+    fprintf(stderr, "                            \"bank\": a single VoiceParamBank for all voices\n");
+    fprintf(stderr, "    glide_interval_blocks   number of blocks between two glides\n");
+    fprintf(stderr, "    seconds                 length of the simulated sound\n");
+}
+
+
+Number glide_target(Integer const glide_index)
+{
+    return 0.5 + 0.4 * (Number)((glide_index * 7) % 5 - 2) / 2.0;
+}
+
+
+double run_objects(Integer const glide_interval, Integer const blocks, Sample& checksum)
+{
+    FloatParamS* params[VOICES * VoiceParamBank::PARAMS];
+    Integer glide_index = 0;
+
+    for (Integer v = 0; v != VOICES; ++v) {
+        params[VoiceParamBank::NOTE_VELOCITY * VOICES + v] = (
+            new FloatParamS("NV", 0.0, 1.0, 1.0)
+        );
+        params[VoiceParamBank::NOTE_PANNING * VOICES + v] = (
+            new FloatParamS("NP", -1.0, 1.0, 0.0)
+        );
+    }
+
+    for (Integer i = 0; i != VOICES * VoiceParamBank::PARAMS; ++i) {
+        params[i]->set_sample_rate(SAMPLE_RATE);
+        params[i]->set_block_size(BLOCK_SIZE);
+    }
+
+    std::chrono::time_point<std::chrono::steady_clock> const begin = (
+        std::chrono::steady_clock::now()
+    );
+
+    for (Integer round = 0; round != blocks; ++round) {
+        if (round % glide_interval == 0) {
+            Integer const voice = glide_index % VOICES;
+            Number const target = glide_target(glide_index++);
+
+            for (Integer p = 0; p != VoiceParamBank::PARAMS; ++p) {
+                FloatParamS& param = *params[p * VOICES + voice];
+
+                param.cancel_events_at(0.0);
+                param.schedule_linear_ramp(GLIDE_DURATION, target);
+            }
+        }
+
+        for (Integer i = 0; i != VOICES * VoiceParamBank::PARAMS; ++i) {
+            Sample const* const buffer = FloatParamS::produce_if_not_constant(
+                *params[i], round, BLOCK_SIZE
+            );
+
+            checksum += buffer == NULL ? params[i]->get_value() : buffer[BLOCK_SIZE - 1];
+        }
+    }
+
+    std::chrono::duration<double> const elapsed = (
+        std::chrono::steady_clock::now() - begin
+    );
+
+    for (Integer i = 0; i != VOICES * VoiceParamBank::PARAMS; ++i) {
+        delete params[i];
+    }
+
+    return elapsed.count();
+}
+
+
+double run_bank(Integer const glide_interval, Integer const blocks, Sample& checksum)
+{
+    VoiceParamBank bank(VOICES);
+    Integer glide_index = 0;
+
+    bank.set_sample_rate(SAMPLE_RATE);
+    bank.set_block_size(BLOCK_SIZE);
+
+    std::chrono::time_point<std::chrono::steady_clock> const begin = (
+        std::chrono::steady_clock::now()
+    );
+
+    for (Integer round = 0; round != blocks; ++round) {
+        if (round % glide_interval == 0) {
+            Integer const voice = glide_index % VOICES;
+            Number const target = glide_target(glide_index++);
+
+            for (Integer p = 0; p != VoiceParamBank::PARAMS; ++p) {
+                VoiceParamBank::Param const param = (VoiceParamBank::Param)p;
+
+                bank.cancel_events_at(param, voice, 0.0);
+                bank.schedule_linear_ramp(param, voice, GLIDE_DURATION, target);
+            }
+        }
+
+        bank.advance(round, BLOCK_SIZE);
+
+        for (Integer p = 0; p != VoiceParamBank::PARAMS; ++p) {
+            VoiceParamBank::Param const param = (VoiceParamBank::Param)p;
+
+            for (Integer lane = 0; lane != VOICES; ++lane) {
+                Sample const* const buffer = bank.get_buffer(param, lane);
+
+                checksum += (
+                    buffer == NULL
+                        ? bank.get_value(param, lane)
+                        : buffer[BLOCK_SIZE - 1]
+                );
+            }
+        }
+    }
+
+    std::chrono::duration<double> const elapsed = (
+        std::chrono::steady_clock::now() - begin
+    );
+
+    return elapsed.count();
+}
+
+
+int main(int const argc, char const* argv[])
+{
+    if (argc < 4) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    char const* const strategy = argv[1];
+    int const glide_interval = atoi(argv[2]);
+    double const seconds = atof(argv[3]);
+    Integer const blocks = (Integer)(seconds * SAMPLE_RATE / (double)BLOCK_SIZE);
+    Sample checksum = 0.0;
+    double elapsed;
+
+    if (glide_interval < 1 || seconds <= 0.0) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    if (0 == strcmp(strategy, "objects")) {
+        elapsed = run_objects((Integer)glide_interval, blocks, checksum);
+    } else if (0 == strcmp(strategy, "bank")) {
+        elapsed = run_bank((Integer)glide_interval, blocks, checksum);
+    } else {
+        usage(argv[0]);
+        return 1;
+    }
+
+    fprintf(stderr, "checksum\t%f\n", checksum);
+    fprintf(
+        stderr,
+        "%s\t%d\t%f\t%f\n",
+        strategy,
+        glide_interval,
+        elapsed,
+        elapsed / seconds
+    );
+
+    return 0;
+}
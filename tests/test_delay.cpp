@@ -23,6 +23,7 @@
 
 #include "dsp/biquad_filter.cpp"
 #include "dsp/delay.cpp"
+#include "dsp/delay_buffer_pool.cpp"
 #include "dsp/distortion.cpp"
 #include "dsp/envelope.cpp"
 #include "dsp/filter.cpp"
@@ -387,8 +388,8 @@ TEST(feedback_signal_merging_is_independent_of_rendered_sample_count, {
         {0.02, 0.04, 0.06, 0.099, 0.099},
     };
     constexpr Sample expected_output[CHANNELS][sample_count] = {
-        {0.00, 0.00, 0.10, 0.20, 0.30, 0.11, 0.12, 0.23, 0.31, 0.11, 0.22, 0.13, 0.11, 0.22, 0.11},
-        {0.00, 0.00, 0.20, 0.40, 0.60, 0.22, 0.24, 0.46, 0.62, 0.22, 0.44, 0.26, 0.22, 0.44, 0.22},
+        {0.00, 0.00, 0.10, 0.20, 0.30, 0.10, 0.10, 0.21, 0.32, 0.13, 0.21, 0.11, 0.12, 0.23, 0.11},
+        {0.00, 0.00, 0.20, 0.40, 0.60, 0.20, 0.20, 0.42, 0.64, 0.26, 0.42, 0.22, 0.24, 0.46, 0.22},
     };
     Sample const* input_buffer[CHANNELS] = {
         (Sample const*)&input_samples[0],
@@ -497,6 +498,127 @@ TEST(reset_clears_the_delay_buffer, {
 })
 
 
+TEST(pooled_delay_leases_its_buffer_when_rendered_and_forgets_its_content_when_released, {
+    constexpr Integer block_size = 5;
+    constexpr Frequency sample_rate = 10.0;
+    constexpr Sample input_samples[CHANNELS][block_size] = {
+        {0.10, 0.20, 0.30, 0.40, 0.50},
+        {0.20, 0.40, 0.60, 0.80, 1.00},
+    };
+    constexpr Sample expected_output[CHANNELS][block_size] = {
+        {0.0, 0.0, 0.10, 0.20, 0.30},
+        {0.0, 0.0, 0.20, 0.40, 0.60},
+    };
+    Sample const* input_buffer[CHANNELS] = {
+        (Sample const*)&input_samples[0],
+        (Sample const*)&input_samples[1]
+    };
+    FixedSignalProducer input(input_buffer);
+    DelayBufferPool delay_buffer_pool;
+    Delay<FixedSignalProducer> delay(input);
+    Sample const* const* rendered_samples;
+
+    input.set_sample_rate(sample_rate);
+    input.set_block_size(block_size);
+
+    delay.use_delay_buffer_pool(delay_buffer_pool);
+    delay.set_sample_rate(sample_rate);
+    delay.set_block_size(block_size);
+    delay.set_feedback_signal_producer(delay);
+    delay.gain.set_value(1.0);
+    delay.time.set_value(0.2);
+
+    delay_buffer_pool.allocate();
+
+    assert_gt((int)delay_buffer_pool.get_size(), 0);
+    assert_eq(0, (int)delay_buffer_pool.get_leased_size());
+
+    SignalProducer::produce< Delay<FixedSignalProducer> >(delay, 1);
+    assert_eq(
+        (int)delay_buffer_pool.get_size(),
+        (int)delay_buffer_pool.get_leased_size()
+    );
+
+    SignalProducer::produce< Delay<FixedSignalProducer> >(delay, 2);
+    delay.release_delay_buffer();
+    assert_eq(0, (int)delay_buffer_pool.get_leased_size());
+
+    rendered_samples = SignalProducer::produce< Delay<FixedSignalProducer> >(
+        delay, 3
+    );
+
+    for (Integer c = 0; c != CHANNELS; ++c) {
+        assert_eq(
+            expected_output[c],
+            rendered_samples[c],
+            block_size,
+            0.001,
+            "channel=%d",
+            (int)c
+        );
+    }
+})
+
+
+TEST(pooled_delay_does_not_lose_its_input_when_leased_again_right_after_being_released, {
+    constexpr Integer block_size = 5;
+    constexpr Frequency sample_rate = 22050.0;
+    constexpr Sample input_samples[CHANNELS][block_size] = {
+        {0.10, 0.20, 0.30, 0.40, 0.50},
+        {0.20, 0.40, 0.60, 0.80, 1.00},
+    };
+    constexpr Sample expected_output[CHANNELS][block_size] = {
+        {0.0, 0.0, 0.10, 0.20, 0.30},
+        {0.0, 0.0, 0.20, 0.40, 0.60},
+    };
+    Sample const* input_buffer[CHANNELS] = {
+        (Sample const*)&input_samples[0],
+        (Sample const*)&input_samples[1]
+    };
+    FixedSignalProducer input(input_buffer);
+    DelayBufferPool delay_buffer_pool;
+    Delay<FixedSignalProducer> delay(input);
+    Sample const* const* rendered_samples;
+
+    input.set_sample_rate(sample_rate);
+    input.set_block_size(block_size);
+
+    delay.use_delay_buffer_pool(delay_buffer_pool);
+    delay.set_sample_rate(sample_rate);
+    delay.set_block_size(block_size);
+    delay.set_feedback_signal_producer(delay);
+    delay.gain.set_value(1.0);
+    delay.time.set_value(2.0 / sample_rate);
+
+    delay_buffer_pool.allocate();
+
+    assert_gt(
+        (int)delay_buffer_pool.get_size(),
+        (int)(CHANNELS * DelayBufferPool::MAX_CLEARED_SAMPLES * sizeof(Sample))
+    );
+
+    SignalProducer::produce< Delay<FixedSignalProducer> >(delay, 1);
+    SignalProducer::produce< Delay<FixedSignalProducer> >(delay, 2);
+    delay.release_delay_buffer();
+    delay_buffer_pool.clear_released_slots();
+
+    rendered_samples = SignalProducer::produce< Delay<FixedSignalProducer> >(
+        delay, 3
+    );
+
+    for (Integer c = 0; c != CHANNELS; ++c) {
+        assert_eq(
+            expected_output[c],
+            rendered_samples[c],
+            block_size,
+            0.001,
+            "channel=%d",
+            (int)c
+        );
+    }
+})
+
+
 TEST(when_tempo_sync_is_on_then_delay_time_is_measured_in_beats_instead_of_seconds, {
     test_basic_delay(1.0, 120.0, ToggleParam::OFF);
     test_delay_with_feedback(1.0, 180.0, ToggleParam::OFF);
@@ -986,3 +1108,125 @@ TEST(output_may_be_panned, {
         distorted_delay, input, "DistortedHighShelfPannedDelay"
     );
 })
+
+
+TEST(multi_tap_delay_is_equivalent_to_mixing_panned_delays_which_share_delay_buffer, {
+    constexpr Integer taps = 4;
+    constexpr Integer block_size = 64;
+    constexpr Integer rounds = 30;
+    constexpr Integer sample_count = rounds * block_size;
+    constexpr Frequency sample_rate = 8000.0;
+    constexpr Number weights[taps] = {1.0, 0.0, 0.6, 0.8};
+    constexpr Number panning_scales[taps] = {1.0, 0.3, -1.0, 0.5};
+    constexpr Seconds times[taps] = {0.010, 0.020, 0.015, 0.003};
+
+    typedef MultiTapDelay<SumOfSines, taps> MultiTapDelayClass;
+    typedef PannedDelay<SumOfSines> PannedDelayClass;
+
+    SumOfSines input_1(0.5, 440.0, 0.3, 1100.0, 0.1, 3300.0, CHANNELS);
+    SumOfSines input_2(0.5, 440.0, 0.3, 1100.0, 0.1, 3300.0, CHANNELS);
+    FloatParamS width_1("W", -1.0, 1.0, 0.6);
+    FloatParamS width_2("W", -1.0, 1.0, 0.6);
+    FloatParamS times_1[taps] = {
+        FloatParamS("T1", 0.0, 0.1, times[0]),
+        FloatParamS("T2", 0.0, 0.1, times[1]),
+        FloatParamS("T3", 0.0, 0.1, times[2]),
+        FloatParamS("T4", 0.0, 0.1, times[3]),
+    };
+    FloatParamS times_2[taps] = {
+        FloatParamS("T1", 0.0, 0.1, times[0]),
+        FloatParamS("T2", 0.0, 0.1, times[1]),
+        FloatParamS("T3", 0.0, 0.1, times[2]),
+        FloatParamS("T4", 0.0, 0.1, times[3]),
+    };
+    MultiTapDelayClass multi_tap_delay(input_1, width_1, times_1);
+    PannedDelayClass panned_delays[taps] = {
+        {input_2, PannedDelayStereoMode::NORMAL, width_2, times_2[0]},
+        {input_2, PannedDelayStereoMode::NORMAL, width_2, times_2[1]},
+        {input_2, PannedDelayStereoMode::NORMAL, width_2, times_2[2]},
+        {input_2, PannedDelayStereoMode::NORMAL, width_2, times_2[3]},
+    };
+    Buffer expected_output(sample_count, CHANNELS);
+    Buffer actual_output(sample_count, CHANNELS);
+    Buffer mixed(block_size, CHANNELS);
+
+    input_1.set_sample_rate(sample_rate);
+    input_1.set_block_size(block_size);
+    input_2.set_sample_rate(sample_rate);
+    input_2.set_block_size(block_size);
+
+    width_1.set_sample_rate(sample_rate);
+    width_1.set_block_size(block_size);
+    width_2.set_sample_rate(sample_rate);
+    width_2.set_block_size(block_size);
+
+    multi_tap_delay.set_sample_rate(sample_rate);
+    multi_tap_delay.set_block_size(block_size);
+
+    for (Integer t = 0; t != taps; ++t) {
+        times_1[t].set_sample_rate(sample_rate);
+        times_1[t].set_block_size(block_size);
+        times_2[t].set_sample_rate(sample_rate);
+        times_2[t].set_block_size(block_size);
+
+        if (t > 0) {
+            panned_delays[t].delay.use_shared_delay_buffer(panned_delays[0].delay);
+        }
+
+        panned_delays[t].set_sample_rate(sample_rate);
+        panned_delays[t].set_block_size(block_size);
+        panned_delays[t].set_panning_scale(panning_scales[t]);
+
+        multi_tap_delay.set_tap(t, weights[t], panning_scales[t]);
+    }
+
+    /*
+    The ramp ends at a block boundary, because when a leader param's ramp ends
+    in the middle of a block, then only its first follower gets the ramping
+    buffer, while the rest of them see a constant value.
+    */
+    width_1.schedule_linear_ramp(0.096, -0.8);
+    width_2.schedule_linear_ramp(0.096, -0.8);
+    times_1[2].schedule_linear_ramp(0.15, 0.05);
+    times_2[2].schedule_linear_ramp(0.15, 0.05);
+
+    for (Integer round = 0; round != rounds; ++round) {
+        actual_output.append(
+            SignalProducer::produce<MultiTapDelayClass>(
+                multi_tap_delay, round, block_size
+            ),
+            block_size
+        );
+
+        for (Integer c = 0; c != CHANNELS; ++c) {
+            std::fill_n(mixed.samples[c], block_size, 0.0);
+        }
+
+        for (Integer t = 0; t != taps; ++t) {
+            Sample const* const* const block = (
+                SignalProducer::produce<PannedDelayClass>(
+                    panned_delays[t], round, block_size
+                )
+            );
+
+            for (Integer c = 0; c != CHANNELS; ++c) {
+                for (Integer i = 0; i != block_size; ++i) {
+                    mixed.samples[c][i] += weights[t] * block[c][i];
+                }
+            }
+        }
+
+        expected_output.append(mixed.samples, block_size);
+    }
+
+    for (Integer c = 0; c != CHANNELS; ++c) {
+        assert_eq(
+            expected_output.samples[c],
+            actual_output.samples[c],
+            sample_count,
+            0.000001,
+            "channel=%d",
+            (int)c
+        );
+    }
+})
@@ -0,0 +1,231 @@
+/*
+ * This file is part of JS80P, a synthesizer plugin.
+ * Copyright (C) 2023, 2024  Attila M. Magyar
+ *
+ * JS80P is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * JS80P is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <cstdint>
+
+#include "test.cpp"
+#include "utils.hpp"
+
+#include "js80p.hpp"
+
+#include "dsp/delay_buffer_pool.cpp"
+
+
+using namespace JS80P;
+
+
+constexpr Integer CHANNELS = 2;
+
+
+void fill(Sample** buffer, Integer const size, Sample const value)
+{
+    for (Integer c = 0; c != CHANNELS; ++c) {
+        std::fill_n(buffer[c], size, value);
+    }
+}
+
+
+void assert_filled(
+        Sample const* const* buffer,
+        Integer const first_sample_index,
+        Integer const last_sample_index,
+        Sample const value
+) {
+    for (Integer c = 0; c != CHANNELS; ++c) {
+        for (Integer i = first_sample_index; i != last_sample_index; ++i) {
+            assert_eq(
+                value, buffer[c][i], DOUBLE_DELTA, "channel=%d, i=%d", (int)c, (int)i
+            );
+        }
+    }
+}
+
+
+TEST(buffers_are_not_available_until_the_arena_is_allocated, {
+    DelayBufferPool pool;
+    DelayBufferPool::SlotId const slot_id = pool.add_slot(CHANNELS, 100);
+
+    assert_eq(0, (int)pool.get_size());
+    assert_true(pool.lease(slot_id) == NULL);
+    assert_true(pool.get(slot_id) == NULL);
+
+    pool.allocate();
+    pool.resize_slot(slot_id, CHANNELS, 200);
+
+    assert_true(pool.lease(slot_id) == NULL);
+})
+
+
+TEST(each_channel_of_each_slot_is_page_aligned, {
+    DelayBufferPool pool;
+    DelayBufferPool::SlotId const slot_1 = pool.add_slot(CHANNELS, 100);
+    DelayBufferPool::SlotId const slot_2 = pool.add_slot(CHANNELS, 1000);
+    DelayBufferPool::SlotId const slot_3 = pool.add_slot(1, 10);
+
+    pool.allocate();
+
+    assert_eq((int)(7 * DelayBufferPool::PAGE_SIZE), (int)pool.get_size());
+    assert_eq(0, (int)pool.get_leased_size());
+
+    Sample** const buffer_1 = pool.lease(slot_1);
+    Sample** const buffer_2 = pool.lease(slot_2);
+    Sample** const buffer_3 = pool.lease(slot_3);
+
+    assert_eq((int)pool.get_size(), (int)pool.get_leased_size());
+
+    assert_eq(0, (int)((uintptr_t)buffer_1[0] % DelayBufferPool::PAGE_SIZE));
+    assert_eq(0, (int)((uintptr_t)buffer_1[1] % DelayBufferPool::PAGE_SIZE));
+    assert_eq(0, (int)((uintptr_t)buffer_2[0] % DelayBufferPool::PAGE_SIZE));
+    assert_eq(0, (int)((uintptr_t)buffer_2[1] % DelayBufferPool::PAGE_SIZE));
+    assert_eq(0, (int)((uintptr_t)buffer_3[0] % DelayBufferPool::PAGE_SIZE));
+
+    fill(buffer_1, 100, 1.0);
+    fill(buffer_2, 1000, 2.0);
+    buffer_3[0][9] = 3.0;
+
+    assert_filled(buffer_1, 0, 100, 1.0);
+    assert_filled(buffer_2, 0, 1000, 2.0);
+})
+
+
+TEST(leasing_is_idempotent_and_only_leased_buffers_are_available, {
+    DelayBufferPool pool;
+    DelayBufferPool::SlotId const slot_id = pool.add_slot(CHANNELS, 100);
+
+    pool.allocate();
+
+    assert_true(pool.get(slot_id) == NULL);
+
+    Sample** const buffer = pool.lease(slot_id);
+
+    assert_true(buffer != NULL);
+    assert_true(pool.lease(slot_id) == buffer);
+    assert_true(pool.get(slot_id) == buffer);
+    assert_eq((int)(CHANNELS * DelayBufferPool::PAGE_SIZE), (int)pool.get_leased_size());
+
+    pool.release(slot_id);
+    pool.release(slot_id);
+
+    assert_true(pool.get(slot_id) == NULL);
+    assert_eq(0, (int)pool.get_leased_size());
+})
+
+
+TEST(released_buffers_are_cleared_incrementally, {
+    constexpr Integer size = DelayBufferPool::MAX_CLEARED_SAMPLES * 2 + 100;
+
+    DelayBufferPool pool;
+    DelayBufferPool::SlotId const slot_id = pool.add_slot(CHANNELS, size);
+
+    pool.allocate();
+
+    Sample** const buffer = pool.lease(slot_id);
+
+    fill(buffer, size, 1.0);
+    pool.release(slot_id);
+
+    pool.clear_released_slots();
+    assert_filled(buffer, 0, DelayBufferPool::MAX_CLEARED_SAMPLES, 0.0);
+    assert_filled(buffer, DelayBufferPool::MAX_CLEARED_SAMPLES, size, 1.0);
+
+    pool.clear_released_slots();
+    pool.clear_released_slots();
+    assert_filled(buffer, 0, size, 0.0);
+})
+
+
+TEST(a_partially_cleared_buffer_is_cleared_completely_when_leased_again, {
+    constexpr Integer size = DelayBufferPool::MAX_CLEARED_SAMPLES * 3 + 100;
+
+    DelayBufferPool pool;
+    DelayBufferPool::SlotId const slot_id = pool.add_slot(CHANNELS, size);
+
+    pool.allocate();
+
+    Sample** const buffer = pool.lease(slot_id);
+
+    fill(buffer, size, 1.0);
+    pool.release(slot_id);
+    pool.clear_released_slots();
+
+    assert_filled(buffer, 0, DelayBufferPool::MAX_CLEARED_SAMPLES, 0.0);
+    assert_filled(buffer, DelayBufferPool::MAX_CLEARED_SAMPLES, size, 1.0);
+    assert_eq(0, (int)pool.get_leased_size());
+
+    assert_true(pool.lease(slot_id) == buffer);
+    assert_filled(buffer, 0, size, 0.0);
+})
+
+
+TEST(only_the_dirty_part_of_a_released_buffer_is_cleared, {
+    constexpr Integer size = DelayBufferPool::MAX_CLEARED_SAMPLES * 3 + 100;
+    constexpr Integer dirty_samples = 1000;
+
+    DelayBufferPool pool;
+    DelayBufferPool::SlotId const slot_1 = pool.add_slot(CHANNELS, size);
+    DelayBufferPool::SlotId const slot_2 = pool.add_slot(CHANNELS, size);
+
+    pool.allocate();
+
+    Sample** const buffer_1 = pool.lease(slot_1);
+    Sample** const buffer_2 = pool.lease(slot_2);
+
+    fill(buffer_1, dirty_samples, 1.0);
+    pool.release(slot_1, dirty_samples);
+    pool.release(slot_2, 0);
+
+    pool.clear_released_slots();
+    pool.clear_released_slots();
+
+    assert_filled(buffer_1, 0, size, 0.0);
+    assert_filled(buffer_2, 0, size, 0.0);
+
+    assert_true(pool.lease(slot_1) == buffer_1);
+    assert_true(pool.lease(slot_2) == buffer_2);
+})
+
+
+TEST(trimming_releases_all_slots_and_provides_fresh_zeroed_buffers, {
+    constexpr Integer size = 5000;
+
+    DelayBufferPool pool;
+    DelayBufferPool::SlotId const slot_1 = pool.add_slot(CHANNELS, size);
+    DelayBufferPool::SlotId const slot_2 = pool.add_slot(CHANNELS, size);
+
+    pool.trim();
+    assert_eq(0, (int)pool.get_size());
+
+    pool.allocate();
+
+    size_t const arena_size = pool.get_size();
+
+    fill(pool.lease(slot_1), size, 0.5);
+    fill(pool.lease(slot_2), size, 0.25);
+    pool.release(slot_2);
+
+    pool.trim();
+
+    assert_eq((int)arena_size, (int)pool.get_size());
+    assert_eq(0, (int)pool.get_leased_size());
+    assert_true(pool.get(slot_1) == NULL);
+    assert_true(pool.get(slot_2) == NULL);
+
+    assert_filled(pool.lease(slot_1), 0, size, 0.0);
+    assert_filled(pool.lease(slot_2), 0, size, 0.0);
+})
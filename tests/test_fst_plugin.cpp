@@ -0,0 +1,507 @@
+/*
+ * This file is part of JS80P, a synthesizer plugin.
+ * Copyright (C) 2024  Attila M. Magyar
+ *
+ * JS80P is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * JS80P is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string>
+
+#include "test.cpp"
+#include "utils.hpp"
+
+#include <fst/fst.h>
+
+#include "js80p.hpp"
+
+#include "bank.hpp"
+#include "plugin/fst/plugin.hpp"
+
+
+using namespace JS80P;
+
+
+/*
+Only the thread which is running the audio callback is watched, so that the
+test itself and the GUI thread's part of the plugin may allocate freely.
+*/
+thread_local bool is_in_audio_callback = false;
+
+size_t audio_callback_allocations = 0;
+size_t audio_callback_deallocations = 0;
+
+
+void* operator new(size_t const size)
+{
+    if (is_in_audio_callback) {
+        ++audio_callback_allocations;
+    }
+
+    void* const ptr = std::malloc(size == 0 ? 1 : size);
+
+    if (ptr == NULL) {
+        throw std::bad_alloc();
+    }
+
+    return ptr;
+}
+
+
+void operator delete(void* const ptr) noexcept
+{
+    if (is_in_audio_callback && ptr != NULL) {
+        ++audio_callback_deallocations;
+    }
+
+    std::free(ptr);
+}
+
+
+void operator delete(void* const ptr, size_t const size) noexcept
+{
+    operator delete(ptr);
+}
+
+
+constexpr VstInt32 BLOCK_SIZE = 256;
+constexpr float SAMPLE_RATE = 22050.0f;
+
+/* more than a second, so that the bank update timer expires a few times */
+constexpr Integer BLOCKS = 100;
+
+
+VstIntPtr VSTCALLBACK host_callback(
+        AEffect* effect,
+        VstInt32 op_code,
+        VstInt32 index,
+        VstIntPtr ivalue,
+        void* pointer,
+        float fvalue
+) {
+    return 0;
+}
+
+
+class MidiMessage
+{
+    public:
+        VstInt32 delta_frames;
+        Midi::Byte bytes[3];
+};
+
+
+class Host
+{
+    public:
+        static constexpr Integer MAX_MESSAGES = 8;
+
+        Host() : effect(FstPlugin::create_instance(&host_callback, NULL))
+        {
+            for (Integer c = 0; c != FstPlugin::OUT_CHANNELS; ++c) {
+                out_samples[c] = &out_buffers[c][0];
+            }
+
+            dispatch(effOpen);
+            dispatch(effSetSampleRate, 0, 0, NULL, SAMPLE_RATE);
+            dispatch(effSetBlockSize, 0, BLOCK_SIZE);
+            dispatch(effMainsChanged, 0, 1);
+        }
+
+        ~Host()
+        {
+            dispatch(effMainsChanged, 0, 0);
+            dispatch(effClose);
+
+            delete effect;
+        }
+
+        FstPlugin& get_plugin() const
+        {
+            return *(FstPlugin*)effect->object;
+        }
+
+        VstIntPtr dispatch(
+                VstInt32 op_code,
+                VstInt32 index = 0,
+                VstIntPtr ivalue = 0,
+                void* pointer = NULL,
+                float fvalue = 0.0f
+        ) {
+            return effect->dispatcher(
+                effect, op_code, index, ivalue, pointer, fvalue
+            );
+        }
+
+        void render_block(Midi::Byte const* const midi = NULL)
+        {
+            if (midi == NULL) {
+                render(BLOCK_SIZE);
+            } else {
+                MidiMessage const message = {0, {midi[0], midi[1], midi[2]}};
+
+                render(BLOCK_SIZE, 1, &message);
+            }
+        }
+
+        void render(
+                VstInt32 const sample_count,
+                Integer const messages_count = 0,
+                MidiMessage const* const messages = NULL
+        ) {
+            is_in_audio_callback = true;
+            send(messages_count, messages);
+            process(sample_count);
+            is_in_audio_callback = false;
+        }
+
+        void send(
+                Integer const messages_count,
+                MidiMessage const* const messages
+        ) {
+            /* VstEvents ends with a flexible array of event pointers */
+            alignas(VstEvents) char buffer[
+                sizeof(VstEvents) + MAX_MESSAGES * sizeof(VstEvent*)
+            ];
+            VstEvents* const events = (VstEvents*)buffer;
+            VstMidiEvent midi_events[MAX_MESSAGES];
+
+            events->numEvents = (VstInt32)messages_count;
+
+            for (Integer i = 0; i != messages_count; ++i) {
+                VstMidiEvent& event = midi_events[i];
+
+                std::memset(&event, 0, sizeof(VstMidiEvent));
+                event.type = kVstMidiType;
+                event.byteSize = sizeof(VstMidiEvent);
+                event.deltaFrames = messages[i].delta_frames;
+                event.midiData[0] = (char)messages[i].bytes[0];
+                event.midiData[1] = (char)messages[i].bytes[1];
+                event.midiData[2] = (char)messages[i].bytes[2];
+
+                events->events[i] = (VstEvent*)&event;
+            }
+
+            if (messages_count > 0) {
+                dispatch(effProcessEvents, 0, 0, (void*)events);
+            }
+        }
+
+        void process(VstInt32 const sample_count)
+        {
+            effect->processReplacing(effect, NULL, out_samples, sample_count);
+        }
+
+        float const* get_output(Integer const channel) const
+        {
+            return out_samples[channel];
+        }
+
+    private:
+        AEffect* const effect;
+
+        float out_buffers[FstPlugin::OUT_CHANNELS][BLOCK_SIZE];
+        float* out_samples[FstPlugin::OUT_CHANNELS];
+};
+
+
+void reset_allocation_counters()
+{
+    audio_callback_allocations = 0;
+    audio_callback_deallocations = 0;
+}
+
+
+void assert_audio_callback_did_not_touch_the_heap()
+{
+    assert_eq(0, (int)audio_callback_allocations);
+    assert_eq(0, (int)audio_callback_deallocations);
+}
+
+
+TEST(audio_callback_does_not_allocate_or_free_memory_while_playing, {
+    Midi::Byte const note_on[] = {0x90, 0x45, 0x70};
+    Host host;
+
+    host.render_block();
+    reset_allocation_counters();
+
+    host.render_block(note_on);
+
+    for (Integer i = 0; i != BLOCKS; ++i) {
+        host.get_plugin().set_parameter(1, (float)i / (float)BLOCKS);
+        host.render_block();
+        host.get_plugin().idle();
+    }
+
+    assert_audio_callback_did_not_touch_the_heap();
+})
+
+
+TEST(all_sound_off_does_not_allocate_or_free_memory_in_the_audio_callback, {
+    Midi::Byte const note_on[] = {0x90, 0x45, 0x70};
+    Midi::Byte const all_sound_off[] = {
+        0xb0, Midi::CONTROL_CHANGE_ALL_SOUND_OFF, 0x00
+    };
+    Host host;
+
+    host.render_block();
+    host.render_block(note_on);
+    reset_allocation_counters();
+
+    host.render_block(all_sound_off);
+
+    for (Integer i = 0; i != BLOCKS; ++i) {
+        host.render_block();
+    }
+
+    assert_audio_callback_did_not_touch_the_heap();
+    assert_false(host.get_plugin().synth.are_voice_buffers_released());
+    assert_true(host.get_plugin().synth.is_idle());
+})
+
+
+TEST(audio_callback_does_not_free_payloads_even_when_the_gui_thread_is_stuck, {
+    Host host;
+    std::string const patch("[js80p]\r\nNAME = Imported\r\nMIX = 0.5\r\n");
+
+    host.render_block();
+    host.get_plugin().set_chunk(
+        (void const*)patch.c_str(), (VstIntPtr)patch.length(), true
+    );
+
+    /* importing the patch itself needs to parse text */
+    host.render_block();
+    reset_allocation_counters();
+
+    for (Integer i = 0; i != BLOCKS; ++i) {
+        host.render_block();
+    }
+
+    assert_audio_callback_did_not_touch_the_heap();
+
+    host.get_plugin().idle();
+
+    char name[kVstMaxProgNameLen];
+
+    host.get_plugin().get_program_name(name, 0);
+    assert_eq("Imported", name);
+})
+
+
+TEST(program_changes_are_reported_to_the_gui_thread_by_index, {
+    Midi::Byte const program_change[] = {0xc0, 0x03, 0x00};
+    Host host;
+
+    host.render_block();
+
+    /* loading the new program needs to parse text */
+    host.render_block(program_change);
+    reset_allocation_counters();
+
+    for (Integer i = 0; i != BLOCKS; ++i) {
+        host.render_block();
+    }
+
+    assert_audio_callback_did_not_touch_the_heap();
+    assert_eq(0, (int)host.get_plugin().get_program());
+
+    host.get_plugin().idle();
+
+    assert_eq(3, (int)host.get_plugin().get_program());
+})
+
+
+TEST(the_final_state_of_the_old_program_is_kept_when_the_program_is_changed, {
+    Midi::Byte const program_change[] = {0xc0, 0x03, 0x00};
+    Host host;
+    Synth& synth = host.get_plugin().synth;
+    char* chunk = NULL;
+    Bank bank;
+
+    host.render_block();
+
+    /* reported to the GUI thread right away */
+    synth.push_message(Synth::MessageType::SET_PARAM, Synth::ParamId::MIX, 0.25, 0);
+    host.render_block();
+
+    /* not reported yet when the program is changed */
+    synth.push_message(Synth::MessageType::SET_PARAM, Synth::ParamId::MIX, 0.75, 0);
+    host.render_block(program_change);
+
+    for (Integer i = 0; i != BLOCKS; ++i) {
+        host.render_block();
+    }
+
+    host.get_plugin().idle();
+
+    VstIntPtr const size = host.dispatch(effGetChunk, 0, 0, (void*)&chunk);
+
+    bank.import(std::string(chunk, (std::string::size_type)size));
+
+    assert_eq(3, (int)host.get_plugin().get_program());
+    assert_true(
+        bank[0].serialize().find("MIX = 0.75") != std::string::npos,
+        "program 0:\n%s",
+        bank[0].serialize().c_str()
+    );
+})
+
+
+TEST(zero_latency_mode_is_kept_when_the_program_is_changed, {
+    Midi::Byte const program_change[] = {0xc0, 0x03, 0x00};
+    Host host;
+    Synth& synth = host.get_plugin().synth;
+
+    synth.push_message(Synth::MessageType::SET_PARAM, Synth::ParamId::ZLAT, 1.0, 0);
+    host.render_block();
+
+    assert_true(synth.is_zero_latency());
+
+    host.render_block(program_change);
+
+    for (Integer i = 0; i != BLOCKS; ++i) {
+        host.render_block();
+    }
+
+    host.get_plugin().idle();
+
+    assert_eq(3, (int)host.get_plugin().get_program());
+    assert_true(synth.is_zero_latency());
+    assert_true(synth.is_zero_latency_atomic());
+})
+
+
+TEST(in_zero_latency_mode_note_events_are_held_back_until_rendering_reaches_them, {
+    MidiMessage const note_on = {100, {0x90, 0x45, 0x70}};
+    Host block_aligned;
+    Host zero_latency;
+
+    zero_latency.get_plugin().synth.process_message(
+        Synth::MessageType::SET_PARAM, Synth::ParamId::ZLAT, 1.0, 0
+    );
+
+    for (Integer i = 0; i != 10; ++i) {
+        block_aligned.render_block();
+        zero_latency.render_block();
+    }
+
+    assert_true(block_aligned.get_plugin().synth.is_idle());
+    assert_true(zero_latency.get_plugin().synth.is_idle());
+
+    block_aligned.send(1, &note_on);
+    zero_latency.send(1, &note_on);
+
+    assert_false(block_aligned.get_plugin().synth.is_idle());
+    assert_true(zero_latency.get_plugin().synth.is_idle());
+
+    zero_latency.process(BLOCK_SIZE);
+
+    assert_false(zero_latency.get_plugin().synth.is_idle());
+})
+
+
+void assert_events_take_effect_on_the_exact_sample(
+        Integer const messages_count,
+        MidiMessage const* const messages
+) {
+    Host expected;
+    Host actual;
+    float expected_samples[FstPlugin::OUT_CHANNELS][BLOCK_SIZE];
+
+    expected.get_plugin().synth.process_message(
+        Synth::MessageType::SET_PARAM, Synth::ParamId::ZLAT, 1.0, 0
+    );
+    actual.get_plugin().synth.process_message(
+        Synth::MessageType::SET_PARAM, Synth::ParamId::ZLAT, 1.0, 0
+    );
+
+    expected.render_block();
+    actual.render_block();
+
+    /*
+    The expected host sends each event at the beginning of its own buffer,
+    while the actual one sends all of them at once, along with their offsets.
+    */
+    for (Integer i = 0; i != messages_count + 1; ++i) {
+        VstInt32 const first = i == 0 ? 0 : messages[i - 1].delta_frames;
+        VstInt32 const last = (
+            i == messages_count ? BLOCK_SIZE : messages[i].delta_frames
+        );
+        VstInt32 const count = last - first;
+
+        if (i == 0) {
+            expected.render(count);
+        } else {
+            MidiMessage message = messages[i - 1];
+
+            message.delta_frames = 0;
+            expected.render(count, 1, &message);
+        }
+
+        for (Integer c = 0; c != FstPlugin::OUT_CHANNELS; ++c) {
+            std::copy_n(expected.get_output(c), count, &expected_samples[c][first]);
+        }
+    }
+
+    actual.render(BLOCK_SIZE, messages_count, messages);
+
+    for (Integer c = 0; c != FstPlugin::OUT_CHANNELS; ++c) {
+        for (Integer i = 0; i != BLOCK_SIZE; ++i) {
+            assert_eq(
+                (double)expected_samples[c][i],
+                (double)actual.get_output(c)[i],
+                0.000001,
+                "channel=%d, i=%d",
+                (int)c,
+                (int)i
+            );
+        }
+    }
+}
+
+
+TEST(in_zero_latency_mode_note_events_take_effect_on_the_exact_sample, {
+    MidiMessage const messages[] = {
+        {50, {0x90, 0x45, 0x70}},
+        {150, {0x80, 0x45, 0x40}},
+        {200, {0x90, 0x45, 0x70}},
+    };
+
+    assert_events_take_effect_on_the_exact_sample(3, messages);
+})
+
+
+TEST(in_zero_latency_mode_sustain_pedal_does_not_overtake_a_held_back_note_off, {
+    MidiMessage const messages[] = {
+        {50, {0x90, 0x45, 0x70}},
+        {100, {0x80, 0x45, 0x40}},
+        {200, {0xb0, Midi::SUSTAIN_PEDAL, 0x7f}},
+    };
+
+    assert_events_take_effect_on_the_exact_sample(3, messages);
+})
+
+
+TEST(in_zero_latency_mode_all_notes_off_does_not_overtake_a_held_back_note_on, {
+    MidiMessage const messages[] = {
+        {100, {0x90, 0x45, 0x70}},
+        {200, {0xb0, Midi::CONTROL_CHANGE_ALL_NOTES_OFF, 0x00}},
+    };
+
+    assert_events_take_effect_on_the_exact_sample(2, messages);
+})
@@ -116,3 +116,25 @@ TEST(gui_initialization, {
     GUI gui(NULL, NULL, NULL, synth, false);
     gui.show();
 })
+
+
+TEST(images_are_shared_between_gui_instances, {
+    Synth synth_1;
+    Synth synth_2;
+
+    assert_eq(0, (int)GUI::get_shared_images_count());
+
+    GUI* gui_1 = new GUI(NULL, NULL, NULL, synth_1, true);
+    size_t const shared_images_count = GUI::get_shared_images_count();
+
+    assert_true(shared_images_count > 0);
+
+    GUI* gui_2 = new GUI(NULL, NULL, NULL, synth_2, true);
+    assert_eq((int)shared_images_count, (int)GUI::get_shared_images_count());
+
+    delete gui_1;
+    assert_eq((int)shared_images_count, (int)GUI::get_shared_images_count());
+
+    delete gui_2;
+    assert_eq(0, (int)GUI::get_shared_images_count());
+})
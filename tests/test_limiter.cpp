@@ -0,0 +1,244 @@
+/*
+ * This file is part of JS80P, a synthesizer plugin.
+ * Copyright (C) 2023, 2024  Attila M. Magyar
+ *
+ * JS80P is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * JS80P is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <cmath>
+
+#include "test.cpp"
+#include "utils.cpp"
+
+#include "js80p.hpp"
+
+#include "dsp/envelope.cpp"
+#include "dsp/filter.cpp"
+#include "dsp/lfo.cpp"
+#include "dsp/lfo_envelope_list.cpp"
+#include "dsp/limiter.cpp"
+#include "dsp/macro.cpp"
+#include "dsp/math.cpp"
+#include "dsp/midi_controller.cpp"
+#include "dsp/oscillator.cpp"
+#include "dsp/param.cpp"
+#include "dsp/queue.cpp"
+#include "dsp/signal_producer.cpp"
+#include "dsp/wavetable.cpp"
+
+
+using namespace JS80P;
+
+
+constexpr Integer CHANNELS = 2;
+constexpr Integer BLOCK_SIZE = 64;
+constexpr Frequency SAMPLE_RATE = 8000.0;
+
+
+typedef Limiter<SumOfSines> SumOfSinesLimiter;
+
+
+void set_up(
+        SumOfSines& input,
+        ToggleParam& enabled,
+        SumOfSinesLimiter& limiter,
+        Byte const enabled_value = ToggleParam::ON
+) {
+    input.set_block_size(BLOCK_SIZE);
+    input.set_sample_rate(SAMPLE_RATE);
+
+    limiter.set_block_size(BLOCK_SIZE);
+    limiter.set_sample_rate(SAMPLE_RATE);
+
+    enabled.set_value(enabled_value);
+}
+
+
+Sample find_peak(Buffer const& buffer, Integer const first_sample_index)
+{
+    Sample peak = 0.0;
+
+    for (Integer c = 0; c != buffer.channels; ++c) {
+        for (Integer i = first_sample_index; i != buffer.size; ++i) {
+            peak = std::max(peak, std::fabs(buffer.samples[c][i]));
+        }
+    }
+
+    return peak;
+}
+
+
+TEST(when_turned_off_then_input_is_passed_through_without_latency, {
+    constexpr Integer rounds = 10;
+    constexpr Integer sample_count = BLOCK_SIZE * rounds;
+
+    SumOfSines input(3.0, 440.0, 0.0, 0.0, 0.0, 0.0, CHANNELS);
+    SumOfSines reference(3.0, 440.0, 0.0, 0.0, 0.0, 0.0, CHANNELS);
+    ToggleParam enabled("L", ToggleParam::OFF);
+    SumOfSinesLimiter limiter(input, enabled);
+    Buffer expected_output(sample_count, CHANNELS);
+    Buffer actual_output(sample_count, CHANNELS);
+
+    set_up(input, enabled, limiter, ToggleParam::OFF);
+    reference.set_block_size(BLOCK_SIZE);
+    reference.set_sample_rate(SAMPLE_RATE);
+
+    render_rounds<SumOfSines>(reference, expected_output, rounds);
+    render_rounds<SumOfSinesLimiter>(limiter, actual_output, rounds);
+
+    assert_eq(0, (int)limiter.get_latency_samples());
+
+    for (Integer c = 0; c != CHANNELS; ++c) {
+        assert_eq(
+            expected_output.samples[c],
+            actual_output.samples[c],
+            sample_count,
+            DOUBLE_DELTA,
+            "channel=%d",
+            (int)c
+        );
+    }
+})
+
+
+TEST(latency_depends_on_sample_rate, {
+    SumOfSines input(0.5, 440.0, 0.0, 0.0, 0.0, 0.0, CHANNELS);
+    ToggleParam enabled("L", ToggleParam::ON);
+    SumOfSinesLimiter limiter(input, enabled);
+
+    limiter.set_sample_rate(8000.0);
+    assert_eq(
+        (int)(SumOfSinesLimiter::FIR_DELAY + 12 - 1),
+        (int)limiter.get_latency_samples()
+    );
+
+    limiter.set_sample_rate(48000.0);
+    assert_eq(
+        (int)(SumOfSinesLimiter::FIR_DELAY + 72 - 1),
+        (int)limiter.get_latency_samples()
+    );
+})
+
+
+TEST(signal_below_the_ceiling_is_delayed_but_not_modified, {
+    constexpr Integer rounds = 10;
+    constexpr Integer sample_count = BLOCK_SIZE * rounds;
+
+    SumOfSines input(0.5, 440.0, 0.3, 1300.0, 0.0, 0.0, CHANNELS);
+    SumOfSines reference(0.5, 440.0, 0.3, 1300.0, 0.0, 0.0, CHANNELS);
+    ToggleParam enabled("L", ToggleParam::OFF);
+    SumOfSinesLimiter limiter(input, enabled);
+    Buffer expected_output(sample_count, CHANNELS);
+    Buffer actual_output(sample_count, CHANNELS);
+
+    set_up(input, enabled, limiter);
+    reference.set_block_size(BLOCK_SIZE);
+    reference.set_sample_rate(SAMPLE_RATE);
+
+    render_rounds<SumOfSines>(reference, expected_output, rounds);
+    render_rounds<SumOfSinesLimiter>(limiter, actual_output, rounds);
+
+    Integer const latency = limiter.get_latency_samples();
+
+    assert_gt((int)latency, 0);
+
+    for (Integer c = 0; c != CHANNELS; ++c) {
+        for (Integer i = 0; i != latency; ++i) {
+            assert_eq(0.0, actual_output.samples[c][i], DOUBLE_DELTA);
+        }
+
+        assert_eq(
+            expected_output.samples[c],
+            &actual_output.samples[c][latency],
+            sample_count - latency,
+            DOUBLE_DELTA,
+            "channel=%d",
+            (int)c
+        );
+    }
+})
+
+
+TEST(sample_peaks_never_exceed_the_ceiling, {
+    constexpr Integer rounds = 20;
+    constexpr Integer sample_count = BLOCK_SIZE * rounds;
+
+    SumOfSines input(3.0, 440.0, 1.5, 1900.0, 0.0, 0.0, CHANNELS);
+    ToggleParam enabled("L", ToggleParam::OFF);
+    SumOfSinesLimiter limiter(input, enabled);
+    Buffer output(sample_count, CHANNELS);
+
+    set_up(input, enabled, limiter);
+
+    render_rounds<SumOfSinesLimiter>(limiter, output, rounds);
+
+    Sample const peak = find_peak(output, 0);
+
+    assert_lte(peak, SumOfSinesLimiter::CEILING + DOUBLE_DELTA);
+    assert_gt(peak, SumOfSinesLimiter::CEILING * 0.8);
+})
+
+
+TEST(inter_sample_peaks_are_detected, {
+    constexpr Integer rounds = 20;
+    constexpr Integer sample_count = BLOCK_SIZE * rounds;
+    constexpr Number amplitude = 1.3;
+    constexpr Frequency frequency = SAMPLE_RATE / 4.0;
+    constexpr Number sample_peak_ratio = 0.70710678118654752440;
+
+    /*
+    The samples of a sine wave at a quarter of the sample rate with a phase of
+    45 degrees are at about 71% of the true peak, so while the samples are below
+    the ceiling, the reconstructed signal would clip.
+    */
+    SumOfSines input(
+        amplitude, frequency, 0.0, 0.0, 0.0, 0.0, CHANNELS, 0.5 / SAMPLE_RATE
+    );
+    ToggleParam enabled("L", ToggleParam::OFF);
+    SumOfSinesLimiter limiter(input, enabled);
+    Buffer output(sample_count, CHANNELS);
+
+    set_up(input, enabled, limiter);
+
+    assert_lt(amplitude * sample_peak_ratio, SumOfSinesLimiter::CEILING);
+
+    render_rounds<SumOfSinesLimiter>(limiter, output, rounds);
+
+    Sample const peak = find_peak(output, sample_count / 2);
+
+    assert_lte(peak, SumOfSinesLimiter::CEILING * sample_peak_ratio * 1.02);
+    assert_gt(peak, SumOfSinesLimiter::CEILING * sample_peak_ratio * 0.9);
+})
+
+
+TEST(rendering_is_independent_of_chunk_size, {
+    SumOfSines input_1(3.0, 440.0, 1.5, 1900.0, 0.0, 0.0, CHANNELS);
+    SumOfSines input_2(3.0, 440.0, 1.5, 1900.0, 0.0, 0.0, CHANNELS);
+    ToggleParam enabled_1("L", ToggleParam::ON);
+    ToggleParam enabled_2("L", ToggleParam::ON);
+    SumOfSinesLimiter limiter_1(input_1, enabled_1);
+    SumOfSinesLimiter limiter_2(input_2, enabled_2);
+
+    input_1.set_sample_rate(SAMPLE_RATE);
+    input_2.set_sample_rate(SAMPLE_RATE);
+    limiter_1.set_sample_rate(SAMPLE_RATE);
+    limiter_2.set_sample_rate(SAMPLE_RATE);
+
+    input_1.set_block_size(5000);
+    input_2.set_block_size(5000);
+
+    assert_rendering_is_independent_from_chunk_size<SumOfSinesLimiter>(
+        limiter_1, limiter_2, DOUBLE_DELTA
+    );
+})
@@ -240,3 +240,107 @@ TEST(can_shift_midpoint, {
     assert_macro_value(macro, 0.75, 0.10 + 0.85 * (0.80 - 0.10));
     assert_macro_value(macro, 1.00, 0.80);
 })
+
+
+TEST(scheduler_evaluates_macro_chains_once_per_round_in_dependency_order, {
+    Macro macro_1("M1");
+    Macro macro_2("M2");
+    Macro macro_3("M3");
+    Macro* macros[] = {&macro_3, &macro_2, &macro_1};
+    MacroScheduler scheduler(macros, 3);
+    FloatParamB param("P", 0.0, 1.0, 0.0);
+
+    macro_3.input.set_macro(&macro_2);
+    macro_2.input.set_macro(&macro_1);
+    param.set_macro(&macro_3);
+    macro_1.input.set_value(0.6);
+
+    scheduler.invalidate();
+    scheduler.update();
+
+    assert_eq(0.6, macro_1.get_value(), DOUBLE_DELTA);
+    assert_eq(0.6, macro_2.get_value(), DOUBLE_DELTA);
+    assert_eq(0.6, macro_3.get_value(), DOUBLE_DELTA);
+
+    macro_1.input.set_value(0.2);
+    macro_3.update();
+
+    assert_eq(0.6, macro_3.get_value(), DOUBLE_DELTA);
+    assert_eq(0.6, param.get_value(), DOUBLE_DELTA);
+
+    scheduler.release();
+    scheduler.update();
+
+    assert_eq(0.2, macro_3.get_value(), DOUBLE_DELTA);
+    assert_eq(0.2, param.get_value(), DOUBLE_DELTA);
+
+    scheduler.release();
+    macro_1.input.set_value(0.4);
+
+    assert_eq(0.4, param.get_value(), DOUBLE_DELTA);
+})
+
+
+TEST(scheduler_can_handle_cyclic_dependencies, {
+    Macro macro_1("M1");
+    Macro macro_2("M2");
+    Macro* macros[] = {&macro_1, &macro_2};
+    MacroScheduler scheduler(macros, 2);
+    FloatParamB param("P", 0.0, 1.0, 0.0);
+
+    macro_1.max.set_value(0.5);
+    macro_2.max.set_value(0.5);
+
+    macro_1.scale.set_macro(&macro_2);
+    macro_2.scale.set_macro(&macro_1);
+    param.set_macro(&macro_2);
+
+    macro_1.input.set_value(1.0);
+    macro_2.input.set_value(1.0);
+
+    macro_1.change(0.0, 1.0);
+    macro_2.change(0.0, 1.0);
+
+    scheduler.invalidate();
+    scheduler.update();
+    scheduler.release();
+
+    assert_eq(0.25, macro_1.get_value(), DOUBLE_DELTA);
+    assert_eq(0.125, macro_2.get_value(), DOUBLE_DELTA);
+})
+
+
+TEST(when_params_have_time_stamped_events_then_macro_queues_events_at_the_same_time_offsets, {
+    Macro macro;
+    MidiController input_controller;
+    MidiController max_controller;
+
+    macro.input.set_midi_controller(&input_controller);
+    macro.max.set_midi_controller(&max_controller);
+
+    input_controller.change(0.0, 0.5);
+    max_controller.change(0.0, 1.0);
+    macro.update();
+
+    input_controller.clear();
+    max_controller.clear();
+    macro.clear();
+
+    input_controller.change(0.1, 0.2);
+    max_controller.change(0.2, 0.5);
+    input_controller.change(0.3, 0.6);
+    macro.update();
+
+    assert_eq(3, (int)macro.events.length());
+
+    assert_eq(0.1, macro.events[0].time_offset, DOUBLE_DELTA);
+    assert_eq(0.2, macro.events[0].number_param_1, DOUBLE_DELTA);
+
+    assert_eq(0.2, macro.events[1].time_offset, DOUBLE_DELTA);
+    assert_eq(0.1, macro.events[1].number_param_1, DOUBLE_DELTA);
+
+    assert_eq(0.3, macro.events[2].time_offset, DOUBLE_DELTA);
+    assert_eq(0.3, macro.events[2].number_param_1, DOUBLE_DELTA);
+
+    assert_eq(0.3, macro.get_value(), DOUBLE_DELTA);
+})
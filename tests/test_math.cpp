@@ -247,6 +247,51 @@ TEST(lookup, {
 })
 
 
+TEST(apply_envelope_shape, {
+    for (int shape = 0; shape != 12; ++shape) {
+        Math::EnvelopeShape const envelope_shape = (Math::EnvelopeShape)shape;
+
+        assert_eq(
+            0.0,
+            Math::apply_envelope_shape(envelope_shape, -0.1),
+            DOUBLE_DELTA,
+            "shape=%d",
+            shape
+        );
+        assert_eq(
+            0.0,
+            Math::apply_envelope_shape(envelope_shape, 0.0),
+            DOUBLE_DELTA,
+            "shape=%d",
+            shape
+        );
+        assert_eq(
+            1.0,
+            Math::apply_envelope_shape(envelope_shape, 1.0),
+            DOUBLE_DELTA,
+            "shape=%d",
+            shape
+        );
+        assert_eq(
+            1.0,
+            Math::apply_envelope_shape(envelope_shape, 1.1),
+            DOUBLE_DELTA,
+            "shape=%d",
+            shape
+        );
+
+        Number previous = 0.0;
+
+        for (Number value = 0.0; value < 1.0; value += 0.0003) {
+            Number const shaped = Math::apply_envelope_shape(envelope_shape, value);
+
+            assert_gte(shaped, previous - DOUBLE_DELTA, "shape=%d", shape);
+            previous = shaped;
+        }
+    }
+})
+
+
 TEST(lookup_periodic, {
     constexpr Integer table_size = 7;
     Number const table[] = {1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0};
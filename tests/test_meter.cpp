@@ -0,0 +1,178 @@
+/*
+ * This file is part of JS80P, a synthesizer plugin.
+ * Copyright (C) 2023, 2024  Attila M. Magyar
+ *
+ * JS80P is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * JS80P is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <cmath>
+
+#include "test.cpp"
+#include "utils.cpp"
+
+#include "js80p.hpp"
+
+#include "dsp/math.cpp"
+#include "dsp/meter.cpp"
+#include "dsp/queue.cpp"
+#include "dsp/signal_producer.cpp"
+#include "seqlock.cpp"
+
+
+using namespace JS80P;
+
+
+constexpr Integer CHANNELS = 2;
+constexpr Integer BLOCK_SIZE = 128;
+constexpr Frequency SAMPLE_RATE = 48000.0;
+
+
+void render_sine(
+        Meter& meter,
+        Number const amplitude,
+        Frequency const frequency,
+        Seconds const length
+) {
+    Integer const blocks = (Integer)(length * SAMPLE_RATE) / BLOCK_SIZE;
+    SumOfSines sine(amplitude, frequency, 0.0, 0.0, 0.0, 0.0, CHANNELS);
+
+    sine.set_block_size(BLOCK_SIZE);
+    sine.set_sample_rate(SAMPLE_RATE);
+
+    for (Integer b = 0; b != blocks; ++b) {
+        Sample const* const* const block = SignalProducer::produce<SumOfSines>(
+            sine, b, BLOCK_SIZE
+        );
+
+        meter.update(block, CHANNELS, BLOCK_SIZE);
+    }
+}
+
+
+void render_silence(Meter& meter, Seconds const length)
+{
+    Integer const blocks = (Integer)(length * SAMPLE_RATE) / BLOCK_SIZE;
+    Buffer buffer(BLOCK_SIZE, CHANNELS);
+
+    for (Integer b = 0; b != blocks; ++b) {
+        meter.update(buffer.samples, CHANNELS, BLOCK_SIZE);
+    }
+}
+
+
+TEST(meter_is_lock_free, {
+    Meter meter;
+
+    assert_true(meter.is_lock_free());
+})
+
+
+TEST(silence_is_measured_as_minimum_loudness, {
+    Meter meter;
+    Meter::Snapshot snapshot;
+
+    meter.set_sample_rate(SAMPLE_RATE);
+
+    assert_true(meter.get_snapshot(snapshot));
+    assert_eq(0.0, snapshot.peak, DOUBLE_DELTA);
+    assert_eq(0.0, snapshot.rms, DOUBLE_DELTA);
+    assert_eq(Meter::MIN_LOUDNESS, snapshot.loudness, DOUBLE_DELTA);
+
+    render_silence(meter, 1.0);
+
+    assert_true(meter.get_snapshot(snapshot));
+    assert_eq(0.0, snapshot.peak, DOUBLE_DELTA);
+    assert_eq(0.0, snapshot.rms, DOUBLE_DELTA);
+    assert_eq(Meter::MIN_LOUDNESS, snapshot.loudness, DOUBLE_DELTA);
+})
+
+
+TEST(peak_rms_and_loudness_of_a_sine_wave, {
+    Meter meter;
+    Meter::Snapshot snapshot;
+
+    meter.set_sample_rate(SAMPLE_RATE);
+    render_sine(meter, 0.5, 1000.0, 4.0);
+
+    assert_true(meter.get_snapshot(snapshot));
+    assert_eq(0.5, snapshot.peak, 0.001);
+    assert_eq(0.5 / std::sqrt(2.0), snapshot.rms, 0.001);
+
+    /*
+    A 1 kHz sine wave with an amplitude of 1.0 on a single channel has a
+    loudness of -3.01 LUFS, the K-weighting gain at 1 kHz is about 0.7 dB.
+    Halving the amplitude is -6.02 dB, the second channel adds +3.01 dB.
+    */
+    assert_eq(-3.01 - 6.02 + 3.01 + 0.69 - 0.691, snapshot.loudness, 0.1);
+})
+
+
+TEST(peak_falls_gradually, {
+    Meter meter;
+    Meter::Snapshot snapshot;
+
+    meter.set_sample_rate(SAMPLE_RATE);
+    render_sine(meter, 1.0, 440.0, 0.5);
+    render_silence(meter, Meter::PEAK_FALL_TIME / 2.0);
+
+    assert_true(meter.get_snapshot(snapshot));
+    assert_eq(
+        std::pow(10.0, - Meter::PEAK_FALL_DB / 40.0), snapshot.peak, 0.01
+    );
+    assert_lt(snapshot.rms, 0.5);
+})
+
+
+TEST(reset_clears_measurements, {
+    Meter meter;
+    Meter::Snapshot snapshot;
+
+    meter.set_sample_rate(SAMPLE_RATE);
+    render_sine(meter, 1.0, 440.0, 0.5);
+    meter.reset();
+
+    assert_true(meter.get_snapshot(snapshot));
+    assert_eq(0.0, snapshot.peak, DOUBLE_DELTA);
+    assert_eq(0.0, snapshot.rms, DOUBLE_DELTA);
+    assert_eq(Meter::MIN_LOUDNESS, snapshot.loudness, DOUBLE_DELTA);
+})
+
+
+TEST(updating_with_silence_is_the_same_as_feeding_silence, {
+    constexpr Integer sample_count = 1000;
+
+    Meter meter;
+    Meter reference_meter;
+    Meter::Snapshot snapshot;
+    Meter::Snapshot expected_snapshot;
+    Buffer buffer(sample_count, CHANNELS);
+
+    meter.set_sample_rate(SAMPLE_RATE);
+    reference_meter.set_sample_rate(SAMPLE_RATE);
+    render_sine(meter, 1.0, 440.0, 3.0);
+    render_sine(reference_meter, 1.0, 440.0, 3.0);
+
+    for (Integer i = 0; i != 30; ++i) {
+        meter.update_with_silence(CHANNELS, sample_count);
+        reference_meter.update(buffer.samples, CHANNELS, sample_count);
+
+        assert_true(meter.get_snapshot(snapshot));
+        assert_true(reference_meter.get_snapshot(expected_snapshot));
+        assert_eq(expected_snapshot.peak, snapshot.peak, DOUBLE_DELTA, "i=%d", (int)i);
+        assert_eq(expected_snapshot.rms, snapshot.rms, DOUBLE_DELTA, "i=%d", (int)i);
+        assert_eq(
+            expected_snapshot.loudness, snapshot.loudness, DOUBLE_DELTA, "i=%d", (int)i
+        );
+    }
+})
@@ -82,6 +82,30 @@ class MidiEventLogger : public Midi::EventHandler
             );
         }
 
+        void control_change_14_bit(
+                Seconds const time_offset,
+                Midi::Channel const channel,
+                Midi::Controller const controller,
+                Midi::Word const new_value
+        ) noexcept {
+            log_event(
+                "CONTROL_CHANGE_14_BIT",
+                time_offset,
+                channel,
+                (Byte)controller,
+                new_value
+            );
+        }
+
+        void nrpn_change(
+                Seconds const time_offset,
+                Midi::Channel const channel,
+                Midi::Word const parameter,
+                Midi::Word const new_value
+        ) noexcept {
+            log_event("NRPN", time_offset, channel, parameter, new_value);
+        }
+
         void program_change(
                 Seconds const time_offset,
                 Midi::Channel const channel,
@@ -146,6 +170,52 @@ class MidiEventLogger : public Midi::EventHandler
         std::string events;
 
     private:
+        void log_event(
+                char const* const event_name,
+                Seconds const time_offset,
+                Midi::Channel const channel,
+                Midi::Byte const byte,
+                Midi::Word const word
+        ) {
+            char buffer[128];
+
+            snprintf(
+                buffer,
+                128,
+                "%s %.1f 0x%02hhx 0x%02hhx 0x%04hx\n",
+                event_name,
+                time_offset,
+                channel,
+                byte,
+                word
+            );
+
+            events += buffer;
+        }
+
+        void log_event(
+                char const* const event_name,
+                Seconds const time_offset,
+                Midi::Channel const channel,
+                Midi::Word const word_1,
+                Midi::Word const word_2
+        ) {
+            char buffer[128];
+
+            snprintf(
+                buffer,
+                128,
+                "%s %.1f 0x%02hhx 0x%04hx 0x%04hx\n",
+                event_name,
+                time_offset,
+                channel,
+                word_1,
+                word_2
+            );
+
+            events += buffer;
+        }
+
         void log_event(
                 char const* const event_name,
                 Seconds const time_offset,
@@ -316,3 +386,36 @@ TEST(running_status, {
         )
     );
 })
+
+
+TEST(high_resolution_controllers_are_assembled_from_msb_and_lsb, {
+    assert_eq(
+        (
+            "CONTROL_CHANGE 1.0 0x03 0x01 0x15\n"
+            "CONTROL_CHANGE 1.0 0x03 0x21 0x3c\n"
+            "CONTROL_CHANGE_14_BIT 1.0 0x03 0x01 0x0abc\n"
+            "CONTROL_CHANGE 1.0 0x04 0x21 0x3c\n"
+            "CONTROL_CHANGE_14_BIT 1.0 0x04 0x01 0x003c\n"
+        ),
+        parse_midi(1.0, "\xb3\x01\x15\x21\x3c\xb4\x21\x3c")
+    );
+})
+
+
+TEST(nrpn_data_entry, {
+    assert_eq(
+        (
+            "CONTROL_CHANGE 1.0 0x05 0x63 0x01\n"
+            "CONTROL_CHANGE 1.0 0x05 0x62 0x07\n"
+            "NRPN 1.0 0x05 0x0087 0x0a95\n"
+            "NRPN 1.0 0x05 0x0087 0x0abc\n"
+            "CONTROL_CHANGE 1.0 0x05 0x65 0x00\n"
+            "CONTROL_CHANGE 1.0 0x05 0x06 0x15\n"
+        ),
+        parse_midi(
+            1.0,
+            "\xb5\x63\x01\x62\x07\x06\x15\x26\x3c\x65\x00\x06\x15",
+            13
+        )
+    );
+})
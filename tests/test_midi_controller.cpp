@@ -85,3 +85,53 @@ TEST(keeps_track_of_assignments, {
     midi_controller.assigned();
     assert_true(midi_controller.is_assigned());
 })
+
+
+TEST(events_at_the_same_time_and_plateaus_are_merged, {
+    MidiController midi_controller;
+
+    midi_controller.change(1.0, 0.2);
+    midi_controller.change(1.0, 0.3);
+    midi_controller.change(2.0, 0.5);
+    midi_controller.change(3.0, 0.5);
+    midi_controller.change(4.0, 0.5);
+    midi_controller.change(5.0, 0.6);
+
+    assert_eq(0.6, midi_controller.get_value());
+    assert_eq(4, (int)midi_controller.events.length());
+    assert_eq(1.0, midi_controller.events[0].time_offset, DOUBLE_DELTA);
+    assert_eq(0.3, midi_controller.events[0].number_param_1, DOUBLE_DELTA);
+    assert_eq(2.0, midi_controller.events[1].time_offset, DOUBLE_DELTA);
+    assert_eq(0.5, midi_controller.events[1].number_param_1, DOUBLE_DELTA);
+    assert_eq(4.0, midi_controller.events[2].time_offset, DOUBLE_DELTA);
+    assert_eq(0.5, midi_controller.events[2].number_param_1, DOUBLE_DELTA);
+    assert_eq(5.0, midi_controller.events[3].time_offset, DOUBLE_DELTA);
+    assert_eq(0.6, midi_controller.events[3].number_param_1, DOUBLE_DELTA);
+})
+
+
+TEST(number_of_events_is_limited_regardless_of_controller_density, {
+    constexpr Integer changes = 1000;
+
+    MidiController midi_controller;
+    Seconds previous_time_offset = -1.0;
+
+    for (Integer i = 0; i != changes; ++i) {
+        midi_controller.change((Seconds)i * 0.001, (Number)i / (Number)changes);
+    }
+
+    assert_lte((int)midi_controller.events.length(), (int)MidiController::MAX_EVENTS);
+    assert_gt((int)midi_controller.events.length(), (int)MidiController::MAX_EVENTS / 2);
+
+    for (Integer i = 0; i != (Integer)midi_controller.events.length(); ++i) {
+        SignalProducer::Event const& event = midi_controller.events[i];
+
+        assert_gt(event.time_offset, previous_time_offset, "i=%d", (int)i);
+        assert_eq(event.time_offset, event.number_param_1, DOUBLE_DELTA, "i=%d", (int)i);
+
+        previous_time_offset = event.time_offset;
+    }
+
+    assert_eq(0.999, midi_controller.events.back().time_offset, DOUBLE_DELTA);
+    assert_eq(0.999, midi_controller.get_value(), DOUBLE_DELTA);
+})
@@ -435,6 +435,150 @@ TEST(custom_waveform_is_updated_before_each_rendering_round, {
 });
 
 
+TEST(oscillators_can_share_a_custom_waveform, {
+    constexpr Frequency sample_rate = 22050.0;
+    constexpr Integer block_size = 2048;
+
+    Byte const voice_status = Constants::VOICE_STATUS_NORMAL;
+
+    SumOfSines expected_1(0.5, 440.0, -0.5, 440.0 * 2.0, 0.0, 440.0 * 9.0, 1, 0.0);
+    SumOfSines expected_2(0.5, 440.0, 0.3, 440.0 * 2.0, 0.2, 440.0 * 9.0, 1, (Number)block_size / sample_rate);
+
+    FloatParamS amplitude("", 0.0, 1.0, 1.0);
+    FloatParamS dummy_float_param("", 0.0, 1.0, 0.0);
+    ToggleParam dummy_toggle_param("", ToggleParam::OFF);
+    FloatParamB harmonic_0("", -1.0, 1.0, 0.0);
+    FloatParamB harmonic_1("", -1.0, 1.0, 0.0);
+    FloatParamB harmonic_8("", -1.0, 1.0, 0.0);
+    FloatParamB harmonic_rest("", -1.0, 1.0, 0.0);
+
+    CustomWaveform custom_waveform(
+        harmonic_0,
+        harmonic_1,
+        harmonic_rest,
+        harmonic_rest,
+        harmonic_rest,
+        harmonic_rest,
+        harmonic_rest,
+        harmonic_rest,
+        harmonic_8,
+        harmonic_rest
+    );
+
+    SimpleOscillator::WaveformParam waveform_param("");
+    SimpleOscillator* oscillators[2];
+
+    for (Integer i = 0; i != 2; ++i) {
+        oscillators[i] = new SimpleOscillator(
+            waveform_param,
+            amplitude,
+            dummy_float_param,
+            dummy_float_param,
+            dummy_float_param,
+            dummy_toggle_param,
+            harmonic_0,
+            harmonic_1,
+            harmonic_rest,
+            harmonic_rest,
+            harmonic_rest,
+            harmonic_rest,
+            harmonic_rest,
+            harmonic_rest,
+            harmonic_8,
+            harmonic_rest,
+            voice_status,
+            &custom_waveform
+        );
+    }
+
+    Buffer actual_output_1(block_size);
+    Buffer actual_output_2(block_size);
+    Buffer expected_output(block_size);
+
+    amplitude.set_sample_rate(sample_rate);
+    amplitude.set_block_size(block_size);
+
+    dummy_float_param.set_sample_rate(sample_rate);
+    dummy_float_param.set_block_size(block_size);
+
+    harmonic_0.set_sample_rate(sample_rate);
+    harmonic_0.set_block_size(block_size);
+
+    harmonic_1.set_sample_rate(sample_rate);
+    harmonic_1.set_block_size(block_size);
+
+    harmonic_8.set_sample_rate(sample_rate);
+    harmonic_8.set_block_size(block_size);
+
+    harmonic_rest.set_sample_rate(sample_rate);
+    harmonic_rest.set_block_size(block_size);
+
+    expected_1.set_sample_rate(sample_rate);
+    expected_1.set_block_size(block_size);
+
+    expected_2.set_sample_rate(sample_rate);
+    expected_2.set_block_size(block_size);
+
+    waveform_param.set_sample_rate(sample_rate);
+    waveform_param.set_block_size(block_size);
+    waveform_param.set_value(SimpleOscillator::CUSTOM);
+
+    harmonic_0.set_value(0.5);
+    harmonic_1.set_value(-0.5);
+
+    for (Integer i = 0; i != 2; ++i) {
+        oscillators[i]->set_block_size(block_size);
+        oscillators[i]->set_sample_rate(sample_rate);
+        oscillators[i]->frequency.set_value(440.0);
+        oscillators[i]->start(0.0);
+    }
+
+    harmonic_1.schedule_value(0.001, 0.3);
+    harmonic_8.schedule_value(0.001, 0.2);
+
+    render_rounds<SimpleOscillator>(*oscillators[0], actual_output_1, 1, block_size, 1);
+    render_rounds<SimpleOscillator>(*oscillators[1], actual_output_2, 1, block_size, 1);
+    render_rounds<SumOfSines>(expected_1, expected_output, 1, block_size, 1);
+
+    assert_close(
+        expected_output.samples[0],
+        actual_output_1.samples[0],
+        block_size,
+        0.01,
+        "round=1, oscillator=1"
+    );
+    assert_close(
+        expected_output.samples[0],
+        actual_output_2.samples[0],
+        block_size,
+        0.01,
+        "round=1, oscillator=2"
+    );
+
+    render_rounds<SimpleOscillator>(*oscillators[1], actual_output_2, 1, block_size, 2);
+    render_rounds<SimpleOscillator>(*oscillators[0], actual_output_1, 1, block_size, 2);
+    render_rounds<SumOfSines>(expected_2, expected_output, 1, block_size, 2);
+
+    assert_close(
+        expected_output.samples[0],
+        actual_output_1.samples[0],
+        block_size,
+        0.01,
+        "round=2, oscillator=1"
+    );
+    assert_close(
+        expected_output.samples[0],
+        actual_output_2.samples[0],
+        block_size,
+        0.01,
+        "round=2, oscillator=2"
+    );
+
+    delete oscillators[0];
+    delete oscillators[1];
+})
+
+
 TEST(sine_chirp_from_100hz_to_400hz, {
     constexpr Frequency start_frequency = 100.0;
     constexpr Frequency end_frequency = 400.0;
@@ -1410,6 +1410,72 @@ TEST(follower_float_param_follows_the_leaders_envelope, {
 })
 
 
+TEST(followers_in_the_same_envelope_stage_share_the_rendered_envelope_block, {
+    constexpr Integer block_size = 10;
+    constexpr Sample expected_samples_1[block_size] = {
+        0.0, 0.0, 1.0, 2.0, 3.0,
+        3.0, 2.0, 1.0, 1.0, 1.0,
+    };
+    constexpr Sample expected_samples_2[block_size] = {
+        0.0, 0.0, 0.0, 1.0, 2.0,
+        3.0, 3.0, 2.0, 1.0, 1.0,
+    };
+    Envelope envelope("env");
+    Envelope* envelopes[Constants::ENVELOPES] = {
+        &envelope, NULL, NULL, NULL, NULL, NULL,
+        NULL, NULL, NULL, NULL, NULL, NULL,
+    };
+    FloatParamS leader("follow", -5.0, 5.0, 0.0, 0.0, envelopes);
+    FloatParamS follower_1(leader);
+    FloatParamS follower_2(leader);
+    FloatParamS follower_3(leader);
+    Sample const* const* rendered_samples;
+
+    leader.set_block_size(block_size);
+    leader.set_sample_rate(1.0);
+    leader.set_envelope(&envelope);
+    leader.set_value(0.2);
+
+    follower_1.set_block_size(block_size);
+    follower_1.set_sample_rate(1.0);
+    follower_2.set_block_size(block_size);
+    follower_2.set_sample_rate(1.0);
+    follower_3.set_block_size(block_size);
+    follower_3.set_sample_rate(1.0);
+
+    envelope.scale.set_value(0.8);
+    envelope.initial_value.set_value(0.625);
+    envelope.delay_time.set_value(0.7);
+    envelope.attack_time.set_value(3.0);
+    envelope.peak_value.set_value(1.0);
+    envelope.hold_time.set_value(1.0);
+    envelope.decay_time.set_value(2.0);
+    envelope.sustain_value.set_value(0.75);
+    envelope.release_time.set_value(2.0);
+    envelope.final_value.set_value(0.625);
+
+    follower_1.start_envelope(0.3, 0.0, 0.0);
+    follower_2.start_envelope(0.3, 0.0, 0.0);
+    follower_3.start_envelope(1.3, 0.0, 0.0);
+
+    rendered_samples = FloatParamS::produce<FloatParamS>(follower_1, 1, block_size);
+    assert_eq(expected_samples_1, rendered_samples[0], block_size, DOUBLE_DELTA);
+    assert_eq(0, (int)leader.get_envelope_render_cache_hits());
+
+    rendered_samples = FloatParamS::produce<FloatParamS>(follower_2, 1, block_size);
+    assert_eq(expected_samples_1, rendered_samples[0], block_size, DOUBLE_DELTA);
+    assert_eq(1, (int)leader.get_envelope_render_cache_hits());
+
+    rendered_samples = FloatParamS::produce<FloatParamS>(follower_3, 1, block_size);
+    assert_eq(expected_samples_2, rendered_samples[0], block_size, DOUBLE_DELTA);
+    assert_eq(1, (int)leader.get_envelope_render_cache_hits());
+
+    rendered_samples = FloatParamS::produce<FloatParamS>(follower_1, 2, block_size);
+    rendered_samples = FloatParamS::produce<FloatParamS>(follower_2, 2, block_size);
+    assert_eq(2, (int)leader.get_envelope_render_cache_hits());
+})
+
+
 TEST(canceling_follower_float_param_envelope_releases_it_in_the_given_amount_of_time, {
     constexpr Integer block_size = 10;
     constexpr Sample expected_samples[block_size] = {
@@ -2074,6 +2140,35 @@ TEST(when_a_midi_controller_is_assigned_to_a_sample_evaluated_float_param_then_f
 })
 
 
+TEST(when_a_macro_has_time_stamped_events_then_float_param_follows_them_within_the_block, {
+    constexpr Integer block_size = 5;
+    constexpr Sample expected_samples[block_size] = {
+        3.0, 3.0, 1.16667, -2.5, -2.5,
+    };
+    FloatParamS float_param("float", -5.0, 5.0, 3.0);
+    MidiController midi_controller;
+    Macro macro;
+    Sample const* const* rendered_samples;
+
+    macro.input.set_midi_controller(&midi_controller);
+    midi_controller.change(0.0, 0.8);
+    midi_controller.clear();
+
+    float_param.set_block_size(block_size);
+    float_param.set_sample_rate(1.0);
+    float_param.set_macro(&macro);
+    macro.clear();
+
+    assert_eq(3.0, float_param.get_value(), DOUBLE_DELTA);
+
+    midi_controller.change(1.5, 0.25);
+
+    rendered_samples = FloatParamS::produce<FloatParamS>(float_param, 1, block_size);
+
+    assert_eq(expected_samples, rendered_samples[0], block_size, 0.01);
+})
+
+
 TEST(float_param_follows_midi_controller_changes_gradually, {
     constexpr Integer block_size = 2000;
     constexpr Frequency sample_rate = 3000.0;
@@ -3092,6 +3187,61 @@ TEST(a_float_param_may_use_logarithmic_scale, {
 });
 
 
+TEST(logarithmic_ramps_match_the_lookup_table, {
+    constexpr Number min = Constants::BIQUAD_FILTER_FREQUENCY_MIN;
+    constexpr Number max = Constants::BIQUAD_FILTER_FREQUENCY_MAX;
+    constexpr Integer block_size = 100;
+    constexpr Frequency sample_rate = 100.0;
+    constexpr Number start_ratio = 0.1;
+    constexpr Number target_ratio = 0.9;
+    constexpr Seconds duration = 0.7;
+    ToggleParam log_scale("log", ToggleParam::ON);
+    FloatParamS param(
+        "freq",
+        min,
+        max,
+        Constants::BIQUAD_FILTER_FREQUENCY_DEFAULT,
+        0.0,
+        NULL,
+        &log_scale,
+        Math::log_biquad_filter_freq_table(),
+        Math::LOG_BIQUAD_FILTER_FREQ_TABLE_MAX_INDEX,
+        Math::LOG_BIQUAD_FILTER_FREQ_TABLE_INDEX_SCALE
+    );
+    Sample expected_samples[block_size];
+    Sample const* const* rendered_samples;
+
+    param.set_block_size(block_size);
+    param.set_sample_rate(sample_rate);
+    param.set_ratio(start_ratio);
+    param.schedule_linear_ramp(duration, param.ratio_to_value(target_ratio));
+
+    for (Integer i = 0; i != block_size; ++i) {
+        Number const ratio = std::min(
+            target_ratio,
+            start_ratio
+            + (target_ratio - start_ratio) * (Number)i / (duration * sample_rate)
+        );
+
+        expected_samples[i] = std::log2(param.ratio_to_value(ratio));
+    }
+
+    rendered_samples = FloatParamS::produce<FloatParamS>(param, 1, block_size);
+
+    for (Integer i = 0; i != block_size; ++i) {
+        assert_eq(
+            expected_samples[i],
+            std::log2(rendered_samples[0][i]),
+            0.001,
+            "i=%d",
+            (int)i
+        );
+    }
+
+    assert_eq(param.ratio_to_value(target_ratio), param.get_value(), 0.01);
+})
+
+
 void assert_decay_status(
         bool const expected,
         FloatParamS& float_param,
@@ -38,7 +38,7 @@ enum RenderMode {
 };
 
 
-void test_varaible_size_rounds(RenderMode const mode)
+void test_varaible_size_rounds(RenderMode const mode, bool const zero_latency)
 {
     constexpr Integer buffer_size = 4096;
     constexpr Frequency sample_rate = 11025.0;
@@ -59,6 +59,14 @@ void test_varaible_size_rounds(RenderMode const mode)
 
     Integer const channels = synth.get_channels();
 
+    synth.process_message(
+        Synth::MessageType::SET_PARAM,
+        Synth::ParamId::ZLAT,
+        zero_latency ? 1.0 : 0.0,
+        0
+    );
+    synth.publish_params_snapshot();
+
     Renderer renderer(synth);
     Integer const latency = renderer.get_latency_samples();
     SumOfSines input(
@@ -79,7 +87,7 @@ void test_varaible_size_rounds(RenderMode const mode)
         0.5, 110.0,
         0.0, 0.0,
         channels,
-        0.005079
+        zero_latency ? 0.0 : 0.005079
     );
     Sample const* const* in_samples;
     Sample const* const* expected_samples;
@@ -168,6 +176,626 @@ void test_varaible_size_rounds(RenderMode const mode)
 
 
 TEST(number_of_samples_to_render_may_vary_between_rounds, {
-    test_varaible_size_rounds(OVERWRITE);
-    test_varaible_size_rounds(ADD);
+    test_varaible_size_rounds(OVERWRITE, false);
+    test_varaible_size_rounds(ADD, false);
+})
+
+
+TEST(in_zero_latency_mode_exactly_the_requested_number_of_samples_are_rendered, {
+    Synth synth;
+    Renderer renderer(synth);
+
+    assert_eq(
+        (int)(synth.get_block_size() + synth.get_latency_samples()),
+        (int)renderer.get_latency_samples()
+    );
+
+    synth.process_message(
+        Synth::MessageType::SET_PARAM, Synth::ParamId::ZLAT, 1.0, 0
+    );
+    synth.publish_params_snapshot();
+
+    assert_eq((int)synth.get_latency_samples(), (int)renderer.get_latency_samples());
+
+    test_varaible_size_rounds(OVERWRITE, true);
+    test_varaible_size_rounds(ADD, true);
+})
+
+
+class NoteOnDispatcher
+{
+    public:
+        NoteOnDispatcher(Synth& synth, Integer const note_on_sample_index)
+            : synth(synth),
+            note_on_sample_index(note_on_sample_index),
+            dispatched_sample_index(-1)
+        {
+        }
+
+        Integer dispatch_events(Integer const sample_index) noexcept
+        {
+            if (dispatched_sample_index < 0 && sample_index >= note_on_sample_index) {
+                dispatched_sample_index = sample_index;
+                synth.note_on(0.0, 1, Midi::NOTE_A_3, 127);
+            }
+
+            return dispatched_sample_index < 0 ? note_on_sample_index : -1;
+        }
+
+        Synth& synth;
+        Integer const note_on_sample_index;
+        Integer dispatched_sample_index;
+};
+
+
+void set_up_sine_synth(Synth& synth, Frequency const sample_rate)
+{
+    synth.set_sample_rate(sample_rate);
+
+    synth.modulator_params.amplitude.set_value(1.0);
+    synth.modulator_params.volume.set_value(1.0);
+    synth.modulator_params.waveform.set_value(SimpleOscillator::SINE);
+    synth.modulator_params.width.set_value(0.0);
+
+    synth.carrier_params.volume.set_value(0.0);
+
+    synth.process_message(
+        Synth::MessageType::SET_PARAM, Synth::ParamId::ZLAT, 1.0, 0
+    );
+}
+
+
+TEST(in_zero_latency_mode_rendering_can_be_split_up_at_event_offsets, {
+    constexpr Frequency sample_rate = 11025.0;
+    constexpr Integer sample_count = 1500;
+    constexpr Integer note_on_sample_index = 333;
+
+    Synth synth;
+    Synth reference_synth;
+    Renderer renderer(synth);
+    Renderer reference_renderer(reference_synth);
+    NoteOnDispatcher dispatcher(synth, note_on_sample_index);
+    Integer const channels = synth.get_channels();
+    double* in_samples[channels];
+    double* out_samples[channels];
+    double* expected_samples[channels];
+
+    set_up_sine_synth(synth, sample_rate);
+    set_up_sine_synth(reference_synth, sample_rate);
+
+    for (Integer c = 0; c != channels; ++c) {
+        in_samples[c] = new double[sample_count];
+        out_samples[c] = new double[sample_count];
+        expected_samples[c] = new double[sample_count];
+        std::fill_n(in_samples[c], sample_count, 0.0);
+    }
+
+    reference_synth.note_on(
+        (Seconds)note_on_sample_index / sample_rate, 1, Midi::NOTE_A_3, 127
+    );
+    reference_renderer.render<double>(sample_count, in_samples, expected_samples);
+
+    renderer.render<double>(sample_count, in_samples, out_samples, dispatcher);
+
+    assert_eq((int)note_on_sample_index, (int)dispatcher.dispatched_sample_index);
+
+    for (Integer c = 0; c != channels; ++c) {
+        for (Integer i = 0; i != note_on_sample_index; ++i) {
+            assert_eq(0.0, out_samples[c][i], DOUBLE_DELTA, "channel=%d, i=%d", (int)c, (int)i);
+        }
+
+        assert_close(
+            expected_samples[c], out_samples[c], sample_count, 0.001, "channel=%d", (int)c
+        );
+
+        delete[] in_samples[c];
+        delete[] out_samples[c];
+        delete[] expected_samples[c];
+    }
+})
+
+
+class RecordingEventHandler
+{
+    public:
+        static constexpr Integer MAX_EVENTS = 32;
+
+        RecordingEventHandler() : events_count(0)
+        {
+        }
+
+        void handle_event(Integer const& event) noexcept
+        {
+            events[events_count++] = event;
+        }
+
+        Integer events[MAX_EVENTS];
+        Integer events_count;
+};
+
+
+TEST(host_events_are_dispatched_in_the_order_of_their_sample_offsets, {
+    RecordingEventHandler event_handler;
+    HostEvents<Integer, RecordingEventHandler> host_events(event_handler, 5);
+
+    assert_true(host_events.is_empty());
+
+    assert_true(host_events.push(30, 1));
+    assert_true(host_events.push(10, 2));
+    assert_true(host_events.push(30, 3));
+    assert_true(host_events.push(20, 4));
+    assert_true(host_events.push(10, 5));
+    assert_false(host_events.push(0, 6));
+
+    assert_eq(5, (int)host_events.length());
+
+    assert_eq(10, (int)host_events.dispatch_events(0));
+    assert_eq(0, (int)event_handler.events_count);
+
+    assert_eq(30, (int)host_events.dispatch_events(25));
+    assert_eq(3, (int)event_handler.events_count);
+    assert_eq(2, (int)event_handler.events[0]);
+    assert_eq(5, (int)event_handler.events[1]);
+    assert_eq(4, (int)event_handler.events[2]);
+
+    assert_eq(-1, (int)host_events.dispatch_events(30));
+    assert_eq(5, (int)event_handler.events_count);
+    assert_eq(1, (int)event_handler.events[3]);
+    assert_eq(3, (int)event_handler.events[4]);
+
+    host_events.clear();
+
+    assert_true(host_events.is_empty());
+    assert_eq(-1, (int)host_events.dispatch_events(100));
+})
+
+
+TEST(flushing_host_events_dispatches_the_ones_that_were_not_reached, {
+    RecordingEventHandler event_handler;
+    HostEvents<Integer, RecordingEventHandler> host_events(event_handler, 5);
+
+    host_events.push(10, 1);
+    host_events.push(9999, 2);
+    host_events.push(20, 3);
+
+    assert_eq(9999, (int)host_events.dispatch_events(128));
+    assert_eq(2, (int)event_handler.events_count);
+
+    host_events.flush();
+
+    assert_eq(3, (int)event_handler.events_count);
+    assert_eq(2, (int)event_handler.events[2]);
+    assert_true(host_events.is_empty());
+})
+
+
+class SubBlockRecorder
+{
+    public:
+        static constexpr Integer MAX_DISPATCHES = 32;
+
+        SubBlockRecorder(
+                HostEvents<Integer, RecordingEventHandler>& host_events
+        ) : host_events(host_events),
+            dispatches_count(0)
+        {
+        }
+
+        Integer dispatch_events(Integer const sample_index) noexcept
+        {
+            dispatches[dispatches_count++] = sample_index;
+
+            return host_events.dispatch_events(sample_index);
+        }
+
+        HostEvents<Integer, RecordingEventHandler>& host_events;
+        Integer dispatches[MAX_DISPATCHES];
+        Integer dispatches_count;
+};
+
+
+TEST(events_closer_than_the_min_sub_block_size_are_dispatched_together, {
+    constexpr Integer sample_count = 256;
+    constexpr Integer expected_dispatches[] = {0, 64, 128, 192, 256};
+
+    Synth synth;
+    Renderer renderer(synth);
+    RecordingEventHandler event_handler;
+    HostEvents<Integer, RecordingEventHandler> host_events(event_handler, 32);
+    SubBlockRecorder recorder(host_events);
+    Integer const channels = synth.get_channels();
+    double* in_samples[channels];
+    double* out_samples[channels];
+
+    for (Integer c = 0; c != channels; ++c) {
+        in_samples[c] = new double[sample_count];
+        out_samples[c] = new double[sample_count];
+        std::fill_n(in_samples[c], sample_count, 0.0);
+    }
+
+    synth.process_message(
+        Synth::MessageType::SET_PARAM, Synth::ParamId::ZLAT, 1.0, 0
+    );
+    renderer.set_min_sub_block_size(64);
+
+    for (Integer i = 0; i != 21; ++i) {
+        host_events.push(i * 10, i);
+    }
+
+    renderer.render<double>(sample_count, in_samples, out_samples, recorder);
+
+    assert_eq(64, (int)renderer.get_min_sub_block_size());
+    assert_eq(21, (int)event_handler.events_count);
+    assert_eq(5, (int)recorder.dispatches_count);
+
+    for (Integer i = 0; i != 5; ++i) {
+        assert_eq((int)expected_dispatches[i], (int)recorder.dispatches[i]);
+    }
+
+    for (Integer c = 0; c != channels; ++c) {
+        delete[] in_samples[c];
+        delete[] out_samples[c];
+    }
+})
+
+
+TEST(idle_synth_is_skipped_until_the_next_event_or_non_silent_input, {
+    constexpr Frequency sample_rate = 11025.0;
+    constexpr Integer sample_count = 1500;
+    constexpr Integer note_on_sample_index = 333;
+
+    Synth synth;
+    Synth reference_synth;
+    Renderer renderer(synth);
+    Renderer reference_renderer(reference_synth);
+    NoteOnDispatcher dispatcher(synth, note_on_sample_index);
+    Integer const channels = synth.get_channels();
+    double* in_samples[channels];
+    double* out_samples[channels];
+    double* expected_samples[channels];
+    Integer rendered_sample_count;
+    Integer skipped_sample_count;
+
+    set_up_sine_synth(synth, sample_rate);
+    set_up_sine_synth(reference_synth, sample_rate);
+
+    for (Integer c = 0; c != channels; ++c) {
+        in_samples[c] = new double[sample_count];
+        out_samples[c] = new double[sample_count];
+        expected_samples[c] = new double[sample_count];
+        std::fill_n(in_samples[c], sample_count, 0.0);
+    }
+
+    for (Integer i = 0; i != 10; ++i) {
+        renderer.render<double>(sample_count, in_samples, out_samples);
+    }
+
+    assert_true(synth.is_idle());
+
+    synth.get_last_rendered_block(rendered_sample_count);
+    renderer.render<double>(123, in_samples, out_samples);
+    synth.get_last_rendered_block(skipped_sample_count);
+    assert_eq((int)rendered_sample_count, (int)skipped_sample_count);
+
+    for (Integer c = 0; c != channels; ++c) {
+        for (Integer i = 0; i != 123; ++i) {
+            assert_eq(0.0, out_samples[c][i], DOUBLE_DELTA, "channel=%d, i=%d", (int)c, (int)i);
+        }
+    }
+
+    reference_synth.note_on(
+        (Seconds)note_on_sample_index / sample_rate, 1, Midi::NOTE_A_3, 127
+    );
+    reference_renderer.render<double>(sample_count, in_samples, expected_samples);
+
+    renderer.render<double>(sample_count, in_samples, out_samples, dispatcher);
+
+    assert_false(synth.is_idle());
+    assert_eq((int)note_on_sample_index, (int)dispatcher.dispatched_sample_index);
+
+    for (Integer c = 0; c != channels; ++c) {
+        for (Integer i = 0; i != note_on_sample_index; ++i) {
+            assert_eq(0.0, out_samples[c][i], DOUBLE_DELTA, "channel=%d, i=%d", (int)c, (int)i);
+        }
+
+        assert_close(
+            expected_samples[c], out_samples[c], sample_count, 0.001, "channel=%d", (int)c
+        );
+    }
+
+    synth.note_off(0.0, 1, Midi::NOTE_A_3, 127);
+
+    for (Integer i = 0; i != 10; ++i) {
+        renderer.render<double>(sample_count, in_samples, out_samples);
+    }
+
+    assert_true(synth.is_idle());
+
+    synth.input_volume.set_value(1.0);
+    in_samples[0][0] = 0.5;
+    renderer.render<double>(123, in_samples, out_samples);
+    synth.get_last_rendered_block(rendered_sample_count);
+    assert_eq(123, (int)rendered_sample_count);
+    assert_false(synth.is_idle());
+
+    for (Integer c = 0; c != channels; ++c) {
+        delete[] in_samples[c];
+        delete[] out_samples[c];
+        delete[] expected_samples[c];
+    }
+})
+
+
+void test_idle_synth_keeps_meters_and_params_snapshot_up_to_date(
+        bool const zero_latency
+) {
+    constexpr Frequency sample_rate = 11025.0;
+    constexpr Integer sample_count = 1500;
+
+    Synth synth;
+    Renderer renderer(synth);
+    Integer const channels = synth.get_channels();
+    Integer const idle_rounds = (
+        (Integer)(
+            sample_rate * (
+                Meter::LOUDNESS_BIN_LENGTH * (Seconds)Meter::LOUDNESS_BINS
+                + 3.0 * Meter::PEAK_FALL_TIME
+            )
+        ) / sample_count
+    );
+    double* in_samples[channels];
+    double* out_samples[channels];
+    Meter::Snapshot meter_snapshot;
+    Synth::ParamsSnapshot params_snapshot;
+
+    set_up_sine_synth(synth, sample_rate);
+    synth.process_message(
+        Synth::MessageType::SET_PARAM, Synth::ParamId::ZLAT, zero_latency ? 1.0 : 0.0, 0
+    );
+    synth.process_message(
+        Synth::MessageType::ASSIGN_CONTROLLER,
+        Synth::ParamId::MIX,
+        0.0,
+        Synth::ControllerId::MODULATION_WHEEL
+    );
+    synth.start_metering();
+
+    for (Integer c = 0; c != channels; ++c) {
+        in_samples[c] = new double[sample_count];
+        out_samples[c] = new double[sample_count];
+        std::fill_n(in_samples[c], sample_count, 0.0);
+    }
+
+    synth.note_on(0.0, 1, Midi::NOTE_A_3, 127);
+    renderer.render<double>(sample_count, in_samples, out_samples);
+    synth.note_off(0.0, 1, Midi::NOTE_A_3, 127);
+    renderer.render<double>(sample_count, in_samples, out_samples);
+
+    assert_true(synth.get_meter_snapshot(Synth::MeterId::METER_OUT, meter_snapshot));
+    assert_gt(meter_snapshot.peak, 0.1);
+
+    for (Integer i = 0; i != 10; ++i) {
+        renderer.render<double>(sample_count, in_samples, out_samples);
+    }
+
+    assert_true(synth.is_idle());
+
+    for (Integer i = 0; i != idle_rounds; ++i) {
+        renderer.render<double>(sample_count, in_samples, out_samples);
+    }
+
+    assert_true(synth.is_idle());
+
+    for (Integer i = 0; i != Synth::MeterId::METERS; ++i) {
+        assert_true(synth.get_meter_snapshot((Synth::MeterId)i, meter_snapshot));
+        assert_lt(meter_snapshot.peak, 0.01, "meter=%d", (int)i);
+        assert_lt(meter_snapshot.rms, 0.001, "meter=%d", (int)i);
+        assert_eq(
+            Meter::MIN_LOUDNESS,
+            meter_snapshot.loudness,
+            DOUBLE_DELTA,
+            "meter=%d",
+            (int)i
+        );
+    }
+
+    synth.midi_controllers[Midi::MODULATION_WHEEL]->change(0.0, 0.7);
+    renderer.render<double>(sample_count, in_samples, out_samples);
+
+    assert_true(synth.get_params_snapshot(params_snapshot));
+    assert_eq(0.7, params_snapshot.ratios[Synth::ParamId::MIX], DOUBLE_DELTA);
+
+    for (Integer c = 0; c != channels; ++c) {
+        delete[] in_samples[c];
+        delete[] out_samples[c];
+    }
+}
+
+
+TEST(idle_synth_keeps_meters_and_params_snapshot_up_to_date, {
+    test_idle_synth_keeps_meters_and_params_snapshot_up_to_date(true);
+    test_idle_synth_keeps_meters_and_params_snapshot_up_to_date(false);
+})
+
+
+void set_up_echo_and_reverb(Synth& synth)
+{
+    Synth::ParamId const param_ids[] = {
+        Synth::ParamId::EEDEL,
+        Synth::ParamId::EEFB,
+        Synth::ParamId::EEWET,
+        Synth::ParamId::ERRS,
+        Synth::ParamId::ERWET,
+    };
+    Number const ratios[] = {0.05, 0.6, 0.7, 0.5, 0.7};
+
+    for (Integer i = 0; i != 5; ++i) {
+        synth.process_message(
+            Synth::MessageType::SET_PARAM, param_ids[i], ratios[i], 0
+        );
+    }
+}
+
+
+void test_offline_rendering(bool const with_echo_and_reverb)
+{
+    constexpr Frequency sample_rate = 11025.0;
+    constexpr Integer sample_count = 1500;
+    constexpr Integer rounds = 12;
+    constexpr Integer note_off_round = 3;
+
+    Synth synth;
+    Synth reference_synth;
+    Renderer renderer(synth);
+    Renderer reference_renderer(reference_synth);
+    Integer const real_time_block_size = synth.get_block_size();
+    Integer const channels = synth.get_channels();
+    double* in_samples[channels];
+    double* out_samples[channels];
+    double* expected_samples[channels];
+
+    set_up_sine_synth(synth, sample_rate);
+    set_up_sine_synth(reference_synth, sample_rate);
+
+    if (with_echo_and_reverb) {
+        set_up_echo_and_reverb(synth);
+        set_up_echo_and_reverb(reference_synth);
+    }
+
+    for (Integer c = 0; c != channels; ++c) {
+        in_samples[c] = new double[sample_count];
+        out_samples[c] = new double[sample_count];
+        expected_samples[c] = new double[sample_count];
+        std::fill_n(in_samples[c], sample_count, 0.0);
+    }
+
+    synth.suspend();
+    synth.set_offline_rendering(true);
+    synth.resume();
+    renderer.reset();
+
+    assert_true(synth.is_rendering_offline());
+    assert_eq((int)real_time_block_size, (int)synth.get_block_size());
+
+    synth.note_on(0.0, 1, Midi::NOTE_A_3, 127);
+    reference_synth.note_on(0.0, 1, Midi::NOTE_A_3, 127);
+
+    for (Integer r = 0; r != rounds; ++r) {
+        if (r == note_off_round) {
+            synth.note_off(0.0, 1, Midi::NOTE_A_3, 127);
+            reference_synth.note_off(0.0, 1, Midi::NOTE_A_3, 127);
+        }
+
+        renderer.render<double>(sample_count, in_samples, out_samples);
+        reference_renderer.render<double>(sample_count, in_samples, expected_samples);
+
+        for (Integer c = 0; c != channels; ++c) {
+            assert_close(
+                expected_samples[c],
+                out_samples[c],
+                sample_count,
+                0.005,
+                "effects=%d, round=%d, channel=%d",
+                (int)with_echo_and_reverb,
+                (int)r,
+                (int)c
+            );
+        }
+    }
+
+    synth.suspend();
+    synth.set_offline_rendering(false);
+    renderer.reset();
+
+    assert_false(synth.is_rendering_offline());
+    assert_true(synth.are_voice_buffers_released());
+    assert_eq((int)real_time_block_size, (int)synth.get_block_size());
+
+    synth.process_message(
+        Synth::MessageType::SET_PARAM, Synth::ParamId::ZLAT, 0.0, 0
+    );
+    synth.publish_params_snapshot();
+
+    assert_eq(
+        (int)(real_time_block_size + synth.get_latency_samples()),
+        (int)renderer.get_latency_samples()
+    );
+
+    for (Integer c = 0; c != channels; ++c) {
+        delete[] in_samples[c];
+        delete[] out_samples[c];
+        delete[] expected_samples[c];
+    }
+}
+
+
+TEST(offline_rendering_keeps_the_block_size_and_sounds_the_same_as_real_time_rendering, {
+    test_offline_rendering(false);
+    test_offline_rendering(true);
+})
+
+
+template<typename NumberType>
+void test_output_clipping(Renderer::Operation const operation)
+{
+    constexpr Integer sample_count = 300;
+    constexpr NumberType loud = 10.0;
+    constexpr NumberType clipped = (NumberType)Synth::OUTPUT_CLIPPING_LEVEL;
+    NumberType const initial = operation == Renderer::Operation::ADD ? 0.5 : 0.0;
+
+    Synth synth;
+    Renderer renderer(synth);
+    Integer const channels = synth.get_channels();
+    NumberType* in_samples[channels];
+    NumberType* out_samples[channels];
+
+    synth.process_message(
+        Synth::MessageType::SET_PARAM, Synth::ParamId::ZLAT, 1.0, 0
+    );
+    synth.input_volume.set_value(1.0);
+
+    for (Integer c = 0; c != channels; ++c) {
+        in_samples[c] = new NumberType[sample_count];
+        out_samples[c] = new NumberType[sample_count];
+
+        for (Integer i = 0; i != sample_count; ++i) {
+            in_samples[c][i] = (i & 1) ? -loud : loud;
+        }
+
+        std::fill_n(out_samples[c], sample_count, initial);
+    }
+
+    if (operation == Renderer::Operation::ADD) {
+        renderer.render<NumberType, Renderer::Operation::ADD>(
+            sample_count, in_samples, out_samples
+        );
+    } else {
+        renderer.render<NumberType>(sample_count, in_samples, out_samples);
+    }
+
+    for (Integer c = 0; c != channels; ++c) {
+        for (Integer i = 0; i != sample_count; ++i) {
+            NumberType const expected = initial + ((i & 1) ? -clipped : clipped);
+
+            assert_eq(
+                (double)expected,
+                (double)out_samples[c][i],
+                0.000001,
+                "channel=%d, i=%d",
+                (int)c,
+                (int)i
+            );
+        }
+
+        delete[] in_samples[c];
+        delete[] out_samples[c];
+    }
+}
+
+
+TEST(output_is_clipped_while_it_is_converted_to_the_format_of_the_host, {
+    test_output_clipping<float>(Renderer::Operation::OVERWRITE);
+    test_output_clipping<float>(Renderer::Operation::ADD);
+    test_output_clipping<double>(Renderer::Operation::OVERWRITE);
+    test_output_clipping<double>(Renderer::Operation::ADD);
 })
@@ -0,0 +1,101 @@
+/*
+ * This file is part of JS80P, a synthesizer plugin.
+ * Copyright (C) 2023, 2024  Attila M. Magyar
+ *
+ * JS80P is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * JS80P is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "test.cpp"
+#include "utils.hpp"
+
+#include "seqlock.cpp"
+
+
+using namespace JS80P;
+
+
+class Item
+{
+    public:
+        Item() noexcept : a(0.0), b(0), c(0)
+        {
+        }
+
+        Item(double const a, int const b, char const c) noexcept
+            : a(a),
+            b(b),
+            c(c)
+        {
+        }
+
+        double a;
+        int b;
+        char c;
+};
+
+
+TEST(seqlock_is_lock_free, {
+    SeqLock<Item> seqlock;
+
+    assert_true(seqlock.is_lock_free());
+})
+
+
+TEST(default_item_can_be_read_before_first_write, {
+    SeqLock<Item> seqlock;
+    Item item(1.0, 2, 'x');
+
+    assert_true(seqlock.read(item));
+    assert_eq(0.0, item.a, DOUBLE_DELTA);
+    assert_eq(0, item.b);
+    assert_eq(0, (int)item.c);
+})
+
+
+TEST(most_recently_written_item_is_read, {
+    SeqLock<Item> seqlock;
+    Item item;
+
+    seqlock.write(Item(1.5, 42, 'a'));
+    seqlock.write(Item(2.5, 123, 'b'));
+
+    assert_true(seqlock.read(item));
+    assert_eq(2.5, item.a, DOUBLE_DELTA);
+    assert_eq(123, item.b);
+    assert_eq('b', item.c);
+
+    assert_true(seqlock.read(item));
+    assert_eq(2.5, item.a, DOUBLE_DELTA);
+    assert_eq(123, item.b);
+    assert_eq('b', item.c);
+})
+
+
+TEST(a_single_field_of_the_most_recently_written_item_can_be_read, {
+    SeqLock<Item> seqlock;
+    double a = 0.0;
+    int b = 0;
+    char c = 0;
+
+    seqlock.write(Item(1.5, 42, 'a'));
+    seqlock.write(Item(2.5, 123, 'b'));
+
+    seqlock.read_field(offsetof(Item, a), a);
+    seqlock.read_field(offsetof(Item, b), b);
+    seqlock.read_field(offsetof(Item, c), c);
+
+    assert_eq(2.5, a, DOUBLE_DELTA);
+    assert_eq(123, b);
+    assert_eq('b', c);
+})
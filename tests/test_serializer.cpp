@@ -574,6 +574,29 @@ TEST(when_a_patch_contains_a_tuning_then_it_overrides_current_tuning_otherwise_c
 })
 
 
+TEST(instance_settings_are_neither_saved_in_patches_nor_loaded_from_them, {
+    Synth synth;
+    std::string patch = "";
+
+    patch += "[js80p]";
+    patch += Serializer::LINE_END;
+    patch += "ZLAT = 0.0";
+    patch += Serializer::LINE_END;
+
+    synth.process_message(Synth::MessageType::SET_PARAM, Synth::ParamId::ZLAT, 1.0, 0);
+    synth.publish_params_snapshot();
+
+    assert_true(
+        Serializer::serialize(synth).find("ZLAT") == std::string::npos
+    );
+
+    Serializer::import_patch_in_audio_thread(synth, patch);
+
+    assert_true(synth.is_zero_latency());
+    assert_true(synth.is_zero_latency_atomic());
+})
+
+
 void assert_upgrade(
         std::string const& old_serialized_param,
         Synth::ParamId const param_id,
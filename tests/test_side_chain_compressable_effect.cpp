@@ -0,0 +1,320 @@
+/*
+ * This file is part of JS80P, a synthesizer plugin.
+ * Copyright (C) 2023, 2024  Attila M. Magyar
+ *
+ * JS80P is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * JS80P is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <cmath>
+
+#include "test.cpp"
+#include "utils.cpp"
+
+#include "js80p.hpp"
+
+#include "dsp/biquad_filter.cpp"
+#include "dsp/delay.cpp"
+#include "dsp/delay_buffer_pool.cpp"
+#include "dsp/distortion.cpp"
+#include "dsp/echo.cpp"
+#include "dsp/effect.cpp"
+#include "dsp/envelope.cpp"
+#include "dsp/filter.cpp"
+#include "dsp/gain.cpp"
+#include "dsp/lfo.cpp"
+#include "dsp/lfo_envelope_list.cpp"
+#include "dsp/macro.cpp"
+#include "dsp/math.cpp"
+#include "dsp/midi_controller.cpp"
+#include "dsp/mixer.cpp"
+#include "dsp/oscillator.cpp"
+#include "dsp/param.cpp"
+#include "dsp/peak_tracker.cpp"
+#include "dsp/queue.cpp"
+#include "dsp/reverb.cpp"
+#include "dsp/side_chain_compressable_effect.cpp"
+#include "dsp/signal_producer.cpp"
+#include "dsp/wavefolder.cpp"
+#include "dsp/wavetable.cpp"
+
+
+using namespace JS80P;
+
+
+constexpr Integer CHANNELS = 2;
+constexpr Integer BLOCK_SIZE = 2048;
+constexpr Frequency SAMPLE_RATE = 22050.0;
+/* Long enough for the echo of the default delay time to come through. */
+constexpr Integer WARM_UP_BLOCKS = 8;
+
+constexpr Sample QUIET = 0.01;
+constexpr Sample LOUD = 0.9;
+
+/* The loudness of the input changes in the middle of the block. */
+constexpr Integer CHANGE_INDEX = 1000;
+
+/* The side-chain is analyzed in 32 sample chunks. */
+constexpr Integer CHANGE_CHUNK_START = 992;
+
+
+class Input
+{
+    public:
+        Input() : time(0), producer(NULL)
+        {
+            for (Integer c = 0; c != CHANNELS; ++c) {
+                buffer[c] = samples[c];
+            }
+
+            producer.set_block_size(BLOCK_SIZE);
+            producer.set_sample_rate(SAMPLE_RATE);
+        }
+
+        void set(Sample const first_amplitude, Sample const second_amplitude)
+        {
+            for (Integer i = 0; i != BLOCK_SIZE; ++i) {
+                Sample const amplitude = (
+                    i < CHANGE_INDEX ? first_amplitude : second_amplitude
+                );
+                Sample const sample = amplitude * std::sin(
+                    Math::PI_DOUBLE * 440.0 * (Number)(time++) / SAMPLE_RATE
+                );
+
+                for (Integer c = 0; c != CHANNELS; ++c) {
+                    samples[c][i] = sample;
+                }
+            }
+
+            producer.set_fixed_samples(buffer);
+        }
+
+    private:
+        Sample samples[CHANNELS][BLOCK_SIZE];
+        Sample const* buffer[CHANNELS];
+        Integer time;
+
+    public:
+        FixedSignalProducer producer;
+};
+
+
+template<class EffectClass>
+class Subject
+{
+    public:
+        explicit Subject(Number const ratio)
+            : effect("E", input.producer, high_shelf_filter_shared_buffers)
+        {
+            effect.set_block_size(BLOCK_SIZE);
+            effect.set_sample_rate(SAMPLE_RATE);
+            effect.dry.set_value(0.0);
+            effect.wet.set_value(1.0);
+            effect.side_chain_compression_threshold.set_value(-20.0);
+            effect.side_chain_compression_attack_time.set_value(0.001);
+            effect.side_chain_compression_release_time.set_value(0.001);
+            effect.side_chain_compression_ratio.set_value(ratio);
+        }
+
+        Sample const* const* render(
+                Integer const round,
+                Sample const first_amplitude,
+                Sample const second_amplitude
+        ) {
+            input.set(first_amplitude, second_amplitude);
+
+            return SignalProducer::produce<EffectClass>(effect, round);
+        }
+
+        Input input;
+        BiquadFilterSharedBuffers high_shelf_filter_shared_buffers;
+        EffectClass effect;
+};
+
+
+/*
+The compressor only scales the wet signal, so the gain that it applies can be
+recovered by comparing its output to the output of an uncompressed effect.
+*/
+class Gains
+{
+    public:
+        Gains(
+                Sample const* const* const compressed,
+                Sample const* const* const uncompressed
+        ) {
+            for (Integer i = 0; i != BLOCK_SIZE; ++i) {
+                Sample const expected = uncompressed[0][i];
+
+                is_known[i] = std::fabs(expected) > 0.00001;
+                gains[i] = is_known[i] ? compressed[0][i] / expected : 0.0;
+            }
+        }
+
+        Sample min(Integer const first, Integer const last) const
+        {
+            Sample min = 1.0;
+
+            for (Integer i = first; i != last; ++i) {
+                if (is_known[i] && gains[i] < min) {
+                    min = gains[i];
+                }
+            }
+
+            return min;
+        }
+
+        Sample max_distance_from_1(Integer const first, Integer const last) const
+        {
+            Sample max = 0.0;
+
+            for (Integer i = first; i != last; ++i) {
+                if (is_known[i]) {
+                    max = std::max(max, (Sample)std::fabs(gains[i] - 1.0));
+                }
+            }
+
+            return max;
+        }
+
+    private:
+        Sample gains[BLOCK_SIZE];
+        bool is_known[BLOCK_SIZE];
+};
+
+
+template<class EffectClass>
+void warm_up(
+        Subject<EffectClass>& compressed,
+        Subject<EffectClass>& uncompressed,
+        Integer& round
+) {
+    for (; round != WARM_UP_BLOCKS; ++round) {
+        compressed.render(round, QUIET, QUIET);
+        uncompressed.render(round, QUIET, QUIET);
+    }
+}
+
+
+template<class EffectClass>
+void test_attack_starts_in_the_middle_of_the_block()
+{
+    Subject<EffectClass> compressed(10.0);
+    Subject<EffectClass> uncompressed(1.0);
+    Integer round = 0;
+
+    warm_up<EffectClass>(compressed, uncompressed, round);
+
+    assert_false(compressed.effect.is_compressing());
+
+    Gains const gains(
+        compressed.render(round, QUIET, LOUD),
+        uncompressed.render(round, QUIET, LOUD)
+    );
+
+    assert_true(compressed.effect.is_compressing());
+    assert_lt(gains.max_distance_from_1(0, CHANGE_CHUNK_START), 0.000001);
+    assert_lt(gains.min(CHANGE_INDEX, CHANGE_INDEX + 200), 0.5);
+}
+
+
+template<class EffectClass>
+void test_release_starts_in_the_middle_of_the_block()
+{
+    Subject<EffectClass> compressed(10.0);
+    Subject<EffectClass> uncompressed(1.0);
+    Integer round = 0;
+
+    warm_up<EffectClass>(compressed, uncompressed, round);
+
+    compressed.render(round, LOUD, LOUD);
+    uncompressed.render(round, LOUD, LOUD);
+    ++round;
+
+    Gains const gains(
+        compressed.render(round, LOUD, QUIET),
+        uncompressed.render(round, LOUD, QUIET)
+    );
+
+    assert_lt(gains.min(0, CHANGE_INDEX), 0.5);
+    assert_lt(gains.max_distance_from_1(BLOCK_SIZE - 200, BLOCK_SIZE), 0.000001);
+}
+
+
+template<class EffectClass>
+void test_compressor_is_bypassed_when_the_release_is_over()
+{
+    Subject<EffectClass> compressed(10.0);
+    Subject<EffectClass> uncompressed(1.0);
+    Integer round = 0;
+
+    warm_up<EffectClass>(compressed, uncompressed, round);
+
+    compressed.render(round, QUIET, LOUD);
+    uncompressed.render(round, QUIET, LOUD);
+    ++round;
+
+    compressed.render(round, LOUD, QUIET);
+    uncompressed.render(round, LOUD, QUIET);
+    ++round;
+
+    Sample const* const* const compressed_output = (
+        compressed.render(round, QUIET, QUIET)
+    );
+    Sample const* const* const uncompressed_output = (
+        uncompressed.render(round, QUIET, QUIET)
+    );
+
+    assert_false(compressed.effect.is_compressing());
+
+    for (Integer c = 0; c != CHANNELS; ++c) {
+        assert_eq(
+            uncompressed_output[c],
+            compressed_output[c],
+            BLOCK_SIZE,
+            DOUBLE_DELTA,
+            "channel=%d",
+            (int)c
+        );
+    }
+}
+
+
+TEST(echo_attack_starts_in_the_middle_of_the_block, {
+    test_attack_starts_in_the_middle_of_the_block< Echo<FixedSignalProducer> >();
+})
+
+
+TEST(reverb_attack_starts_in_the_middle_of_the_block, {
+    test_attack_starts_in_the_middle_of_the_block< Reverb<FixedSignalProducer> >();
+})
+
+
+TEST(echo_release_starts_in_the_middle_of_the_block, {
+    test_release_starts_in_the_middle_of_the_block< Echo<FixedSignalProducer> >();
+})
+
+
+TEST(reverb_release_starts_in_the_middle_of_the_block, {
+    test_release_starts_in_the_middle_of_the_block< Reverb<FixedSignalProducer> >();
+})
+
+
+TEST(echo_compressor_is_bypassed_when_the_release_is_over, {
+    test_compressor_is_bypassed_when_the_release_is_over< Echo<FixedSignalProducer> >();
+})
+
+
+TEST(reverb_compressor_is_bypassed_when_the_release_is_over, {
+    test_compressor_is_bypassed_when_the_release_is_over< Reverb<FixedSignalProducer> >();
+})
@@ -1130,6 +1130,26 @@ TEST(find_peak_finds_the_latest_peak, {
 })
 
 
+TEST(find_abs_max_finds_the_largest_absolute_value_in_the_given_range, {
+    constexpr Integer block_size = 6;
+    constexpr Integer channels = 2;
+    constexpr Sample negative[block_size] = {-0.50, -0.50,  0.00, -0.20, -0.10, -0.30};
+    constexpr Sample positive[block_size] = {-0.10,  0.25,  0.25,  0.00,  0.10, -0.15};
+    constexpr Sample loud[block_size] = {0.0, 0.0, 0.0, 0.0, 0.0, 5000.0};
+
+    Sample const* buffer[channels] = {positive, negative};
+
+    assert_eq(0.0, SignalProducer::find_abs_max(buffer, channels, 0, 0), DOUBLE_DELTA);
+    assert_eq(0.50, SignalProducer::find_abs_max(buffer, channels, 0, block_size), DOUBLE_DELTA);
+    assert_eq(0.25, SignalProducer::find_abs_max(buffer, channels, 2, 5), DOUBLE_DELTA);
+    assert_eq(0.30, SignalProducer::find_abs_max(buffer, channels, 4, 6), DOUBLE_DELTA);
+    assert_eq(0.25, SignalProducer::find_abs_max(buffer, 1, 0, block_size), DOUBLE_DELTA);
+
+    buffer[1] = loud;
+    assert_eq(1000.0, SignalProducer::find_abs_max(buffer, channels, 0, block_size), DOUBLE_DELTA);
+})
+
+
 TEST(latest_peak_is_capped_at_60db, {
     constexpr Integer block_size = 5;
     constexpr Integer channels = 1;
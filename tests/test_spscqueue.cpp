@@ -16,6 +16,8 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include <cstdlib>
+#include <new>
 #include <string>
 
 #include "test.cpp"
@@ -27,6 +29,35 @@
 using namespace JS80P;
 
 
+size_t allocations = 0;
+
+
+void* operator new(size_t const size)
+{
+    ++allocations;
+
+    void* const ptr = std::malloc(size == 0 ? 1 : size);
+
+    if (ptr == NULL) {
+        throw std::bad_alloc();
+    }
+
+    return ptr;
+}
+
+
+void operator delete(void* const ptr) noexcept
+{
+    std::free(ptr);
+}
+
+
+void operator delete(void* const ptr, size_t const size) noexcept
+{
+    std::free(ptr);
+}
+
+
 TEST(queue_is_created_empty, {
     SPSCQueue<std::string> q(16);
 
@@ -154,3 +185,35 @@ TEST(queue_can_be_filled_and_emptied_multiple_times, {
 
     }
 })
+
+
+class PayloadMessage
+{
+    public:
+        int type;
+        size_t index;
+        std::string* payload;
+};
+
+
+TEST(passing_trivially_copyable_messages_does_not_allocate, {
+    SPSCQueue<PayloadMessage> q(16);
+    std::string* const payload = new std::string("some payload");
+    PayloadMessage message{1, 2, payload};
+    PayloadMessage popped{0, 0, NULL};
+    size_t const allocations_before = allocations;
+
+    for (size_t i = 0; i != 100; ++i) {
+        assert_true(q.push(message));
+        assert_true(q.push(message));
+        assert_true(q.pop(popped));
+        assert_true(q.pop(popped));
+    }
+
+    assert_eq((int)allocations_before, (int)allocations);
+    assert_eq(1, popped.type);
+    assert_eq(2, (int)popped.index);
+    assert_eq("some payload", *popped.payload);
+
+    delete payload;
+})
@@ -124,6 +124,77 @@ TEST(synth_rendering_is_independent_of_chunk_size, {
 })
 
 
+TEST(voice_buffers_are_released_while_suspended, {
+    constexpr Frequency sample_rate = 44100.0;
+    constexpr Integer block_size = 1024;
+    constexpr Integer rounds = 20;
+    Synth synth_1;
+    Synth synth_2;
+    Buffer output_1(block_size * rounds, Synth::OUT_CHANNELS);
+    Buffer output_2(block_size * rounds, Synth::OUT_CHANNELS);
+
+    synth_1.set_block_size(block_size);
+    synth_2.set_block_size(block_size);
+
+    assert_false(synth_2.are_voice_buffers_released());
+
+    synth_2.suspend();
+    assert_true(synth_2.are_voice_buffers_released());
+
+    set_up_chunk_size_independent_test(synth_1, sample_rate);
+    set_up_chunk_size_independent_test(synth_2, sample_rate);
+    assert_false(synth_2.are_voice_buffers_released());
+
+    render_rounds<Synth>(synth_1, output_1, rounds);
+    render_rounds<Synth>(synth_2, output_2, rounds);
+
+    for (Integer c = 0; c != Synth::OUT_CHANNELS; ++c) {
+        assert_eq(
+            output_1.samples[c],
+            output_2.samples[c],
+            block_size * rounds,
+            DOUBLE_DELTA,
+            "channel=%d",
+            (int)c
+        );
+    }
+})
+
+
+TEST(when_rendering_while_suspended_then_voices_are_not_rendered_and_their_buffers_stay_released, {
+    constexpr Frequency sample_rate = 44100.0;
+    constexpr Integer block_size = 1024;
+    constexpr Integer rounds = 20;
+    Synth synth;
+    Buffer output(block_size * rounds, Synth::OUT_CHANNELS);
+    Buffer silence(block_size * rounds, Synth::OUT_CHANNELS);
+
+    synth.set_block_size(block_size);
+    synth.set_sample_rate(sample_rate);
+    synth.suspend();
+
+    synth.note_on(0.0, 1, Midi::NOTE_A_4, 114);
+
+    render_rounds<Synth>(synth, output, rounds);
+
+    assert_true(synth.are_voice_buffers_released());
+
+    for (Integer c = 0; c != Synth::OUT_CHANNELS; ++c) {
+        assert_eq(
+            silence.samples[c],
+            output.samples[c],
+            block_size * rounds,
+            DOUBLE_DELTA,
+            "channel=%d",
+            (int)c
+        );
+    }
+
+    synth.resume();
+    assert_false(synth.are_voice_buffers_released());
+})
+
+
 void set_param(Synth& synth, Synth::ParamId const param_id, Number const ratio)
 {
     synth.push_message(SET_PARAM, param_id, ratio, 0);
@@ -194,6 +265,38 @@ TEST(messages_get_processed_during_rendering, {
 });
 
 
+TEST(params_snapshot_is_published_once_per_block_including_controlled_params, {
+    Synth synth;
+    Synth::ParamsSnapshot snapshot;
+
+    synth.resume();
+
+    set_param(synth, Synth::ParamId::PM, 0.123);
+    assign_controller(
+        synth, Synth::ParamId::MIX, Synth::ControllerId::MODULATION_WHEEL
+    );
+    synth.control_change(0.0, 1, Midi::MODULATION_WHEEL, 127);
+
+    SignalProducer::produce<Synth>(synth, 1);
+
+    assert_true(synth.get_params_snapshot(snapshot));
+    assert_eq(0.123, snapshot.ratios[Synth::ParamId::PM], DOUBLE_DELTA);
+    assert_eq(1.0, snapshot.ratios[Synth::ParamId::MIX], DOUBLE_DELTA);
+    assert_eq(
+        (int)Synth::ControllerId::MODULATION_WHEEL,
+        (int)snapshot.controller_ids[Synth::ParamId::MIX]
+    );
+
+    synth.control_change(0.0, 1, Midi::MODULATION_WHEEL, 0);
+    SignalProducer::produce<Synth>(synth, 2);
+    SignalProducer::produce<Synth>(synth, 3);
+
+    assert_true(synth.get_params_snapshot(snapshot));
+    assert_eq(0.0, snapshot.ratios[Synth::ParamId::MIX], DOUBLE_DELTA);
+    assert_eq(0.123, snapshot.ratios[Synth::ParamId::PM], DOUBLE_DELTA);
+})
+
+
 TEST(midi_controller_changes_can_affect_parameters, {
     constexpr Integer block_size = 2048;
 
@@ -581,6 +684,269 @@ TEST(when_the_same_controller_message_is_received_over_multiple_channels_then_on
 })
 
 
+TEST(high_resolution_controller_values_are_received_via_14_bit_controllers, {
+    Synth synth;
+    Midi::Byte const buffer[] = {
+        0xb1, Midi::MODULATION_WHEEL, 0x15, Midi::MODULATION_WHEEL + 32, 0x3c,
+        0xb1, Midi::VOLUME, 0x40, Midi::VOLUME + 32, 0x01,
+    };
+
+    Midi::EventDispatcher<Synth>::dispatch_events(synth, 0.1, buffer, 10);
+
+    assert_eq(
+        2748.0 / 16383.0,
+        synth.midi_controllers[Midi::MODULATION_WHEEL]->get_value(),
+        DOUBLE_DELTA
+    );
+    assert_eq(
+        8193.0 / 16383.0,
+        synth.midi_controllers[Midi::VOLUME]->get_value(),
+        DOUBLE_DELTA
+    );
+    assert_eq(1, synth.midi_controllers[Midi::MODULATION_WHEEL]->events.length());
+    assert_eq(1, synth.midi_controllers[Midi::VOLUME]->events.length());
+})
+
+
+TEST(maximum_14_bit_controller_values_reach_the_maximum_ratio, {
+    Synth synth;
+    Midi::Byte const buffer[] = {
+        0xb1, Midi::MODULATION_WHEEL, 0x7f, Midi::MODULATION_WHEEL + 32, 0x7f,
+    };
+
+    Midi::EventDispatcher<Synth>::dispatch_events(synth, 0.1, buffer, 5);
+
+    assert_eq(
+        1.0, synth.midi_controllers[Midi::MODULATION_WHEEL]->get_value(), DOUBLE_DELTA
+    );
+})
+
+
+TEST(nrpn_does_not_change_the_midi_controller_with_the_same_number, {
+    Synth synth;
+    Midi::Byte const buffer[] = {
+        0xb1, Midi::NRPN_MSB, 0x00, Midi::NRPN_LSB, Midi::SUSTAIN_PEDAL,
+        0xb1, Midi::DATA_ENTRY, 0x7f, Midi::DATA_ENTRY_LSB, 0x7f,
+        0xb2, Midi::NRPN_MSB, 0x00, Midi::NRPN_LSB, Midi::VOLUME,
+        0xb2, Midi::DATA_ENTRY, 0x40,
+    };
+
+    Midi::Controller const controllers[] = {Midi::SUSTAIN_PEDAL, Midi::VOLUME};
+    Number initial_values[2];
+
+    for (Integer i = 0; i != 2; ++i) {
+        initial_values[i] = synth.midi_controllers[controllers[i]]->get_value();
+    }
+
+    Midi::EventDispatcher<Synth>::dispatch_events(synth, 0.1, buffer, 18);
+
+    for (Integer i = 0; i != 2; ++i) {
+        Midi::Controller const controller = controllers[i];
+
+        assert_eq(
+            initial_values[i],
+            synth.midi_controllers[controller]->get_value(),
+            DOUBLE_DELTA,
+            "controller=%d",
+            (int)controller
+        );
+        assert_eq(
+            0,
+            synth.midi_controllers[controller]->events.length(),
+            "controller=%d",
+            (int)controller
+        );
+    }
+})
+
+
+void render_pitch_bent_note(
+        Synth& synth,
+        Buffer& buffer,
+        bool const mpe
+) {
+    constexpr Frequency sample_rate = 5000.0;
+    constexpr Integer block_size = 512;
+    constexpr Integer rounds = 4;
+
+    synth.set_sample_rate(sample_rate);
+    synth.set_block_size(block_size);
+    synth.resume();
+
+    set_param(synth, Synth::ParamId::MPE, mpe ? 1.0 : 0.0);
+    assign_controller(synth, Synth::ParamId::MFIN, Synth::ControllerId::PITCH_WHEEL);
+    assign_controller(synth, Synth::ParamId::CFIN, Synth::ControllerId::PITCH_WHEEL);
+    synth.process_messages();
+
+    synth.note_on(0.0, 1, Midi::NOTE_A_3, 114);
+    synth.pitch_wheel_change(0.0, 1, 12000);
+    synth.pitch_wheel_change(0.05, 1, 15000);
+
+    if (mpe) {
+        synth.pitch_wheel_change(0.1, 2, 2000);
+    }
+
+    render_rounds<Synth>(synth, buffer, rounds, block_size);
+}
+
+
+TEST(in_mpe_mode_expression_controllers_on_member_channels_only_affect_voices_on_the_same_channel, {
+    constexpr Integer buffer_size = 4 * 512;
+
+    Synth synth_without_mpe;
+    Synth synth_with_mpe;
+    Buffer expected_output(buffer_size, synth_without_mpe.get_channels());
+    Buffer actual_output(buffer_size, synth_with_mpe.get_channels());
+
+    render_pitch_bent_note(synth_without_mpe, expected_output, false);
+    render_pitch_bent_note(synth_with_mpe, actual_output, true);
+
+    assert_eq(0.5, synth_with_mpe.pitch_wheel.get_value(), DOUBLE_DELTA);
+    assert_eq(
+        15000.0 / 16384.0,
+        synth_with_mpe.channel_pitch_wheels[1].get_value(),
+        DOUBLE_DELTA
+    );
+    assert_eq(
+        2000.0 / 16384.0,
+        synth_with_mpe.channel_pitch_wheels[2].get_value(),
+        DOUBLE_DELTA
+    );
+
+    for (Integer c = 0; c != synth_with_mpe.get_channels(); ++c) {
+        assert_eq(
+            expected_output.samples[c],
+            actual_output.samples[c],
+            buffer_size,
+            DOUBLE_DELTA,
+            "channel=%d",
+            (int)c
+        );
+    }
+})
+
+
+void render_note_bent_via_the_manager_channel(
+        Synth& synth,
+        Buffer& buffer,
+        bool const mpe
+) {
+    constexpr Frequency sample_rate = 5000.0;
+    constexpr Integer block_size = 512;
+    constexpr Integer rounds = 4;
+
+    synth.set_sample_rate(sample_rate);
+    synth.set_block_size(block_size);
+    synth.resume();
+
+    set_param(synth, Synth::ParamId::MPE, mpe ? 1.0 : 0.0);
+    assign_controller(synth, Synth::ParamId::MFIN, Synth::ControllerId::PITCH_WHEEL);
+    assign_controller(synth, Synth::ParamId::CFIN, Synth::ControllerId::PITCH_WHEEL);
+    synth.process_messages();
+
+    synth.note_on(0.0, 1, Midi::NOTE_A_3, 114);
+    synth.pitch_wheel_change(0.0, 1, 10000);
+
+    if (mpe) {
+        synth.pitch_wheel_change(0.05, 0, 10192);
+    } else {
+        synth.pitch_wheel_change(0.05, 1, 12000);
+    }
+
+    render_rounds<Synth>(synth, buffer, rounds, block_size);
+}
+
+
+TEST(in_mpe_mode_expression_controllers_on_the_manager_channel_are_combined_with_member_channels, {
+    constexpr Integer buffer_size = 4 * 512;
+
+    Synth synth_without_mpe;
+    Synth synth_with_mpe;
+    Buffer expected_output(buffer_size, synth_without_mpe.get_channels());
+    Buffer actual_output(buffer_size, synth_with_mpe.get_channels());
+
+    render_note_bent_via_the_manager_channel(synth_without_mpe, expected_output, false);
+    render_note_bent_via_the_manager_channel(synth_with_mpe, actual_output, true);
+
+    assert_eq(
+        10192.0 / 16384.0, synth_with_mpe.pitch_wheel.get_value(), DOUBLE_DELTA
+    );
+    assert_eq(
+        12000.0 / 16384.0,
+        synth_with_mpe.channel_pitch_wheels[1].get_value(),
+        DOUBLE_DELTA
+    );
+    assert_eq(
+        10192.0 / 16384.0,
+        synth_with_mpe.channel_pitch_wheels[2].get_value(),
+        DOUBLE_DELTA
+    );
+
+    for (Integer c = 0; c != synth_with_mpe.get_channels(); ++c) {
+        assert_eq(
+            expected_output.samples[c],
+            actual_output.samples[c],
+            buffer_size,
+            DOUBLE_DELTA,
+            "channel=%d",
+            (int)c
+        );
+    }
+})
+
+
+void render_note_bent_after_turning_mpe_off(Synth& synth, Buffer& buffer, bool const mpe)
+{
+    constexpr Frequency sample_rate = 5000.0;
+    constexpr Integer block_size = 512;
+    constexpr Integer rounds = 2;
+
+    synth.set_sample_rate(sample_rate);
+    synth.set_block_size(block_size);
+    synth.resume();
+
+    set_param(synth, Synth::ParamId::MPE, mpe ? 1.0 : 0.0);
+    assign_controller(synth, Synth::ParamId::MFIN, Synth::ControllerId::PITCH_WHEEL);
+    assign_controller(synth, Synth::ParamId::CFIN, Synth::ControllerId::PITCH_WHEEL);
+    synth.process_messages();
+
+    synth.note_on(0.0, 1, Midi::NOTE_A_3, 114);
+
+    render_rounds<Synth>(synth, buffer, rounds, block_size);
+
+    set_param(synth, Synth::ParamId::MPE, 0.0);
+    synth.process_messages();
+
+    synth.pitch_wheel_change(0.0, 1, 12000);
+
+    render_rounds<Synth>(synth, buffer, rounds, block_size, rounds);
+}
+
+
+TEST(when_mpe_is_turned_off_then_voices_follow_the_synth_level_controllers_again, {
+    constexpr Integer buffer_size = 2 * 512;
+
+    Synth synth_without_mpe;
+    Synth synth_with_mpe;
+    Buffer expected_output(buffer_size, synth_without_mpe.get_channels());
+    Buffer actual_output(buffer_size, synth_with_mpe.get_channels());
+
+    render_note_bent_after_turning_mpe_off(synth_without_mpe, expected_output, false);
+    render_note_bent_after_turning_mpe_off(synth_with_mpe, actual_output, true);
+
+    for (Integer c = 0; c != synth_with_mpe.get_channels(); ++c) {
+        assert_eq(
+            expected_output.samples[c],
+            actual_output.samples[c],
+            buffer_size,
+            DOUBLE_DELTA,
+            "channel=%d",
+            (int)c
+        );
+    }
+})
+
+
 TEST(when_synth_state_is_cleared_then_lfos_are_started_again, {
     Synth synth;
 
@@ -1175,6 +1541,18 @@ TEST(can_process_messages_synchronously, {
     );
     assert_true(synth.is_dirty());
 
+    assert_eq(
+        synth.get_param_default_ratio(Synth::ParamId::PM),
+        synth.get_param_ratio_atomic(Synth::ParamId::PM),
+        DOUBLE_DELTA
+    );
+    assert_eq(
+        Synth::ControllerId::NONE,
+        synth.get_param_controller_id_atomic(Synth::ParamId::FM)
+    );
+
+    synth.publish_params_snapshot();
+
     assert_eq(
         0.123, synth.get_param_ratio_atomic(Synth::ParamId::PM), DOUBLE_DELTA
     );
@@ -1927,3 +2305,220 @@ TEST(keeps_track_of_number_of_active_voices, {
     SignalProducer::produce<Synth>(synth, 2);
     assert_eq(0, (int)synth.get_active_voices_count());
 })
+
+
+TEST(only_changing_or_controlled_params_are_rendered_in_every_round, {
+    constexpr Frequency sample_rate = 1000.0;
+    constexpr Integer block_size = 128;
+    Synth synth;
+
+    synth.set_block_size(block_size);
+    synth.set_sample_rate(sample_rate);
+
+    SignalProducer::produce<Synth>(synth, 0);
+    assert_eq(0, (int)synth.get_active_params_count());
+
+    synth.push_message(
+        Synth::MessageType::SET_PARAM_SMOOTHLY, Synth::ParamId::PM, 0.3, 0
+    );
+    SignalProducer::produce<Synth>(synth, 1);
+    assert_eq(1, (int)synth.get_active_params_count());
+
+    SignalProducer::produce<Synth>(synth, 2);
+    assert_eq(0, (int)synth.get_active_params_count());
+    assert_eq(0.3, synth.phase_modulation_level.get_ratio(), DOUBLE_DELTA);
+
+    synth.push_message(
+        Synth::MessageType::ASSIGN_CONTROLLER,
+        Synth::ParamId::PM,
+        0.0,
+        Synth::ControllerId::LFO_1
+    );
+    SignalProducer::produce<Synth>(synth, 3);
+    SignalProducer::produce<Synth>(synth, 4);
+    assert_eq(1, (int)synth.get_active_params_count());
+
+    synth.push_message(
+        Synth::MessageType::ASSIGN_CONTROLLER,
+        Synth::ParamId::PM,
+        0.0,
+        Synth::ControllerId::NONE
+    );
+    SignalProducer::produce<Synth>(synth, 5);
+    SignalProducer::produce<Synth>(synth, 6);
+    assert_eq(0, (int)synth.get_active_params_count());
+})
+
+
+Integer render_until_idle(Synth& synth, Integer& round, Integer const max_rounds)
+{
+    for (Integer i = 0; i != max_rounds; ++i) {
+        if (synth.is_idle()) {
+            return i;
+        }
+
+        SignalProducer::produce<Synth>(synth, ++round);
+    }
+
+    return synth.is_idle() ? max_rounds : -1;
+}
+
+
+TEST(synth_becomes_idle_when_voices_and_effect_tails_fall_silent, {
+    constexpr Frequency sample_rate = 1000.0;
+    constexpr Integer block_size = 100;
+    Synth synth(0);
+    Integer round = 0;
+
+    synth.set_block_size(block_size);
+    synth.set_sample_rate(sample_rate);
+    synth.resume();
+
+    set_up_quickly_decaying_envelope(synth);
+    assign_controller(synth, Synth::ParamId::PM, Synth::ControllerId::LFO_1);
+    synth.process_messages();
+
+    assert_false(synth.is_idle());
+    assert_lte(0, (int)render_until_idle(synth, round, 10));
+
+    set_param(synth, Synth::ParamId::FM, 0.5);
+    assert_false(synth.is_idle());
+    assert_lte(1, (int)render_until_idle(synth, round, 10));
+
+    synth.note_on(0.0, 1, Midi::NOTE_A_3, 127);
+    assert_false(synth.is_idle());
+    assert_eq(-1, (int)render_until_idle(synth, round, 3));
+    synth.note_off(0.0, 1, Midi::NOTE_A_3, 127);
+    assert_lte(1, (int)render_until_idle(synth, round, 10));
+    assert_eq(0, (int)synth.get_active_voices_count());
+
+    synth.effects.echo.delay_time.set_value(1.0);
+    synth.effects.echo.feedback.set_value(0.0);
+    synth.effects.echo.wet.set_value(1.0);
+    synth.note_on(0.0, 1, Midi::NOTE_A_3, 127);
+    render_until_idle(synth, round, 1);
+    synth.note_off(0.0, 1, Midi::NOTE_A_3, 127);
+
+    /* The echo of the note is still in the delay buffer. */
+    assert_lte(30, (int)render_until_idle(synth, round, 100));
+})
+
+
+void set_up_parallel_rendering_test(Synth& synth, bool const use_polyphonic_lfo)
+{
+    synth.set_sample_rate(44100.0);
+    synth.set_block_size(256);
+    synth.resume();
+
+    set_param(synth, Synth::ParamId::MIX, 0.4);
+    set_param(synth, Synth::ParamId::PM, 0.3);
+    set_param(synth, Synth::ParamId::FM, 0.2);
+    set_param(synth, Synth::ParamId::AM, 0.3);
+    set_param(synth, Synth::ParamId::MOIA, 0.5);
+    set_param(synth, Synth::ParamId::MOIS, 0.5);
+    set_param(synth, Synth::ParamId::MF1FIA, 0.5);
+    set_param(synth, Synth::ParamId::N2DEC, 0.1);
+    set_param(synth, Synth::ParamId::N2SUS, 0.3);
+    set_param(synth, Synth::ParamId::N2REL, 0.2);
+    set_param(synth, Synth::ParamId::L1FRQ, 0.3);
+
+    if (use_polyphonic_lfo) {
+        set_param(
+            synth,
+            Synth::ParamId::L1AEN,
+            synth.lfos[0]->amplitude_envelope.value_to_ratio(1)
+        );
+    }
+
+    assign_controller(synth, Synth::ParamId::MF1FRQ, Synth::ControllerId::LFO_1);
+    assign_controller(synth, Synth::ParamId::CF1FRQ, Synth::ControllerId::LFO_1);
+    assign_controller(synth, Synth::ParamId::MVOL, Synth::ControllerId::ENVELOPE_2);
+    assign_controller(synth, Synth::ParamId::CDTN, Synth::ControllerId::MODULATION_WHEEL);
+    assign_controller(synth, Synth::ParamId::MFLD, Synth::ControllerId::MACRO_1);
+    assign_controller(synth, Synth::ParamId::M1IN, Synth::ControllerId::PITCH_WHEEL);
+
+    synth.process_messages();
+
+    synth.note_on(0.0, 1, Midi::NOTE_A_2, 100);
+    synth.note_on(0.01, 1, Midi::NOTE_C_3, 110);
+    synth.note_on(0.02, 1, Midi::NOTE_E_3, 120);
+    synth.note_on(0.03, 1, Midi::NOTE_G_3, 127);
+    synth.control_change(0.1, 1, Midi::MODULATION_WHEEL, 90);
+    synth.pitch_wheel_change(0.2, 1, 12000);
+    synth.note_off(0.3, 1, Midi::NOTE_C_3, 64);
+    synth.note_on(0.35, 1, Midi::NOTE_C_5, 100);
+    synth.note_off(0.4, 1, Midi::NOTE_A_2, 64);
+}
+
+
+void test_parallel_rendering(bool const use_polyphonic_lfo)
+{
+    constexpr Integer block_size = 256;
+    constexpr Integer rounds = 100;
+    Synth synth_1;
+    Synth synth_2;
+    Buffer output_1(block_size * rounds, Synth::OUT_CHANNELS);
+    Buffer output_2(block_size * rounds, Synth::OUT_CHANNELS);
+
+    WorkerPool::override_workers_count(2);
+    synth_2.set_parallel_rendering(true);
+    assert_true(synth_2.is_rendering_in_parallel());
+
+    set_up_parallel_rendering_test(synth_1, use_polyphonic_lfo);
+    set_up_parallel_rendering_test(synth_2, use_polyphonic_lfo);
+
+    render_rounds<Synth>(synth_1, output_1, rounds);
+    render_rounds<Synth>(synth_2, output_2, rounds);
+
+    for (Integer c = 0; c != Synth::OUT_CHANNELS; ++c) {
+        assert_eq(
+            output_1.samples[c],
+            output_2.samples[c],
+            block_size * rounds,
+            DOUBLE_DELTA,
+            "channel=%d, use_polyphonic_lfo=%d",
+            (int)c,
+            (int)use_polyphonic_lfo
+        );
+    }
+
+    synth_2.set_parallel_rendering(false);
+    assert_false(synth_2.is_rendering_in_parallel());
+    assert_eq(0, (int)WorkerPool::get_workers_count());
+
+    WorkerPool::override_workers_count(0);
+}
+
+
+TEST(rendering_voices_in_parallel_produces_the_same_output_as_sequential_rendering, {
+    test_parallel_rendering(false);
+    test_parallel_rendering(true);
+})
+
+
+TEST(latency_can_be_queried_from_other_threads, {
+    Synth synth;
+
+    synth.set_sample_rate(44100.0);
+
+    assert_eq(0, (int)synth.get_latency_samples_atomic());
+    assert_false(synth.is_zero_latency_atomic());
+
+    synth.process_message(SET_PARAM, Synth::ParamId::ELIM, 1.0, 0);
+    synth.process_message(SET_PARAM, Synth::ParamId::ZLAT, 1.0, 0);
+    synth.publish_params_snapshot();
+
+    assert_gt((int)synth.get_latency_samples_atomic(), 0);
+    assert_eq(
+        (int)synth.get_latency_samples(),
+        (int)synth.get_latency_samples_atomic()
+    );
+    assert_true(synth.is_zero_latency_atomic());
+
+    synth.process_message(SET_PARAM, Synth::ParamId::ELIM, 0.0, 0);
+    synth.process_message(SET_PARAM, Synth::ParamId::ZLAT, 0.0, 0);
+    synth.publish_params_snapshot();
+
+    assert_eq(0, (int)synth.get_latency_samples_atomic());
+    assert_false(synth.is_zero_latency_atomic());
+})
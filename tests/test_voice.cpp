@@ -26,6 +26,7 @@
 
 #include "dsp/biquad_filter.cpp"
 #include "dsp/delay.cpp"
+#include "dsp/delay_buffer_pool.cpp"
 #include "dsp/distortion.cpp"
 #include "dsp/envelope.cpp"
 #include "dsp/filter.cpp"
@@ -42,6 +43,7 @@
 #include "dsp/wavetable.cpp"
 
 #include "voice.cpp"
+#include "voice_param_bank.cpp"
 
 
 using namespace JS80P;
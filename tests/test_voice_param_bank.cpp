@@ -0,0 +1,325 @@
+/*
+ * This file is part of JS80P, a synthesizer plugin.
+ * Copyright (C) 2023, 2024  Attila M. Magyar
+ *
+ * JS80P is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * JS80P is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <functional>
+
+#include "test.cpp"
+#include "utils.cpp"
+
+#include "js80p.hpp"
+
+#include "dsp/envelope.cpp"
+#include "dsp/lfo.cpp"
+#include "dsp/lfo_envelope_list.cpp"
+#include "dsp/macro.cpp"
+#include "dsp/math.cpp"
+#include "dsp/midi_controller.cpp"
+#include "dsp/oscillator.cpp"
+#include "dsp/param.cpp"
+#include "dsp/queue.cpp"
+#include "dsp/signal_producer.cpp"
+#include "dsp/wavetable.cpp"
+
+#include "voice_param_bank.cpp"
+
+
+using namespace JS80P;
+
+
+constexpr Integer LANES = 3;
+constexpr Integer BLOCK_SIZE = 128;
+constexpr Integer ROUNDS = 5;
+constexpr Frequency SAMPLE_RATE = 1000.0;
+
+
+class Reference
+{
+    public:
+        Reference()
+            : note_velocity("NV", 0.0, 1.0, 1.0),
+            note_panning("NP", -1.0, 1.0, 0.0)
+        {
+            note_velocity.set_sample_rate(SAMPLE_RATE);
+            note_velocity.set_block_size(BLOCK_SIZE);
+            note_panning.set_sample_rate(SAMPLE_RATE);
+            note_panning.set_block_size(BLOCK_SIZE);
+        }
+
+        FloatParamS& get(VoiceParamBank::Param const param)
+        {
+            return param == VoiceParamBank::NOTE_VELOCITY ? note_velocity : note_panning;
+        }
+
+        FloatParamS note_velocity;
+        FloatParamS note_panning;
+};
+
+
+typedef std::function<void (
+    Integer const round,
+    VoiceParamBank& bank,
+    Integer const lane,
+    FloatParamS& reference,
+    VoiceParamBank::Param const param
+)> Scheduler;
+
+
+void assert_lanes_match_float_params(
+        Integer const sample_count,
+        Scheduler const& schedule
+) {
+    VoiceParamBank bank(LANES);
+    Reference references[LANES];
+
+    bank.set_sample_rate(SAMPLE_RATE);
+    bank.set_block_size(BLOCK_SIZE);
+
+    for (Integer round = 0; round != ROUNDS; ++round) {
+        for (Integer lane = 0; lane != LANES; ++lane) {
+            for (Integer p = 0; p != VoiceParamBank::PARAMS; ++p) {
+                VoiceParamBank::Param const param = (VoiceParamBank::Param)p;
+
+                schedule(round, bank, lane, references[lane].get(param), param);
+            }
+        }
+
+        bank.advance(round, sample_count);
+
+        for (Integer lane = 0; lane != LANES; ++lane) {
+            for (Integer p = 0; p != VoiceParamBank::PARAMS; ++p) {
+                VoiceParamBank::Param const param = (VoiceParamBank::Param)p;
+                FloatParamS& reference = references[lane].get(param);
+                Sample const* const expected = (
+                    FloatParamS::produce_if_not_constant<FloatParamS>(
+                        reference, round, sample_count
+                    )
+                );
+                Sample const* const actual = bank.get_buffer(param, lane);
+
+                if (expected == NULL) {
+                    assert_eq(
+                        NULL,
+                        actual,
+                        "round=%d, lane=%d, param=%d",
+                        (int)round,
+                        (int)lane,
+                        (int)p
+                    );
+                    assert_eq(
+                        reference.get_value(),
+                        bank.get_value(param, lane),
+                        DOUBLE_DELTA,
+                        "round=%d, lane=%d, param=%d",
+                        (int)round,
+                        (int)lane,
+                        (int)p
+                    );
+                } else {
+                    assert_true(actual != NULL);
+                    assert_eq(
+                        expected,
+                        actual,
+                        sample_count,
+                        DOUBLE_DELTA,
+                        "round=%d, lane=%d, param=%d",
+                        (int)round,
+                        (int)lane,
+                        (int)p
+                    );
+                }
+            }
+        }
+    }
+}
+
+
+TEST(lanes_are_constant_until_an_event_is_scheduled, {
+    assert_lanes_match_float_params(
+        BLOCK_SIZE,
+        [](
+                Integer const round,
+                VoiceParamBank& bank,
+                Integer const lane,
+                FloatParamS& reference,
+                VoiceParamBank::Param const param
+        ) {
+            if (round != 2 || lane != 1) {
+                return;
+            }
+
+            Seconds const time_offset = 0.0305;
+            Number const value = param == VoiceParamBank::NOTE_VELOCITY ? 0.3 : -0.6;
+
+            bank.cancel_events_at(param, lane, time_offset);
+            bank.schedule_value(param, lane, time_offset, value);
+            reference.cancel_events_at(time_offset);
+            reference.schedule_value(time_offset, value);
+        }
+    );
+})
+
+
+TEST(values_are_clamped, {
+    assert_lanes_match_float_params(
+        BLOCK_SIZE,
+        [](
+                Integer const round,
+                VoiceParamBank& bank,
+                Integer const lane,
+                FloatParamS& reference,
+                VoiceParamBank::Param const param
+        ) {
+            if (round != 0) {
+                return;
+            }
+
+            bank.schedule_value(param, lane, 0.01, 5.0);
+            reference.schedule_value(0.01, 5.0);
+            bank.schedule_value(param, lane, 0.02, -5.0);
+            reference.schedule_value(0.02, -5.0);
+        }
+    );
+})
+
+
+TEST(events_which_are_scheduled_for_a_later_round_are_kept_until_then, {
+    assert_lanes_match_float_params(
+        BLOCK_SIZE - 28,
+        [](
+                Integer const round,
+                VoiceParamBank& bank,
+                Integer const lane,
+                FloatParamS& reference,
+                VoiceParamBank::Param const param
+        ) {
+            if (round != 0) {
+                return;
+            }
+
+            Seconds const time_offset = 0.15 + 0.1 * (Seconds)lane;
+
+            bank.schedule_value(param, lane, time_offset, 0.5);
+            reference.schedule_value(time_offset, 0.5);
+        }
+    );
+})
+
+
+TEST(linear_ramps_may_span_multiple_rounds, {
+    assert_lanes_match_float_params(
+        BLOCK_SIZE,
+        [](
+                Integer const round,
+                VoiceParamBank& bank,
+                Integer const lane,
+                FloatParamS& reference,
+                VoiceParamBank::Param const param
+        ) {
+            if (round != 0) {
+                return;
+            }
+
+            Seconds const time_offset = 0.0123 * (Seconds)lane;
+            Seconds const duration = 0.1 + 0.07 * (Seconds)lane;
+
+            bank.cancel_events_at(param, lane, time_offset);
+            bank.schedule_value(param, lane, time_offset, 0.1);
+            bank.schedule_linear_ramp(param, lane, duration, 0.8);
+
+            reference.cancel_events_at(time_offset);
+            reference.schedule_value(time_offset, 0.1);
+            reference.schedule_linear_ramp(duration, 0.8);
+        }
+    );
+})
+
+
+TEST(cancelling_stops_a_ramp_and_a_new_one_starts_from_where_it_stopped, {
+    assert_lanes_match_float_params(
+        BLOCK_SIZE,
+        [](
+                Integer const round,
+                VoiceParamBank& bank,
+                Integer const lane,
+                FloatParamS& reference,
+                VoiceParamBank::Param const param
+        ) {
+            if (round == 0) {
+                bank.schedule_linear_ramp(param, lane, 0.3, -1.0);
+                reference.schedule_linear_ramp(0.3, -1.0);
+            } else if (round == 1) {
+                Seconds const time_offset = 0.05 + 0.01 * (Seconds)lane;
+
+                bank.cancel_events_at(param, lane, time_offset);
+                bank.schedule_linear_ramp(param, lane, 0.2, 0.7);
+
+                reference.cancel_events_at(time_offset);
+                reference.schedule_linear_ramp(0.2, 0.7);
+            }
+        }
+    );
+})
+
+
+TEST(ramps_towards_out_of_range_targets_are_shortened, {
+    assert_lanes_match_float_params(
+        BLOCK_SIZE,
+        [](
+                Integer const round,
+                VoiceParamBank& bank,
+                Integer const lane,
+                FloatParamS& reference,
+                VoiceParamBank::Param const param
+        ) {
+            if (round != 0) {
+                return;
+            }
+
+            bank.schedule_value(param, lane, 0.0, 0.5);
+            bank.schedule_linear_ramp(param, lane, 0.2, 3.0);
+
+            reference.schedule_value(0.0, 0.5);
+            reference.schedule_linear_ramp(0.2, 3.0);
+        }
+    );
+})
+
+
+TEST(resetting_a_lane_cancels_its_events_and_leaves_other_lanes_alone, {
+    assert_lanes_match_float_params(
+        BLOCK_SIZE,
+        [](
+                Integer const round,
+                VoiceParamBank& bank,
+                Integer const lane,
+                FloatParamS& reference,
+                VoiceParamBank::Param const param
+        ) {
+            if (round == 0) {
+                bank.schedule_linear_ramp(param, lane, 0.3, 0.0);
+                reference.schedule_linear_ramp(0.3, 0.0);
+            } else if (round == 1 && lane == 2) {
+                if (param == VoiceParamBank::NOTE_VELOCITY) {
+                    bank.reset_lane(lane);
+                }
+
+                reference.reset();
+            }
+        }
+    );
+})
@@ -0,0 +1,245 @@
+/*
+ * This file is part of JS80P, a synthesizer plugin.
+ * Copyright (C) 2023, 2024  Attila M. Magyar
+ *
+ * JS80P is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * JS80P is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <atomic>
+#include <thread>
+
+#include "test.cpp"
+#include "utils.hpp"
+
+#include "js80p.hpp"
+
+#include "worker_pool.cpp"
+
+
+using namespace JS80P;
+
+
+class CountingJob : public WorkerPool::Job
+{
+    public:
+        CountingJob() noexcept : runs(0), value(0)
+        {
+        }
+
+        virtual void run() noexcept override
+        {
+            ++runs;
+
+            for (Integer i = 0; i != 1000; ++i) {
+                value = (value * 31 + i) % 1000003;
+            }
+        }
+
+        Integer runs;
+        Integer value;
+};
+
+
+class BlockingJob : public WorkerPool::Job
+{
+    public:
+        BlockingJob() noexcept : is_started(false), is_released(false)
+        {
+        }
+
+        virtual void run() noexcept override
+        {
+            is_started.store(true);
+
+            while (!is_released.load()) {
+                std::this_thread::yield();
+            }
+        }
+
+        std::atomic<bool> is_started;
+        std::atomic<bool> is_released;
+};
+
+
+TEST(deque_pops_jobs_in_reverse_order_and_thieves_take_the_oldest_one, {
+    WorkerPool::Deque deque;
+    CountingJob job_1;
+    CountingJob job_2;
+    CountingJob job_3;
+
+    assert_true(deque.pop() == NULL);
+    assert_true(deque.steal() == NULL);
+
+    assert_true(deque.push(&job_1));
+    assert_true(deque.push(&job_2));
+    assert_true(deque.push(&job_3));
+
+    assert_true(deque.steal() == &job_1);
+    assert_true(deque.pop() == &job_3);
+    assert_true(deque.pop() == &job_2);
+    assert_true(deque.pop() == NULL);
+    assert_true(deque.steal() == NULL);
+})
+
+
+TEST(when_deque_is_full_then_submitted_jobs_are_run_inline, {
+    WorkerPool::Deque deque;
+    CountingJob jobs[WorkerPool::Deque::CAPACITY + 1];
+
+    for (Integer i = 0; i != WorkerPool::Deque::CAPACITY; ++i) {
+        deque.submit(jobs[i]);
+        assert_false(jobs[i].is_done());
+    }
+
+    CountingJob& overflow = jobs[WorkerPool::Deque::CAPACITY];
+
+    deque.submit(overflow);
+    assert_true(overflow.is_done());
+    assert_eq(1, (int)overflow.runs);
+
+    for (Integer i = 0; i != WorkerPool::Deque::CAPACITY; ++i) {
+        deque.join(jobs[i]);
+        assert_true(jobs[i].is_done());
+        assert_eq(1, (int)jobs[i].runs);
+    }
+
+    assert_true(deque.pop() == NULL);
+})
+
+
+TEST(when_all_workers_are_busy_then_submitted_jobs_are_run_inline, {
+    WorkerPool::override_workers_count(1);
+
+    WorkerPool::Deque* const deque = WorkerPool::acquire_deque();
+    BlockingJob blocking;
+    CountingJob job;
+
+    assert_true(deque != NULL);
+
+    deque->submit(blocking);
+
+    while (!blocking.is_started.load()) {
+        std::this_thread::yield();
+    }
+
+    deque->submit(job);
+    assert_true(job.is_done());
+    assert_eq(1, (int)job.runs);
+
+    blocking.is_released.store(true);
+    deque->join(blocking);
+
+    WorkerPool::release_deque(deque);
+})
+
+
+TEST(workers_are_started_by_the_first_deque_and_stopped_by_the_last_one, {
+    WorkerPool::override_workers_count(3);
+
+    assert_eq(0, (int)WorkerPool::get_workers_count());
+
+    WorkerPool::Deque* const deque_1 = WorkerPool::acquire_deque();
+    WorkerPool::Deque* const deque_2 = WorkerPool::acquire_deque();
+
+    assert_true(deque_1 != NULL);
+    assert_true(deque_2 != NULL);
+    assert_true(deque_1 != deque_2);
+    assert_eq(3, (int)WorkerPool::get_workers_count());
+
+    WorkerPool::release_deque(deque_1);
+    assert_eq(3, (int)WorkerPool::get_workers_count());
+
+    WorkerPool::release_deque(deque_2);
+    assert_eq(0, (int)WorkerPool::get_workers_count());
+})
+
+
+TEST(number_of_deques_is_limited, {
+    WorkerPool::override_workers_count(2);
+
+    constexpr Integer DEQUES = WorkerPool::MAX_DEQUES;
+
+    WorkerPool::Deque* deques[DEQUES + 1];
+
+    for (Integer i = 0; i != DEQUES; ++i) {
+        deques[i] = WorkerPool::acquire_deque();
+        assert_true(deques[i] != NULL, "i=%d", (int)i);
+    }
+
+    deques[DEQUES] = WorkerPool::acquire_deque();
+    assert_true(deques[DEQUES] == NULL);
+
+    for (Integer i = 0; i != DEQUES; ++i) {
+        WorkerPool::release_deque(deques[i]);
+    }
+
+    assert_eq(0, (int)WorkerPool::get_workers_count());
+})
+
+
+void submit_and_join_jobs(
+        WorkerPool::Deque* const deque,
+        CountingJob (&jobs)[WorkerPool::Deque::CAPACITY],
+        Integer const rounds
+) {
+    for (Integer r = 0; r != rounds; ++r) {
+        for (Integer i = 0; i != WorkerPool::Deque::CAPACITY; ++i) {
+            deque->submit(jobs[i]);
+        }
+
+        for (Integer i = 0; i != WorkerPool::Deque::CAPACITY; ++i) {
+            deque->join(jobs[i]);
+        }
+    }
+}
+
+
+TEST(every_submitted_job_is_run_exactly_once, {
+    constexpr Integer OWNERS = 4;
+    constexpr Integer ROUNDS = 200;
+
+    WorkerPool::override_workers_count(WorkerPool::MAX_WORKERS);
+
+    CountingJob jobs[OWNERS][WorkerPool::Deque::CAPACITY];
+    CountingJob expected;
+    WorkerPool::Deque* deques[OWNERS];
+    std::thread owners[OWNERS];
+
+    for (Integer r = 0; r != ROUNDS; ++r) {
+        expected.run();
+    }
+
+    for (Integer o = 0; o != OWNERS; ++o) {
+        deques[o] = WorkerPool::acquire_deque();
+        assert_true(deques[o] != NULL, "o=%d", (int)o);
+    }
+
+    for (Integer o = 0; o != OWNERS; ++o) {
+        owners[o] = std::thread(
+            submit_and_join_jobs, deques[o], std::ref(jobs[o]), ROUNDS
+        );
+    }
+
+    for (Integer o = 0; o != OWNERS; ++o) {
+        owners[o].join();
+        WorkerPool::release_deque(deques[o]);
+    }
+
+    for (Integer o = 0; o != OWNERS; ++o) {
+        for (Integer i = 0; i != WorkerPool::Deque::CAPACITY; ++i) {
+            assert_eq((int)ROUNDS, (int)jobs[o][i].runs, "o=%d, i=%d", (int)o, (int)i);
+            assert_eq((int)expected.value, (int)jobs[o][i].value, "o=%d, i=%d", (int)o, (int)i);
+        }
+    }
+})